@@ -80,6 +80,9 @@ if(ASSIMP_FOUND)
   unset(CMAKE_REQUIRED_LIBRARIES)
 endif()
 
+# Threads
+find_package(Threads REQUIRED)
+
 # Boost
 set(DART_MIN_BOOST_VERSION 1.46.0 CACHE INTERNAL "Boost min version requirement" FORCE)
 if(MSVC)
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/AllowedCollisionMatrixGenerator.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "dart/collision/CollisionDetector.hpp"
+#include "dart/collision/CollisionGroup.hpp"
+#include "dart/collision/CollisionOption.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/math/Constants.hpp"
+
+namespace dart {
+namespace collision {
+
+//==============================================================================
+std::shared_ptr<dynamics::AllowedCollisionMatrix> generateAllowedCollisionMatrix(
+    dynamics::Skeleton* skel,
+    const CollisionDetectorPtr& collisionDetector,
+    std::size_t numSamples,
+    unsigned int seed)
+{
+  assert(skel);
+  assert(collisionDetector);
+
+  const std::size_t numBodyNodes = skel->getNumBodyNodes();
+  const std::size_t numDofs = skel->getNumDofs();
+
+  auto matrix
+      = std::make_shared<dynamics::AllowedCollisionMatrix>(numBodyNodes);
+
+  // One group per BodyNode so that each pair can be checked on its own
+  std::vector<std::unique_ptr<CollisionGroup>> groups;
+  groups.reserve(numBodyNodes);
+  for (std::size_t i = 0u; i < numBodyNodes; ++i)
+  {
+    groups.emplace_back(collisionDetector->createCollisionGroup(
+        skel->getBodyNode(i)));
+  }
+
+  // A pair that collides in some samples but not in others needs to be
+  // checked, so it isn't tested again once that is known.
+  std::vector<std::size_t> numCollisions(numBodyNodes * numBodyNodes, 0u);
+  std::vector<bool> mayBeAllowed(numBodyNodes * numBodyNodes, true);
+
+  const Eigen::VectorXd originalPositions = skel->getPositions();
+  Eigen::VectorXd lower(numDofs);
+  Eigen::VectorXd upper(numDofs);
+  for (std::size_t i = 0u; i < numDofs; ++i)
+  {
+    lower[i] = skel->getPositionLowerLimit(i);
+    upper[i] = skel->getPositionUpperLimit(i);
+
+    if (!std::isfinite(lower[i]) || !std::isfinite(upper[i]))
+    {
+      lower[i] = -math::constantsd::pi();
+      upper[i] = math::constantsd::pi();
+    }
+  }
+
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  Eigen::VectorXd positions(numDofs);
+
+  const CollisionOption option(false, 1u, nullptr);
+
+  for (std::size_t sample = 0u; sample < numSamples; ++sample)
+  {
+    for (std::size_t i = 0u; i < numDofs; ++i)
+      positions[i] = lower[i] + distribution(generator) * (upper[i] - lower[i]);
+    skel->setPositions(positions);
+
+    for (std::size_t i = 0u; i < numBodyNodes; ++i)
+    {
+      if (groups[i]->getNumShapeFrames() == 0u)
+        continue;
+
+      for (std::size_t j = i + 1u; j < numBodyNodes; ++j)
+      {
+        const std::size_t pair = i * numBodyNodes + j;
+        if (!mayBeAllowed[pair] || groups[j]->getNumShapeFrames() == 0u)
+          continue;
+
+        if (groups[i]->collide(groups[j].get(), option))
+          ++numCollisions[pair];
+
+        if (numCollisions[pair] != 0u && numCollisions[pair] != sample + 1u)
+          mayBeAllowed[pair] = false;
+      }
+    }
+  }
+
+  skel->setPositions(originalPositions);
+
+  for (std::size_t i = 0u; i < numBodyNodes; ++i)
+  {
+    for (std::size_t j = i + 1u; j < numBodyNodes; ++j)
+    {
+      if (mayBeAllowed[i * numBodyNodes + j])
+        matrix->setCollisionAllowed(i, j);
+    }
+  }
+
+  return matrix;
+}
+
+}  // namespace collision
+}  // namespace dart
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_ALLOWEDCOLLISIONMATRIXGENERATOR_HPP_
+#define DART_COLLISION_ALLOWEDCOLLISIONMATRIXGENERATOR_HPP_
+
+#include <memory>
+
+#include "dart/collision/SmartPointer.hpp"
+#include "dart/dynamics/AllowedCollisionMatrix.hpp"
+
+namespace dart {
+
+namespace dynamics {
+class Skeleton;
+}  // namespace dynamics
+
+namespace collision {
+
+/// Create the allowed collision matrix of skel by checking its self-collisions
+/// with collisionDetector in numSamples random configurations. The positions
+/// are sampled uniformly within the position limits, or within [-pi, pi] for
+/// unlimited degrees of freedom. Each pair of BodyNodes that collided in none
+/// of the samples or in all of them is allowed to collide, i.e., won't be
+/// checked once the matrix is set by Skeleton::setAllowedCollisionMatrix().
+///
+/// Pairs that only collide in rare configurations may be missed by the
+/// sampling, so numSamples should be large enough for the given Skeleton. The
+/// positions of skel are restored before returning. The result is
+/// deterministic for a given seed.
+std::shared_ptr<dynamics::AllowedCollisionMatrix> generateAllowedCollisionMatrix(
+    dynamics::Skeleton* skel,
+    const CollisionDetectorPtr& collisionDetector,
+    std::size_t numSamples = 1000u,
+    unsigned int seed = 0u);
+
+}  // namespace collision
+}  // namespace dart
+
+#endif  // DART_COLLISION_ALLOWEDCOLLISIONMATRIXGENERATOR_HPP_
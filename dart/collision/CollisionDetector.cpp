@@ -34,6 +34,7 @@
 #include <algorithm>
 
 #include "dart/common/Console.hpp"
+#include "dart/common/ThreadPool.hpp"
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/CollisionGroup.hpp"
 #include "dart/dynamics/BodyNode.hpp"
@@ -49,6 +50,113 @@ CollisionDetector::createCollisionGroupAsSharedPtr()
   return std::shared_ptr<CollisionGroup>(createCollisionGroup().release());
 }
 
+//==============================================================================
+static bool checkRaycastGroupValidity(
+    CollisionDetector* cd, CollisionGroup* group)
+{
+  if (cd != group->getCollisionDetector().get())
+  {
+    dterr << "[CollisionDetector::raycast] Attempting to cast rays against a "
+          << "collision group that is created from a different collision "
+          << "detector instance.\n";
+
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+static void sortRayHits(const RaycastOption& option, RaycastResult* result)
+{
+  auto& hits = result->rayHits;
+  if (hits.size() < 2u)
+    return;
+
+  const auto closer = [](const RayHit& hit1, const RayHit& hit2)
+  {
+    return hit1.fraction < hit2.fraction;
+  };
+
+  if (option.enableAllHits)
+  {
+    std::sort(hits.begin(), hits.end(), closer);
+  }
+  else
+  {
+    std::iter_swap(hits.begin(), std::min_element(hits.begin(), hits.end(),
+                                                  closer));
+    hits.resize(1u);
+  }
+}
+
+//==============================================================================
+bool CollisionDetector::raycast(
+    CollisionGroup* group,
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& to,
+    const RaycastOption& option,
+    RaycastResult* result)
+{
+  RaycastResult localResult;
+  if (!result)
+    result = &localResult;
+
+  result->clear();
+
+  if (!checkRaycastGroupValidity(this, group))
+    return false;
+
+  group->updateEngineData();
+
+  castRay(group, Ray(from, to), option, result);
+  sortRayHits(option, result);
+
+  return result->hasHit();
+}
+
+//==============================================================================
+std::size_t CollisionDetector::raycast(
+    CollisionGroup* group,
+    const std::vector<Ray>& rays,
+    const RaycastOption& option,
+    std::vector<RaycastResult>* results)
+{
+  std::vector<RaycastResult> localResults;
+  if (!results)
+    results = &localResults;
+
+  results->resize(rays.size());
+  for (auto& result : *results)
+    result.clear();
+
+  if (!checkRaycastGroupValidity(this, group))
+    return 0u;
+
+  group->updateEngineData();
+
+  const auto cast = [&](std::size_t i)
+  {
+    RaycastResult& result = (*results)[i];
+    castRay(group, rays[i], option, &result);
+    sortRayHits(option, &result);
+  };
+
+  if (option.threadPool && canCastRaysConcurrently())
+  {
+    option.threadPool->parallelFor(0u, rays.size(), cast);
+  }
+  else
+  {
+    for (std::size_t i = 0u; i < rays.size(); ++i)
+      cast(i);
+  }
+
+  return static_cast<std::size_t>(std::count_if(
+      results->begin(), results->end(),
+      [](const RaycastResult& result) { return result.hasHit(); }));
+}
+
 //==============================================================================
 std::shared_ptr<CollisionObject> CollisionDetector::claimCollisionObject(
     const dynamics::ShapeFrame* shapeFrame)
@@ -66,6 +174,12 @@ void CollisionDetector::notifyCollisionObjectDestroying(
   // Do nothing
 }
 
+//==============================================================================
+bool CollisionDetector::canCastRaysConcurrently() const
+{
+  return true;
+}
+
 //==============================================================================
 CollisionDetector::CollisionObjectManager::CollisionObjectManager(
     CollisionDetector* cd)
@@ -42,6 +42,9 @@
 #include "dart/collision/CollisionResult.hpp"
 #include "dart/collision/DistanceOption.hpp"
 #include "dart/collision/DistanceResult.hpp"
+#include "dart/collision/Ray.hpp"
+#include "dart/collision/RaycastOption.hpp"
+#include "dart/collision/RaycastResult.hpp"
 #include "dart/collision/SmartPointer.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
 
@@ -142,6 +145,30 @@ public:
       const DistanceOption& option = DistanceOption(false, 0.0, nullptr),
       DistanceResult* result = nullptr) = 0;
 
+  /// Cast a ray from 'from' to 'to' against the shapes in the given
+  /// CollisionGroup, and return true if it hits any of them.
+  ///
+  /// The hits are stored in the given RaycastResult if provided. A ray that
+  /// starts inside a solid shape doesn't hit that shape.
+  bool raycast(
+      CollisionGroup* group,
+      const Eigen::Vector3d& from,
+      const Eigen::Vector3d& to,
+      const RaycastOption& option = RaycastOption(),
+      RaycastResult* result = nullptr);
+
+  /// Cast a batch of rays against the shapes in the given CollisionGroup, and
+  /// return the number of rays that hit any of them.
+  ///
+  /// The engine data of the group is updated only once for the whole batch,
+  /// and the rays are distributed over RaycastOption::threadPool if provided.
+  /// The hits of rays[i] are stored in (*results)[i] if results is provided.
+  std::size_t raycast(
+      CollisionGroup* group,
+      const std::vector<Ray>& rays,
+      const RaycastOption& option = RaycastOption(),
+      std::vector<RaycastResult>* results = nullptr);
+
 protected:
 
   class CollisionObjectManager;
@@ -163,6 +190,19 @@ protected:
   /// Notify that a CollisionObject is destroying. Do nothing by default.
   virtual void notifyCollisionObjectDestroying(CollisionObject* object);
 
+  /// Add a hit to result for every CollisionObject of group that the ray
+  /// enters, in any order. The engine data of group is already up to date.
+  /// This is called concurrently for different rays unless
+  /// canCastRaysConcurrently() returns false.
+  virtual void castRay(
+      const CollisionGroup* group,
+      const Ray& ray,
+      const RaycastOption& option,
+      RaycastResult* result) = 0;
+
+  /// Return true if castRay() may be called concurrently. True by default.
+  virtual bool canCastRaysConcurrently() const;
+
 protected:
 
   std::unique_ptr<CollisionObjectManager> mCollisionObjectManager;
@@ -32,6 +32,7 @@
 #include "dart/collision/CollisionFilter.hpp"
 
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Skeleton.hpp"
 #include "dart/collision/CollisionObject.hpp"
 
 namespace dart {
@@ -52,19 +53,28 @@ bool BodyNodeCollisionFilter::needCollision(
     return true;
   // We assume that non-ShapeNode is always being checked collision.
 
-  auto bodyNode1 = shapeNode1->getBodyNodePtr();
-  auto bodyNode2 = shapeNode2->getBodyNodePtr();
+  // Collision detection may run in a worker thread, so the BodyNodes are not
+  // reference counted here
+  const dynamics::BodyNode* bodyNode1 = shapeNode1->getRawBodyNode();
+  const dynamics::BodyNode* bodyNode2 = shapeNode2->getRawBodyNode();
 
   if (!bodyNode1->isCollidable() || !bodyNode2->isCollidable())
     return false;
 
-  if (bodyNode1->getSkeleton() == bodyNode2->getSkeleton())
+  const auto skeleton = bodyNode1->getSkeleton();
+  if (skeleton == bodyNode2->getSkeleton())
   {
-    auto skeleton = bodyNode1->getSkeleton();
-
     if (!skeleton->isEnabledSelfCollisionCheck())
       return false;
 
+    const auto& matrix = skeleton->getAllowedCollisionMatrix();
+    if (matrix && matrix->getNumBodyNodes() == skeleton->getNumBodyNodes()
+        && matrix->isCollisionAllowed(bodyNode1->getIndexInSkeleton(),
+                                      bodyNode2->getIndexInSkeleton()))
+    {
+      return false;
+    }
+
     if (!skeleton->isEnabledAdjacentBodyCheck())
     {
       if (areAdjacentBodies(bodyNode1, bodyNode2))
@@ -36,6 +36,8 @@
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/CollisionDetector.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Shape.hpp"
+#include "dart/dynamics/ShapeFrame.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 
 namespace dart {
@@ -74,6 +76,9 @@ void CollisionGroup::addShapeFrame(const dynamics::ShapeFrame* shapeFrame)
   addCollisionObjectToEngine(collObj.get());
 
   mShapeFrameMap.push_back(std::make_pair(shapeFrame, collObj));
+
+  // The engine data of a newly added CollisionObject is always updated
+  mEngineDataStates.push_back(EngineDataState{0u, nullptr, 0u});
 }
 
 //==============================================================================
@@ -107,6 +112,8 @@ void CollisionGroup::removeShapeFrame(const dynamics::ShapeFrame* shapeFrame)
 
   removeCollisionObjectFromEngine(search->second.get());
 
+  mEngineDataStates.erase(mEngineDataStates.begin()
+                          + (search - mShapeFrameMap.begin()));
   mShapeFrameMap.erase(search);
 }
 
@@ -130,6 +137,7 @@ void CollisionGroup::removeAllShapeFrames()
   removeAllCollisionObjectsFromEngine();
 
   mShapeFrameMap.clear();
+  mEngineDataStates.clear();
 }
 
 //==============================================================================
@@ -192,13 +200,75 @@ double CollisionGroup::distance(
   return mCollisionDetector->distance(this, otherGroup, option, result);
 }
 
+//==============================================================================
+bool CollisionGroup::raycast(
+    const Eigen::Vector3d& from,
+    const Eigen::Vector3d& to,
+    const RaycastOption& option,
+    RaycastResult* result)
+{
+  return mCollisionDetector->raycast(this, from, to, option, result);
+}
+
+//==============================================================================
+std::size_t CollisionGroup::raycast(
+    const std::vector<Ray>& rays,
+    const RaycastOption& option,
+    std::vector<RaycastResult>* results)
+{
+  return mCollisionDetector->raycast(this, rays, option, results);
+}
+
 //==============================================================================
 void CollisionGroup::updateEngineData()
 {
-  for (auto& pair : mShapeFrameMap)
-    pair.second->updateEngineData();
+  assert(mEngineDataStates.size() == mShapeFrameMap.size());
+
+  // Shapes whose primitive properties or vertices might change are updated
+  // every time because not all of them tell us when they change (e.g., the
+  // point masses move the vertices of a SoftMeshShape)
+  const unsigned int deformingVariance = dynamics::Shape::DYNAMIC_PRIMITIVE
+      | dynamics::Shape::DYNAMIC_VERTICES
+      | dynamics::Shape::DYNAMIC_ELEMENTS;
+
+  mUpdatedCollisionObjects.clear();
+
+  for (std::size_t i = 0u; i < mShapeFrameMap.size(); ++i)
+  {
+    const dynamics::ShapeFrame* shapeFrame = mShapeFrameMap[i].first;
+    CollisionObject* collObj = mShapeFrameMap[i].second.get();
+    EngineDataState& state = mEngineDataStates[i];
+
+    const std::size_t transformVersion
+        = shapeFrame->getWorldTransformVersion();
+    const dynamics::Shape* shape = shapeFrame->getShape().get();
+    const std::size_t shapeVersion = shape ? shape->getVersion() : 0u;
+
+    if (transformVersion == state.mTransformVersion
+        && shape == state.mShape
+        && shapeVersion == state.mShapeVersion
+        && !(shape && (shape->getDataVariance() & deformingVariance)))
+    {
+      continue;
+    }
+
+    collObj->updateEngineData();
+    mUpdatedCollisionObjects.push_back(collObj);
+
+    state.mTransformVersion = transformVersion;
+    state.mShape = shape;
+    state.mShapeVersion = shapeVersion;
+  }
+
+  refitCollisionGroupEngineData(mUpdatedCollisionObjects);
+}
 
-  updateCollisionGroupEngineData();
+//==============================================================================
+void CollisionGroup::refitCollisionGroupEngineData(
+    const std::vector<CollisionObject*>& updatedObjects)
+{
+  if (!updatedObjects.empty())
+    updateCollisionGroupEngineData();
 }
 
 }  // namespace collision
@@ -39,6 +39,9 @@
 #include "dart/collision/CollisionResult.hpp"
 #include "dart/collision/DistanceOption.hpp"
 #include "dart/collision/DistanceResult.hpp"
+#include "dart/collision/Ray.hpp"
+#include "dart/collision/RaycastOption.hpp"
+#include "dart/collision/RaycastResult.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
 
 namespace dart {
@@ -48,6 +51,8 @@ class CollisionGroup
 {
 public:
 
+  friend class CollisionDetector;
+
   /// Constructor
   CollisionGroup(const CollisionDetectorPtr& collisionDetector);
   // CollisionGroup also can be created from CollisionDetector::create()
@@ -211,10 +216,34 @@ public:
       const DistanceOption& option = DistanceOption(false, 0.0, nullptr),
       DistanceResult* result = nullptr);
 
+  /// Cast a ray from 'from' to 'to' against the shapes in this CollisionGroup,
+  /// and return true if it hits any of them.
+  ///
+  /// \sa CollisionDetector::raycast()
+  bool raycast(
+      const Eigen::Vector3d& from,
+      const Eigen::Vector3d& to,
+      const RaycastOption& option = RaycastOption(),
+      RaycastResult* result = nullptr);
+
+  /// Cast a batch of rays against the shapes in this CollisionGroup, and
+  /// return the number of rays that hit any of them.
+  ///
+  /// \sa CollisionDetector::raycast()
+  std::size_t raycast(
+      const std::vector<Ray>& rays,
+      const RaycastOption& option = RaycastOption(),
+      std::vector<RaycastResult>* results = nullptr);
+
 protected:
 
   /// Update engine data. This function should be called before the collision
   /// detection is performed by the engine in most cases.
+  ///
+  /// Only the CollisionObjects whose ShapeFrames have moved, whose Shapes
+  /// have been modified (see Shape::getVersion()) or whose Shapes have a
+  /// deforming data variance are updated, so static objects cost next to
+  /// nothing.
   void updateEngineData();
 
   /// Initialize the collision detection engine data such as broadphase
@@ -239,6 +268,15 @@ protected:
   /// This function will be called ahead of every collision checking.
   virtual void updateCollisionGroupEngineData() = 0;
 
+  /// Refit the collision detection engine data such as broadphase algorithm
+  /// to the given CollisionObjects, which are the ones whose engine data was
+  /// updated since the last collision checking. This function will be called
+  /// ahead of every collision checking, even when no CollisionObject was
+  /// updated. The default implementation calls
+  /// updateCollisionGroupEngineData() unless updatedObjects is empty.
+  virtual void refitCollisionGroupEngineData(
+      const std::vector<CollisionObject*>& updatedObjects);
+
 protected:
 
   /// Collision detector
@@ -264,6 +302,27 @@ protected:
   // original and copy are not guranteed to be the same as we copy std::map
   // (e.g., by world cloning).
 
+  /// State of a ShapeFrame in mShapeFrameMap when the engine data of its
+  /// CollisionObject was last updated by this CollisionGroup
+  struct EngineDataState
+  {
+    /// World transform version of the ShapeFrame
+    std::size_t mTransformVersion;
+
+    /// Shape of the ShapeFrame
+    const dynamics::Shape* mShape;
+
+    /// Version of mShape, which changes when its geometry is modified
+    std::size_t mShapeVersion;
+  };
+
+  /// Engine data states of the ShapeFrames, in the same order as
+  /// mShapeFrameMap
+  std::vector<EngineDataState> mEngineDataStates;
+
+  /// CollisionObjects updated by the last call of updateEngineData()
+  std::vector<CollisionObject*> mUpdatedCollisionObjects;
+
 };
 
 }  // namespace collision
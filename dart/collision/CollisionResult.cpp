@@ -31,6 +31,10 @@
 
 #include "dart/collision/CollisionResult.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/dynamics/ShapeFrame.hpp"
 #include "dart/dynamics/ShapeNode.hpp"
@@ -121,6 +125,130 @@ void CollisionResult::clear()
   mCollidingBodyNodes.clear();
 }
 
+//==============================================================================
+static const void* getContactOwner(const CollisionObject* object)
+{
+  const dynamics::ShapeFrame* frame = object->getShapeFrame();
+
+  if (frame->isShapeNode())
+    return frame->asShapeNode()->getRawBodyNode();
+
+  return frame;
+}
+
+//==============================================================================
+bool CollisionResult::ContactKey::operator<(const ContactKey& other) const
+{
+  const std::less<const void*> less;
+
+  if (owner1 != other.owner1)
+    return less(owner1, other.owner1);
+
+  if (owner2 != other.owner2)
+    return less(owner2, other.owner2);
+
+  return index < other.index;
+}
+
+//==============================================================================
+std::size_t CollisionResult::reduceContacts(std::size_t maxNumContactsPerPair)
+{
+  assert(maxNumContactsPerPair > 0u);
+
+  const std::size_t numContacts = mContacts.size();
+  if (numContacts <= maxNumContactsPerPair)
+    return 0u;
+
+  // Cluster the contacts by the pair of bodies. Sorting keeps the contacts of
+  // a pair next to each other and in their original order.
+  mReductionKeys.resize(numContacts);
+  for (std::size_t i = 0u; i < numContacts; ++i)
+  {
+    ContactKey& key = mReductionKeys[i];
+    key.owner1 = getContactOwner(mContacts[i].collisionObject1);
+    key.owner2 = getContactOwner(mContacts[i].collisionObject2);
+    if (std::less<const void*>()(key.owner2, key.owner1))
+      std::swap(key.owner1, key.owner2);
+    key.index = i;
+  }
+  std::sort(mReductionKeys.begin(), mReductionKeys.end());
+
+  mReductionKept.assign(numContacts, true);
+
+  std::size_t end = 0u;
+  for (std::size_t begin = 0u; begin < numContacts; begin = end)
+  {
+    end = begin + 1u;
+    while (end < numContacts
+           && mReductionKeys[end].owner1 == mReductionKeys[begin].owner1
+           && mReductionKeys[end].owner2 == mReductionKeys[begin].owner2)
+    {
+      ++end;
+    }
+
+    const ContactKey* cluster = mReductionKeys.data() + begin;
+    const std::size_t clusterSize = end - begin;
+    if (clusterSize <= maxNumContactsPerPair)
+      continue;
+
+    for (std::size_t i = 0u; i < clusterSize; ++i)
+      mReductionKept[cluster[i].index] = false;
+
+    // Start from the deepest contact
+    std::size_t selected = 0u;
+    for (std::size_t i = 1u; i < clusterSize; ++i)
+    {
+      if (mContacts[cluster[i].index].penetrationDepth
+          > mContacts[cluster[selected].index].penetrationDepth)
+      {
+        selected = i;
+      }
+    }
+
+    // Then repeatedly add the contact that is farthest from all the contacts
+    // kept so far
+    mReductionDistances.assign(
+          clusterSize, std::numeric_limits<double>::infinity());
+    for (std::size_t k = 0u; k < maxNumContactsPerPair; ++k)
+    {
+      mReductionKept[cluster[selected].index] = true;
+      mReductionDistances[selected] = -1.0;
+
+      const Eigen::Vector3d& point = mContacts[cluster[selected].index].point;
+      std::size_t next = selected;
+      for (std::size_t i = 0u; i < clusterSize; ++i)
+      {
+        if (mReductionDistances[i] < 0.0)
+          continue;
+
+        mReductionDistances[i] = std::min(
+            mReductionDistances[i],
+            (mContacts[cluster[i].index].point - point).squaredNorm());
+
+        if (next == selected
+            || mReductionDistances[i] > mReductionDistances[next])
+        {
+          next = i;
+        }
+      }
+
+      selected = next;
+    }
+  }
+
+  std::size_t numKept = 0u;
+  for (std::size_t i = 0u; i < numContacts; ++i)
+  {
+    if (mReductionKept[i])
+      mContacts[numKept++] = mContacts[i];
+  }
+
+  const std::size_t numRemoved = numContacts - numKept;
+  mContacts.resize(numKept);
+
+  return numRemoved;
+}
+
 //==============================================================================
 void CollisionResult::addObject(CollisionObject* object)
 {
@@ -139,7 +267,7 @@ void CollisionResult::addObject(CollisionObject* object)
   if(frame->isShapeNode())
   {
     const dynamics::ShapeNode* node = frame->asShapeNode();
-    mCollidingBodyNodes.insert(node->getBodyNodePtr());
+    mCollidingBodyNodes.insert(node->getRawBodyNode());
   }
 }
 
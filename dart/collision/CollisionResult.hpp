@@ -89,6 +89,15 @@ public:
   /// Clear all the contacts
   void clear();
 
+  /// Reduce the contacts between each pair of BodyNodes (or of ShapeFrames
+  /// that are not ShapeNodes) to at most maxNumContactsPerPair. The deepest
+  /// contact of a pair is kept first. Each further contact is the one farthest
+  /// from the contacts kept so far, which spreads the kept contacts over the
+  /// contact area. The order of the kept contacts is preserved.
+  ///
+  /// Returns the number of contacts that were removed.
+  std::size_t reduceContacts(std::size_t maxNumContactsPerPair);
+
 protected:
 
   void addObject(CollisionObject* object);
@@ -102,6 +111,26 @@ protected:
   /// Set of ShapeFrames that are colliding
   std::unordered_set<const dynamics::ShapeFrame*> mCollidingShapeFrames;
 
+  /// Contact of mContacts together with the pair of bodies it belongs to
+  struct ContactKey
+  {
+    const void* owner1;
+    const void* owner2;
+    std::size_t index;
+
+    bool operator<(const ContactKey& other) const;
+  };
+
+  /// Contacts sorted by the pair of bodies, reused by reduceContacts()
+  std::vector<ContactKey> mReductionKeys;
+
+  /// Whether each contact is kept, reused by reduceContacts()
+  std::vector<bool> mReductionKept;
+
+  /// Distances of the contacts of a pair to the kept contacts, reused by
+  /// reduceContacts()
+  std::vector<double> mReductionDistances;
+
 };
 
 }  // namespace collision
@@ -63,7 +63,8 @@ struct Contact
   /// Second colliding collision object
   CollisionObject* collisionObject2;
 
-  /// Penetration depth
+  /// Penetration depth. The speculative contacts of the ConstraintSolver have
+  /// a negative depth, whose magnitude is the gap between the objects.
   double penetrationDepth;
 
   // TODO(JS): triID1 will be deprecated when we don't use fcl_mesh
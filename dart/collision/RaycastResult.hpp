@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_RAYCAST_RESULT_HPP_
+#define DART_COLLISION_RAYCAST_RESULT_HPP_
+
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace collision {
+
+class CollisionObject;
+
+struct RayHit
+{
+  /// Collision object hit by the ray
+  CollisionObject* collisionObject;
+
+  /// Point where the ray enters the shape w.r.t. the world frame
+  Eigen::Vector3d point;
+
+  /// Normal of the surface at the hit point w.r.t. the world frame, which
+  /// points against the ray
+  Eigen::Vector3d normal;
+
+  /// Fraction of the ray from its start to the hit point, which is in [0, 1]
+  double fraction;
+
+  /// Constructor
+  RayHit();
+};
+
+struct RaycastResult
+{
+  /// Hits sorted by RayHit::fraction. There is at most one hit for each
+  /// collision object, and only the closest one unless
+  /// RaycastOption::enableAllHits is true.
+  std::vector<RayHit> rayHits;
+
+  /// Clear the result
+  void clear();
+
+  /// Return true if the ray hit at least one shape
+  bool hasHit() const;
+};
+
+}  // namespace collision
+}  // namespace dart
+
+#endif  // DART_COLLISION_RAYCAST_RESULT_HPP_
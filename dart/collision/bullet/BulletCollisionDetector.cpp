@@ -34,6 +34,8 @@
 
 #include "dart/collision/bullet/BulletCollisionDetector.hpp"
 
+#include <algorithm>
+
 #include <bullet/BulletCollision/Gimpact/btGImpactShape.h>
 
 #include "dart/common/Console.hpp"
@@ -363,6 +365,76 @@ void BulletCollisionDetector::notifyCollisionObjectDestroying(
   reclaimBulletCollisionShape(object->getShape());
 }
 
+//==============================================================================
+void BulletCollisionDetector::castRay(
+    const CollisionGroup* group,
+    const Ray& ray,
+    const RaycastOption& option,
+    RaycastResult* result)
+{
+  const auto casted = static_cast<const BulletCollisionGroup*>(group);
+  const auto collisionWorld = casted->getBulletCollisionWorld();
+
+  const btVector3 from = convertVector3(ray.from);
+  const btVector3 to = convertVector3(ray.to);
+
+  const auto addHit = [&](const btCollisionObject* bulletCollObj,
+                          const btVector3& point,
+                          const btVector3& normal,
+                          double fraction)
+  {
+    const auto userData = static_cast<BulletCollisionObject::UserData*>(
+          bulletCollObj->getUserPointer());
+    assert(userData);
+
+    // Meshes report a hit for every triangle, but only the closest one of
+    // each collision object is kept
+    auto& hits = result->rayHits;
+    auto it = std::find_if(hits.begin(), hits.end(), [&](const RayHit& hit)
+    {
+      return hit.collisionObject == userData->collisionObject;
+    });
+    if (it == hits.end())
+      it = hits.insert(hits.end(), RayHit());
+    else if (it->fraction <= fraction)
+      return;
+
+    it->collisionObject = userData->collisionObject;
+    it->point = convertVector3(point);
+    it->normal = convertVector3(normal).normalized();
+    it->fraction = fraction;
+  };
+
+  if (option.enableAllHits)
+  {
+    btCollisionWorld::AllHitsRayResultCallback callback(from, to);
+    collisionWorld->rayTest(from, to, callback);
+
+    for (auto i = 0; i < callback.m_collisionObjects.size(); ++i)
+    {
+      addHit(callback.m_collisionObjects[i], callback.m_hitPointWorld[i],
+             callback.m_hitNormalWorld[i], callback.m_hitFractions[i]);
+    }
+  }
+  else
+  {
+    btCollisionWorld::ClosestRayResultCallback callback(from, to);
+    collisionWorld->rayTest(from, to, callback);
+
+    if (callback.hasHit())
+    {
+      addHit(callback.m_collisionObject, callback.m_hitPointWorld,
+             callback.m_hitNormalWorld, callback.m_closestHitFraction);
+    }
+  }
+}
+
+//==============================================================================
+bool BulletCollisionDetector::canCastRaysConcurrently() const
+{
+  return false;
+}
+
 //==============================================================================
 btCollisionShape* BulletCollisionDetector::claimBulletCollisionShape(
     const dynamics::ConstShapePtr& shape)
@@ -107,6 +107,17 @@ protected:
   // Documentation inherited
   void notifyCollisionObjectDestroying(CollisionObject* object) override;
 
+  // Documentation inherited
+  void castRay(
+      const CollisionGroup* group,
+      const Ray& ray,
+      const RaycastOption& option,
+      RaycastResult* result) override;
+
+  /// Return false because btCollisionWorld::rayTest() reuses the traversal
+  /// stack of the broad-phase, so it can't be called concurrently
+  bool canCastRaysConcurrently() const override;
+
 private:
 
   btCollisionShape* claimBulletCollisionShape(
@@ -111,6 +111,19 @@ void BulletCollisionGroup::updateCollisionGroupEngineData()
   mBulletCollisionWorld->updateAabbs();
 }
 
+//==============================================================================
+void BulletCollisionGroup::refitCollisionGroupEngineData(
+    const std::vector<CollisionObject*>& updatedObjects)
+{
+  for (auto collObj : updatedObjects)
+  {
+    auto casted = static_cast<BulletCollisionObject*>(collObj);
+
+    mBulletCollisionWorld->updateSingleAabb(
+          casted->getBulletCollisionObject());
+  }
+}
+
 //==============================================================================
 btCollisionWorld* BulletCollisionGroup::getBulletCollisionWorld()
 {
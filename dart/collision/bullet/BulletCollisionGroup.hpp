@@ -75,6 +75,10 @@ protected:
   // Documentation inherited
   void updateCollisionGroupEngineData() override;
 
+  // Documentation inherited
+  void refitCollisionGroupEngineData(
+      const std::vector<CollisionObject*>& updatedObjects) override;
+
   /// Return Bullet collision world
   btCollisionWorld* getBulletCollisionWorld();
 
@@ -32,6 +32,9 @@
 #include "dart/collision/dart/DARTCollide.hpp"
 #include "dart/collision/CollisionObject.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 
 #include "dart/math/Helpers.hpp"
@@ -39,6 +42,13 @@
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/EllipsoidShape.hpp"
 #include "dart/dynamics/CylinderShape.hpp"
+#include "dart/dynamics/CapsuleShape.hpp"
+#include "dart/dynamics/PlaneShape.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
+#include "dart/dynamics/VoxelGridShape.hpp"
+#include "dart/dynamics/MultiSphereShape.hpp"
+#include "dart/dynamics/MeshShape.hpp"
+#include "dart/dynamics/SoftMeshShape.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 
 namespace dart {
@@ -1109,143 +1119,1148 @@ int collideSphereSphere(CollisionObject* o1, CollisionObject* o2, const double&
 
 }
 
-int collideCylinderSphere(CollisionObject* o1, CollisionObject* o2, const double& cyl_rad, const double& half_height, const Eigen::Isometry3d& T0,
+//==============================================================================
+static void addContact(CollisionObject* o1, CollisionObject* o2,
+                       const Eigen::Vector3d& point,
+                       const Eigen::Vector3d& normal,
+                       double penetration,
+                       CollisionResult& result)
+{
+  Contact contact;
+  contact.collisionObject1 = o1;
+  contact.collisionObject2 = o2;
+  contact.point = point;
+  contact.normal = normal;
+  contact.penetrationDepth = penetration;
+  result.addContact(contact);
+}
+
+//==============================================================================
+// Make the contacts added since firstContact read as if the two objects had
+// been passed in the other order
+static void swapContacts(CollisionResult& result, std::size_t firstContact)
+{
+  for (std::size_t i = firstContact; i < result.getNumContacts(); ++i)
+  {
+    Contact& contact = result.getContact(i);
+    std::swap(contact.collisionObject1, contact.collisionObject2);
+    contact.normal = -contact.normal;
+  }
+}
+
+//==============================================================================
+// Compute the parameters s and t of the closest points p0 + s * (q0 - p0) and
+// p1 + t * (q1 - p1) of two segments
+static void computeClosestPointsOnSegments(
+    const Eigen::Vector3d& p0, const Eigen::Vector3d& q0,
+    const Eigen::Vector3d& p1, const Eigen::Vector3d& q1,
+    double& s, double& t)
+{
+  const Eigen::Vector3d d0 = q0 - p0;
+  const Eigen::Vector3d d1 = q1 - p1;
+  const Eigen::Vector3d r = p0 - p1;
+  const double a = d0.squaredNorm();
+  const double e = d1.squaredNorm();
+  const double f = d1.dot(r);
+
+  if (a <= DART_COLLISION_EPS && e <= DART_COLLISION_EPS)
+  {
+    s = 0.0;
+    t = 0.0;
+    return;
+  }
+
+  if (a <= DART_COLLISION_EPS)
+  {
+    s = 0.0;
+    t = math::clip(f / e, 0.0, 1.0);
+    return;
+  }
+
+  const double c = d0.dot(r);
+  if (e <= DART_COLLISION_EPS)
+  {
+    s = math::clip(-c / a, 0.0, 1.0);
+    t = 0.0;
+    return;
+  }
+
+  const double b = d0.dot(d1);
+  const double denom = a * e - b * b;
+  s = (denom > DART_COLLISION_EPS)
+      ? math::clip((b * f - c * e) / denom, 0.0, 1.0) : 0.0;
+  t = (b * s + f) / e;
+
+  if (t < 0.0)
+  {
+    s = math::clip(-c / a, 0.0, 1.0);
+    t = 0.0;
+  }
+  else if (t > 1.0)
+  {
+    s = math::clip((b - c) / a, 0.0, 1.0);
+    t = 1.0;
+  }
+}
+
+//==============================================================================
+// Clip the segment from p to q to the box of the given half size centered at
+// the origin. Return false if the segment misses the box.
+static bool clipSegmentToBox(const Eigen::Vector3d& p, const Eigen::Vector3d& q,
+                             const Eigen::Vector3d& halfSize,
+                             double& t0, double& t1)
+{
+  const Eigen::Vector3d d = q - p;
+  t0 = 0.0;
+  t1 = 1.0;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::abs(d[i]) < DART_COLLISION_EPS)
+    {
+      if (std::abs(p[i]) > halfSize[i])
+        return false;
+
+      continue;
+    }
+
+    double ta = (-halfSize[i] - p[i]) / d[i];
+    double tb = (halfSize[i] - p[i]) / d[i];
+    if (ta > tb)
+      std::swap(ta, tb);
+
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+    if (t0 > t1)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+static bool isInsideBox(const Eigen::Vector3d& point,
+                        const Eigen::Vector3d& halfSize)
+{
+  return (point.cwiseAbs().array() <= halfSize.array()).all();
+}
+
+//==============================================================================
+// Return the points on the rims of the two caps of a cylinder that reach the
+// farthest along -normal and along the two directions perpendicular to it. The
+// cylinder is given by its center and its (unit) axis. The points are in the
+// order: [bottom cap, top cap] x [-normal, +normal, +side, -side].
+static void computeCylinderRimPoints(
+    const Eigen::Vector3d& center, const Eigen::Vector3d& axis,
+    double radius, double halfHeight, const Eigen::Vector3d& normal,
+    Eigen::Vector3d points[8])
+{
+  Eigen::Vector3d down = normal.dot(axis) * axis - normal;
+  const double mag = down.norm();
+  if (mag > DART_COLLISION_EPS)
+  {
+    down /= mag;
+  }
+  else
+  {
+    // The caps are parallel to the plane. Any direction on the caps will do.
+    down = axis.unitOrthogonal();
+  }
+  const Eigen::Vector3d side = axis.cross(down);
+
+  for (int i = 0; i < 2; ++i)
+  {
+    const Eigen::Vector3d cap
+        = center + (i == 0 ? -halfHeight : halfHeight) * axis;
+    points[4 * i + 0] = cap + radius * down;
+    points[4 * i + 1] = cap - radius * down;
+    points[4 * i + 2] = cap + radius * side;
+    points[4 * i + 3] = cap - radius * side;
+  }
+}
+
+//==============================================================================
+int collideCylinderSphere(CollisionObject* o1, CollisionObject* o2,
+                          const double& cyl_rad, const double& half_height,
+                          const Eigen::Isometry3d& T0,
                           const double& sphere_rad, const Eigen::Isometry3d& T1,
                           CollisionResult& result)
 {
-  Eigen::Vector3d center = T0.inverse() * T1.translation();
+  const Eigen::Vector3d center = T0.inverse() * T1.translation();
+  const double dist = std::sqrt(center[0] * center[0] + center[1] * center[1]);
 
-  double dist = sqrt(center[0] * center[0] + center[1] * center[1]);
+  Eigen::Vector3d radial = Eigen::Vector3d::UnitX();
+  if (dist > DART_COLLISION_EPS)
+    radial = Eigen::Vector3d(center[0], center[1], 0.0) / dist;
 
-  if ( dist < cyl_rad && std::abs(center[2]) < half_height + sphere_rad )
+  if (dist <= cyl_rad && std::abs(center[2]) <= half_height)
   {
-    Contact contact;
-    contact.collisionObject1 = o1;
-    contact.collisionObject2 = o2;
-    contact.penetrationDepth = 0.5 * (half_height + sphere_rad - math::sign(center[2]) * center[2]);
-    contact.point = T0 * Eigen::Vector3d(center[0], center[1], half_height - contact.penetrationDepth);
-    contact.normal = T0.linear() * Eigen::Vector3d(0.0, 0.0, math::sign(center[2]));
-    result.addContact(contact);
+    // The center of the sphere is inside the cylinder. Push it out through the
+    // nearest of the side or the caps.
+    const double sidePenetration = cyl_rad - dist;
+    const double capPenetration = half_height - std::abs(center[2]);
+
+    Eigen::Vector3d normal;
+    double penetration;
+    if (capPenetration < sidePenetration)
+    {
+      normal = Eigen::Vector3d(0.0, 0.0, -math::sign(center[2]));
+      penetration = capPenetration + sphere_rad;
+    }
+    else
+    {
+      normal = -radial;
+      penetration = sidePenetration + sphere_rad;
+    }
+
+    addContact(o1, o2, T1.translation(), T0.linear() * normal, penetration,
+               result);
     return 1;
   }
-  else
+
+  // Closest point of the cylinder to the center of the sphere
+  Eigen::Vector3d point = std::min(dist, cyl_rad) * radial;
+  point[2] = math::clip(center[2], -half_height, half_height);
+
+  Eigen::Vector3d normal = point - center;
+  const double mag = normal.norm();
+  const double penetration = sphere_rad - mag;
+  if (penetration <= 0.0)
+    return 0;
+
+  normal /= mag;
+  addContact(o1, o2, T0 * point, T0.linear() * normal, penetration, result);
+
+  return 1;
+}
+
+//==============================================================================
+int collideCylinderPlane(CollisionObject* o1, CollisionObject* o2,
+                         const double& cyl_rad, const double& half_height,
+                         const Eigen::Isometry3d& T0,
+                         const Eigen::Vector3d& plane_normal,
+                         const Eigen::Isometry3d& T1,
+                         CollisionResult& result)
+{
+  const Eigen::Vector3d normal = T1.linear() * plane_normal;
+  const double offset = normal.dot(T1.translation());
+
+  // A cylinder lying on its side touches the plane along a line and a cylinder
+  // standing on a cap touches it over a disk, so take the contacts from the
+  // points of the cap rims instead of only the deepest point.
+  Eigen::Vector3d points[8];
+  computeCylinderRimPoints(T0.translation(), T0.linear().col(2), cyl_rad,
+                           half_height, normal, points);
+
+  int numContacts = 0;
+  for (const auto& point : points)
+  {
+    const double penetration = offset - normal.dot(point);
+    if (penetration > 0.0)
+    {
+      addContact(o1, o2, point, normal, penetration, result);
+      ++numContacts;
+    }
+  }
+
+  return numContacts;
+}
+
+//==============================================================================
+int collideCylinderBox(CollisionObject* o1, CollisionObject* o2,
+                       const double& cyl_rad, const double& half_height,
+                       const Eigen::Isometry3d& T0,
+                       const Eigen::Vector3d& size1,
+                       const Eigen::Isometry3d& T1,
+                       CollisionResult& result)
+{
+  // Everything below is in the frame of the box
+  const Eigen::Vector3d halfSize = 0.5 * size1;
+  const Eigen::Isometry3d T = T1.inverse() * T0;
+  const Eigen::Vector3d center = T.translation();
+  const Eigen::Vector3d axis = T.linear().col(2);
+
+  const auto projectCylinder = [&](const Eigen::Vector3d& n)
+  {
+    const double c = std::abs(n.dot(axis));
+    return half_height * c + cyl_rad * std::sqrt(std::max(0.0, 1.0 - c * c));
+  };
+  const auto projectBox = [&](const Eigen::Vector3d& n)
+  {
+    return halfSize.dot(n.cwiseAbs());
+  };
+
+  // Separating axis test. The face normals of the box, the axis of the
+  // cylinder, the cross products of the axis with the edges of the box and the
+  // directions from the axis to the corners of the box cover every way the
+  // two shapes can touch except a cap rim against an edge of the box, which is
+  // approximated by the neighboring axes. Edge axes are slightly penalized so
+  // that face contacts are preferred when they are about as deep.
+  double minScore = std::numeric_limits<double>::infinity();
+  double minPenetration = 0.0;
+  Eigen::Vector3d normal = Eigen::Vector3d::UnitZ();
+  const auto testAxis = [&](Eigen::Vector3d n, double bias)
   {
-    double penetration = 0.5 * (cyl_rad + sphere_rad - dist);
-    if ( penetration > 0.0 )
+    const double mag = n.norm();
+    if (mag < DART_COLLISION_EPS)
+      return true;
+
+    n /= mag;
+    const double distance = n.dot(center);
+    const double penetration
+        = projectCylinder(n) + projectBox(n) - std::abs(distance);
+    if (penetration < 0.0)
+      return false;
+
+    if (bias * penetration < minScore)
     {
-      if ( std::abs(center[2]) > half_height )
+      minScore = bias * penetration;
+      minPenetration = penetration;
+      normal = (distance < 0.0) ? -n : n;
+    }
+
+    return true;
+  };
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!testAxis(Eigen::Vector3d::Unit(i), 1.0))
+      return 0;
+  }
+
+  if (!testAxis(axis, 1.0))
+    return 0;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!testAxis(axis.cross(Eigen::Vector3d::Unit(i)), 1.05))
+      return 0;
+  }
+
+  Eigen::Vector3d corners[8];
+  for (int i = 0; i < 8; ++i)
+  {
+    corners[i] = Eigen::Vector3d(
+          (i & 1) ? halfSize[0] : -halfSize[0],
+          (i & 2) ? halfSize[1] : -halfSize[1],
+          (i & 4) ? halfSize[2] : -halfSize[2]);
+
+    const Eigen::Vector3d w = corners[i] - center;
+    if (!testAxis(w - w.dot(axis) * axis, 1.05))
+      return 0;
+  }
+
+  // The normal points from the box to the cylinder. Collect the points of the
+  // cylinder inside the box and the corners of the box inside the cylinder.
+  const double boxMax = projectBox(normal);
+  const double cylinderMin = normal.dot(center) - projectCylinder(normal);
+
+  int numContacts = 0;
+  const auto addBoxFrameContact
+      = [&](const Eigen::Vector3d& point, double penetration)
+  {
+    addContact(o1, o2, T1 * point, T1.linear() * normal,
+               std::min(penetration, minPenetration), result);
+    ++numContacts;
+  };
+
+  Eigen::Vector3d rimPoints[8];
+  computeCylinderRimPoints(center, axis, cyl_rad, half_height, normal,
+                           rimPoints);
+
+  // The line of the side of the cylinder that is nearest to the box, which is
+  // where a lying cylinder rests on a face
+  double t0;
+  double t1;
+  const Eigen::Vector3d& p = rimPoints[0];
+  const Eigen::Vector3d& q = rimPoints[4];
+  if (clipSegmentToBox(p, q, halfSize, t0, t1))
+  {
+    const Eigen::Vector3d start = p + t0 * (q - p);
+    const Eigen::Vector3d end = p + t1 * (q - p);
+
+    const double startPenetration = boxMax - normal.dot(start);
+    if (startPenetration > 0.0)
+      addBoxFrameContact(start, startPenetration);
+
+    const double endPenetration = boxMax - normal.dot(end);
+    if ((end - start).norm() > DART_COLLISION_EPS && endPenetration > 0.0)
+      addBoxFrameContact(end, endPenetration);
+  }
+
+  // The other points of the cap rims, which is where a standing cylinder rests
+  // on a face
+  for (int i = 0; i < 8; ++i)
+  {
+    if (i == 0 || i == 4)
+      continue;
+
+    const double penetration = boxMax - normal.dot(rimPoints[i]);
+    if (penetration > 0.0 && isInsideBox(rimPoints[i], halfSize))
+      addBoxFrameContact(rimPoints[i], penetration);
+  }
+
+  // The corners of the box inside the cylinder
+  const Eigen::Isometry3d Tinv = T.inverse();
+  for (const auto& corner : corners)
+  {
+    const Eigen::Vector3d local = Tinv * corner;
+    if (std::abs(local[2]) > half_height
+        || local.head<2>().squaredNorm() > cyl_rad * cyl_rad)
+    {
+      continue;
+    }
+
+    const double penetration = normal.dot(corner) - cylinderMin;
+    if (penetration > 0.0)
+      addBoxFrameContact(corner, penetration);
+  }
+
+  // Edge against edge: neither shape has a feature inside the other, so put
+  // a single contact between the deepest point of the cylinder and the box
+  if (numContacts == 0)
+  {
+    Eigen::Vector3d deepest = rimPoints[0];
+    if (normal.dot(rimPoints[4]) < normal.dot(deepest))
+      deepest = rimPoints[4];
+
+    const Eigen::Vector3d nearest
+        = deepest.cwiseMax(-halfSize).cwiseMin(halfSize);
+    addBoxFrameContact(0.5 * (deepest + nearest), minPenetration);
+  }
+
+  return numContacts;
+}
+
+//==============================================================================
+int collideCapsuleSphere(CollisionObject* o1, CollisionObject* o2,
+                         const double& capsule_rad, const double& half_height,
+                         const Eigen::Isometry3d& T0,
+                         const double& sphere_rad, const Eigen::Isometry3d& T1,
+                         CollisionResult& result)
+{
+  const Eigen::Vector3d center = T0.inverse() * T1.translation();
+
+  // The capsule acts as a sphere centered at the closest point of its segment
+  Eigen::Isometry3d T = T0;
+  T.translation()
+      = T0 * Eigen::Vector3d(
+          0.0, 0.0, math::clip(center[2], -half_height, half_height));
+
+  return collideSphereSphere(o1, o2, capsule_rad, T, sphere_rad, T1, result);
+}
+
+//==============================================================================
+int collideCapsuleCapsule(CollisionObject* o1, CollisionObject* o2,
+                          const double& rad0, const double& half_height0,
+                          const Eigen::Isometry3d& T0,
+                          const double& rad1, const double& half_height1,
+                          const Eigen::Isometry3d& T1,
+                          CollisionResult& result)
+{
+  const Eigen::Vector3d axis0 = T0.linear().col(2);
+  const Eigen::Vector3d axis1 = T1.linear().col(2);
+  const Eigen::Vector3d p0 = T0.translation() - half_height0 * axis0;
+  const Eigen::Vector3d q0 = T0.translation() + half_height0 * axis0;
+  const Eigen::Vector3d p1 = T1.translation() - half_height1 * axis1;
+  const Eigen::Vector3d q1 = T1.translation() + half_height1 * axis1;
+
+  Eigen::Isometry3d S0 = Eigen::Isometry3d::Identity();
+  Eigen::Isometry3d S1 = Eigen::Isometry3d::Identity();
+
+  // Parallel capsules touch along a line, so put a contact at each end of the
+  // part of the segments that overlaps
+  if (half_height0 > DART_COLLISION_EPS && half_height1 > DART_COLLISION_EPS
+      && std::abs(axis0.dot(axis1)) > 1.0 - DART_COLLISION_EPS)
+  {
+    const double length0 = 2.0 * half_height0;
+    double s0 = axis0.dot(p1 - p0) / length0;
+    double s1 = axis0.dot(q1 - p0) / length0;
+    if (s0 > s1)
+      std::swap(s0, s1);
+    s0 = std::max(s0, 0.0);
+    s1 = std::min(s1, 1.0);
+
+    if (s1 - s0 > DART_COLLISION_EPS)
+    {
+      int numContacts = 0;
+      for (const double s : {s0, s1})
       {
-        Eigen::Vector3d point = (Eigen::Vector3d(center[0], center[1], 0.0).normalized());
-        point *= cyl_rad;
-        point[2] = math::sign(center[2]) * half_height;
-        Eigen::Vector3d normal = point - center;
-        penetration = sphere_rad - normal.norm();
-        normal = (T0.linear() * normal).normalized();
-        point = T0 * point;
-
-        if (penetration > 0.0)
+        S0.translation() = p0 + s * (q0 - p0);
+        const double t = math::clip(
+            axis1.dot(S0.translation() - p1) / (2.0 * half_height1), 0.0, 1.0);
+        S1.translation() = p1 + t * (q1 - p1);
+        numContacts += collideSphereSphere(o1, o2, rad0, S0, rad1, S1, result);
+      }
+
+      return numContacts;
+    }
+  }
+
+  double s;
+  double t;
+  computeClosestPointsOnSegments(p0, q0, p1, q1, s, t);
+  S0.translation() = p0 + s * (q0 - p0);
+  S1.translation() = p1 + t * (q1 - p1);
+
+  return collideSphereSphere(o1, o2, rad0, S0, rad1, S1, result);
+}
+
+//==============================================================================
+int collideCapsuleBox(CollisionObject* o1, CollisionObject* o2,
+                      const double& capsule_rad, const double& half_height,
+                      const Eigen::Isometry3d& T0,
+                      const Eigen::Vector3d& size1, const Eigen::Isometry3d& T1,
+                      CollisionResult& result)
+{
+  const Eigen::Vector3d axis = T0.linear().col(2);
+  const Eigen::Vector3d p = T0.translation() - half_height * axis;
+  const Eigen::Vector3d q = T0.translation() + half_height * axis;
+
+  dVector3 p1, p2, c, side, lret, bret;
+  dMatrix3 R;
+  convVector(p, p1);
+  convVector(q, p2);
+  convVector(T1.translation(), c);
+  convMatrix(T1, R);
+  convVector(0.5 * size1, side);
+  dClosestLineBoxPoints(p1, p2, c, R, side, lret, bret);
+
+  const Eigen::Vector3d linePoint(lret[0], lret[1], lret[2]);
+  const Eigen::Vector3d boxPoint(bret[0], bret[1], bret[2]);
+  const double dist = (linePoint - boxPoint).norm();
+  if (dist >= capsule_rad)
+    return 0;
+
+  // The segment of the capsule goes through the box, so treat the capsule as
+  // its bounding box
+  if (dist < DART_COLLISION_EPS)
+  {
+    const Eigen::Vector3d size(
+          2.0 * capsule_rad, 2.0 * capsule_rad,
+          2.0 * (half_height + capsule_rad));
+
+    return collideBoxBox(o1, o2, size, T0, size1, T1, result);
+  }
+
+  addContact(o1, o2, boxPoint, (linePoint - boxPoint) / dist,
+             capsule_rad - dist, result);
+  int numContacts = 1;
+
+  // The end caps also touch the box when the capsule lies on it
+  const Eigen::Vector3d halfSize = 0.5 * size1;
+  const Eigen::Isometry3d T1inv = T1.inverse();
+  for (const auto& end : {p, q})
+  {
+    if ((end - linePoint).norm() < DART_COLLISION_EPS)
+      continue;
+
+    const Eigen::Vector3d local = T1inv * end;
+    const Eigen::Vector3d nearest = T1 * local.cwiseMax(-halfSize).cwiseMin(
+        halfSize);
+    const double endDist = (end - nearest).norm();
+    if (endDist < DART_COLLISION_EPS || endDist >= capsule_rad)
+      continue;
+
+    addContact(o1, o2, nearest, (end - nearest) / endDist,
+               capsule_rad - endDist, result);
+    ++numContacts;
+  }
+
+  return numContacts;
+}
+
+//==============================================================================
+// Collide the spheres of the given radius centered at the points with a plane.
+// The contact points are the deepest points of the spheres.
+static int collideSpheresPlane(CollisionObject* o1, CollisionObject* o2,
+                               double radius,
+                               std::initializer_list<Eigen::Vector3d> centers,
+                               const Eigen::Vector3d& normal, double offset,
+                               CollisionResult& result)
+{
+  int numContacts = 0;
+  for (const auto& center : centers)
+  {
+    const double penetration = offset - normal.dot(center) + radius;
+    if (penetration > 0.0)
+    {
+      addContact(o1, o2, center - radius * normal, normal, penetration,
+                 result);
+      ++numContacts;
+    }
+  }
+
+  return numContacts;
+}
+
+//==============================================================================
+int collideSpherePlane(CollisionObject* o1, CollisionObject* o2,
+                       const double& sphere_rad, const Eigen::Isometry3d& T0,
+                       const Eigen::Vector3d& plane_normal,
+                       const Eigen::Isometry3d& T1,
+                       CollisionResult& result)
+{
+  const Eigen::Vector3d normal = T1.linear() * plane_normal;
+
+  return collideSpheresPlane(o1, o2, sphere_rad, {T0.translation()}, normal,
+                             normal.dot(T1.translation()), result);
+}
+
+//==============================================================================
+int collideCapsulePlane(CollisionObject* o1, CollisionObject* o2,
+                        const double& capsule_rad, const double& half_height,
+                        const Eigen::Isometry3d& T0,
+                        const Eigen::Vector3d& plane_normal,
+                        const Eigen::Isometry3d& T1,
+                        CollisionResult& result)
+{
+  const Eigen::Vector3d normal = T1.linear() * plane_normal;
+  const Eigen::Vector3d axis = T0.linear().col(2);
+
+  return collideSpheresPlane(o1, o2, capsule_rad,
+                             {T0.translation() - half_height * axis,
+                              T0.translation() + half_height * axis},
+                             normal, normal.dot(T1.translation()), result);
+}
+
+//==============================================================================
+int collideBoxPlane(CollisionObject* o1, CollisionObject* o2,
+                    const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
+                    const Eigen::Vector3d& plane_normal,
+                    const Eigen::Isometry3d& T1,
+                    CollisionResult& result)
+{
+  const Eigen::Vector3d normal = T1.linear() * plane_normal;
+  const double offset = normal.dot(T1.translation());
+  const Eigen::Vector3d halfSize = 0.5 * size0;
+
+  int numContacts = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    const Eigen::Vector3d corner = T0 * Eigen::Vector3d(
+          (i & 1) ? halfSize[0] : -halfSize[0],
+          (i & 2) ? halfSize[1] : -halfSize[1],
+          (i & 4) ? halfSize[2] : -halfSize[2]);
+
+    const double penetration = offset - normal.dot(corner);
+    if (penetration > 0.0)
+    {
+      addContact(o1, o2, corner, normal, penetration, result);
+      ++numContacts;
+    }
+  }
+
+  return numContacts;
+}
+
+//==============================================================================
+// Return the point of the triangle abc that is the closest to p
+static Eigen::Vector3d computeClosestPointOnTriangle(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& a,
+    const Eigen::Vector3d& b, const Eigen::Vector3d& c)
+{
+  const Eigen::Vector3d ab = b - a;
+  const Eigen::Vector3d ac = c - a;
+  const Eigen::Vector3d ap = p - a;
+  const double d1 = ab.dot(ap);
+  const double d2 = ac.dot(ap);
+  if (d1 <= 0.0 && d2 <= 0.0)
+    return a;
+
+  const Eigen::Vector3d bp = p - b;
+  const double d3 = ab.dot(bp);
+  const double d4 = ac.dot(bp);
+  if (d3 >= 0.0 && d4 <= d3)
+    return b;
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    return a + d1 / (d1 - d3) * ab;
+
+  const Eigen::Vector3d cp = p - c;
+  const double d5 = ab.dot(cp);
+  const double d6 = ac.dot(cp);
+  if (d6 >= 0.0 && d5 <= d6)
+    return c;
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    return a + d2 / (d2 - d6) * ac;
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+
+  const double denom = 1.0 / (va + vb + vc);
+  return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+//==============================================================================
+// Collide a sphere with the triangles of the cells of the height field below
+// it. Everything is in the frame of the height field.
+static int collideSphereHeightmapCells(
+    CollisionObject* o1, CollisionObject* o2,
+    double radius, const Eigen::Vector3d& center,
+    const dynamics::HeightmapShape* heightmap, const Eigen::Isometry3d& T1,
+    CollisionResult& result)
+{
+  std::size_t minRow, maxRow, minColumn, maxColumn;
+  if (center[2] - radius > heightmap->getBoundingBox().getMax()[2]
+      || !heightmap->computeCellRange(
+        center.head<2>().array() - radius, center.head<2>().array() + radius,
+        minRow, maxRow, minColumn, maxColumn))
+  {
+    return 0;
+  }
+
+  // The sphere touches the face of a triangle when the center projects inside
+  // it, and an edge or a vertex otherwise. Contacts with an edge or a vertex
+  // of a touched face are dropped, since that face already pushes the sphere
+  // out. Otherwise a sphere resting on flat terrain would also be pushed
+  // sideways by the edges of the neighboring triangles.
+  struct TriangleContact
+  {
+    Eigen::Vector3d point;
+    Eigen::Vector3d normal;
+    double penetration;
+    Eigen::Vector3d triangle[3];
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+  std::vector<TriangleContact, Eigen::aligned_allocator<TriangleContact>>
+      faceContacts;
+  std::vector<TriangleContact, Eigen::aligned_allocator<TriangleContact>>
+      featureContacts;
+
+  const double eps2 = DART_COLLISION_EPS * DART_COLLISION_EPS;
+
+  for (std::size_t i = minRow; i <= maxRow; ++i)
+  {
+    for (std::size_t j = minColumn; j <= maxColumn; ++j)
+    {
+      const Eigen::Vector3d v00 = heightmap->getVertex(i, j);
+      const Eigen::Vector3d v01 = heightmap->getVertex(i, j + 1);
+      const Eigen::Vector3d v10 = heightmap->getVertex(i + 1, j);
+      const Eigen::Vector3d v11 = heightmap->getVertex(i + 1, j + 1);
+
+      // The two triangles of the cell, counterclockwise seen from above
+      const Eigen::Vector3d triangles[2][3]
+          = {{v00, v01, v11}, {v00, v11, v10}};
+
+      for (const auto& triangle : triangles)
+      {
+        const Eigen::Vector3d& a = triangle[0];
+        const Eigen::Vector3d& b = triangle[1];
+        const Eigen::Vector3d& c = triangle[2];
+
+        const Eigen::Vector3d point
+            = computeClosestPointOnTriangle(center, a, b, c);
+        const Eigen::Vector3d up = (b - a).cross(c - a).normalized();
+        const double height = up.dot(center - a);
+        const bool onFace
+            = (point - (center - height * up)).squaredNorm() <= eps2;
+
+        TriangleContact contact;
+        if (height <= 0.0)
         {
-          Contact contact;
-          contact.collisionObject1 = o1;
-          contact.collisionObject2 = o2;
-          contact.point = point;
-          contact.normal = normal;
-          contact.penetrationDepth = penetration;
-          result.addContact(contact);
-          return 1;
+          // Below the surface, which is solid. Only the triangle right above
+          // the center pushes the sphere out.
+          if (!onFace)
+            continue;
+
+          contact.normal = up;
+          contact.penetration = radius - height;
+        }
+        else
+        {
+          contact.normal = center - point;
+          const double dist = contact.normal.norm();
+          if (dist >= radius)
+            continue;
+
+          contact.normal /= dist;
+          contact.penetration = radius - dist;
         }
+
+        contact.point = point;
+        contact.triangle[0] = a;
+        contact.triangle[1] = b;
+        contact.triangle[2] = c;
+
+        if (onFace)
+          faceContacts.push_back(contact);
+        else
+          featureContacts.push_back(contact);
       }
-      else // if( center[2] >= -half_height && center[2] <= half_height )
+    }
+  }
+
+  int numContacts = 0;
+  for (const auto& contact : faceContacts)
+  {
+    addContact(o1, o2, T1 * contact.point, T1.linear() * contact.normal,
+               contact.penetration, result);
+    ++numContacts;
+  }
+
+  for (const auto& contact : featureContacts)
+  {
+    bool internal = false;
+    for (const auto& faceContact : faceContacts)
+    {
+      const Eigen::Vector3d* face = faceContact.triangle;
+      if ((computeClosestPointOnTriangle(
+             contact.point, face[0], face[1], face[2])
+           - contact.point).squaredNorm() <= eps2)
       {
-        Eigen::Vector3d point = (Eigen::Vector3d(center[0], center[1], 0.0)).normalized();
-        Eigen::Vector3d normal = -(T0.linear() * point);
-        point *= (cyl_rad - penetration);
-        point[2] = center[2];
-        point = T0 * point;
-
-        Contact contact;
-        contact.collisionObject1 = o1;
-        contact.collisionObject2 = o2;
-        contact.point = point;
-        contact.normal = normal;
-        contact.penetrationDepth = penetration;
-        result.addContact(contact);
-        return 1;
+        internal = true;
+        break;
+      }
+    }
+
+    if (internal)
+      continue;
+
+    addContact(o1, o2, T1 * contact.point, T1.linear() * contact.normal,
+               contact.penetration, result);
+    ++numContacts;
+  }
+
+  return numContacts;
+}
+
+//==============================================================================
+int collideSphereHeightmap(CollisionObject* o1, CollisionObject* o2,
+                           const double& sphere_rad,
+                           const Eigen::Isometry3d& T0,
+                           const dynamics::HeightmapShape* heightmap,
+                           const Eigen::Isometry3d& T1,
+                           CollisionResult& result)
+{
+  return collideSphereHeightmapCells(o1, o2, sphere_rad,
+                                     T1.inverse() * T0.translation(),
+                                     heightmap, T1, result);
+}
+
+//==============================================================================
+int collideShapeHeightmap(CollisionObject* o1, CollisionObject* o2,
+                          const dynamics::Shape* shape,
+                          const Eigen::Isometry3d& T0,
+                          const dynamics::HeightmapShape* heightmap,
+                          const Eigen::Isometry3d& T1,
+                          CollisionResult& result)
+{
+  // Everything below is in the frame of the height field
+  const Eigen::Isometry3d T = T1.inverse() * T0;
+  const math::BoundingBox& box = shape->getBoundingBox();
+  const Eigen::Vector3d center = T * box.computeCenter();
+  const Eigen::Vector3d halfExtents
+      = T.linear().cwiseAbs() * box.computeHalfExtents();
+  const Eigen::Vector3d min = center - halfExtents;
+  const Eigen::Vector3d max = center + halfExtents;
+
+  std::size_t minRow, maxRow, minColumn, maxColumn;
+  if (min[2] > heightmap->getBoundingBox().getMax()[2]
+      || !heightmap->computeCellRange(min.head<2>(), max.head<2>(),
+                                      minRow, maxRow, minColumn, maxColumn))
+  {
+    return 0;
+  }
+
+  int numContacts = 0;
+
+  // The points of the shape that are below the surface. The capsule is
+  // collided as the spheres of its ends instead.
+  std::vector<Eigen::Vector3d> points;
+  if (dynamics::BoxShape::getStaticType() == shape->getType())
+  {
+    const Eigen::Vector3d halfSize
+        = 0.5 * static_cast<const dynamics::BoxShape*>(shape)->getSize();
+    for (int i = 0; i < 8; ++i)
+    {
+      points.push_back(T * Eigen::Vector3d(
+          (i & 1) ? halfSize[0] : -halfSize[0],
+          (i & 2) ? halfSize[1] : -halfSize[1],
+          (i & 4) ? halfSize[2] : -halfSize[2]));
+    }
+  }
+  else if (dynamics::CylinderShape::getStaticType() == shape->getType())
+  {
+    const auto* cylinder = static_cast<const dynamics::CylinderShape*>(shape);
+    Eigen::Vector3d rimPoints[8];
+    computeCylinderRimPoints(T.translation(), T.linear().col(2),
+                             cylinder->getRadius(),
+                             0.5 * cylinder->getHeight(),
+                             Eigen::Vector3d::UnitZ(), rimPoints);
+    points.assign(rimPoints, rimPoints + 8);
+  }
+  else if (dynamics::CapsuleShape::getStaticType() == shape->getType())
+  {
+    const auto* capsule = static_cast<const dynamics::CapsuleShape*>(shape);
+    const Eigen::Vector3d axis
+        = 0.5 * capsule->getHeight() * T.linear().col(2);
+    for (const double side : {-1.0, 1.0})
+    {
+      numContacts += collideSphereHeightmapCells(
+            o1, o2, capsule->getRadius(), T.translation() + side * axis,
+            heightmap, T1, result);
+    }
+  }
+
+  for (const auto& point : points)
+  {
+    double height;
+    Eigen::Vector3d normal;
+    if (!heightmap->computeHeight(point[0], point[1], height, &normal)
+        || point[2] >= height)
+    {
+      continue;
+    }
+
+    addContact(o1, o2, T1 * point, T1.linear() * normal,
+               (height - point[2]) * normal[2], result);
+    ++numContacts;
+  }
+
+  // The vertices of the height field that are inside the shape, which is
+  // where bumps of the terrain poke into it. A vertex is inside the convex
+  // shape if vertical rays from both sides enter the shape before reaching it.
+  const double length = max[2] - min[2] + 1.0;
+  for (std::size_t i = minRow; i <= maxRow + 1u; ++i)
+  {
+    for (std::size_t j = minColumn; j <= maxColumn + 1u; ++j)
+    {
+      const Eigen::Vector3d vertex = heightmap->getVertex(i, j);
+      if (vertex[2] < min[2] || vertex[2] > max[2]
+          || vertex[0] < min[0] || vertex[0] > max[0]
+          || vertex[1] < min[1] || vertex[1] > max[1])
+      {
+        continue;
+      }
+
+      double fromBelow;
+      double fromAbove;
+      Eigen::Vector3d normal;
+      const Eigen::Vector3d up = length * Eigen::Vector3d::UnitZ();
+      if (!raycastShape(shape, T, vertex - up, vertex, fromBelow, normal)
+          || !raycastShape(shape, T, vertex + up, vertex, fromAbove, normal))
+      {
+        continue;
+      }
+
+      addContact(o1, o2, T1 * vertex, T1.linear().col(2),
+                 (1.0 - fromBelow) * length, result);
+      ++numContacts;
+    }
+  }
+
+  return numContacts;
+}
+
+//==============================================================================
+// Collide a shape with a single voxel, which is a cube at T
+static int collideShapeVoxel(CollisionObject* o1, CollisionObject* o2,
+                             const dynamics::Shape* shape,
+                             const Eigen::Isometry3d& T0,
+                             const Eigen::Vector3d& size,
+                             const Eigen::Isometry3d& T,
+                             CollisionResult& result)
+{
+  const auto& shapeType = shape->getType();
+
+  if (dynamics::SphereShape::getStaticType() == shapeType)
+  {
+    const auto* sphere = static_cast<const dynamics::SphereShape*>(shape);
+
+    return collideSphereBox(o1, o2, sphere->getRadius(), T0, size, T, result);
+  }
+  else if (dynamics::BoxShape::getStaticType() == shapeType)
+  {
+    const auto* box = static_cast<const dynamics::BoxShape*>(shape);
+
+    return collideBoxBox(o1, o2, box->getSize(), T0, size, T, result);
+  }
+  else if (dynamics::EllipsoidShape::getStaticType() == shapeType)
+  {
+    const auto* ellipsoid = static_cast<const dynamics::EllipsoidShape*>(shape);
+
+    return collideSphereBox(o1, o2, ellipsoid->getRadii()[0], T0, size, T,
+                            result);
+  }
+  else if (dynamics::CylinderShape::getStaticType() == shapeType)
+  {
+    const auto* cylinder = static_cast<const dynamics::CylinderShape*>(shape);
+
+    return collideCylinderBox(o1, o2,
+                              cylinder->getRadius(),
+                              0.5 * cylinder->getHeight(), T0,
+                              size, T, result);
+  }
+  else if (dynamics::CapsuleShape::getStaticType() == shapeType)
+  {
+    const auto* capsule = static_cast<const dynamics::CapsuleShape*>(shape);
+
+    return collideCapsuleBox(o1, o2,
+                             capsule->getRadius(),
+                             0.5 * capsule->getHeight(), T0,
+                             size, T, result);
+  }
+
+  return 0;
+}
+
+//==============================================================================
+int collideShapeVoxelGrid(CollisionObject* o1, CollisionObject* o2,
+                          const dynamics::Shape* shape,
+                          const Eigen::Isometry3d& T0,
+                          const dynamics::VoxelGridShape* voxelGrid,
+                          const Eigen::Isometry3d& T1,
+                          CollisionResult& result)
+{
+  using Key = dynamics::VoxelGridShape::Key;
+
+  const auto& voxels = voxelGrid->getOccupiedVoxels();
+  if (voxels.empty())
+    return 0;
+
+  // The range of the voxels that overlap the bounding box of the shape, in the
+  // frame of the voxel grid
+  const Eigen::Isometry3d T = T1.inverse() * T0;
+  const math::BoundingBox& box = shape->getBoundingBox();
+  const Eigen::Vector3d center = T * box.computeCenter();
+  const Eigen::Vector3d halfExtents
+      = T.linear().cwiseAbs() * box.computeHalfExtents();
+  const Key minKey = voxelGrid->computeKey(center - halfExtents);
+  const Key maxKey = voxelGrid->computeKey(center + halfExtents);
+
+  const double resolution = voxelGrid->getResolution();
+  const Eigen::Vector3d size = Eigen::Vector3d::Constant(resolution);
+  Eigen::Isometry3d voxelTransform = T1;
+
+  int numContacts = 0;
+  CollisionResult voxelResult;
+  std::vector<Contact> internalContacts;
+
+  const auto collideVoxel = [&](const Key& key)
+  {
+    voxelTransform.translation() = T1 * voxelGrid->computeVoxelCenter(key);
+
+    voxelResult.clear();
+    if (!collideShapeVoxel(o1, o2, shape, T0, size, voxelTransform,
+                           voxelResult))
+    {
+      return;
+    }
+
+    for (const auto& contact : voxelResult.getContacts())
+    {
+      // The normal can't push the shape out through a face shared with
+      // another occupied voxel, since the surface is continuous there. Remove
+      // those directions so that the edges between the voxels don't push the
+      // shape sideways.
+      Eigen::Vector3d normal = T1.linear().transpose() * contact.normal;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        if (std::abs(normal[axis]) <= DART_COLLISION_EPS)
+          continue;
+
+        Key neighbor = key;
+        neighbor[axis] += (normal[axis] > 0.0) ? 1 : -1;
+        if (voxelGrid->isOccupied(neighbor))
+          normal[axis] = 0.0;
+      }
+
+      const double norm = normal.norm();
+      if (norm <= DART_COLLISION_EPS)
+      {
+        internalContacts.push_back(contact);
+        continue;
+      }
+
+      Contact surfaceContact = contact;
+      surfaceContact.normal = T1.linear() * (normal / norm);
+      result.addContact(surfaceContact);
+      ++numContacts;
+    }
+  };
+
+  // Look up the voxels in the range unless there are fewer occupied voxels
+  // than that
+  const Eigen::Array3d extents
+      = (maxKey - minKey).cast<double>().array() + 1.0;
+  if (extents.prod() <= static_cast<double>(voxels.size()))
+  {
+    Key key;
+    for (key[0] = minKey[0]; key[0] <= maxKey[0]; ++key[0])
+    {
+      for (key[1] = minKey[1]; key[1] <= maxKey[1]; ++key[1])
+      {
+        for (key[2] = minKey[2]; key[2] <= maxKey[2]; ++key[2])
+        {
+          if (voxelGrid->isOccupied(key))
+            collideVoxel(key);
+        }
+      }
+    }
+  }
+  else
+  {
+    for (const auto& key : voxels)
+    {
+      if ((key.array() >= minKey.array()).all()
+          && (key.array() <= maxKey.array()).all())
+      {
+        collideVoxel(key);
       }
     }
   }
-  return 0;
-}
-
-int collideCylinderPlane(CollisionObject* o1, CollisionObject* o2, const double& cyl_rad, const double& half_height, const Eigen::Isometry3d& T0,
-                         const Eigen::Vector3d& plane_normal, const Eigen::Isometry3d& T1,
-                         CollisionResult& result)
-{
-  Eigen::Vector3d normal = T1.linear() * plane_normal;
-  Eigen::Vector3d Rx = T0.linear().rightCols(1);
-  Eigen::Vector3d Ry = normal - normal.dot(Rx) * Rx;
-  double mag = Ry.norm();
-  Ry.normalize();
-  if (mag < DART_COLLISION_EPS)
-  {
-    if (std::abs(Rx[2]) > 1.0 - DART_COLLISION_EPS)
-      Ry = Eigen::Vector3d::UnitX();
-    else
-      Ry = (Eigen::Vector3d(Rx[1], -Rx[0], 0.0)).normalized();
-  }
-
-  Eigen::Vector3d Rz = Rx.cross(Ry);
-  Eigen::Isometry3d T;
-  T.linear().col(0) = Rx;
-  T.linear().col(1) = Ry;
-  T.linear().col(2) = Rz;
-  T.translation() = T0.translation();
 
-  Eigen::Vector3d nn = T.linear().transpose() * normal;
-  Eigen::Vector3d pn = T.inverse() * T1.translation();
-
-  // four corners c0 = ( -h/2, -r ), c1 = ( +h/2, -r ), c2 = ( +h/2, +r ), c3 = ( -h/2, +r )
-  Eigen::Vector3d c[4] = {
-    Eigen::Vector3d(-half_height, -cyl_rad, 0.0),
-    Eigen::Vector3d(+half_height, -cyl_rad, 0.0),
-    Eigen::Vector3d(+half_height, +cyl_rad, 0.0),
-    Eigen::Vector3d(-half_height, +cyl_rad, 0.0) };
-
-  double depth[4] = { (pn - c[0]).dot(nn), (pn - c[1]).dot(nn), (pn - c[2]).dot(nn), (pn - c[3]).dot(nn) };
-
-  double penetration = -1.0;
-  int found = -1;
-  for (int i = 0; i < 4; i++)
+  // The shape is buried in the voxels. Keep the internal contacts so that it
+  // still collides.
+  if (0 == numContacts)
   {
-    if (depth[i] > penetration)
+    for (const auto& contact : internalContacts)
     {
-      penetration = depth[i];
-      found = i;
+      result.addContact(contact);
+      ++numContacts;
     }
   }
 
-  Eigen::Vector3d point;
+  return numContacts;
+}
 
-  if (std::abs(depth[found] - depth[(found+1)%4]) < DART_COLLISION_EPS)
-    point = T * (0.5 * (c[found] + c[(found+1)%4]));
-  else if (std::abs(depth[found] - depth[(found+3)%4]) < DART_COLLISION_EPS)
-    point = T * (0.5 * (c[found] + c[(found+3)%4]));
-  else
-    point = T * c[found];
+//==============================================================================
+// The routines for the cylinder and the capsule take them as the first shape
+// in this order of precedence, and the routines for the plane, the height
+// field, and the voxel grid take them as the second shape
+static int getShapeRank(const std::string& shapeType)
+{
+  if (dynamics::CylinderShape::getStaticType() == shapeType)
+    return 3;
 
-  if (penetration > 0.0)
+  if (dynamics::CapsuleShape::getStaticType() == shapeType)
+    return 2;
+
+  if (dynamics::PlaneShape::getStaticType() == shapeType
+      || dynamics::HeightmapShape::getStaticType() == shapeType
+      || dynamics::VoxelGridShape::getStaticType() == shapeType)
   {
-    Contact contact;
-    contact.collisionObject1 = o1;
-    contact.collisionObject2 = o2;
-    contact.point = point;
-    contact.normal = normal;
-    contact.penetrationDepth = penetration;
-    result.addContact(contact);
-    return 1;
+    return 0;
   }
 
-  return 0;
+  return 1;
+}
+
+//==============================================================================
+// Return the transform of the plane moved so that its origin is on the plane
+static Eigen::Isometry3d getPlaneTransform(
+    const dynamics::PlaneShape* plane, const Eigen::Isometry3d& T)
+{
+  Eigen::Isometry3d planeT = T;
+  planeT.translation() = T * (plane->getOffset() * plane->getNormal());
+
+  return planeT;
 }
 
 //==============================================================================
@@ -1260,9 +2275,30 @@ int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
   const auto& shapeType1 = shape1->getType();
   const auto& shapeType2 = shape2->getType();
 
+  if (getShapeRank(shapeType1) < getShapeRank(shapeType2))
+  {
+    const std::size_t firstContact = result.getNumContacts();
+    const int numContacts = collide(o2, o1, result);
+    swapContacts(result, firstContact);
+
+    return numContacts;
+  }
+
   const Eigen::Isometry3d& T1 = o1->getTransform();
   const Eigen::Isometry3d& T2 = o2->getTransform();
 
+  // Any shape is collided with a voxel grid voxel by voxel
+  if (dynamics::VoxelGridShape::getStaticType() == shapeType2)
+  {
+    const auto* voxelGrid1
+        = static_cast<const dynamics::VoxelGridShape*>(shape2.get());
+
+    return collideShapeVoxelGrid(o1, o2,
+                                 shape1.get(), T1,
+                                 voxelGrid1, T2,
+                                 result);
+  }
+
   if (dynamics::SphereShape::getStaticType() == shapeType1)
   {
     const auto* sphere0
@@ -1294,6 +2330,27 @@ int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
                                  ellipsoid1->getRadii()[0], T2,
                                  result);
     }
+    else if (dynamics::PlaneShape::getStaticType() == shapeType2)
+    {
+      const auto* plane1
+          = static_cast<const dynamics::PlaneShape*>(shape2.get());
+
+      return collideSpherePlane(o1, o2,
+                                sphere0->getRadius(), T1,
+                                plane1->getNormal(),
+                                getPlaneTransform(plane1, T2),
+                                result);
+    }
+    else if (dynamics::HeightmapShape::getStaticType() == shapeType2)
+    {
+      const auto* heightmap1
+          = static_cast<const dynamics::HeightmapShape*>(shape2.get());
+
+      return collideSphereHeightmap(o1, o2,
+                                    sphere0->getRadius(), T1,
+                                    heightmap1, T2,
+                                    result);
+    }
   }
   else if (dynamics::BoxShape::getStaticType() == shapeType1)
   {
@@ -1327,6 +2384,27 @@ int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
                               ellipsoid1->getRadii()[0], T2,
                               result);
     }
+    else if (dynamics::PlaneShape::getStaticType() == shapeType2)
+    {
+      const auto* plane1
+          = static_cast<const dynamics::PlaneShape*>(shape2.get());
+
+      return collideBoxPlane(o1, o2,
+                             box0->getSize(), T1,
+                             plane1->getNormal(),
+                             getPlaneTransform(plane1, T2),
+                             result);
+    }
+    else if (dynamics::HeightmapShape::getStaticType() == shapeType2)
+    {
+      const auto* heightmap1
+          = static_cast<const dynamics::HeightmapShape*>(shape2.get());
+
+      return collideShapeHeightmap(o1, o2,
+                                   shape1.get(), T1,
+                                   heightmap1, T2,
+                                   result);
+    }
   }
   else if (dynamics::EllipsoidShape::getStaticType() == shapeType1)
   {
@@ -1363,6 +2441,156 @@ int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
                                  ellipsoid1->getRadii()[0], T2,
                                  result);
     }
+    else if (dynamics::PlaneShape::getStaticType() == shapeType2)
+    {
+      const auto* plane1
+          = static_cast<const dynamics::PlaneShape*>(shape2.get());
+
+      return collideSpherePlane(o1, o2,
+                                ellipsoid0->getRadii()[0], T1,
+                                plane1->getNormal(),
+                                getPlaneTransform(plane1, T2),
+                                result);
+    }
+    else if (dynamics::HeightmapShape::getStaticType() == shapeType2)
+    {
+      const auto* heightmap1
+          = static_cast<const dynamics::HeightmapShape*>(shape2.get());
+
+      return collideSphereHeightmap(o1, o2,
+                                    ellipsoid0->getRadii()[0], T1,
+                                    heightmap1, T2,
+                                    result);
+    }
+  }
+  else if (dynamics::CapsuleShape::getStaticType() == shapeType1)
+  {
+    const auto* capsule0
+        = static_cast<const dynamics::CapsuleShape*>(shape1.get());
+    const double radius0 = capsule0->getRadius();
+    const double halfHeight0 = 0.5 * capsule0->getHeight();
+
+    if (dynamics::SphereShape::getStaticType() == shapeType2)
+    {
+      const auto* sphere1
+          = static_cast<const dynamics::SphereShape*>(shape2.get());
+
+      return collideCapsuleSphere(o1, o2,
+                                  radius0, halfHeight0, T1,
+                                  sphere1->getRadius(), T2,
+                                  result);
+    }
+    else if (dynamics::EllipsoidShape::getStaticType() == shapeType2)
+    {
+      const auto* ellipsoid1
+          = static_cast<const dynamics::EllipsoidShape*>(shape2.get());
+
+      return collideCapsuleSphere(o1, o2,
+                                  radius0, halfHeight0, T1,
+                                  ellipsoid1->getRadii()[0], T2,
+                                  result);
+    }
+    else if (dynamics::BoxShape::getStaticType() == shapeType2)
+    {
+      const auto* box1
+          = static_cast<const dynamics::BoxShape*>(shape2.get());
+
+      return collideCapsuleBox(o1, o2,
+                               radius0, halfHeight0, T1,
+                               box1->getSize(), T2,
+                               result);
+    }
+    else if (dynamics::CapsuleShape::getStaticType() == shapeType2)
+    {
+      const auto* capsule1
+          = static_cast<const dynamics::CapsuleShape*>(shape2.get());
+
+      return collideCapsuleCapsule(o1, o2,
+                                   radius0, halfHeight0, T1,
+                                   capsule1->getRadius(),
+                                   0.5 * capsule1->getHeight(), T2,
+                                   result);
+    }
+    else if (dynamics::PlaneShape::getStaticType() == shapeType2)
+    {
+      const auto* plane1
+          = static_cast<const dynamics::PlaneShape*>(shape2.get());
+
+      return collideCapsulePlane(o1, o2,
+                                 radius0, halfHeight0, T1,
+                                 plane1->getNormal(),
+                                 getPlaneTransform(plane1, T2),
+                                 result);
+    }
+    else if (dynamics::HeightmapShape::getStaticType() == shapeType2)
+    {
+      const auto* heightmap1
+          = static_cast<const dynamics::HeightmapShape*>(shape2.get());
+
+      return collideShapeHeightmap(o1, o2,
+                                   shape1.get(), T1,
+                                   heightmap1, T2,
+                                   result);
+    }
+  }
+  else if (dynamics::CylinderShape::getStaticType() == shapeType1)
+  {
+    const auto* cylinder0
+        = static_cast<const dynamics::CylinderShape*>(shape1.get());
+    const double radius0 = cylinder0->getRadius();
+    const double halfHeight0 = 0.5 * cylinder0->getHeight();
+
+    if (dynamics::SphereShape::getStaticType() == shapeType2)
+    {
+      const auto* sphere1
+          = static_cast<const dynamics::SphereShape*>(shape2.get());
+
+      return collideCylinderSphere(o1, o2,
+                                   radius0, halfHeight0, T1,
+                                   sphere1->getRadius(), T2,
+                                   result);
+    }
+    else if (dynamics::EllipsoidShape::getStaticType() == shapeType2)
+    {
+      const auto* ellipsoid1
+          = static_cast<const dynamics::EllipsoidShape*>(shape2.get());
+
+      return collideCylinderSphere(o1, o2,
+                                   radius0, halfHeight0, T1,
+                                   ellipsoid1->getRadii()[0], T2,
+                                   result);
+    }
+    else if (dynamics::BoxShape::getStaticType() == shapeType2)
+    {
+      const auto* box1
+          = static_cast<const dynamics::BoxShape*>(shape2.get());
+
+      return collideCylinderBox(o1, o2,
+                                radius0, halfHeight0, T1,
+                                box1->getSize(), T2,
+                                result);
+    }
+    else if (dynamics::PlaneShape::getStaticType() == shapeType2)
+    {
+      const auto* plane1
+          = static_cast<const dynamics::PlaneShape*>(shape2.get());
+
+      return collideCylinderPlane(o1, o2,
+                                  radius0, halfHeight0, T1,
+                                  plane1->getNormal(),
+                                  getPlaneTransform(plane1, T2),
+                                  result);
+    }
+    else if (dynamics::HeightmapShape::getStaticType() == shapeType2)
+    {
+      const auto* heightmap1
+          = static_cast<const dynamics::HeightmapShape*>(shape2.get());
+
+      return collideShapeHeightmap(o1, o2,
+                                   shape1.get(), T1,
+                                   heightmap1, T2,
+                                   result);
+    }
   }
 
   dterr << "[DARTCollisionDetector] Attempting to check for an "
@@ -1372,5 +2600,422 @@ int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
   return false;
 }
 
+//==============================================================================
+// The ray tests below are done in the frame of the shape, where the ray is
+// p + t * d for t in [0, 1].
+//==============================================================================
+static bool raycastSphere(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d, double radius,
+    double& t, Eigen::Vector3d& normal)
+{
+  // Starting inside or not moving
+  const double c = p.squaredNorm() - radius * radius;
+  const double a = d.squaredNorm();
+  if (c <= 0.0 || a == 0.0)
+    return false;
+
+  // Moving away
+  const double b = p.dot(d);
+  if (b >= 0.0)
+    return false;
+
+  const double discriminant = b * b - a * c;
+  if (discriminant < 0.0)
+    return false;
+
+  t = (-b - std::sqrt(discriminant)) / a;
+  if (t > 1.0)
+    return false;
+
+  normal = (p + t * d).normalized();
+
+  return true;
+}
+
+//==============================================================================
+static bool raycastEllipsoid(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d,
+    const Eigen::Vector3d& radii, double& t, Eigen::Vector3d& normal)
+{
+  // Scale the ellipsoid to the unit sphere
+  const Eigen::Vector3d scaledP = p.cwiseQuotient(radii);
+  const Eigen::Vector3d scaledD = d.cwiseQuotient(radii);
+
+  if (!raycastSphere(scaledP, scaledD, 1.0, t, normal))
+    return false;
+
+  normal = (scaledP + t * scaledD).cwiseQuotient(radii).normalized();
+
+  return true;
+}
+
+//==============================================================================
+static bool raycastBox(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d,
+    const Eigen::Vector3d& halfSize, double& t, Eigen::Vector3d& normal)
+{
+  if ((p.cwiseAbs().array() <= halfSize.array()).all())
+    return false;
+
+  // Intersect the slabs of the three axes
+  double enter = -std::numeric_limits<double>::infinity();
+  double exit = std::numeric_limits<double>::infinity();
+  int enterAxis = -1;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (d[i] == 0.0)
+    {
+      if (std::abs(p[i]) > halfSize[i])
+        return false;
+
+      continue;
+    }
+
+    double t1 = (-halfSize[i] - p[i]) / d[i];
+    double t2 = (halfSize[i] - p[i]) / d[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+
+    if (t1 > enter)
+    {
+      enter = t1;
+      enterAxis = i;
+    }
+    exit = std::min(exit, t2);
+  }
+
+  if (enterAxis < 0 || enter > exit || enter < 0.0 || enter > 1.0)
+    return false;
+
+  t = enter;
+  normal.setZero();
+  normal[enterAxis] = d[enterAxis] > 0.0 ? -1.0 : 1.0;
+
+  return true;
+}
+
+//==============================================================================
+/// Compute the interval of t where the ray is inside the infinite cylinder of
+/// the given radius around the z-axis. Return false if there is none.
+static bool intersectInfiniteCylinder(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d, double radius,
+    double& enter, double& exit)
+{
+  const double a = d.head<2>().squaredNorm();
+  const double c = p.head<2>().squaredNorm() - radius * radius;
+
+  if (a == 0.0)
+  {
+    if (c > 0.0)
+      return false;
+
+    enter = -std::numeric_limits<double>::infinity();
+    exit = std::numeric_limits<double>::infinity();
+
+    return true;
+  }
+
+  const double b = p.head<2>().dot(d.head<2>());
+  const double discriminant = b * b - a * c;
+  if (discriminant < 0.0)
+    return false;
+
+  const double sqrtDiscriminant = std::sqrt(discriminant);
+  enter = (-b - sqrtDiscriminant) / a;
+  exit = (-b + sqrtDiscriminant) / a;
+
+  return true;
+}
+
+//==============================================================================
+static bool raycastCylinder(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d,
+    double radius, double halfHeight, double& t, Eigen::Vector3d& normal)
+{
+  if (p.head<2>().squaredNorm() <= radius * radius
+      && std::abs(p[2]) <= halfHeight)
+  {
+    return false;
+  }
+
+  double sideEnter;
+  double sideExit;
+  if (!intersectInfiniteCylinder(p, d, radius, sideEnter, sideExit))
+    return false;
+
+  double capEnter = -std::numeric_limits<double>::infinity();
+  double capExit = std::numeric_limits<double>::infinity();
+  if (d[2] == 0.0)
+  {
+    if (std::abs(p[2]) > halfHeight)
+      return false;
+  }
+  else
+  {
+    capEnter = (-halfHeight - p[2]) / d[2];
+    capExit = (halfHeight - p[2]) / d[2];
+    if (capEnter > capExit)
+      std::swap(capEnter, capExit);
+  }
+
+  const double enter = std::max(sideEnter, capEnter);
+  const double exit = std::min(sideExit, capExit);
+  if (enter > exit || enter < 0.0 || enter > 1.0)
+    return false;
+
+  t = enter;
+  if (sideEnter >= capEnter)
+  {
+    normal << p.head<2>() + t * d.head<2>(), 0.0;
+    normal.normalize();
+  }
+  else
+  {
+    normal = Eigen::Vector3d(0.0, 0.0, d[2] > 0.0 ? -1.0 : 1.0);
+  }
+
+  return true;
+}
+
+//==============================================================================
+static bool raycastCapsule(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d,
+    double radius, double halfHeight, double& t, Eigen::Vector3d& normal)
+{
+  const Eigen::Vector3d closestOnAxis(
+        0.0, 0.0, math::clip(p[2], -halfHeight, halfHeight));
+  if ((p - closestOnAxis).squaredNorm() <= radius * radius)
+    return false;
+
+  // The ray enters either through the side of the cylinder or through one of
+  // the hemispheres, whichever comes first
+  bool hit = false;
+  t = std::numeric_limits<double>::infinity();
+
+  double sideEnter;
+  double sideExit;
+  if (d.head<2>().squaredNorm() > 0.0
+      && intersectInfiniteCylinder(p, d, radius, sideEnter, sideExit)
+      && sideEnter >= 0.0 && sideEnter <= 1.0
+      && std::abs(p[2] + sideEnter * d[2]) <= halfHeight)
+  {
+    hit = true;
+    t = sideEnter;
+    normal << p.head<2>() + t * d.head<2>(), 0.0;
+    normal.normalize();
+  }
+
+  for (const double side : {-1.0, 1.0})
+  {
+    const Eigen::Vector3d center(0.0, 0.0, side * halfHeight);
+
+    double capT;
+    Eigen::Vector3d capNormal;
+    if (raycastSphere(p - center, d, radius, capT, capNormal)
+        && capT < t && side * (p[2] + capT * d[2]) >= halfHeight)
+    {
+      hit = true;
+      t = capT;
+      normal = capNormal;
+    }
+  }
+
+  return hit;
+}
+
+//==============================================================================
+static bool raycastPlane(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d,
+    const Eigen::Vector3d& planeNormal, double offset,
+    double& t, Eigen::Vector3d& normal)
+{
+  // The plane is hit only from the side its normal points to
+  const double startHeight = planeNormal.dot(p) - offset;
+  const double endHeight = planeNormal.dot(p + d) - offset;
+  if (startHeight <= 0.0 || endHeight > 0.0)
+    return false;
+
+  t = startHeight / (startHeight - endHeight);
+  normal = planeNormal.normalized();
+
+  return true;
+}
+
+//==============================================================================
+static bool raycastMultiSphere(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d,
+    const dynamics::MultiSphereShape::Spheres& spheres,
+    double& t, Eigen::Vector3d& normal)
+{
+  bool hit = false;
+  t = std::numeric_limits<double>::infinity();
+
+  for (const auto& sphere : spheres)
+  {
+    const Eigen::Vector3d localP = p - sphere.second;
+
+    // Starting inside any of the spheres is starting inside the shape
+    if (localP.squaredNorm() <= sphere.first * sphere.first)
+      return false;
+
+    double sphereT;
+    Eigen::Vector3d sphereNormal;
+    if (raycastSphere(localP, d, sphere.first, sphereT, sphereNormal)
+        && sphereT < t)
+    {
+      hit = true;
+      t = sphereT;
+      normal = sphereNormal;
+    }
+  }
+
+  return hit;
+}
+
+//==============================================================================
+static bool raycastMesh(
+    const Eigen::Vector3d& p, const Eigen::Vector3d& d, const aiMesh* mesh,
+    const Eigen::Vector3d& scale, double& t, Eigen::Vector3d& normal)
+{
+  bool hit = false;
+
+  for (auto i = 0u; i < mesh->mNumFaces; ++i)
+  {
+    const aiFace& face = mesh->mFaces[i];
+    if (face.mNumIndices != 3u)
+      continue;
+
+    Eigen::Vector3d vertices[3];
+    for (auto j = 0u; j < 3u; ++j)
+    {
+      const aiVector3D& vertex = mesh->mVertices[face.mIndices[j]];
+      vertices[j] = Eigen::Vector3d(vertex.x, vertex.y, vertex.z)
+          .cwiseProduct(scale);
+    }
+
+    // Moller-Trumbore intersection, which accepts both sides of the triangle
+    const Eigen::Vector3d edge1 = vertices[1] - vertices[0];
+    const Eigen::Vector3d edge2 = vertices[2] - vertices[0];
+    const Eigen::Vector3d pVec = d.cross(edge2);
+    const double det = edge1.dot(pVec);
+    if (det == 0.0)
+      continue;
+
+    const double invDet = 1.0 / det;
+    const Eigen::Vector3d tVec = p - vertices[0];
+    const double u = tVec.dot(pVec) * invDet;
+    if (u < 0.0 || u > 1.0)
+      continue;
+
+    const Eigen::Vector3d qVec = tVec.cross(edge1);
+    const double v = d.dot(qVec) * invDet;
+    if (v < 0.0 || u + v > 1.0)
+      continue;
+
+    const double triangleT = edge2.dot(qVec) * invDet;
+    if (triangleT < 0.0 || triangleT > 1.0 || (hit && triangleT >= t))
+      continue;
+
+    hit = true;
+    t = triangleT;
+    normal = edge1.cross(edge2).normalized();
+    if (normal.dot(d) > 0.0)
+      normal = -normal;
+  }
+
+  return hit;
+}
+
+//==============================================================================
+bool raycastShape(const dynamics::Shape* shape, const Eigen::Isometry3d& T,
+                  const Eigen::Vector3d& from, const Eigen::Vector3d& to,
+                  double& fraction, Eigen::Vector3d& normal)
+{
+  const Eigen::Vector3d p = T.inverse() * from;
+  const Eigen::Vector3d d = T.linear().transpose() * (to - from);
+
+  const auto& shapeType = shape->getType();
+  bool hit = false;
+
+  if (dynamics::SphereShape::getStaticType() == shapeType)
+  {
+    const auto* sphere = static_cast<const dynamics::SphereShape*>(shape);
+    hit = raycastSphere(p, d, sphere->getRadius(), fraction, normal);
+  }
+  else if (dynamics::BoxShape::getStaticType() == shapeType)
+  {
+    const auto* box = static_cast<const dynamics::BoxShape*>(shape);
+    hit = raycastBox(p, d, 0.5 * box->getSize(), fraction, normal);
+  }
+  else if (dynamics::EllipsoidShape::getStaticType() == shapeType)
+  {
+    const auto* ellipsoid
+        = static_cast<const dynamics::EllipsoidShape*>(shape);
+    hit = raycastEllipsoid(p, d, ellipsoid->getRadii(), fraction, normal);
+  }
+  else if (dynamics::CylinderShape::getStaticType() == shapeType)
+  {
+    const auto* cylinder = static_cast<const dynamics::CylinderShape*>(shape);
+    hit = raycastCylinder(p, d, cylinder->getRadius(),
+                          0.5 * cylinder->getHeight(), fraction, normal);
+  }
+  else if (dynamics::CapsuleShape::getStaticType() == shapeType)
+  {
+    const auto* capsule = static_cast<const dynamics::CapsuleShape*>(shape);
+    hit = raycastCapsule(p, d, capsule->getRadius(),
+                         0.5 * capsule->getHeight(), fraction, normal);
+  }
+  else if (dynamics::PlaneShape::getStaticType() == shapeType)
+  {
+    const auto* plane = static_cast<const dynamics::PlaneShape*>(shape);
+    hit = raycastPlane(p, d, plane->getNormal(), plane->getOffset(),
+                       fraction, normal);
+  }
+  else if (dynamics::MultiSphereShape::getStaticType() == shapeType)
+  {
+    const auto* multiSphere
+        = static_cast<const dynamics::MultiSphereShape*>(shape);
+    hit = raycastMultiSphere(p, d, multiSphere->getSpheres(),
+                             fraction, normal);
+  }
+  else if (dynamics::MeshShape::getStaticType() == shapeType)
+  {
+    const auto* meshShape = static_cast<const dynamics::MeshShape*>(shape);
+    const aiScene* scene = meshShape->getMesh();
+    if (scene)
+    {
+      for (auto i = 0u; i < scene->mNumMeshes; ++i)
+      {
+        double meshFraction;
+        Eigen::Vector3d meshNormal;
+        if (raycastMesh(p, d, scene->mMeshes[i], meshShape->getScale(),
+                        meshFraction, meshNormal)
+            && (!hit || meshFraction < fraction))
+        {
+          hit = true;
+          fraction = meshFraction;
+          normal = meshNormal;
+        }
+      }
+    }
+  }
+  else if (dynamics::SoftMeshShape::getStaticType() == shapeType)
+  {
+    const auto* softMeshShape
+        = static_cast<const dynamics::SoftMeshShape*>(shape);
+    const aiMesh* mesh = softMeshShape->getAssimpMesh();
+    if (mesh)
+    {
+      hit = raycastMesh(p, d, mesh, Eigen::Vector3d::Ones(),
+                        fraction, normal);
+    }
+  }
+
+  if (hit)
+    normal = T.linear() * normal;
+
+  return hit;
+}
+
 } // namespace collision
 } // namespace dart
@@ -37,6 +37,12 @@
 #include "dart/collision/CollisionDetector.hpp"
 
 namespace dart {
+
+namespace dynamics {
+class HeightmapShape;
+class VoxelGridShape;
+}  // namespace dynamics
+
 namespace collision {
 
 int collide(CollisionObject* o1, CollisionObject* o2,
@@ -69,6 +75,37 @@ int collideCylinderSphere(
     const double& sphere_rad, const Eigen::Isometry3d& T1,
     CollisionResult& result);
 
+int collideCylinderBox(
+    CollisionObject* o1, CollisionObject* o2,
+    const double& cyl_rad, const double& half_height,
+    const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& size1, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+int collideCapsuleSphere(
+    CollisionObject* o1, CollisionObject* o2,
+    const double& capsule_rad, const double& half_height,
+    const Eigen::Isometry3d& T0,
+    const double& sphere_rad, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+int collideCapsuleCapsule(
+    CollisionObject* o1, CollisionObject* o2,
+    const double& rad0, const double& half_height0,
+    const Eigen::Isometry3d& T0,
+    const double& rad1, const double& half_height1,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+int collideCapsuleBox(
+    CollisionObject* o1, CollisionObject* o2,
+    const double& capsule_rad, const double& half_height,
+    const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& size1, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+// The plane of the functions below passes through the origin of T1
+
 int collideCylinderPlane(
     CollisionObject* o1, CollisionObject* o2,
     const double& cyl_rad, const double& half_height,
@@ -76,6 +113,59 @@ int collideCylinderPlane(
     const Eigen::Vector3d& plane_normal, const Eigen::Isometry3d& T1,
     CollisionResult& result);
 
+int collideCapsulePlane(
+    CollisionObject* o1, CollisionObject* o2,
+    const double& capsule_rad, const double& half_height,
+    const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& plane_normal, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+int collideSpherePlane(
+    CollisionObject* o1, CollisionObject* o2,
+    const double& sphere_rad, const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& plane_normal, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+int collideBoxPlane(
+    CollisionObject* o1, CollisionObject* o2,
+    const Eigen::Vector3d& size0, const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& plane_normal, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+// The height field of the functions below is in the frame T1
+
+int collideSphereHeightmap(
+    CollisionObject* o1, CollisionObject* o2,
+    const double& sphere_rad, const Eigen::Isometry3d& T0,
+    const dynamics::HeightmapShape* heightmap, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+/// Collide a BoxShape, a CylinderShape, or a CapsuleShape with a height field
+int collideShapeHeightmap(
+    CollisionObject* o1, CollisionObject* o2,
+    const dynamics::Shape* shape, const Eigen::Isometry3d& T0,
+    const dynamics::HeightmapShape* heightmap, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+// The voxel grid of the function below is in the frame T1
+
+/// Collide a SphereShape, an EllipsoidShape (as a sphere), a BoxShape, a
+/// CylinderShape, or a CapsuleShape with the occupied voxels of a voxel grid
+int collideShapeVoxelGrid(
+    CollisionObject* o1, CollisionObject* o2,
+    const dynamics::Shape* shape, const Eigen::Isometry3d& T0,
+    const dynamics::VoxelGridShape* voxelGrid, const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+/// Cast the ray from 'from' to 'to' against the shape whose frame is at T.
+/// Return true if the ray enters the shape, along with the fraction of the ray
+/// at the hit point and the surface normal there, which points against the ray.
+/// A ray that starts inside a solid shape doesn't hit it. Meshes are hit from
+/// both sides. Cones and line segments are never hit.
+bool raycastShape(const dynamics::Shape* shape, const Eigen::Isometry3d& T,
+                  const Eigen::Vector3d& from, const Eigen::Vector3d& to,
+                  double& fraction, Eigen::Vector3d& normal);
+
 }  // namespace collision
 }  // namespace dart
 
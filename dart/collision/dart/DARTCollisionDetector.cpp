@@ -31,6 +31,9 @@
 
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/dart/DARTCollide.hpp"
@@ -40,6 +43,11 @@
 #include "dart/dynamics/SphereShape.hpp"
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/CapsuleShape.hpp"
+#include "dart/dynamics/CylinderShape.hpp"
+#include "dart/dynamics/PlaneShape.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
+#include "dart/dynamics/VoxelGridShape.hpp"
 
 namespace dart {
 namespace collision {
@@ -128,33 +136,35 @@ bool DARTCollisionDetector::collide(
   if (objects.empty())
     return false;
 
+  // Broad phase: only the pairs whose bounding boxes overlap are passed on to
+  // the narrow phase
+  casted->updateEngineData();
+  const auto& pairs = casted->computeOverlappingPairs();
+
   auto collisionFound = false;
   const auto& filter = option.collisionFilter;
 
-  for (auto i = 0u; i < objects.size() - 1; ++i)
+  for (const auto& pair : pairs)
   {
-    auto* collObj1 = objects[i];
+    auto* collObj1 = objects[pair.first];
+    auto* collObj2 = objects[pair.second];
 
-    for (auto j = i + 1u; j < objects.size(); ++j)
-    {
-      auto* collObj2 = objects[j];
-
-      if (filter && !filter->needCollision(collObj1, collObj2))
-        continue;
+    if (filter && !filter->needCollision(collObj1, collObj2))
+      continue;
 
-      collisionFound = checkPair(collObj1, collObj2, option, result);
+    if (checkPair(collObj1, collObj2, option, result))
+      collisionFound = true;
 
-      if (result)
-      {
-        if (result->getNumContacts() >= option.maxNumContacts)
-          return true;
-      }
-      else
-      {
-        // If no result is passed, stop checking when the first contact is found
-        if (collisionFound)
-          return true;
-      }
+    if (result)
+    {
+      if (result->getNumContacts() >= option.maxNumContacts)
+        return true;
+    }
+    else
+    {
+      // If no result is passed, stop checking when the first contact is found
+      if (collisionFound)
+        return true;
     }
   }
 
@@ -190,33 +200,36 @@ bool DARTCollisionDetector::collide(
   if (objects1.empty() || objects2.empty())
     return false;
 
+  // Broad phase: only the pairs whose bounding boxes overlap are passed on to
+  // the narrow phase
+  casted1->updateEngineData();
+  casted2->updateEngineData();
+  const auto& pairs = casted1->computeOverlappingPairs(casted2);
+
   auto collisionFound = false;
   const auto& filter = option.collisionFilter;
 
-  for (auto i = 0u; i < objects1.size(); ++i)
+  for (const auto& pair : pairs)
   {
-    auto* collObj1 = objects1[i];
+    auto* collObj1 = objects1[pair.first];
+    auto* collObj2 = objects2[pair.second];
 
-    for (auto j = 0u; j < objects2.size(); ++j)
-    {
-      auto* collObj2 = objects2[j];
-
-      if (filter && !filter->needCollision(collObj1, collObj2))
-        continue;
+    if (filter && !filter->needCollision(collObj1, collObj2))
+      continue;
 
-      collisionFound = checkPair(collObj1, collObj2, option, result);
+    if (checkPair(collObj1, collObj2, option, result))
+      collisionFound = true;
 
-      if (result)
-      {
-        if (result->getNumContacts() >= option.maxNumContacts)
-          return true;
-      }
-      else
-      {
-        // If no result is passed, stop checking when the first contact is found
-        if (collisionFound)
-          return true;
-      }
+    if (result)
+    {
+      if (result->getNumContacts() >= option.maxNumContacts)
+        return true;
+    }
+    else
+    {
+      // If no result is passed, stop checking when the first contact is found
+      if (collisionFound)
+        return true;
     }
   }
 
@@ -249,6 +262,88 @@ double DARTCollisionDetector::distance(
   return 0.0;
 }
 
+//==============================================================================
+/// Return true if the segment from 'from' to 'to' crosses the box, along with
+/// the fraction of the segment where it enters the box
+static bool intersectSegmentBox(
+    const Eigen::Vector3d& from, const Eigen::Vector3d& to,
+    const Eigen::Vector3d& min, const Eigen::Vector3d& max, double& enter)
+{
+  const Eigen::Vector3d d = to - from;
+
+  enter = 0.0;
+  double exit = 1.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (d[i] == 0.0)
+    {
+      if (from[i] < min[i] || from[i] > max[i])
+        return false;
+
+      continue;
+    }
+
+    double t1 = (min[i] - from[i]) / d[i];
+    double t2 = (max[i] - from[i]) / d[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+
+    enter = std::max(enter, t1);
+    exit = std::min(exit, t2);
+    if (enter > exit)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+void DARTCollisionDetector::castRay(
+    const CollisionGroup* group,
+    const Ray& ray,
+    const RaycastOption& option,
+    RaycastResult* result)
+{
+  const auto casted = static_cast<const DARTCollisionGroup*>(group);
+  const auto& mins = casted->mBoundingBoxMins;
+  const auto& maxs = casted->mBoundingBoxMaxs;
+  const int axis = casted->mSweepAxis;
+  const double rayMax = std::max(ray.from[axis], ray.to[axis]);
+
+  double closestFraction = std::numeric_limits<double>::infinity();
+
+  // The bounding boxes are sorted by their lower bounds along the sweep axis,
+  // so the ones beyond the end of the ray are skipped all at once
+  for (const std::size_t index : casted->mSweepOrder)
+  {
+    if (mins[index][axis] > rayMax)
+      break;
+
+    // Only the closest hit is kept, so farther objects can be skipped
+    double enter;
+    if (!intersectSegmentBox(ray.from, ray.to, mins[index], maxs[index], enter)
+        || (!option.enableAllHits && enter > closestFraction))
+    {
+      continue;
+    }
+
+    CollisionObject* object = casted->mCollisionObjects[index];
+
+    RayHit hit;
+    if (!raycastShape(object->getShape().get(), object->getTransform(),
+                      ray.from, ray.to, hit.fraction, hit.normal))
+    {
+      continue;
+    }
+
+    hit.collisionObject = object;
+    hit.point = ray.from + hit.fraction * (ray.to - ray.from);
+    closestFraction = std::min(closestFraction, hit.fraction);
+
+    result->rayHits.push_back(hit);
+  }
+}
+
 //==============================================================================
 DARTCollisionDetector::DARTCollisionDetector()
   : CollisionDetector()
@@ -271,6 +366,21 @@ void warnUnsupportedShapeType(const dynamics::ShapeFrame* shapeFrame)
   if (shapeType == dynamics::BoxShape::getStaticType())
     return;
 
+  if (shapeType == dynamics::CapsuleShape::getStaticType())
+    return;
+
+  if (shapeType == dynamics::CylinderShape::getStaticType())
+    return;
+
+  if (shapeType == dynamics::PlaneShape::getStaticType())
+    return;
+
+  if (shapeType == dynamics::HeightmapShape::getStaticType())
+    return;
+
+  if (shapeType == dynamics::VoxelGridShape::getStaticType())
+    return;
+
   if (shapeType == dynamics::EllipsoidShape::getStaticType())
   {
     const auto& ellipsoid
@@ -282,7 +392,9 @@ void warnUnsupportedShapeType(const dynamics::ShapeFrame* shapeFrame)
 
   dterr << "[DARTCollisionDetector] Attempting to create shape type ["
         << shapeType << "] that is not supported "
-        << "by DARTCollisionDetector. Currently, only BoxShape and "
+        << "by DARTCollisionDetector. Currently, only SphereShape, "
+        << "BoxShape, CapsuleShape, CylinderShape, PlaneShape, "
+        << "HeightmapShape, VoxelGridShape, and "
         << "EllipsoidShape (only when all the radii are equal) are "
         << "supported. This shape will always get penetrated by other "
         << "objects.\n";
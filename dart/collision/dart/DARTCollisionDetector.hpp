@@ -93,6 +93,13 @@ protected:
   std::unique_ptr<CollisionObject> createCollisionObject(
       const dynamics::ShapeFrame* shapeFrame) override;
 
+  // Documentation inherited
+  void castRay(
+      const CollisionGroup* group,
+      const Ray& ray,
+      const RaycastOption& option,
+      RaycastResult* result) override;
+
 };
 
 }  // namespace collision
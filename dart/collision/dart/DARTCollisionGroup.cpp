@@ -31,7 +31,10 @@
 
 #include "dart/collision/dart/DARTCollisionGroup.hpp"
 
-#include "dart/collision/CollisionObject.hpp"
+#include <algorithm>
+#include <cassert>
+
+#include "dart/collision/dart/DARTCollisionObject.hpp"
 
 namespace dart {
 namespace collision {
@@ -39,7 +42,9 @@ namespace collision {
 //==============================================================================
 DARTCollisionGroup::DARTCollisionGroup(
     const CollisionDetectorPtr& collisionDetector)
-  : CollisionGroup(collisionDetector)
+  : CollisionGroup(collisionDetector),
+    mSweepAxis(0),
+    mNeedSweepOrderRebuild(true)
 {
   // Do nothing
 }
@@ -57,6 +62,7 @@ void DARTCollisionGroup::addCollisionObjectToEngine(CollisionObject* object)
       == mCollisionObjects.end())
   {
     mCollisionObjects.push_back(object);
+    mNeedSweepOrderRebuild = true;
   }
 }
 
@@ -74,18 +80,219 @@ void DARTCollisionGroup::removeCollisionObjectFromEngine(
 {
   mCollisionObjects.erase(
       std::remove(mCollisionObjects.begin(), mCollisionObjects.end(), object));
+  mNeedSweepOrderRebuild = true;
 }
 
 //==============================================================================
 void DARTCollisionGroup::removeAllCollisionObjectsFromEngine()
 {
   mCollisionObjects.clear();
+  mNeedSweepOrderRebuild = true;
 }
 
 //==============================================================================
 void DARTCollisionGroup::updateCollisionGroupEngineData()
 {
-  // Do nothing
+  const std::size_t numObjects = mCollisionObjects.size();
+
+  mBoundingBoxMins.resize(numObjects);
+  mBoundingBoxMaxs.resize(numObjects);
+
+  Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+  Eigen::Vector3d squaredSum = Eigen::Vector3d::Zero();
+
+  for (std::size_t i = 0u; i < numObjects; ++i)
+  {
+    assert(dynamic_cast<const DARTCollisionObject*>(mCollisionObjects[i]));
+    const auto object
+        = static_cast<const DARTCollisionObject*>(mCollisionObjects[i]);
+
+    mBoundingBoxMins[i] = object->getWorldBoundingBoxMin();
+    mBoundingBoxMaxs[i] = object->getWorldBoundingBoxMax();
+
+    const Eigen::Vector3d center
+        = 0.5 * (mBoundingBoxMins[i] + mBoundingBoxMaxs[i]);
+    sum += center;
+    squaredSum += center.cwiseProduct(center);
+  }
+
+  // Sweep along the axis where the objects are spread the most so that as few
+  // bounding boxes as possible overlap along it. Some hysteresis avoids
+  // resorting from scratch when two axes have about the same spread.
+  if (numObjects > 0u)
+  {
+    const double n = static_cast<double>(numObjects);
+    const Eigen::Vector3d variance
+        = squaredSum / n - (sum / n).cwiseProduct(sum / n);
+
+    int axis;
+    if (variance.maxCoeff(&axis) > 1.5 * variance[mSweepAxis])
+    {
+      mSweepAxis = axis;
+      mNeedSweepOrderRebuild = true;
+    }
+  }
+
+  const int sweepAxis = mSweepAxis;
+  const auto& mins = mBoundingBoxMins;
+  const auto lessThan = [&mins, sweepAxis](std::size_t i, std::size_t j)
+  {
+    return mins[i][sweepAxis] < mins[j][sweepAxis];
+  };
+
+  if (mNeedSweepOrderRebuild || mSweepOrder.size() != numObjects)
+  {
+    mSweepOrder.resize(numObjects);
+    for (std::size_t i = 0u; i < numObjects; ++i)
+      mSweepOrder[i] = i;
+
+    std::sort(mSweepOrder.begin(), mSweepOrder.end(), lessThan);
+    mNeedSweepOrderRebuild = false;
+
+    return;
+  }
+
+  // Insertion sort, which is nearly linear thanks to temporal coherence
+  for (std::size_t i = 1u; i < numObjects; ++i)
+  {
+    const std::size_t index = mSweepOrder[i];
+    std::size_t j = i;
+    while (j > 0u && lessThan(index, mSweepOrder[j - 1u]))
+    {
+      mSweepOrder[j] = mSweepOrder[j - 1u];
+      --j;
+    }
+    mSweepOrder[j] = index;
+  }
+}
+
+//==============================================================================
+void DARTCollisionGroup::refitCollisionGroupEngineData(
+    const std::vector<CollisionObject*>& updatedObjects)
+{
+  // Nothing has moved, so the bounding boxes and their order are still valid
+  if (updatedObjects.empty() && !mNeedSweepOrderRebuild
+      && mSweepOrder.size() == mCollisionObjects.size())
+  {
+    return;
+  }
+
+  updateCollisionGroupEngineData();
+}
+
+//==============================================================================
+static bool overlap(const Eigen::Vector3d& min1, const Eigen::Vector3d& max1,
+                    const Eigen::Vector3d& min2, const Eigen::Vector3d& max2)
+{
+  return (min1.array() <= max2.array()).all()
+      && (min2.array() <= max1.array()).all();
+}
+
+//==============================================================================
+const std::vector<std::pair<std::size_t, std::size_t>>&
+DARTCollisionGroup::computeOverlappingPairs()
+{
+  mOverlappingPairs.clear();
+
+  const std::size_t numObjects = mSweepOrder.size();
+  assert(numObjects == mCollisionObjects.size());
+
+  for (std::size_t i = 0u; i < numObjects; ++i)
+  {
+    const std::size_t index1 = mSweepOrder[i];
+    const double max1 = mBoundingBoxMaxs[index1][mSweepAxis];
+
+    for (std::size_t j = i + 1u; j < numObjects; ++j)
+    {
+      const std::size_t index2 = mSweepOrder[j];
+      if (mBoundingBoxMins[index2][mSweepAxis] > max1)
+        break;
+
+      if (overlap(mBoundingBoxMins[index1], mBoundingBoxMaxs[index1],
+                  mBoundingBoxMins[index2], mBoundingBoxMaxs[index2]))
+      {
+        mOverlappingPairs.emplace_back(std::min(index1, index2),
+                                       std::max(index1, index2));
+      }
+    }
+  }
+
+  // Check the pairs in the same order as a brute-force double loop would so
+  // that the contacts are reported in the same order
+  std::sort(mOverlappingPairs.begin(), mOverlappingPairs.end());
+
+  return mOverlappingPairs;
+}
+
+//==============================================================================
+const std::vector<std::pair<std::size_t, std::size_t>>&
+DARTCollisionGroup::computeOverlappingPairs(
+    const DARTCollisionGroup* otherGroup)
+{
+  mOverlappingPairs.clear();
+
+  const int axis = mSweepAxis;
+  const auto& mins1 = mBoundingBoxMins;
+  const auto& maxs1 = mBoundingBoxMaxs;
+  const auto& mins2 = otherGroup->mBoundingBoxMins;
+  const auto& maxs2 = otherGroup->mBoundingBoxMaxs;
+
+  const std::vector<std::size_t>& order1 = mSweepOrder;
+  const std::vector<std::size_t>* order2 = &otherGroup->mSweepOrder;
+  if (otherGroup->mSweepAxis != axis)
+  {
+    mOtherSweepOrder = otherGroup->mSweepOrder;
+    std::sort(mOtherSweepOrder.begin(), mOtherSweepOrder.end(),
+              [&mins2, axis](std::size_t i, std::size_t j)
+              { return mins2[i][axis] < mins2[j][axis]; });
+    order2 = &mOtherSweepOrder;
+  }
+
+  const std::size_t numObjects1 = order1.size();
+  const std::size_t numObjects2 = order2->size();
+  assert(numObjects1 == mCollisionObjects.size());
+  assert(numObjects2 == otherGroup->mCollisionObjects.size());
+
+  // Merge the two sorted sequences. Each overlapping pair is found when the
+  // box whose lower bound comes first is visited.
+  std::size_t i = 0u;
+  std::size_t j = 0u;
+  while (i < numObjects1 && j < numObjects2)
+  {
+    const std::size_t index1 = order1[i];
+    const std::size_t index2 = (*order2)[j];
+
+    if (mins1[index1][axis] <= mins2[index2][axis])
+    {
+      for (std::size_t k = j; k < numObjects2; ++k)
+      {
+        const std::size_t other = (*order2)[k];
+        if (mins2[other][axis] > maxs1[index1][axis])
+          break;
+
+        if (overlap(mins1[index1], maxs1[index1], mins2[other], maxs2[other]))
+          mOverlappingPairs.emplace_back(index1, other);
+      }
+      ++i;
+    }
+    else
+    {
+      for (std::size_t k = i; k < numObjects1; ++k)
+      {
+        const std::size_t other = order1[k];
+        if (mins1[other][axis] > maxs2[index2][axis])
+          break;
+
+        if (overlap(mins1[other], maxs1[other], mins2[index2], maxs2[index2]))
+          mOverlappingPairs.emplace_back(other, index2);
+      }
+      ++j;
+    }
+  }
+
+  std::sort(mOverlappingPairs.begin(), mOverlappingPairs.end());
+
+  return mOverlappingPairs;
 }
 
 }  // namespace collision
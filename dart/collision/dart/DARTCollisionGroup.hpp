@@ -32,6 +32,8 @@
 #ifndef DART_COLLISION_DART_DARTCOLLISIONGROUP_HPP_
 #define DART_COLLISION_DART_DARTCOLLISIONGROUP_HPP_
 
+#include <vector>
+#include <Eigen/Dense>
 #include "dart/collision/CollisionGroup.hpp"
 
 namespace dart {
@@ -72,11 +74,51 @@ protected:
   // Documentation inherited
   void updateCollisionGroupEngineData() override;
 
+  // Documentation inherited
+  void refitCollisionGroupEngineData(
+      const std::vector<CollisionObject*>& updatedObjects) override;
+
+  /// Return the pairs of indices into mCollisionObjects whose world bounding
+  /// boxes overlap, sorted in lexicographical order with the first index
+  /// smaller than the second one. updateEngineData() should be called first.
+  const std::vector<std::pair<std::size_t, std::size_t>>&
+  computeOverlappingPairs();
+
+  /// Return the pairs of indices into mCollisionObjects of this group and of
+  /// otherGroup whose world bounding boxes overlap, sorted in lexicographical
+  /// order. updateEngineData() should be called first for both groups.
+  const std::vector<std::pair<std::size_t, std::size_t>>&
+  computeOverlappingPairs(const DARTCollisionGroup* otherGroup);
+
 protected:
 
   /// CollisionObjects added to this DARTCollisionGroup
   std::vector<CollisionObject*> mCollisionObjects;
 
+  /// Lower corners of the world bounding boxes of mCollisionObjects
+  std::vector<Eigen::Vector3d> mBoundingBoxMins;
+
+  /// Upper corners of the world bounding boxes of mCollisionObjects
+  std::vector<Eigen::Vector3d> mBoundingBoxMaxs;
+
+  /// Indices into mCollisionObjects sorted by the lower bound of the bounding
+  /// boxes along mSweepAxis. This is kept sorted by insertion sort, which
+  /// costs O(n) when the objects move only a little between updates.
+  std::vector<std::size_t> mSweepOrder;
+
+  /// Axis along which the bounding boxes are sorted and swept
+  int mSweepAxis;
+
+  /// Whether mSweepOrder needs to be rebuilt because CollisionObjects were
+  /// added or removed
+  bool mNeedSweepOrderRebuild;
+
+  /// Cache data for the indices of the other group sorted along mSweepAxis
+  std::vector<std::size_t> mOtherSweepOrder;
+
+  /// Cache data for the overlapping pairs
+  std::vector<std::pair<std::size_t, std::size_t>> mOverlappingPairs;
+
 };
 
 }  // namespace collision
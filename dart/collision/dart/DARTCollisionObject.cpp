@@ -31,6 +31,10 @@
 
 #include "dart/collision/dart/DARTCollisionObject.hpp"
 
+#include <limits>
+
+#include "dart/dynamics/PlaneShape.hpp"
+
 namespace dart {
 namespace collision {
 
@@ -38,15 +42,46 @@ namespace collision {
 DARTCollisionObject::DARTCollisionObject(
     CollisionDetector* collisionDetector,
     const dynamics::ShapeFrame* shapeFrame)
-  : CollisionObject(collisionDetector, shapeFrame)
+  : CollisionObject(collisionDetector, shapeFrame),
+    mWorldBoundingBoxMin(Eigen::Vector3d::Zero()),
+    mWorldBoundingBoxMax(Eigen::Vector3d::Zero())
 {
   // Do nothing
 }
 
+//==============================================================================
+const Eigen::Vector3d& DARTCollisionObject::getWorldBoundingBoxMin() const
+{
+  return mWorldBoundingBoxMin;
+}
+
+//==============================================================================
+const Eigen::Vector3d& DARTCollisionObject::getWorldBoundingBoxMax() const
+{
+  return mWorldBoundingBoxMax;
+}
+
 //==============================================================================
 void DARTCollisionObject::updateEngineData()
 {
-  // Do nothing
+  // A plane is unbounded. Use the largest finite values rather than infinity
+  // so that the broad phase can still compute the center of the box.
+  if (getShape()->getType() == dynamics::PlaneShape::getStaticType())
+  {
+    mWorldBoundingBoxMax.setConstant(std::numeric_limits<double>::max());
+    mWorldBoundingBoxMin = -mWorldBoundingBoxMax;
+    return;
+  }
+
+  const math::BoundingBox& box = getShape()->getBoundingBox();
+  const Eigen::Isometry3d& tf = getTransform();
+
+  const Eigen::Vector3d center = tf * box.computeCenter();
+  const Eigen::Vector3d halfExtents
+      = tf.linear().cwiseAbs() * box.computeHalfExtents();
+
+  mWorldBoundingBoxMin = center - halfExtents;
+  mWorldBoundingBoxMax = center + halfExtents;
 }
 
 }  // namespace collision
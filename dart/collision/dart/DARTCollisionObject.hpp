@@ -46,6 +46,14 @@ public:
 
   friend class DARTCollisionDetector;
 
+  /// Return the lower corner of the axis-aligned bounding box of this
+  /// CollisionObject in world coordinates as of the last engine data update
+  const Eigen::Vector3d& getWorldBoundingBoxMin() const;
+
+  /// Return the upper corner of the axis-aligned bounding box of this
+  /// CollisionObject in world coordinates as of the last engine data update
+  const Eigen::Vector3d& getWorldBoundingBoxMax() const;
+
 protected:
 
   /// Constructor
@@ -55,6 +63,14 @@ protected:
   // Documentation inherited
   void updateEngineData() override;
 
+protected:
+
+  /// Lower corner of the world axis-aligned bounding box
+  Eigen::Vector3d mWorldBoundingBoxMin;
+
+  /// Upper corner of the world axis-aligned bounding box
+  Eigen::Vector3d mWorldBoundingBoxMax;
+
 };
 
 }  // namespace collision
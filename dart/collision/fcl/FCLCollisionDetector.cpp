@@ -46,7 +46,9 @@
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/DistanceFilter.hpp"
+#include "dart/collision/dart/DARTCollide.hpp"
 #include "dart/collision/fcl/FCLTypes.hpp"
+#include "dart/collision/fcl/FCLMeshGeometryCache.hpp"
 #include "dart/collision/fcl/FCLCollisionObject.hpp"
 #include "dart/collision/fcl/FCLCollisionGroup.hpp"
 #include "dart/collision/fcl/tri_tri_intersection_test.hpp"
@@ -59,6 +61,8 @@
 #include "dart/dynamics/PlaneShape.hpp"
 #include "dart/dynamics/MeshShape.hpp"
 #include "dart/dynamics/SoftMeshShape.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
+#include "dart/dynamics/VoxelGridShape.hpp"
 
 namespace dart {
 namespace collision {
@@ -74,6 +78,9 @@ bool distanceCallback(
     void* cdata,
     fcl::FCL_REAL& dist);
 
+bool raycastCallback(
+    fcl::CollisionObject* o1, fcl::CollisionObject* o2, void* cdata);
+
 void postProcessFCL(
     const fcl::CollisionResult& fclResult,
     fcl::CollisionObject* o1,
@@ -231,6 +238,29 @@ struct FCLDistanceCallbackData
   }
 };
 
+struct FCLRaycastCallbackData
+{
+  /// Ray to cast
+  const Ray& ray;
+
+  /// FCL collision object whose bounding box is the bounding box of the ray
+  const fcl::CollisionObject* rayObject;
+
+  /// Raycast result of DART
+  RaycastResult* result;
+
+  FCLRaycastCallbackData(
+      const Ray& ray,
+      const fcl::CollisionObject* rayObject,
+      RaycastResult* result)
+    : ray(ray),
+      rayObject(rayObject),
+      result(result)
+  {
+    // Do nothing
+  }
+};
+
 //==============================================================================
 // Create a cube mesh for collision detection
 template<class BV>
@@ -589,56 +619,77 @@ fcl::BVHModel<BV>* createCylinder(double _baseRadius, double _topRadius,
 
 //==============================================================================
 template<class BV>
-fcl::BVHModel<BV>* createMesh(float _scaleX, float _scaleY, float _scaleZ,
-                              const aiScene* _mesh)
+fcl::BVHModel<BV>* createSoftMesh(const aiMesh* _mesh)
 {
-  // Create FCL mesh from Assimp mesh
+  // Create FCL mesh from Assimp mesh. The vertices are shared by the triangles
+  // so that FCLCollisionObject can update them per point mass.
 
   assert(_mesh);
   fcl::BVHModel<BV>* model = new fcl::BVHModel<BV>;
-  model->beginModel();
-  for (std::size_t i = 0; i < _mesh->mNumMeshes; i++)
+
+  std::vector<fcl::Vec3f> vertices(_mesh->mNumVertices);
+  for (std::size_t i = 0; i < _mesh->mNumVertices; i++)
   {
-    for (std::size_t j = 0; j < _mesh->mMeshes[i]->mNumFaces; j++)
-    {
-      fcl::Vec3f vertices[3];
-      for (std::size_t k = 0; k < 3; k++)
-      {
-        const aiVector3D& vertex
-            = _mesh->mMeshes[i]->mVertices[
-              _mesh->mMeshes[i]->mFaces[j].mIndices[k]];
-        vertices[k] = fcl::Vec3f(vertex.x * _scaleX,
-                                 vertex.y * _scaleY,
-                                 vertex.z * _scaleZ);
-      }
-      model->addTriangle(vertices[0], vertices[1], vertices[2]);
-    }
+    const aiVector3D& vertex = _mesh->mVertices[i];
+    vertices[i] = fcl::Vec3f(vertex.x, vertex.y, vertex.z);
   }
+
+  std::vector<fcl::Triangle> triangles(_mesh->mNumFaces);
+  for (std::size_t i = 0; i < _mesh->mNumFaces; i++)
+  {
+    const unsigned int* indices = _mesh->mFaces[i].mIndices;
+    triangles[i] = fcl::Triangle(indices[0], indices[1], indices[2]);
+  }
+
+  model->beginModel();
+  model->addSubModel(vertices, triangles);
   model->endModel();
   return model;
 }
 
 //==============================================================================
 template<class BV>
-fcl::BVHModel<BV>* createSoftMesh(const aiMesh* _mesh)
+fcl::BVHModel<BV>* createHeightmap(const dynamics::HeightmapShape* _heightmap)
 {
-  // Create FCL mesh from Assimp mesh
+  // Create FCL mesh from the height field grid, splitting each cell along the
+  // same diagonal as HeightmapShape::computeHeight() does.
 
-  assert(_mesh);
+  assert(_heightmap);
   fcl::BVHModel<BV>* model = new fcl::BVHModel<BV>;
-  model->beginModel();
 
-  for (std::size_t i = 0; i < _mesh->mNumFaces; i++)
+  const std::size_t numRows = _heightmap->getNumRows();
+  const std::size_t numColumns = _heightmap->getNumColumns();
+
+  std::vector<fcl::Vec3f> vertices(numRows * numColumns);
+  for (std::size_t i = 0; i < numRows; ++i)
   {
-    fcl::Vec3f vertices[3];
-    for (std::size_t j = 0; j < 3; j++)
+    for (std::size_t j = 0; j < numColumns; ++j)
     {
-      const aiVector3D& vertex = _mesh->mVertices[_mesh->mFaces[i].mIndices[j]];
-      vertices[j] = fcl::Vec3f(vertex.x, vertex.y, vertex.z);
+      vertices[i * numColumns + j]
+          = FCLTypes::convertVector3(_heightmap->getVertex(i, j));
     }
-    model->addTriangle(vertices[0], vertices[1], vertices[2]);
   }
 
+  std::vector<fcl::Triangle> triangles;
+  if (numRows > 1u && numColumns > 1u)
+    triangles.reserve(2u * (numRows - 1u) * (numColumns - 1u));
+
+  for (std::size_t i = 0; i + 1u < numRows; ++i)
+  {
+    for (std::size_t j = 0; j + 1u < numColumns; ++j)
+    {
+      const std::size_t v00 = i * numColumns + j;
+      const std::size_t v01 = v00 + 1u;
+      const std::size_t v10 = v00 + numColumns;
+      const std::size_t v11 = v10 + 1u;
+
+      triangles.push_back(fcl::Triangle(v00, v01, v11));
+      triangles.push_back(fcl::Triangle(v00, v11, v10));
+    }
+  }
+
+  model->beginModel();
+  model->addSubModel(vertices, triangles);
   model->endModel();
   return model;
 }
@@ -815,6 +866,29 @@ double FCLCollisionDetector::distance(
   return std::max(distData.unclampedMinDistance, option.distanceLowerBound);
 }
 
+//==============================================================================
+void FCLCollisionDetector::castRay(
+    const CollisionGroup* group,
+    const Ray& ray,
+    const RaycastOption& /*option*/,
+    RaycastResult* result)
+{
+  // Query the broad-phase with the bounding box of the ray, and test the ray
+  // against the shapes of the objects whose bounding boxes overlap it
+  const Eigen::Vector3d size = (ray.to - ray.from).cwiseAbs();
+  const Eigen::Vector3d center = 0.5 * (ray.from + ray.to);
+  fcl::CollisionObject rayObject(
+        fcl_shared_ptr<fcl::CollisionGeometry>(
+          new fcl::Box(size[0], size[1], size[2])),
+        fcl::Transform3f(FCLTypes::convertVector3(center)));
+
+  FCLRaycastCallbackData raycastData(ray, &rayObject, result);
+
+  const auto casted = static_cast<const FCLCollisionGroup*>(group);
+  casted->getFCLCollisionManager()->collide(
+        &rayObject, &raycastData, raycastCallback);
+}
+
 //==============================================================================
 void FCLCollisionDetector::setPrimitiveShapeType(
     FCLCollisionDetector::PrimitiveShape type)
@@ -921,6 +995,8 @@ FCLCollisionDetector::createFCLCollisionGeometry(
   using dynamics::PlaneShape;
   using dynamics::MeshShape;
   using dynamics::SoftMeshShape;
+  using dynamics::HeightmapShape;
+  using dynamics::VoxelGridShape;
 
   fcl::CollisionGeometry* geom = nullptr;
   const auto& shapeType = shape->getType();
@@ -1016,10 +1092,15 @@ FCLCollisionDetector::createFCLCollisionGeometry(
     assert(dynamic_cast<const MeshShape*>(shape.get()));
 
     auto shapeMesh = static_cast<const MeshShape*>(shape.get());
-    const Eigen::Vector3d& scale = shapeMesh->getScale();
-    auto aiScene = shapeMesh->getMesh();
 
-    geom = createMesh<fcl::OBBRSS>(scale[0], scale[1], scale[2], aiScene);
+    // The BVH is shared with all the other meshes loaded from the same
+    // resource, so it's owned by the cache rather than by this shape.
+    auto sharedGeom
+        = FCLMeshGeometryCache::getInstance().claimGeometry(shapeMesh);
+
+    return fcl_shared_ptr<fcl::CollisionGeometry>(
+          sharedGeom.get(),
+          FCLCollisionGeometryDeleter(this, shape, sharedGeom));
   }
   else if (SoftMeshShape::getStaticType() == shapeType)
   {
@@ -1030,6 +1111,23 @@ FCLCollisionDetector::createFCLCollisionGeometry(
 
     geom = createSoftMesh<fcl::OBBRSS>(aiMesh);
   }
+  else if (HeightmapShape::getStaticType() == shapeType)
+  {
+    assert(dynamic_cast<const HeightmapShape*>(shape.get()));
+
+    auto heightmap = static_cast<const HeightmapShape*>(shape.get());
+
+    // FCL 0.5 has no height field geometry, so the grid is converted into a
+    // BVH whose tree prunes the cells that are away from the other object.
+    geom = createHeightmap<fcl::OBBRSS>(heightmap);
+  }
+  else if (VoxelGridShape::getStaticType() == shapeType)
+  {
+    // FCL is built without octomap here, so the voxels are represented by a
+    // BVH of their exposed faces. It's (re)built by
+    // FCLCollisionObject::updateEngineData() whenever the voxels change.
+    geom = new fcl::BVHModel<fcl::OBBRSS>;
+  }
   else
   {
     dterr << "[FCLCollisionDetector::createFCLCollisionGeometry] "
@@ -1046,9 +1144,11 @@ FCLCollisionDetector::createFCLCollisionGeometry(
 //==============================================================================
 FCLCollisionDetector::FCLCollisionGeometryDeleter::FCLCollisionGeometryDeleter(
     FCLCollisionDetector* cd,
-    const dynamics::ConstShapePtr& shape)
+    const dynamics::ConstShapePtr& shape,
+    const fcl_shared_ptr<fcl::CollisionGeometry>& sharedGeometry)
   : mFCLCollisionDetector(cd),
-    mShape(shape)
+    mShape(shape),
+    mSharedGeometry(sharedGeometry)
 {
   assert(cd);
   assert(shape);
@@ -1060,13 +1160,58 @@ void FCLCollisionDetector::FCLCollisionGeometryDeleter::operator()(
 {
   mFCLCollisionDetector->mShapeMap.erase(mShape);
 
-  delete geom;
+  if (!mSharedGeometry)
+    delete geom;
 }
 
 
 
 namespace {
 
+//==============================================================================
+/// Return true if the FCL object has no geometry to check, like the BVH of an
+/// empty voxel grid, which FCL's narrow phase can't handle
+bool isEmpty(const fcl::CollisionObject* fclObject)
+{
+  auto userData
+      = static_cast<FCLCollisionObject::UserData*>(fclObject->getUserData());
+  assert(userData);
+  assert(dynamic_cast<FCLCollisionObject*>(userData->mCollisionObject));
+
+  return static_cast<FCLCollisionObject*>(userData->mCollisionObject)
+      ->isEmpty();
+}
+
+//==============================================================================
+bool raycastCallback(
+    fcl::CollisionObject* o1, fcl::CollisionObject* o2, void* cdata)
+{
+  auto raycastData = static_cast<FCLRaycastCallbackData*>(cdata);
+  const auto& ray = raycastData->ray;
+
+  fcl::CollisionObject* fclObject
+      = (o1 == raycastData->rayObject) ? o2 : o1;
+
+  auto userData
+      = static_cast<FCLCollisionObject::UserData*>(fclObject->getUserData());
+  assert(userData);
+
+  CollisionObject* object = userData->mCollisionObject;
+  assert(object);
+
+  RayHit hit;
+  if (raycastShape(object->getShape().get(), object->getTransform(),
+                   ray.from, ray.to, hit.fraction, hit.normal))
+  {
+    hit.collisionObject = object;
+    hit.point = ray.from + hit.fraction * (ray.to - ray.from);
+    raycastData->result->rayHits.push_back(hit);
+  }
+
+  // Visit every object whose bounding box overlaps the ray
+  return false;
+}
+
 //==============================================================================
 bool collisionCallback(
     fcl::CollisionObject* o1, fcl::CollisionObject* o2, void* cdata)
@@ -1079,6 +1224,9 @@ bool collisionCallback(
   if (collData->done)
     return true;
 
+  if (isEmpty(o1) || isEmpty(o2))
+    return collData->done;
+
   const auto& fclRequest  = collData->fclRequest;
         auto& fclResult   = collData->fclResult;
         auto* result      = collData->result;
@@ -1161,6 +1309,9 @@ bool distanceCallback(
     return true;
   }
 
+  if (isEmpty(o1) || isEmpty(o2))
+    return distData->done;
+
   // Filtering
   if (filter)
   {
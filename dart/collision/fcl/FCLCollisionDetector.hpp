@@ -142,6 +142,13 @@ protected:
   std::unique_ptr<CollisionObject> createCollisionObject(
       const dynamics::ShapeFrame* shapeFrame) override;
 
+  // Documentation inherited
+  void castRay(
+      const CollisionGroup* group,
+      const Ray& ray,
+      const RaycastOption& option,
+      RaycastResult* result) override;
+
   /// Return fcl::CollisionGeometry associated with give Shape. New
   /// fcl::CollisionGeome will be created if it hasn't created yet.
   fcl_shared_ptr<fcl::CollisionGeometry> claimFCLCollisionGeometry(
@@ -157,12 +164,17 @@ private:
 
   /// This deleter is responsible for deleting fcl::CollisionGeometry and
   /// removing it from mShapeMap when it is not shared by any CollisionObjects.
+  /// If sharedGeometry is given, the geometry is owned by FCLMeshGeometryCache
+  /// and only this reference to it is released.
   class FCLCollisionGeometryDeleter final
   {
   public:
 
-    FCLCollisionGeometryDeleter(FCLCollisionDetector* cd,
-                                const dynamics::ConstShapePtr& shape);
+    FCLCollisionGeometryDeleter(
+        FCLCollisionDetector* cd,
+        const dynamics::ConstShapePtr& shape,
+        const fcl_shared_ptr<fcl::CollisionGeometry>& sharedGeometry
+            = fcl_shared_ptr<fcl::CollisionGeometry>());
 
     void operator()(fcl::CollisionGeometry* geom) const;
 
@@ -172,6 +184,8 @@ private:
 
     dynamics::ConstShapePtr mShape;
 
+    fcl_shared_ptr<fcl::CollisionGeometry> mSharedGeometry;
+
   };
 
   /// Create fcl::CollisionGeometry with the custom deleter
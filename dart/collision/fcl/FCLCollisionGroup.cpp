@@ -99,6 +99,29 @@ void FCLCollisionGroup::updateCollisionGroupEngineData()
   mBroadPhaseAlg->update();
 }
 
+//==============================================================================
+void FCLCollisionGroup::refitCollisionGroupEngineData(
+    const std::vector<CollisionObject*>& updatedObjects)
+{
+  if (updatedObjects.empty())
+    return;
+
+  if (updatedObjects.size() == mShapeFrameMap.size())
+  {
+    updateCollisionGroupEngineData();
+    return;
+  }
+
+  mUpdatedFCLCollisionObjects.clear();
+  for (auto collObj : updatedObjects)
+  {
+    auto casted = static_cast<FCLCollisionObject*>(collObj);
+    mUpdatedFCLCollisionObjects.push_back(casted->getFCLCollisionObject());
+  }
+
+  mBroadPhaseAlg->update(mUpdatedFCLCollisionObjects);
+}
+
 //==============================================================================
 FCLCollisionGroup::FCLCollisionManager*
 FCLCollisionGroup::getFCLCollisionManager()
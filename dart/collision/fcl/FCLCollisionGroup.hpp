@@ -79,6 +79,10 @@ protected:
   // Documentation inherited
   void updateCollisionGroupEngineData() override;
 
+  // Documentation inherited
+  void refitCollisionGroupEngineData(
+      const std::vector<CollisionObject*>& updatedObjects) override;
+
   /// Return FCL collision manager that is also a broad-phase algorithm
   FCLCollisionManager* getFCLCollisionManager();
 
@@ -90,6 +94,9 @@ protected:
   /// FCL broad-phase algorithm
   std::unique_ptr<FCLCollisionManager> mBroadPhaseAlg;
 
+  /// FCL collision objects to be refitted in the broad-phase algorithm
+  std::vector<fcl::CollisionObject*> mUpdatedFCLCollisionObjects;
+
 };
 
 }  // namespace collision
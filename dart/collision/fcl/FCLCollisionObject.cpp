@@ -35,6 +35,9 @@
 
 #include "dart/collision/fcl/FCLTypes.hpp"
 #include "dart/dynamics/SoftMeshShape.hpp"
+#include "dart/dynamics/VoxelGridShape.hpp"
+#include "dart/dynamics/SoftBodyNode.hpp"
+#include "dart/dynamics/PointMass.hpp"
 #include "dart/dynamics/ShapeFrame.hpp"
 
 namespace dart {
@@ -59,6 +62,12 @@ const fcl::CollisionObject* FCLCollisionObject::getFCLCollisionObject() const
   return mFCLCollisionObject.get();
 }
 
+//==============================================================================
+bool FCLCollisionObject::isEmpty() const
+{
+  return mIsEmpty;
+}
+
 //==============================================================================
 FCLCollisionObject::FCLCollisionObject(
     CollisionDetector* collisionDetector,
@@ -66,9 +75,16 @@ FCLCollisionObject::FCLCollisionObject(
     const fcl_shared_ptr<fcl::CollisionGeometry>& fclCollGeom)
   : CollisionObject(collisionDetector, shapeFrame),
     mFCLCollisionObjectUserData(new UserData(this)),
-    mFCLCollisionObject(new fcl::CollisionObject(fclCollGeom))
+    mFCLCollisionObject(new fcl::CollisionObject(fclCollGeom)),
+    mVoxelGridVersion(0u),
+    mIsEmpty(false)
 {
   mFCLCollisionObject->setUserData(mFCLCollisionObjectUserData.get());
+
+  // The BVH of a voxel grid is only built once it has occupied voxels
+  const auto& shape = shapeFrame->getShape();
+  if (shape && shape->getType() == dynamics::VoxelGridShape::getStaticType())
+    mIsEmpty = true;
 }
 
 //==============================================================================
@@ -80,13 +96,14 @@ void FCLCollisionObject::updateEngineData()
 
   auto shape = mShapeFrame->getShape().get();
 
-  // Update soft-body's vertices
-  if (shape->getType() == dynamics::SoftMeshShape::getStaticType())
+  // Update soft-body's vertices unless the soft body is at rest
+  if (shape->getType() == dynamics::SoftMeshShape::getStaticType()
+      && updateSoftMeshVertices(static_cast<const SoftMeshShape*>(shape)))
   {
     assert(dynamic_cast<const SoftMeshShape*>(shape));
     auto softMeshShape = static_cast<const SoftMeshShape*>(shape);
 
-    const aiMesh* mesh = softMeshShape->getAssimpMesh();
+    // Keep the Assimp mesh in sync for the other users of it (e.g., rendering)
     const_cast<SoftMeshShape*>(softMeshShape)->update();
     // TODO(JS): update function be called by somewhere out of here.
 
@@ -101,23 +118,135 @@ void FCLCollisionObject::updateEngineData()
     assert(dynamic_cast<fcl::BVHModel<fcl::OBBRSS>*>(collGeom));
     auto bvhModel = static_cast<fcl::BVHModel<fcl::OBBRSS>*>(collGeom);
 
+    // The vertices are shared by the triangles (see createSoftMesh()), so one
+    // vertex per point mass is updated. The bounding volumes are refitted
+    // bottom-up instead of rebuilding the hierarchy.
+    assert(static_cast<std::size_t>(bvhModel->num_vertices)
+           == mSoftMeshVertices.size());
     bvhModel->beginUpdateModel();
-    for (auto i = 0u; i < mesh->mNumFaces; ++i)
+    bvhModel->updateSubModel(mSoftMeshVertices);
+    bvhModel->endUpdateModel(true, true);
+  }
+
+  // Rebuild the surface of the voxel grid whenever voxels are added or removed
+  if (shape->getType() == dynamics::VoxelGridShape::getStaticType())
+  {
+    assert(dynamic_cast<const dynamics::VoxelGridShape*>(shape));
+    auto voxelGrid = static_cast<const dynamics::VoxelGridShape*>(shape);
+
+    if (voxelGrid->getVersion() != mVoxelGridVersion)
     {
-      fcl::Vec3f vertices[3];
-      for (auto j = 0u; j < 3; ++j)
-      {
-        const auto& vertex = mesh->mVertices[mesh->mFaces[i].mIndices[j]];
-        vertices[j] = fcl::Vec3f(vertex.x, vertex.y, vertex.z);
-      }
-      bvhModel->updateTriangle(vertices[0], vertices[1], vertices[2]);
+      updateVoxelGridTriangles(voxelGrid);
+      mVoxelGridVersion = voxelGrid->getVersion();
     }
-    bvhModel->endUpdateModel();
   }
 
   mFCLCollisionObject->setTransform(FCLTypes::convertTransform(getTransform()));
   mFCLCollisionObject->computeAABB();
 }
 
+//==============================================================================
+bool FCLCollisionObject::updateSoftMeshVertices(
+    const dynamics::SoftMeshShape* softMeshShape)
+{
+  const auto softBodyNode = softMeshShape->getSoftBodyNode();
+  const auto numPointMasses = softBodyNode->getNumPointMasses();
+
+  bool moved = false;
+  if (mSoftMeshVertices.size() != numPointMasses)
+  {
+    mSoftMeshVertices.resize(numPointMasses);
+    moved = true;
+  }
+
+  for (auto i = 0u; i < numPointMasses; ++i)
+  {
+    const Eigen::Vector3d& position
+        = softBodyNode->getPointMass(i)->getLocalPosition();
+    fcl::Vec3f& vertex = mSoftMeshVertices[i];
+
+    if (vertex[0] != position[0] || vertex[1] != position[1]
+        || vertex[2] != position[2])
+    {
+      vertex.setValue(position[0], position[1], position[2]);
+      moved = true;
+    }
+  }
+
+  return moved;
+}
+
+//==============================================================================
+void FCLCollisionObject::updateVoxelGridTriangles(
+    const dynamics::VoxelGridShape* voxelGrid)
+{
+  using Key = dynamics::VoxelGridShape::Key;
+
+#if FCL_VERSION_AT_LEAST(0,3,0)
+  auto collGeom = const_cast<fcl::CollisionGeometry*>(
+        mFCLCollisionObject->collisionGeometry().get());
+#else
+  fcl::CollisionGeometry* collGeom
+      = const_cast<fcl::CollisionGeometry*>(
+        mFCLCollisionObject->getCollisionGeometry());
+#endif
+  assert(dynamic_cast<fcl::BVHModel<fcl::OBBRSS>*>(collGeom));
+  auto bvhModel = static_cast<fcl::BVHModel<fcl::OBBRSS>*>(collGeom);
+
+  // Only the faces between an occupied voxel and a free one are on the
+  // surface, which keeps the model small for dense point clouds.
+  std::vector<fcl::Vec3f> vertices;
+  std::vector<fcl::Triangle> triangles;
+
+  const double halfResolution = 0.5 * voxelGrid->getResolution();
+
+  for (const auto& key : voxelGrid->getOccupiedVoxels())
+  {
+    const Eigen::Vector3d center = voxelGrid->computeVoxelCenter(key);
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      for (const int side : {-1, 1})
+      {
+        Key neighbor = key;
+        neighbor[axis] += side;
+        if (voxelGrid->isOccupied(neighbor))
+          continue;
+
+        // The corners of the face, counterclockwise seen from outside
+        const int u = (axis + (side > 0 ? 1 : 2)) % 3;
+        const int v = (axis + (side > 0 ? 2 : 1)) % 3;
+
+        const std::size_t first = vertices.size();
+        for (const auto& corner : {std::make_pair(-1, -1),
+                                   std::make_pair(1, -1),
+                                   std::make_pair(1, 1),
+                                   std::make_pair(-1, 1)})
+        {
+          Eigen::Vector3d vertex = center;
+          vertex[axis] += side * halfResolution;
+          vertex[u] += corner.first * halfResolution;
+          vertex[v] += corner.second * halfResolution;
+          vertices.push_back(FCLTypes::convertVector3(vertex));
+        }
+
+        triangles.push_back(fcl::Triangle(first, first + 1u, first + 2u));
+        triangles.push_back(fcl::Triangle(first, first + 2u, first + 3u));
+      }
+    }
+  }
+
+  // FCL refuses to build an empty model, which is left unfinished. The
+  // collision callbacks skip this object while it's empty (see isEmpty()).
+  mIsEmpty = triangles.empty();
+  bvhModel->beginModel();
+  if (!mIsEmpty)
+  {
+    bvhModel->addSubModel(vertices, triangles);
+    bvhModel->endModel();
+  }
+  bvhModel->computeLocalAABB();
+}
+
 }  // namespace collision
 }  // namespace dart
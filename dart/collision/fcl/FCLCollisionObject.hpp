@@ -32,11 +32,17 @@
 #ifndef DART_COLLISION_FCL_FCLCOLLISIONOBJECT_HPP_
 #define DART_COLLISION_FCL_FCLCOLLISIONOBJECT_HPP_
 
+#include <vector>
 #include <fcl/collision_object.h>
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/fcl/FCLTypes.hpp"
 
 namespace dart {
+namespace dynamics {
+class SoftMeshShape;
+class VoxelGridShape;
+}  // namespace dynamics
+
 namespace collision {
 
 class CollisionObject;
@@ -60,6 +66,11 @@ public:
   /// Return FCL collision object
   const fcl::CollisionObject* getFCLCollisionObject() const;
 
+  /// Return true if the FCL geometry has nothing to collide with, e.g., the
+  /// BVH of a VoxelGridShape without occupied voxels. FCL can't build such a
+  /// BVH, so these objects must be kept away from the narrow phase.
+  bool isEmpty() const;
+
 protected:
 
   /// Constructor
@@ -70,6 +81,15 @@ protected:
   // Documentation inherited
   void updateEngineData() override;
 
+  /// Copy the positions of the point masses of the soft body into
+  /// mSoftMeshVertices. Return false if none of them has moved since the last
+  /// call.
+  bool updateSoftMeshVertices(const dynamics::SoftMeshShape* softMeshShape);
+
+  /// Rebuild the BVH from the faces of the voxels that are exposed to free
+  /// space
+  void updateVoxelGridTriangles(const dynamics::VoxelGridShape* voxelGrid);
+
 protected:
 
   /// FCL collision geometry user data
@@ -78,6 +98,17 @@ protected:
   /// FCL collision object
   std::unique_ptr<fcl::CollisionObject> mFCLCollisionObject;
 
+  /// Positions of the point masses when the shape is a SoftMeshShape, which
+  /// are the vertices of the BVH
+  std::vector<fcl::Vec3f> mSoftMeshVertices;
+
+  /// Version of the voxel grid that the BVH was built from when the shape is a
+  /// VoxelGridShape
+  std::size_t mVoxelGridVersion;
+
+  /// Whether the FCL geometry is empty
+  bool mIsEmpty;
+
 };
 
 }  // namespace collision
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/fcl/FCLMeshGeometryCache.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <tuple>
+
+#include <assimp/scene.h>
+#include <fcl/BVH/BVH_model.h>
+
+#include "dart/common/Timer.hpp"
+#include "dart/dynamics/MeshShape.hpp"
+
+namespace dart {
+namespace collision {
+
+namespace {
+
+//==============================================================================
+template<class BV>
+fcl::BVHModel<BV>* createMesh(float _scaleX, float _scaleY, float _scaleZ,
+                              const aiScene* _mesh)
+{
+  // Create FCL mesh from Assimp mesh
+
+  assert(_mesh);
+  fcl::BVHModel<BV>* model = new fcl::BVHModel<BV>;
+  model->beginModel();
+  for (std::size_t i = 0; i < _mesh->mNumMeshes; i++)
+  {
+    for (std::size_t j = 0; j < _mesh->mMeshes[i]->mNumFaces; j++)
+    {
+      fcl::Vec3f vertices[3];
+      for (std::size_t k = 0; k < 3; k++)
+      {
+        const aiVector3D& vertex
+            = _mesh->mMeshes[i]->mVertices[
+              _mesh->mMeshes[i]->mFaces[j].mIndices[k]];
+        vertices[k] = fcl::Vec3f(vertex.x * _scaleX,
+                                 vertex.y * _scaleY,
+                                 vertex.z * _scaleZ);
+      }
+      model->addTriangle(vertices[0], vertices[1], vertices[2]);
+    }
+  }
+  model->endModel();
+  return model;
+}
+
+//==============================================================================
+void hashBytes(std::uint64_t& hash, const void* data, std::size_t size)
+{
+  // 64-bit FNV-1a
+  const auto bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0u; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+}
+
+//==============================================================================
+std::size_t hashMesh(const aiScene* mesh)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+
+  hashBytes(hash, &mesh->mNumMeshes, sizeof(mesh->mNumMeshes));
+  for (std::size_t i = 0u; i < mesh->mNumMeshes; ++i)
+  {
+    const aiMesh* subMesh = mesh->mMeshes[i];
+
+    hashBytes(hash, &subMesh->mNumVertices, sizeof(subMesh->mNumVertices));
+    hashBytes(hash, subMesh->mVertices,
+              subMesh->mNumVertices * sizeof(aiVector3D));
+
+    hashBytes(hash, &subMesh->mNumFaces, sizeof(subMesh->mNumFaces));
+    for (std::size_t j = 0u; j < subMesh->mNumFaces; ++j)
+    {
+      const aiFace& face = subMesh->mFaces[j];
+      hashBytes(hash, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+    }
+  }
+
+  return static_cast<std::size_t>(hash);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+FCLMeshGeometryCache::Statistics::Statistics()
+  : numEntries(0u),
+    numHits(0u),
+    numMisses(0u),
+    memoryUsage(0u),
+    buildTime(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+FCLMeshGeometryCache& FCLMeshGeometryCache::getInstance()
+{
+  static FCLMeshGeometryCache cache;
+  return cache;
+}
+
+//==============================================================================
+FCLMeshGeometryCache::FCLMeshGeometryCache()
+  : mNumHits(0u),
+    mNumMisses(0u),
+    mBuildTime(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+fcl_shared_ptr<fcl::CollisionGeometry> FCLMeshGeometryCache::claimGeometry(
+    const dynamics::MeshShape* meshShape)
+{
+  assert(meshShape);
+
+  const aiScene* mesh = meshShape->getMesh();
+  const Eigen::Vector3d& scale = meshShape->getScale();
+
+  Key key;
+  key.mUri = meshShape->getMeshUri();
+  key.mScale = scale;
+  key.mHash = hashMesh(mesh);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  auto& entry = mEntries[key];
+
+  auto geom = entry.mGeometry.lock();
+  if (geom)
+  {
+    ++mNumHits;
+    return geom;
+  }
+
+  ++mNumMisses;
+
+  const double startTime = common::Timer::getWallTime();
+  auto model = createMesh<fcl::OBBRSS>(scale[0], scale[1], scale[2], mesh);
+  mBuildTime += common::Timer::getWallTime() - startTime;
+
+  entry.mMemoryUsage = static_cast<std::size_t>(model->memUsage(0));
+  geom.reset(model);
+  entry.mGeometry = geom;
+
+  removeExpiredEntries();
+
+  return geom;
+}
+
+//==============================================================================
+FCLMeshGeometryCache::Statistics FCLMeshGeometryCache::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  Statistics stats;
+  stats.numHits = mNumHits;
+  stats.numMisses = mNumMisses;
+  stats.buildTime = mBuildTime;
+
+  for (const auto& entry : mEntries)
+  {
+    if (entry.second.mGeometry.expired())
+      continue;
+
+    ++stats.numEntries;
+    stats.memoryUsage += entry.second.mMemoryUsage;
+  }
+
+  return stats;
+}
+
+//==============================================================================
+void FCLMeshGeometryCache::resetStatistics()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  mNumHits = 0u;
+  mNumMisses = 0u;
+  mBuildTime = 0.0;
+}
+
+//==============================================================================
+void FCLMeshGeometryCache::removeExpiredEntries()
+{
+  for (auto it = mEntries.begin(); it != mEntries.end();)
+  {
+    if (it->second.mGeometry.expired())
+      it = mEntries.erase(it);
+    else
+      ++it;
+  }
+}
+
+//==============================================================================
+bool FCLMeshGeometryCache::Key::operator<(const Key& other) const
+{
+  return std::tie(mUri, mScale[0], mScale[1], mScale[2], mHash)
+      < std::tie(other.mUri, other.mScale[0], other.mScale[1], other.mScale[2],
+                 other.mHash);
+}
+
+}  // namespace collision
+}  // namespace dart
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_FCL_FCLMESHGEOMETRYCACHE_HPP_
+#define DART_COLLISION_FCL_FCLMESHGEOMETRYCACHE_HPP_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <Eigen/Dense>
+#include <fcl/collision_object.h>
+#include "dart/collision/fcl/FCLTypes.hpp"
+
+namespace dart {
+namespace dynamics {
+class MeshShape;
+}  // namespace dynamics
+
+namespace collision {
+
+/// FCLMeshGeometryCache shares the BVH of MeshShapes among all the
+/// FCLCollisionDetectors of a process. MeshShapes that are loaded from the
+/// same URI, with the same scale and the same mesh contents, get the same
+/// fcl::CollisionGeometry instead of building their own copy, which matters
+/// when the same robot model is instantiated many times.
+///
+/// The cache only holds weak references. A cached BVH is released as soon as
+/// the last collision object that uses it is destroyed.
+class FCLMeshGeometryCache
+{
+public:
+
+  struct Statistics
+  {
+    /// Number of BVHs currently alive in the cache
+    std::size_t numEntries;
+
+    /// Number of requests that were served with an existing BVH
+    std::size_t numHits;
+
+    /// Number of requests that required building a new BVH
+    std::size_t numMisses;
+
+    /// Memory used by the BVHs currently alive in the cache, in bytes
+    std::size_t memoryUsage;
+
+    /// Total time spent on building BVHs, in seconds
+    double buildTime;
+
+    /// Constructor
+    Statistics();
+  };
+
+  /// Return the cache shared by the whole process
+  static FCLMeshGeometryCache& getInstance();
+
+  /// Return the BVH for the mesh of meshShape, building it only if no BVH
+  /// with the same URI, scale, and contents is alive
+  fcl_shared_ptr<fcl::CollisionGeometry> claimGeometry(
+      const dynamics::MeshShape* meshShape);
+
+  /// Return the statistics of this cache
+  Statistics getStatistics() const;
+
+  /// Reset the hit, miss, and build time counters
+  void resetStatistics();
+
+protected:
+
+  /// Constructor
+  FCLMeshGeometryCache();
+
+  /// Remove the entries whose BVHs were already released
+  void removeExpiredEntries();
+
+private:
+
+  struct Key
+  {
+    /// URI of the mesh resource; empty if the mesh was created in memory
+    std::string mUri;
+
+    /// Scale that is baked into the BVH
+    Eigen::Vector3d mScale;
+
+    /// Hash of the vertices and faces of the mesh
+    std::size_t mHash;
+
+    bool operator<(const Key& other) const;
+  };
+
+  struct Entry
+  {
+    fcl_weak_ptr<fcl::CollisionGeometry> mGeometry;
+
+    std::size_t mMemoryUsage;
+  };
+
+  /// Protects all the members below since the cache is shared among
+  /// collision detectors that may be used from different threads
+  mutable std::mutex mMutex;
+
+  std::map<Key, Entry> mEntries;
+
+  std::size_t mNumHits;
+
+  std::size_t mNumMisses;
+
+  double mBuildTime;
+
+};
+
+}  // namespace collision
+}  // namespace dart
+
+#endif  // DART_COLLISION_FCL_FCLMESHGEOMETRYCACHE_HPP_
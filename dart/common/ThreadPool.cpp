@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace dart {
+namespace common {
+
+//==============================================================================
+ThreadPool::ThreadPool(std::size_t numThreads)
+  : mIsStopping(false)
+{
+  const std::size_t numWorkers = numThreads > 1u ? numThreads - 1u : 0u;
+
+  mWorkers.reserve(numWorkers);
+  for (std::size_t i = 0u; i < numWorkers; ++i)
+    mWorkers.emplace_back(&ThreadPool::runWorker, this);
+}
+
+//==============================================================================
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsStopping = true;
+  }
+  mCondition.notify_all();
+
+  for (auto& worker : mWorkers)
+    worker.join();
+}
+
+//==============================================================================
+std::size_t ThreadPool::getNumThreads() const
+{
+  return mWorkers.size() + 1u;
+}
+
+//==============================================================================
+std::size_t ThreadPool::getNumHardwareThreads()
+{
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+//==============================================================================
+void ThreadPool::parallelFor(
+    std::size_t begin,
+    std::size_t end,
+    const std::function<void(std::size_t)>& fn)
+{
+  if (end <= begin)
+    return;
+
+  const std::size_t count = end - begin;
+  const std::size_t numChunks = std::min(count, getNumThreads());
+
+  if (numChunks == 1u)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+      fn(i);
+    return;
+  }
+
+  const auto runChunk = [&](std::size_t chunk)
+  {
+    const std::size_t chunkBegin = begin + count * chunk / numChunks;
+    const std::size_t chunkEnd = begin + count * (chunk + 1u) / numChunks;
+    for (std::size_t i = chunkBegin; i < chunkEnd; ++i)
+      fn(i);
+  };
+
+  // The first chunk is run by the calling thread while the workers take care
+  // of the rest.
+  std::vector<std::future<void>> futures;
+  futures.reserve(numChunks - 1u);
+  for (std::size_t chunk = 1u; chunk < numChunks; ++chunk)
+    futures.push_back(submit(std::bind(runChunk, chunk)));
+
+  std::exception_ptr error;
+  try
+  {
+    runChunk(0u);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  for (auto& future : futures)
+  {
+    try
+    {
+      future.get();
+    }
+    catch (...)
+    {
+      if (!error)
+        error = std::current_exception();
+    }
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+//==============================================================================
+std::future<void> ThreadPool::submit(std::function<void()> task)
+{
+  auto packagedTask
+      = std::make_shared<std::packaged_task<void()>>(std::move(task));
+  std::future<void> future = packagedTask->get_future();
+
+  if (mWorkers.empty())
+  {
+    (*packagedTask)();
+    return future;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTasks.emplace_back([packagedTask]() { (*packagedTask)(); });
+  }
+  mCondition.notify_one();
+
+  return future;
+}
+
+//==============================================================================
+void ThreadPool::runWorker()
+{
+  while (true)
+  {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait(lock, [this]() { return mIsStopping || !mTasks.empty(); });
+
+      if (mTasks.empty())
+        return;
+
+      task = std::move(mTasks.front());
+      mTasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+}  // namespace common
+}  // namespace dart
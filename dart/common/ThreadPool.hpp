@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_THREADPOOL_HPP_
+#define DART_COMMON_THREADPOOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dart {
+namespace common {
+
+/// ThreadPool is a fixed-size pool of worker threads.
+///
+/// The number of threads passed to the constructor counts the calling thread,
+/// so a pool of N threads spawns N-1 workers and the caller of parallelFor()
+/// takes part in the work. A pool of one thread never spawns a worker and runs
+/// every task inline, which makes it a drop-in replacement for a serial loop.
+class ThreadPool
+{
+public:
+  /// Constructor
+  explicit ThreadPool(std::size_t numThreads = 1u);
+
+  /// Destructor. Waits for the queued tasks to finish.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// Return the number of threads including the calling thread
+  std::size_t getNumThreads() const;
+
+  /// Return the number of hardware threads, which is at least one
+  static std::size_t getNumHardwareThreads();
+
+  /// Call fn(i) for every i in [begin, end) and block until all the calls
+  /// have returned. The range is split into contiguous chunks, one per
+  /// thread, so the assignment of indices to threads is deterministic. If any
+  /// call throws, the first exception is rethrown on the calling thread after
+  /// all the chunks have finished.
+  ///
+  /// fn must be safe to call concurrently for distinct indices.
+  void parallelFor(std::size_t begin, std::size_t end,
+                   const std::function<void(std::size_t)>& fn);
+
+  /// Queue a task to be run by a worker thread. If the pool has no workers,
+  /// the task is run immediately on the calling thread.
+  std::future<void> submit(std::function<void()> task);
+
+protected:
+  /// Main loop of the worker threads
+  void runWorker();
+
+  /// Worker threads
+  std::vector<std::thread> mWorkers;
+
+  /// Queued tasks
+  std::deque<std::function<void()>> mTasks;
+
+  /// Protects mTasks and mIsStopping
+  std::mutex mMutex;
+
+  /// Signaled when a task is queued or the pool is stopping
+  std::condition_variable mCondition;
+
+  /// Whether the destructor has been called
+  bool mIsStopping;
+};
+
+}  // namespace common
+}  // namespace dart
+
+#endif  // DART_COMMON_THREADPOOL_HPP_
@@ -58,6 +58,12 @@ std::size_t ConstraintBase::getDimension() const
   return mDim;
 }
 
+//==============================================================================
+bool ConstraintBase::getJacobian(ConstraintJacobian* /*_jacobian*/)
+{
+  return false;
+}
+
 //==============================================================================
 void ConstraintBase::uniteSkeletons()
 {
@@ -88,5 +94,17 @@ dynamics::SkeletonPtr ConstraintBase::getRootSkeleton(
   return _skeleton;
 }
 
+//==============================================================================
+bool ConstraintBase::isFullyDynamic(const dynamics::Skeleton* _skeleton)
+{
+  for (std::size_t i = 0; i < _skeleton->getNumJoints(); ++i)
+  {
+    if (!_skeleton->getJoint(i)->isDynamic())
+      return false;
+  }
+
+  return true;
+}
+
 }  // namespace constraint
 }  // namespace dart
@@ -34,6 +34,8 @@
 
 #include <cstddef>
 
+#include <Eigen/Dense>
+
 #include "dart/dynamics/SmartPointer.hpp"
 
 namespace dart {
@@ -69,6 +71,26 @@ struct ConstraintInfo
   double invTimeStep;
 };
 
+/// ConstraintJacobian is the Jacobian of a constraint w.r.t. the generalized
+/// velocities of the skeletons that the constraint acts on
+struct ConstraintJacobian
+{
+  /// Number of skeletons that the constraint acts on, at most two
+  std::size_t numSkeletons;
+
+  /// Skeletons that the constraint acts on
+  dynamics::Skeleton* skeletons[2];
+
+  /// Jacobians w.r.t. the generalized velocities of the skeletons. Each of
+  /// them has a row per dimension of the constraint and a column per degree of
+  /// freedom of the skeleton.
+  Eigen::MatrixXd jacobians[2];
+
+  /// Constraint force mixing. The diagonal of the LCP matrix is scaled by
+  /// (1 + cfm) to keep it away from singular.
+  double cfm;
+};
+
 /// Constraint is a base class of concrete constraints classes
 class ConstraintBase
 {
@@ -88,6 +110,13 @@ public:
   /// Get velocity change due to the uint impulse
   virtual void getVelocityChange(double* _vel, bool _withCfm) = 0;
 
+  /// Get the Jacobian of this constraint w.r.t. the generalized velocities of
+  /// the reactive skeletons that it acts on. LCP solvers use it to compute the
+  /// LCP matrix as J * M^-1 * J^T instead of applying a unit impulse per
+  /// dimension. Return false if this constraint doesn't provide its Jacobian,
+  /// which is the default.
+  virtual bool getJacobian(ConstraintJacobian* _jacobian);
+
   /// Excite the constraint
   virtual void excite() = 0;
 
@@ -112,6 +141,12 @@ public:
   ///
   static dynamics::SkeletonPtr getRootSkeleton(dynamics::SkeletonPtr _skeleton);
 
+  /// Return true if all the joints of _skeleton are dynamic. The inverse mass
+  /// matrix of a skeleton with motion-prescribed joints doesn't describe its
+  /// response to impulses, so constraints on such a skeleton can't provide a
+  /// Jacobian.
+  static bool isFullyDynamic(const dynamics::Skeleton* _skeleton);
+
   //----------------------------------------------------------------------------
   // Friendship
   //----------------------------------------------------------------------------
@@ -31,6 +31,11 @@
 
 #include "dart/constraint/ConstraintSolver.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <set>
+
 #include "dart/common/Console.hpp"
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/CollisionGroup.hpp"
@@ -38,6 +43,7 @@
 #include "dart/collision/fcl/FCLCollisionDetector.hpp"
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
 #include "dart/dynamics/SoftBodyNode.hpp"
 #include "dart/dynamics/Joint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
@@ -62,8 +68,22 @@ ConstraintSolver::ConstraintSolver(double timeStep)
     mCollisionOption(
       collision::CollisionOption(
         true, 1000u, std::make_shared<collision::BodyNodeCollisionFilter>())),
+    mIsCollisionDetected(false),
     mTimeStep(timeStep),
-    mLCPSolver(new DantzigLCPSolver(mTimeStep))
+    mLCPSolver(new DantzigLCPSolver(mTimeStep)),
+    mLCPMatrixAssembly(LCPSolver::UNIT_IMPULSE),
+    mLastNumLCPAllocations(0u),
+    mIsWarmStartingEnabled(true),
+    mWarmStartingDistance(0.01),
+    mLastNumWarmStartedContacts(0u),
+    mMaxNumContactsPerPair(0u),
+    mLastNumReducedContacts(0u),
+    mLastNumSpeculativeContacts(0u),
+    mLastNumLCPIterations(0u),
+    mLastLCPResidual(0.0),
+    mIsSleepingEnabled(false),
+    mSleepingThreshold(1e-3),
+    mTimeToSleep(0.5)
 {
   assert(timeStep > 0.0);
 
@@ -98,6 +118,7 @@ void ConstraintSolver::addSkeleton(const SkeletonPtr& skeleton)
   }
 
   mCollisionGroup->addShapeFramesOf(skeleton.get());
+  skeleton->mIslandIndex = mSkeletons.size();
   mSkeletons.push_back(skeleton);
   mConstrainedGroups.reserve(mSkeletons.size());
 }
@@ -122,10 +143,38 @@ void ConstraintSolver::removeSkeleton(const SkeletonPtr& skeleton)
            << "', which doesn't exist in the ConstraintSolver.\n";
   }
 
+  // The detected contacts may refer to the removed collision objects
   mCollisionGroup->removeShapeFramesOf(skeleton.get());
+  mIsCollisionDetected = false;
+  mContinuousGroup.reset();
+  mContinuousShapeNodes.clear();
   mSkeletons.erase(remove(mSkeletons.begin(), mSkeletons.end(), skeleton),
                    mSkeletons.end());
+
+  // The addresses of the removed body nodes may be reused by new body nodes,
+  // which must not be warm started with the cached impulses
+  const auto& bodyNodes = skeleton->getBodyNodes();
+  const auto isRemoved = [&](const dynamics::BodyNode* bodyNode)
+  {
+    return std::find(bodyNodes.begin(), bodyNodes.end(), bodyNode)
+        != bodyNodes.end();
+  };
+  mContactImpulses.erase(
+        std::remove_if(mContactImpulses.begin(), mContactImpulses.end(),
+                       [&](const ContactImpulse& contactImpulse)
+                       {
+                         return isRemoved(contactImpulse.bodyNode1)
+                             || isRemoved(contactImpulse.bodyNode2);
+                       }),
+        mContactImpulses.end());
   mConstrainedGroups.reserve(mSkeletons.size());
+
+  // Nothing would wake up the skeleton once it's removed
+  skeleton->setSleeping(false);
+
+  // The islands are indexed by the positions of the skeletons
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    mSkeletons[i]->mIslandIndex = i;
 }
 
 //==============================================================================
@@ -140,7 +189,14 @@ void ConstraintSolver::removeSkeletons(
 void ConstraintSolver::removeAllSkeletons()
 {
   mCollisionGroup->removeAllShapeFrames();
+  mIsCollisionDetected = false;
+  mContinuousGroup.reset();
+  mContinuousShapeNodes.clear();
+
+  for (const auto& skeleton : mSkeletons)
+    skeleton->setSleeping(false);
   mSkeletons.clear();
+  mContactImpulses.clear();
 }
 
 //==============================================================================
@@ -223,6 +279,10 @@ void ConstraintSolver::setCollisionDetector(
   mCollisionDetector = collisionDetector;
 
   mCollisionGroup = mCollisionDetector->createCollisionGroupAsSharedPtr();
+  mIsCollisionDetected = false;
+  mContinuousGroup.reset();
+  mContinuousShapeNodes.clear();
+  mContactImpulses.clear();
 
   for (const auto& skeleton : mSkeletons)
     mCollisionGroup->addShapeFramesOf(skeleton.get());
@@ -272,6 +332,7 @@ void ConstraintSolver::setLCPSolver(std::unique_ptr<LCPSolver> _lcpSolver)
   assert(_lcpSolver && "Invalid LCP solver.");
 
   mLCPSolver = std::move(_lcpSolver);
+  mLCPSolver->setMatrixAssembly(mLCPMatrixAssembly);
 }
 
 //==============================================================================
@@ -280,6 +341,431 @@ LCPSolver* ConstraintSolver::getLCPSolver() const
   return mLCPSolver.get();
 }
 
+//==============================================================================
+void ConstraintSolver::setLCPMatrixAssembly(
+    LCPSolver::MatrixAssembly assembly)
+{
+  mLCPMatrixAssembly = assembly;
+  mLCPSolver->setMatrixAssembly(mLCPMatrixAssembly);
+}
+
+//==============================================================================
+LCPSolver::MatrixAssembly ConstraintSolver::getLCPMatrixAssembly() const
+{
+  return mLCPMatrixAssembly;
+}
+
+//==============================================================================
+void ConstraintSolver::setThreadPool(
+    const std::shared_ptr<common::ThreadPool>& threadPool)
+{
+  mThreadPool = threadPool;
+  mLCPWorkspaces.clear();
+}
+
+//==============================================================================
+std::shared_ptr<common::ThreadPool> ConstraintSolver::getThreadPool() const
+{
+  return mThreadPool;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getLastNumLCPAllocations() const
+{
+  return mLastNumLCPAllocations;
+}
+
+//==============================================================================
+void ConstraintSolver::setWarmStartingEnabled(bool enabled)
+{
+  mIsWarmStartingEnabled = enabled;
+
+  if (!mIsWarmStartingEnabled)
+    mContactImpulses.clear();
+}
+
+//==============================================================================
+bool ConstraintSolver::isWarmStartingEnabled() const
+{
+  return mIsWarmStartingEnabled;
+}
+
+//==============================================================================
+void ConstraintSolver::setWarmStartingDistance(double distance)
+{
+  assert(distance >= 0.0);
+  mWarmStartingDistance = distance;
+}
+
+//==============================================================================
+double ConstraintSolver::getWarmStartingDistance() const
+{
+  return mWarmStartingDistance;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getLastNumWarmStartedContacts() const
+{
+  return mLastNumWarmStartedContacts;
+}
+
+//==============================================================================
+void ConstraintSolver::setMaxNumContactsPerPair(std::size_t maxNumContacts)
+{
+  mMaxNumContactsPerPair = maxNumContacts;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getMaxNumContactsPerPair() const
+{
+  return mMaxNumContactsPerPair;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getLastNumReducedContacts() const
+{
+  return mLastNumReducedContacts;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getLastNumSpeculativeContacts() const
+{
+  return mLastNumSpeculativeContacts;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getLastNumLCPIterations() const
+{
+  return mLastNumLCPIterations;
+}
+
+//==============================================================================
+double ConstraintSolver::getLastLCPResidual() const
+{
+  return mLastLCPResidual;
+}
+
+//==============================================================================
+void ConstraintSolver::setSleepingEnabled(bool enabled)
+{
+  mIsSleepingEnabled = enabled;
+
+  if (!mIsSleepingEnabled)
+  {
+    for (const auto& skeleton : mSkeletons)
+      skeleton->setSleeping(false);
+  }
+}
+
+//==============================================================================
+bool ConstraintSolver::isSleepingEnabled() const
+{
+  return mIsSleepingEnabled;
+}
+
+//==============================================================================
+void ConstraintSolver::setSleepingThreshold(double threshold)
+{
+  assert(threshold >= 0.0);
+  mSleepingThreshold = threshold;
+}
+
+//==============================================================================
+double ConstraintSolver::getSleepingThreshold() const
+{
+  return mSleepingThreshold;
+}
+
+//==============================================================================
+void ConstraintSolver::setTimeToSleep(double time)
+{
+  assert(time >= 0.0);
+  mTimeToSleep = time;
+}
+
+//==============================================================================
+double ConstraintSolver::getTimeToSleep() const
+{
+  return mTimeToSleep;
+}
+
+//==============================================================================
+/// Return true if something other than the constraint solver has changed the
+/// state or the inputs of a sleeping skeleton. This runs for every sleeping
+/// skeleton on every step, so the DOFs are compared in place.
+static bool isDisturbed(const Skeleton* skel)
+{
+  const std::size_t numDofs = skel->getNumDofs();
+  if (static_cast<std::size_t>(skel->mSleepingPositions.size()) != numDofs)
+    return true;
+
+  for (std::size_t i = 0u; i < numDofs; ++i)
+  {
+    const DegreeOfFreedom* dof = skel->getDof(i);
+    if (dof->getPosition() != skel->mSleepingPositions[i]
+        || dof->getVelocity() != 0.0
+        || dof->getForce() != 0.0
+        || dof->getCommand() != 0.0)
+    {
+      return true;
+    }
+  }
+
+  for (std::size_t i = 0u; i < skel->getNumBodyNodes(); ++i)
+  {
+    if (!skel->getBodyNode(i)->getExternalForceLocal().isZero(0.0))
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+void ConstraintSolver::updateSleepingSkeletons()
+{
+  if (!mIsSleepingEnabled)
+    return;
+
+  const std::size_t numSkeletons = mSkeletons.size();
+  mIslandRestingTimes.assign(
+        numSkeletons, std::numeric_limits<double>::infinity());
+
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    Skeleton* skel = mSkeletons[i].get();
+
+    if (!skel->isMobile() || skel->getNumDofs() == 0u)
+      continue;
+
+    if (skel->isSleeping())
+    {
+      if (!isDisturbed(skel))
+        continue;
+
+      skel->setSleeping(false);
+    }
+    else if (skel->computeKineticEnergy()
+             <= mSleepingThreshold * skel->getMass())
+    {
+      skel->mRestingTime += mTimeStep;
+    }
+    else
+    {
+      skel->mRestingTime = 0.0;
+    }
+
+    double& islandRestingTime = mIslandRestingTimes[skel->mIslandIndex];
+    islandRestingTime = std::min(islandRestingTime, skel->mRestingTime);
+  }
+
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    Skeleton* skel = mSkeletons[i].get();
+
+    if (!skel->isMobile() || skel->getNumDofs() == 0u || skel->isSleeping())
+      continue;
+
+    if (mIslandRestingTimes[skel->mIslandIndex] >= mTimeToSleep)
+      skel->setSleeping(true);
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::detectCollision()
+{
+  mCollisionResult.clear();
+
+  mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
+
+  mLastNumReducedContacts = 0u;
+  if (mMaxNumContactsPerPair > 0u)
+  {
+    mLastNumReducedContacts
+        = mCollisionResult.reduceContacts(mMaxNumContactsPerPair);
+  }
+
+  mIsCollisionDetected = true;
+}
+
+//==============================================================================
+/// Largest number of poses at which a Skeleton is sampled in one time step
+static constexpr std::size_t MAX_NUM_SWEEP_SAMPLES = 16u;
+
+//==============================================================================
+/// Return the pair of BodyNodes of the contact in the order of their addresses
+static std::pair<const BodyNode*, const BodyNode*> getBodyNodePair(
+    const collision::Contact& contact)
+{
+  const BodyNode* bodyNode1 = contact.collisionObject1->getShapeFrame()
+      ->asShapeNode()->getBodyNodePtr().get();
+  const BodyNode* bodyNode2 = contact.collisionObject2->getShapeFrame()
+      ->asShapeNode()->getBodyNodePtr().get();
+
+  if (bodyNode2 < bodyNode1)
+    std::swap(bodyNode1, bodyNode2);
+
+  return std::make_pair(bodyNode1, bodyNode2);
+}
+
+//==============================================================================
+void ConstraintSolver::addSpeculativeContacts()
+{
+  mSpeculativeContacts.clear();
+  mLastNumSpeculativeContacts = 0u;
+
+  // Collect the continuous ShapeNodes of the Skeletons that can be swept,
+  // along with the range of the ShapeNodes of each Skeleton
+  std::vector<const ShapeNode*> shapeNodes;
+  std::vector<std::size_t> ranges(mSkeletons.size() + 1u, 0u);
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    const Skeleton* skel = mSkeletons[i].get();
+    if (skel->getNumSoftBodyNodes() == 0u)
+    {
+      for (std::size_t j = 0u; j < skel->getNumShapeNodes(); ++j)
+      {
+        const ShapeNode* shapeNode = skel->getShapeNode(j);
+        const CollisionAspect* aspect = shapeNode->getCollisionAspect();
+        if (aspect && aspect->isContinuous() && shapeNode->getShape())
+          shapeNodes.push_back(shapeNode);
+      }
+    }
+
+    ranges[i + 1u] = shapeNodes.size();
+  }
+
+  if (shapeNodes.empty())
+  {
+    mContinuousGroup.reset();
+    mContinuousShapeNodes.clear();
+    return;
+  }
+
+  if (!mContinuousGroup || shapeNodes != mContinuousShapeNodes)
+  {
+    mContinuousGroup = mCollisionDetector->createCollisionGroupAsSharedPtr();
+    for (const ShapeNode* shapeNode : shapeNodes)
+      mContinuousGroup->addShapeFrame(shapeNode);
+    mContinuousShapeNodes = shapeNodes;
+  }
+
+  // The pairs of BodyNodes that are already in contact
+  std::set<std::pair<const BodyNode*, const BodyNode*>> pairs;
+  for (const auto& contact : mCollisionResult.getContacts())
+    pairs.insert(getBodyNodePair(contact));
+
+  Eigen::aligned_vector<Eigen::Isometry3d> transforms;
+  std::set<std::pair<const BodyNode*, const BodyNode*>> newPairs;
+
+  for (std::size_t s = 0u; s < mSkeletons.size(); ++s)
+  {
+    Skeleton* skel = mSkeletons[s].get();
+    const std::size_t first = ranges[s];
+    const std::size_t last = ranges[s + 1u];
+
+    if (first == last || !skel->isMobile() || skel->getNumDofs() == 0u
+        || (mIsSleepingEnabled && skel->isSleeping()))
+    {
+      continue;
+    }
+
+    const Eigen::VectorXd positions = skel->getPositions();
+
+    transforms.clear();
+    for (std::size_t i = first; i < last; ++i)
+      transforms.push_back(shapeNodes[i]->getWorldTransform());
+
+    // Sample the motion finely enough that each ShapeNode moves less than half
+    // of its smallest extent between the samples
+    skel->integratePositions(mTimeStep);
+    std::size_t numSamples = 0u;
+    for (std::size_t i = first; i < last; ++i)
+    {
+      const Eigen::Isometry3d& T0 = transforms[i - first];
+      const Eigen::Isometry3d& T1 = shapeNodes[i]->getWorldTransform();
+      const math::BoundingBox& box
+          = shapeNodes[i]->getShape()->getBoundingBox();
+      const double extent = box.computeFullExtents().minCoeff();
+      if (!(extent > 0.0))
+        continue;
+
+      const Eigen::AngleAxisd rotation(T0.linear().transpose() * T1.linear());
+      const double displacement
+          = (T1.translation() - T0.translation()).norm()
+            + std::abs(rotation.angle())
+              * box.computeHalfExtents().norm();
+
+      numSamples = std::max(numSamples, static_cast<std::size_t>(
+          std::ceil(displacement / (0.5 * extent))));
+    }
+    numSamples = std::min(numSamples, MAX_NUM_SWEEP_SAMPLES);
+
+    for (std::size_t k = 1u; k <= numSamples; ++k)
+    {
+      skel->setPositions(positions);
+      skel->integratePositions(mTimeStep * k / numSamples);
+
+      mContinuousResult.clear();
+      mContinuousGroup->collide(
+            mCollisionGroup.get(), mCollisionOption, &mContinuousResult);
+      if (mMaxNumContactsPerPair > 0u)
+        mContinuousResult.reduceContacts(mMaxNumContactsPerPair);
+
+      newPairs.clear();
+      for (const auto& contact : mContinuousResult.getContacts())
+      {
+        const ShapeNode* shapeNode1
+            = contact.collisionObject1->getShapeFrame()->asShapeNode();
+        const ShapeNode* shapeNode2
+            = contact.collisionObject2->getShapeFrame()->asShapeNode();
+
+        // Only the contacts between a swept ShapeNode and another Skeleton
+        const bool isSwept1 = shapeNode1->getSkeleton().get() == skel;
+        const bool isSwept2 = shapeNode2->getSkeleton().get() == skel;
+        if (isSwept1 == isSwept2)
+          continue;
+
+        const ShapeNode* swept = isSwept1 ? shapeNode1 : shapeNode2;
+        const auto it = std::find(shapeNodes.begin() + first,
+                                  shapeNodes.begin() + last, swept);
+        if (it == shapeNodes.begin() + last)
+          continue;
+
+        const auto pair = getBodyNodePair(contact);
+        if (pairs.count(pair) || isSoftContact(contact))
+          continue;
+
+        newPairs.insert(pair);
+
+        // Move the contact point back with the swept ShapeNode. The normal
+        // points from the second object to the first one, so the gap is the
+        // distance that the objects travel toward each other along the normal
+        // minus the penetration depth at the sampled pose.
+        const Eigen::Isometry3d& T0 = transforms[it - shapeNodes.begin()
+                                                 - first];
+        const Eigen::Vector3d point
+            = T0 * swept->getWorldTransform().inverse() * contact.point;
+        const Eigen::Vector3d travel = contact.point - point;
+        const double approach = isSwept1 ? -travel.dot(contact.normal)
+                                         : travel.dot(contact.normal);
+        const double gap = approach - contact.penetrationDepth;
+
+        collision::Contact speculativeContact = contact;
+        speculativeContact.point = point;
+        speculativeContact.penetrationDepth = -std::max(gap, 0.0);
+        mSpeculativeContacts.push_back(speculativeContact);
+      }
+
+      // Only the earliest contacts between two BodyNodes are kept
+      pairs.insert(newPairs.begin(), newPairs.end());
+    }
+
+    skel->setPositions(positions);
+  }
+
+  mLastNumSpeculativeContacts = mSpeculativeContacts.size();
+}
+
 //==============================================================================
 void ConstraintSolver::solve()
 {
@@ -299,6 +785,10 @@ DART_SUPPRESS_DEPRECATED_END
 
   // Solve constrained groups
   solveConstrainedGroups();
+
+  // Keep the contact impulses to warm start the next step
+  if (mIsWarmStartingEnabled)
+    cacheContactImpulses();
 }
 
 //==============================================================================
@@ -377,9 +867,17 @@ void ConstraintSolver::updateConstraints()
   //----------------------------------------------------------------------------
   // Update automatic constraints: contact constraints
   //----------------------------------------------------------------------------
-  mCollisionResult.clear();
+  if (!mIsCollisionDetected)
+    detectCollision();
 
-  mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
+  mIsCollisionDetected = false;
+
+  // The sweep moves the Skeletons, so it can't run concurrently with the
+  // forward dynamics like detectCollision()
+  addSpeculativeContacts();
+
+  if (mIsSleepingEnabled)
+    updateIslands();
 
   // Destroy previous contact constraints
   mContactConstraints.clear();
@@ -387,21 +885,37 @@ void ConstraintSolver::updateConstraints()
   // Destroy previous soft contact constraints
   mSoftContactConstraints.clear();
 
-  // Create new contact constraints
-  for (auto i = 0u; i < mCollisionResult.getNumContacts(); ++i)
+  // Create new contact constraints. The speculative contacts follow the
+  // detected ones, but their bodies aren't colliding yet.
+  const std::size_t numContacts = mCollisionResult.getNumContacts();
+  for (auto i = 0u; i < numContacts + mSpeculativeContacts.size(); ++i)
   {
-    auto& ct = mCollisionResult.getContact(i);
+    const bool isSpeculative = i >= numContacts;
+    auto& ct = isSpeculative ? mSpeculativeContacts[i - numContacts]
+                             : mCollisionResult.getContact(i);
 
-    // Set colliding bodies
     auto shapeFrame1 = const_cast<dynamics::ShapeFrame*>(
           ct.collisionObject1->getShapeFrame());
     auto shapeFrame2 = const_cast<dynamics::ShapeFrame*>(
           ct.collisionObject2->getShapeFrame());
 
+    // Set colliding bodies
+    if (!isSpeculative)
+    {
 DART_SUPPRESS_DEPRECATED_BEGIN
-    shapeFrame1->asShapeNode()->getBodyNodePtr()->setColliding(true);
-    shapeFrame2->asShapeNode()->getBodyNodePtr()->setColliding(true);
+      shapeFrame1->asShapeNode()->getBodyNodePtr()->setColliding(true);
+      shapeFrame2->asShapeNode()->getBodyNodePtr()->setColliding(true);
 DART_SUPPRESS_DEPRECATED_END
+    }
+
+    // A sleeping skeleton can only be touching other sleeping or immobile
+    // skeletons at this point, so there is nothing to solve
+    if (mIsSleepingEnabled
+        && (shapeFrame1->asShapeNode()->getSkeleton()->isSleeping()
+            || shapeFrame2->asShapeNode()->getSkeleton()->isSleeping()))
+    {
+      continue;
+    }
 
     if (isSoftContact(ct))
     {
@@ -415,6 +929,11 @@ DART_SUPPRESS_DEPRECATED_END
     }
   }
 
+  // Start the contact constraints from the impulses of the previous step
+  mLastNumWarmStartedContacts = 0u;
+  if (mIsWarmStartingEnabled)
+    warmStartContactConstraints();
+
   // Add the new contact constraints to dynamic constraint list
   for (const auto& contactConstraint : mContactConstraints)
   {
@@ -444,6 +963,9 @@ DART_SUPPRESS_DEPRECATED_END
   // Create new joint constraints
   for (const auto& skel : mSkeletons)
   {
+    if (mIsSleepingEnabled && skel->isSleeping())
+      continue;
+
     const std::size_t numJoints = skel->getNumJoints();
     for (std::size_t i = 0; i < numJoints; i++)
     {
@@ -499,6 +1021,89 @@ DART_SUPPRESS_DEPRECATED_END
   }
 }
 
+//==============================================================================
+/// Merge the unions of two skeletons in the same way the constraints do in
+/// ConstraintBase::uniteSkeletons()
+static void uniteSkeletons(const SkeletonPtr& skel1, const SkeletonPtr& skel2)
+{
+  SkeletonPtr root1 = ConstraintBase::compressPath(skel1);
+  SkeletonPtr root2 = ConstraintBase::compressPath(skel2);
+
+  if (root1 == root2)
+    return;
+
+  if (root1->mUnionSize < root2->mUnionSize)
+  {
+    root1->mUnionRootSkeleton = root2;
+    root2->mUnionSize += root1->mUnionSize;
+  }
+  else
+  {
+    root2->mUnionRootSkeleton = root1;
+    root1->mUnionSize += root2->mUnionSize;
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::updateIslands()
+{
+  const std::size_t numSkeletons = mSkeletons.size();
+
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+    mSkeletons[i]->mUnionIndex = i;
+
+  // Unite the skeletons in contact, including the sleeping ones, whose
+  // contact constraints are never created
+  const auto uniteContact = [](const collision::Contact& contact)
+  {
+    BodyNode* bodyNode1 = const_cast<dynamics::ShapeFrame*>(
+          contact.collisionObject1->getShapeFrame())->asShapeNode()
+        ->getBodyNodePtr().get();
+    BodyNode* bodyNode2 = const_cast<dynamics::ShapeFrame*>(
+          contact.collisionObject2->getShapeFrame())->asShapeNode()
+        ->getBodyNodePtr().get();
+
+    if (bodyNode1->isReactive() && bodyNode2->isReactive())
+      uniteSkeletons(bodyNode1->getSkeleton(), bodyNode2->getSkeleton());
+  };
+
+  for (const auto& contact : mCollisionResult.getContacts())
+    uniteContact(contact);
+
+  for (const auto& contact : mSpeculativeContacts)
+    uniteContact(contact);
+
+  // Only the manual constraints have been activated so far
+  for (const auto& constraint : mActiveConstraints)
+    constraint->uniteSkeletons();
+
+  mIsIslandAwake.assign(numSkeletons, false);
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    const SkeletonPtr& skel = mSkeletons[i];
+    skel->mIslandIndex = ConstraintBase::compressPath(skel)->mUnionIndex;
+
+    if (skel->isMobile() && skel->getNumDofs() > 0u && !skel->isSleeping())
+      mIsIslandAwake[skel->mIslandIndex] = true;
+  }
+
+  // Wake up the sleeping skeletons that are touched by awake ones
+  for (const auto& skel : mSkeletons)
+  {
+    if (skel->isSleeping() && mIsIslandAwake[skel->mIslandIndex])
+      skel->setSleeping(false);
+  }
+
+  mActiveConstraints.erase(
+        std::remove_if(mActiveConstraints.begin(), mActiveConstraints.end(),
+                       [](const ConstraintBasePtr& constraint)
+                       { return constraint->getRootSkeleton()->isSleeping(); }),
+        mActiveConstraints.end());
+
+  for (const auto& skel : mSkeletons)
+    skel->resetUnion();
+}
+
 //==============================================================================
 void ConstraintSolver::buildConstrainedGroups()
 {
@@ -568,13 +1173,193 @@ void ConstraintSolver::buildConstrainedGroups()
 //==============================================================================
 void ConstraintSolver::solveConstrainedGroups()
 {
-  for (std::vector<ConstrainedGroup>::iterator it = mConstrainedGroups.begin();
-       it != mConstrainedGroups.end(); ++it)
+  const std::size_t numGroups = mConstrainedGroups.size();
+  // Solvers that don't declare themselves thread safe may keep state in
+  // solve(), so their groups are solved one after another
+  const std::size_t numThreads
+      = (mThreadPool && mLCPSolver->isThreadSafe())
+        ? std::min(mThreadPool->getNumThreads(), numGroups) : 1u;
+
+  const std::size_t numAllocations = countLCPAllocations();
+
+  LCPWorkspace& serialWorkspace = mLCPSolver->getWorkspace();
+  serialWorkspace.resetStatistics();
+
+  if (numThreads <= 1u)
   {
-    mLCPSolver->solve(&(*it));
+    for (std::vector<ConstrainedGroup>::iterator it = mConstrainedGroups.begin();
+         it != mConstrainedGroups.end(); ++it)
+    {
+      mLCPSolver->solve(&(*it));
+    }
+
+    mLastNumLCPAllocations = countLCPAllocations() - numAllocations;
+    mLastNumLCPIterations = serialWorkspace.numIterations;
+    mLastLCPResidual = serialWorkspace.residual;
+    return;
+  }
+
+  if (mLCPWorkspaces.size() < numThreads)
+    mLCPWorkspaces.resize(numThreads);
+
+  for (auto& workspace : mLCPWorkspaces)
+    workspace.resetStatistics();
+
+  // Each thread solves a contiguous range of groups with its own workspace.
+  // The groups are disjoint, so the threads never touch the same Skeleton.
+  mThreadPool->parallelFor(0u, numThreads, [&](std::size_t thread)
+  {
+    const std::size_t begin = numGroups * thread / numThreads;
+    const std::size_t end = numGroups * (thread + 1u) / numThreads;
+    for (std::size_t i = begin; i < end; ++i)
+      mLCPSolver->solve(&mConstrainedGroups[i], &mLCPWorkspaces[thread]);
+  });
+
+  mLastNumLCPAllocations = countLCPAllocations() - numAllocations;
+  mLastNumLCPIterations = 0u;
+  mLastLCPResidual = 0.0;
+  for (const auto& workspace : mLCPWorkspaces)
+  {
+    mLastNumLCPIterations += workspace.numIterations;
+    mLastLCPResidual = std::max(mLastLCPResidual, workspace.residual);
   }
 }
 
+//==============================================================================
+std::size_t ConstraintSolver::countLCPAllocations() const
+{
+  std::size_t numAllocations = mLCPSolver->getWorkspace().getNumAllocations();
+  for (const auto& workspace : mLCPWorkspaces)
+    numAllocations += workspace.getNumAllocations();
+
+  return numAllocations;
+}
+
+//==============================================================================
+namespace {
+
+//==============================================================================
+bool lessBodyNodePair(
+    const dynamics::BodyNode* bodyNodeA1, const dynamics::BodyNode* bodyNodeA2,
+    const dynamics::BodyNode* bodyNodeB1, const dynamics::BodyNode* bodyNodeB2)
+{
+  const std::less<const dynamics::BodyNode*> less;
+
+  if (less(bodyNodeA1, bodyNodeB1))
+    return true;
+
+  if (less(bodyNodeB1, bodyNodeA1))
+    return false;
+
+  return less(bodyNodeA2, bodyNodeB2);
+}
+
+}  // anonymous namespace
+
+//==============================================================================
+void ConstraintSolver::warmStartContactConstraints()
+{
+  if (mContactImpulses.empty())
+    return;
+
+  const double squaredDistance = mWarmStartingDistance * mWarmStartingDistance;
+
+  for (const auto& contactConstraint : mContactConstraints)
+  {
+    const dynamics::BodyNode* bodyNode1 = contactConstraint->mBodyNode1;
+    const dynamics::BodyNode* bodyNode2 = contactConstraint->mBodyNode2;
+
+    // The cache stores the impulse acting on the body with the smaller address
+    double sign = 1.0;
+    if (std::less<const dynamics::BodyNode*>()(bodyNode2, bodyNode1))
+    {
+      std::swap(bodyNode1, bodyNode2);
+      sign = -1.0;
+    }
+
+    const auto range = std::equal_range(
+          mContactImpulses.begin(), mContactImpulses.end(),
+          ContactImpulse{bodyNode1, bodyNode2,
+                         Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero()},
+          [](const ContactImpulse& a, const ContactImpulse& b)
+          {
+            return lessBodyNodePair(
+                  a.bodyNode1, a.bodyNode2, b.bodyNode1, b.bodyNode2);
+          });
+
+    // TODO(JS): Assumed single contact
+    const Eigen::Vector3d& point = contactConstraint->mContacts[0]->point;
+
+    const ContactImpulse* closest = nullptr;
+    double closestSquaredDistance = 0.0;
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      const double distance = (it->point - point).squaredNorm();
+      if (distance <= squaredDistance
+          && (!closest || distance < closestSquaredDistance))
+      {
+        closest = &(*it);
+        closestSquaredDistance = distance;
+      }
+    }
+
+    if (closest)
+    {
+      contactConstraint->setInitialImpulse(sign * closest->impulse);
+      ++mLastNumWarmStartedContacts;
+    }
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::cacheContactImpulses()
+{
+  mContactImpulses.clear();
+
+  for (const auto& contactConstraint : mContactConstraints)
+  {
+    // TODO(JS): Assumed single contact
+    const collision::Contact* contact = contactConstraint->mContacts[0];
+    if (contact->force.isZero())
+      continue;
+
+    ContactImpulse contactImpulse{
+      contactConstraint->mBodyNode1, contactConstraint->mBodyNode2,
+      contact->point, contact->force * mTimeStep};
+
+    if (std::less<const dynamics::BodyNode*>()(
+          contactImpulse.bodyNode2, contactImpulse.bodyNode1))
+    {
+      std::swap(contactImpulse.bodyNode1, contactImpulse.bodyNode2);
+      contactImpulse.impulse = -contactImpulse.impulse;
+    }
+
+    mContactImpulses.push_back(contactImpulse);
+  }
+
+  // The points break the ties so that the order doesn't depend on the sorting
+  // algorithm
+  std::sort(mContactImpulses.begin(), mContactImpulses.end(),
+            [](const ContactImpulse& a, const ContactImpulse& b)
+            {
+              if (lessBodyNodePair(
+                    a.bodyNode1, a.bodyNode2, b.bodyNode1, b.bodyNode2))
+              {
+                return true;
+              }
+
+              if (lessBodyNodePair(
+                    b.bodyNode1, b.bodyNode2, a.bodyNode1, a.bodyNode2))
+              {
+                return false;
+              }
+
+              return std::lexicographical_compare(
+                    a.point.data(), a.point.data() + 3,
+                    b.point.data(), b.point.data() + 3);
+            });
+}
+
 //==============================================================================
 bool ConstraintSolver::isSoftContact(const collision::Contact& contact) const
 {
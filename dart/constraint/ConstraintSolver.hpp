@@ -37,13 +37,16 @@
 #include <Eigen/Dense>
 
 #include "dart/common/Deprecated.hpp"
+#include "dart/common/ThreadPool.hpp"
 #include "dart/constraint/SmartPointer.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
+#include "dart/constraint/LCPSolver.hpp"
 #include "dart/collision/CollisionDetector.hpp"
 
 namespace dart {
 
 namespace dynamics {
+class BodyNode;
 class Skeleton;
 class ShapeNodeCollisionObject;
 }  // namespace dynamics
@@ -134,6 +137,128 @@ public:
   /// Get LCP solver
   LCPSolver* getLCPSolver() const;
 
+  /// Set the method that the LCP solver uses to compute the LCP matrix. The
+  /// method is kept when the LCP solver is replaced. The default is
+  /// LCPSolver::UNIT_IMPULSE.
+  void setLCPMatrixAssembly(LCPSolver::MatrixAssembly assembly);
+
+  /// Get the method that the LCP solver uses to compute the LCP matrix
+  LCPSolver::MatrixAssembly getLCPMatrixAssembly() const;
+
+  /// Set the thread pool that is used to solve the constrained groups. The
+  /// groups don't share any Skeleton, so when the pool has more than one
+  /// thread the groups are distributed over the threads and solved
+  /// concurrently, each thread with its own LCPWorkspace. The impulses are the
+  /// same as the ones of the serial solve. LCP solvers whose isThreadSafe()
+  /// returns false still solve the groups one by one. Passing nullptr solves
+  /// the groups one by one on the calling thread, which is the default.
+  void setThreadPool(const std::shared_ptr<common::ThreadPool>& threadPool);
+
+  /// Get the thread pool that is used to solve the constrained groups
+  std::shared_ptr<common::ThreadPool> getThreadPool() const;
+
+  /// Return the number of times the LCP scratch memory was allocated during
+  /// the last call of solve(). The scratch memory persists across the steps,
+  /// so this is zero once the largest constrained group has been solved.
+  std::size_t getLastNumLCPAllocations() const;
+
+  /// Set whether the contact impulses of the previous step are used as the
+  /// initial guess of the LCP solver. A contact is matched to the closest
+  /// contact of the previous step between the same pair of bodies, if it is
+  /// within the warm starting distance. Only iterative LCP solvers like
+  /// PGSLCPSolver benefit from this. Enabled by default.
+  void setWarmStartingEnabled(bool enabled);
+
+  /// Return true if the LCP solver is warm started with the contact impulses of
+  /// the previous step
+  bool isWarmStartingEnabled() const;
+
+  /// Set the maximum distance between two contact points to be considered as
+  /// the same contact in consecutive steps
+  void setWarmStartingDistance(double distance);
+
+  /// Get the maximum distance between two contact points to be considered as
+  /// the same contact in consecutive steps
+  double getWarmStartingDistance() const;
+
+  /// Return the number of contacts that were warm started in the last call of
+  /// solve()
+  std::size_t getLastNumWarmStartedContacts() const;
+
+  /// Set the maximum number of contacts kept between each pair of bodies once
+  /// the collision detection is done, see CollisionResult::reduceContacts().
+  /// Mesh-on-mesh collisions can produce dozens of nearly coincident contacts
+  /// per pair, which make the LCP much larger without changing the motion.
+  /// Zero keeps all the contacts, which is the default.
+  void setMaxNumContactsPerPair(std::size_t maxNumContacts);
+
+  /// Get the maximum number of contacts kept between each pair of bodies, or
+  /// zero if all the contacts are kept
+  std::size_t getMaxNumContactsPerPair() const;
+
+  /// Return the number of contacts that were removed by the contact reduction
+  /// in the last collision detection
+  std::size_t getLastNumReducedContacts() const;
+
+  /// Return the number of speculative contacts that were created in the last
+  /// call of solve(). The ShapeNodes whose CollisionAspect is continuous are
+  /// swept from their current poses to the poses that the current velocities
+  /// of their Skeletons lead to in one time step. A contact found ahead of a
+  /// ShapeNode becomes a contact constraint with a negative penetration depth,
+  /// whose magnitude is the gap that the bodies may close in this step. This
+  /// keeps fast bodies from tunnelling through thin objects at coarse time
+  /// steps. Skeletons with soft bodies are not swept. The speculative contacts
+  /// are not part of getLastCollisionResult(), since their bodies aren't
+  /// touching yet.
+  std::size_t getLastNumSpeculativeContacts() const;
+
+  /// Return the total number of iterations that the LCP solver spent on the
+  /// constrained groups in the last call of solve()
+  std::size_t getLastNumLCPIterations() const;
+
+  /// Return the largest residual of the LCPs of the constrained groups in the
+  /// last call of solve(). See LCPWorkspace::residual.
+  double getLastLCPResidual() const;
+
+  /// Set whether resting Skeletons are put to sleep. The Skeletons that touch
+  /// each other or are linked by a constraint form an island, which is put to
+  /// sleep once all of its Skeletons have been resting for the time to sleep.
+  /// World::step() skips the dynamics of sleeping Skeletons, and their
+  /// constraints are not solved. A sleeping island wakes up when an awake
+  /// Skeleton touches it, or when one of its Skeletons is given a force, a
+  /// command, a velocity or new positions. Disabled by default.
+  void setSleepingEnabled(bool enabled);
+
+  /// Return true if resting Skeletons are put to sleep
+  bool isSleepingEnabled() const;
+
+  /// Set the kinetic energy per unit mass below which a Skeleton is resting
+  void setSleepingThreshold(double threshold);
+
+  /// Get the kinetic energy per unit mass below which a Skeleton is resting
+  double getSleepingThreshold() const;
+
+  /// Set how long all the Skeletons of an island need to be resting before the
+  /// island is put to sleep
+  void setTimeToSleep(double time);
+
+  /// Get how long all the Skeletons of an island need to be resting before the
+  /// island is put to sleep
+  double getTimeToSleep() const;
+
+  /// Wake up the sleeping Skeletons that have been disturbed and put the
+  /// islands that have been resting long enough to sleep. World::step() calls
+  /// this before computing the dynamics. Does nothing unless sleeping is
+  /// enabled.
+  void updateSleepingSkeletons();
+
+  /// Run the collision detection on the current positions of the Skeletons
+  /// and keep the result for the next call of solve(), which then skips its
+  /// own collision detection. The positions must not change in between, but
+  /// the velocities may, so World::step() can run this concurrently with the
+  /// forward dynamics.
+  void detectCollision();
+
   /// Solve constraint impulses and apply them to the skeletons
   void solve();
 
@@ -153,12 +278,31 @@ private:
   /// Update constraints
   void updateConstraints();
 
+  /// Sweep the continuous ShapeNodes over the time step and collect the
+  /// speculative contacts in mSpeculativeContacts
+  void addSpeculativeContacts();
+
+  /// Unite the Skeletons in contact into islands, wake up the sleeping islands
+  /// that are touched by awake Skeletons and drop the manual constraints of
+  /// the islands that remain sleeping
+  void updateIslands();
+
   /// Build constrained groupsContact
   void buildConstrainedGroups();
 
   /// Solve constrained groups
   void solveConstrainedGroups();
 
+  /// Return the total number of allocations of the LCP scratch memory
+  std::size_t countLCPAllocations() const;
+
+  /// Set the initial impulses of the contact constraints to the matching
+  /// impulses of the previous step
+  void warmStartContactConstraints();
+
+  /// Store the impulses of the contact constraints for the next step
+  void cacheContactImpulses();
+
   /// Return true if at least one of colliding body is soft body
   bool isSoftContact(const collision::Contact& _contact) const;
 
@@ -176,6 +320,10 @@ private:
   /// Last collision checking result
   collision::CollisionResult mCollisionResult;
 
+  /// Whether mCollisionResult was computed by detectCollision() for the
+  /// upcoming solve()
+  bool mIsCollisionDetected;
+
   /// Time step
   double mTimeStep;
 
@@ -208,6 +356,94 @@ private:
 
   /// Constraint group list
   std::vector<ConstrainedGroup> mConstrainedGroups;
+
+  /// Thread pool used to solve the constrained groups concurrently
+  std::shared_ptr<common::ThreadPool> mThreadPool;
+
+  /// Scratch memory of the LCP solver, one per thread of mThreadPool
+  std::vector<LCPWorkspace> mLCPWorkspaces;
+
+  /// Method to compute the LCP matrix
+  LCPSolver::MatrixAssembly mLCPMatrixAssembly;
+
+  /// Number of LCP scratch memory allocations during the last solve()
+  std::size_t mLastNumLCPAllocations;
+
+  /// Contact impulse of a previous step
+  struct ContactImpulse
+  {
+    /// Body with the smaller address. The body nodes are only compared and
+    /// never dereferenced. The entries of a skeleton are dropped when it is
+    /// removed from the solver.
+    const dynamics::BodyNode* bodyNode1;
+
+    /// Body with the larger address
+    const dynamics::BodyNode* bodyNode2;
+
+    /// Contact point w.r.t. the world frame
+    Eigen::Vector3d point;
+
+    /// Contact impulse acting on bodyNode1 w.r.t. the world frame
+    Eigen::Vector3d impulse;
+  };
+
+  /// Whether the contact constraints are warm started
+  bool mIsWarmStartingEnabled;
+
+  /// Maximum distance between matching contact points of consecutive steps
+  double mWarmStartingDistance;
+
+  /// Contact impulses of the previous step sorted by the body pair
+  std::vector<ContactImpulse> mContactImpulses;
+
+  /// Number of warm started contacts in the last solve()
+  std::size_t mLastNumWarmStartedContacts;
+
+  /// Maximum number of contacts kept between each pair of bodies, or zero
+  std::size_t mMaxNumContactsPerPair;
+
+  /// Number of contacts removed by the contact reduction in the last
+  /// collision detection
+  std::size_t mLastNumReducedContacts;
+
+  /// Collision group of the ShapeNodes whose CollisionAspect is continuous
+  collision::CollisionGroupPtr mContinuousGroup;
+
+  /// ShapeNodes in mContinuousGroup
+  std::vector<const dynamics::ShapeNode*> mContinuousShapeNodes;
+
+  /// Contacts found by the sweep of a Skeleton at one of its sampled poses
+  collision::CollisionResult mContinuousResult;
+
+  /// Speculative contacts of the last solve(). They are kept apart from
+  /// mCollisionResult, which only holds the contacts of touching bodies.
+  std::vector<collision::Contact> mSpeculativeContacts;
+
+  /// Number of speculative contacts created in the last solve()
+  std::size_t mLastNumSpeculativeContacts;
+
+  /// Total number of LCP iterations in the last solve()
+  std::size_t mLastNumLCPIterations;
+
+  /// Largest LCP residual in the last solve()
+  double mLastLCPResidual;
+
+  /// Whether resting Skeletons are put to sleep
+  bool mIsSleepingEnabled;
+
+  /// Kinetic energy per unit mass below which a Skeleton is resting
+  double mSleepingThreshold;
+
+  /// How long an island needs to be resting before it is put to sleep
+  double mTimeToSleep;
+
+  /// Shortest resting time of the awake Skeletons of each island, indexed by
+  /// Skeleton::mIslandIndex
+  std::vector<double> mIslandRestingTimes;
+
+  /// Whether each island has an awake Skeleton, indexed by
+  /// Skeleton::mIslandIndex
+  std::vector<bool> mIsIslandAwake;
 };
 
 }  // namespace constraint
@@ -31,6 +31,7 @@
 
 #include "dart/constraint/ContactConstraint.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "dart/external/odelcpsolver/lcp.h"
@@ -73,7 +74,8 @@ ContactConstraint::ContactConstraint(collision::Contact& _contact,
     mIsFrictionOn(true),
     mAppliedImpulseIndex(-1),
     mIsBounceOn(false),
-    mActive(false)
+    mActive(false),
+    mInitialImpulse(Eigen::Vector3d::Zero())
 {
   // TODO(JS): Assumed single contact
   mContacts.push_back(&_contact);
@@ -361,6 +363,18 @@ const Eigen::Vector3d& ContactConstraint::getFrictionDirection1() const
   return mFirstFrictionalDirection;
 }
 
+//==============================================================================
+void ContactConstraint::setInitialImpulse(const Eigen::Vector3d& _impulse)
+{
+  mInitialImpulse = _impulse;
+}
+
+//==============================================================================
+const Eigen::Vector3d& ContactConstraint::getInitialImpulse() const
+{
+  return mInitialImpulse;
+}
+
 //==============================================================================
 void ContactConstraint::update()
 {
@@ -412,10 +426,17 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       //------------------------------------------------------------------------
       // Bouncing
       //------------------------------------------------------------------------
-      // A. Penetration correction
+      // A. Penetration correction. A negative penetration depth is the gap of
+      // a speculative contact, which the bodies may close in this step.
+      const bool isSpeculative = mContacts[i]->penetrationDepth < 0.0;
       double bouncingVelocity = mContacts[i]->penetrationDepth
                                 - mErrorAllowance;
-      if (bouncingVelocity < 0.0)
+      if (isSpeculative)
+      {
+        bouncingVelocity
+            = mContacts[i]->penetrationDepth * _info->invTimeStep;
+      }
+      else if (bouncingVelocity < 0.0)
       {
         bouncingVelocity = 0.0;
       }
@@ -427,7 +448,7 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       }
 
       // B. Restitution
-      if (mIsBounceOn)
+      if (mIsBounceOn && !isSpeculative)
       {
         double& negativeRelativeVel = _info->b[index];
         double restitutionVel = negativeRelativeVel * mRestitutionCoeff;
@@ -452,11 +473,22 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       _info->b[index] += bouncingVelocity;
 //      std::cout << "_lcp->b[_idx]: " << _lcp->b[_idx] << std::endl;
 
-      // TODO(JS): Initial guess
-      // x
-      _info->x[index] = 0.0;
-      _info->x[index + 1] = 0.0;
-      _info->x[index + 2] = 0.0;
+      // Initial guess: the initial impulse in the contact frame
+      if (mInitialImpulse.isZero())
+      {
+        _info->x[index] = 0.0;
+        _info->x[index + 1] = 0.0;
+        _info->x[index + 2] = 0.0;
+      }
+      else
+      {
+        const Eigen::MatrixXd D
+            = getTangentBasisMatrixODE(mContacts[i]->normal);
+        _info->x[index]
+            = std::max(mInitialImpulse.dot(mContacts[i]->normal), 0.0);
+        _info->x[index + 1] = mInitialImpulse.dot(D.col(0));
+        _info->x[index + 2] = mInitialImpulse.dot(D.col(1));
+      }
 
       // Increase index
       index += 3;
@@ -480,10 +512,17 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       //------------------------------------------------------------------------
       // Bouncing
       //------------------------------------------------------------------------
-      // A. Penetration correction
+      // A. Penetration correction. A negative penetration depth is the gap of
+      // a speculative contact, which the bodies may close in this step.
+      const bool isSpeculative = mContacts[i]->penetrationDepth < 0.0;
       double bouncingVelocity = mContacts[i]->penetrationDepth
                                 - DART_ERROR_ALLOWANCE;
-      if (bouncingVelocity < 0.0)
+      if (isSpeculative)
+      {
+        bouncingVelocity
+            = mContacts[i]->penetrationDepth * _info->invTimeStep;
+      }
+      else if (bouncingVelocity < 0.0)
       {
         bouncingVelocity = 0.0;
       }
@@ -495,7 +534,7 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       }
 
       // B. Restitution
-      if (mIsBounceOn)
+      if (mIsBounceOn && !isSpeculative)
       {
         double& negativeRelativeVel = _info->b[i];
         double restitutionVel = negativeRelativeVel * mRestitutionCoeff;
@@ -518,9 +557,8 @@ void ContactConstraint::getInformation(ConstraintInfo* _info)
       _info->b[i] += bouncingVelocity;
 //      std::cout << "_lcp->b[_idx]: " << _lcp->b[_idx] << std::endl;
 
-      // TODO(JS): Initial guess
-      // x
-      _info->x[i] = 0.0;
+      // Initial guess: the normal component of the initial impulse
+      _info->x[i] = std::max(mInitialImpulse.dot(mContacts[i]->normal), 0.0);
 
       // Increase index
     }
@@ -625,6 +663,28 @@ void ContactConstraint::getVelocityChange(double* _vel, bool _withCfm)
   }
 }
 
+//==============================================================================
+bool ContactConstraint::getJacobian(ConstraintJacobian* _jacobian)
+{
+  assert(_jacobian != nullptr && "Null pointer is not allowed.");
+
+  if ((mBodyNode1->isReactive()
+       && !isFullyDynamic(mBodyNode1->getSkeleton().get()))
+      || (mBodyNode2->isReactive()
+          && !isFullyDynamic(mBodyNode2->getSkeleton().get())))
+  {
+    return false;
+  }
+
+  _jacobian->numSkeletons = 0u;
+  _jacobian->cfm = mConstraintForceMixing;
+
+  addJacobian(mBodyNode1, mJacobians1, _jacobian);
+  addJacobian(mBodyNode2, mJacobians2, _jacobian);
+
+  return true;
+}
+
 //==============================================================================
 void ContactConstraint::excite()
 {
@@ -775,6 +835,38 @@ void ContactConstraint::updateFirstFrictionalDirection()
 //  mFirstFrictionalDirection;
 }
 
+//==============================================================================
+void ContactConstraint::addJacobian(
+    dynamics::BodyNode* _bodyNode,
+    const Eigen::aligned_vector<Eigen::Vector6d>& _bodyJacobians,
+    ConstraintJacobian* _jacobian) const
+{
+  if (!_bodyNode->isReactive())
+    return;
+
+  dynamics::Skeleton* skeleton = _bodyNode->getSkeleton().get();
+
+  // Both bodies belong to the same skeleton in case of self collision
+  std::size_t index = 0u;
+  while (index < _jacobian->numSkeletons
+         && _jacobian->skeletons[index] != skeleton)
+  {
+    ++index;
+  }
+
+  Eigen::MatrixXd& jacobian = _jacobian->jacobians[index];
+  if (index == _jacobian->numSkeletons)
+  {
+    _jacobian->skeletons[index] = skeleton;
+    jacobian.setZero(mDim, skeleton->getNumDofs());
+    ++_jacobian->numSkeletons;
+  }
+
+  const math::Jacobian bodyJacobian = skeleton->getJacobian(_bodyNode);
+  for (std::size_t i = 0; i < mDim; ++i)
+    jacobian.row(i).noalias() += _bodyJacobians[i].transpose() * bodyJacobian;
+}
+
 //==============================================================================
 Eigen::MatrixXd ContactConstraint::getTangentBasisMatrixODE(
     const Eigen::Vector3d& _n)
@@ -90,6 +90,15 @@ public:
   /// Get first frictional direction
   const Eigen::Vector3d& getFrictionDirection1() const;
 
+  /// Set the contact impulse that the LCP solver starts from. The impulse acts
+  /// on the first body and is expressed in the world frame. Iterative solvers
+  /// like PGSLCPSolver converge faster when it is close to the solution, e.g.,
+  /// when it is the impulse of the same contact in the previous step.
+  void setInitialImpulse(const Eigen::Vector3d& _impulse);
+
+  /// Get the contact impulse that the LCP solver starts from
+  const Eigen::Vector3d& getInitialImpulse() const;
+
   //----------------------------------------------------------------------------
   // Friendship
   //----------------------------------------------------------------------------
@@ -114,6 +123,9 @@ protected:
   // Documentation inherited
   void getVelocityChange(double* _vel, bool _withCfm) override;
 
+  // Documentation inherited
+  bool getJacobian(ConstraintJacobian* _jacobian) override;
+
   // Documentation inherited
   void excite() override;
 
@@ -141,6 +153,12 @@ private:
   ///
   void updateFirstFrictionalDirection();
 
+  /// Add the Jacobian of the contact w.r.t. the generalized velocities of the
+  /// skeleton of _bodyNode to _jacobian
+  void addJacobian(dynamics::BodyNode* _bodyNode,
+                   const Eigen::aligned_vector<Eigen::Vector6d>& _bodyJacobians,
+                   ConstraintJacobian* _jacobian) const;
+
   ///
   Eigen::MatrixXd getTangentBasisMatrixODE(const Eigen::Vector3d& _n);
 
@@ -184,6 +202,9 @@ private:
   ///
   bool mActive;
 
+  /// Initial guess of the contact impulse acting on mBodyNode1
+  Eigen::Vector3d mInitialImpulse;
+
   /// Global constraint error allowance
   static double mErrorAllowance;
 
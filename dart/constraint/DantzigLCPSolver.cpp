@@ -59,6 +59,20 @@ DantzigLCPSolver::~DantzigLCPSolver()
 //==============================================================================
 void DantzigLCPSolver::solve(ConstrainedGroup* _group)
 {
+  solve(_group, &mWorkspace);
+}
+
+//==============================================================================
+bool DantzigLCPSolver::isThreadSafe() const
+{
+  return true;
+}
+
+//==============================================================================
+void DantzigLCPSolver::solve(
+    ConstrainedGroup* _group, LCPWorkspace* _workspace)
+{
+  assert(_workspace);
 
   // Build LCP terms by aggregating them from constraints
   std::size_t numConstraints = _group->getNumConstraints();
@@ -69,13 +83,15 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
     return;
 
   int nSkip = dPAD(n);
-  double* A = new double[n * nSkip];
-  double* x = new double[n];
-  double* b = new double[n];
-  double* w = new double[n];
-  double* lo = new double[n];
-  double* hi = new double[n];
-  int* findex = new int[n];
+  _workspace->reserve(n, nSkip, numConstraints,
+                      dEstimateSolveLCPMemoryReq(n, true));
+  double* A = _workspace->A;
+  double* x = _workspace->x;
+  double* b = _workspace->b;
+  double* w = _workspace->w;
+  double* lo = _workspace->lo;
+  double* hi = _workspace->hi;
+  int* findex = _workspace->findex;
 
   // Set w to 0 and findex to -1
 #ifndef NDEBUG
@@ -85,7 +101,7 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
   std::memset(findex, -1, n * sizeof(int));
 
   // Compute offset indices
-  std::size_t* offset = new std::size_t[n];
+  std::size_t* offset = _workspace->offset;
   offset[0] = 0;
 //  std::cout << "offset[" << 0 << "]: " << offset[0] << std::endl;
   for (std::size_t i = 1; i < numConstraints; ++i)
@@ -96,6 +112,11 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
 //    std::cout << "offset[" << i << "]: " << offset[i] << std::endl;
   }
 
+  // Compute A from the Jacobians if the constraints provide them
+  const bool hasMatrix
+      = mMatrixAssembly == JACOBIAN
+        && computeMatrixFromJacobians(_group, offset, nSkip, A, _workspace);
+
   // For each constraint
   ConstraintInfo constInfo;
   constInfo.invTimeStep = 1.0 / mTimeStep;
@@ -113,6 +134,18 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
     // Fill vectors: lo, hi, b, w
     constraint->getInformation(&constInfo);
 
+    if (hasMatrix)
+    {
+      // Adjust findex for global index
+      for (std::size_t j = 0; j < constraint->getDimension(); ++j)
+      {
+        if (findex[offset[i] + j] >= 0)
+          findex[offset[i] + j] += offset[i];
+      }
+
+      continue;
+    }
+
     // Fill a matrix by impulse tests: A
     constraint->excite();
     for (std::size_t j = 0; j < constraint->getDimension(); ++j)
@@ -160,7 +193,7 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
 //  std::cout << std::endl;
 
   // Solve LCP using ODE's Dantzig algorithm
-  dSolveLCP(n, A, x, b, w, 0, lo, hi, findex);
+  dSolveLCP(n, A, x, b, w, 0, lo, hi, findex, _workspace->scratch);
 
   // Print LCP formulation
 //  dtdbg << "After solve:" << std::endl;
@@ -174,16 +207,6 @@ void DantzigLCPSolver::solve(ConstrainedGroup* _group)
     constraint->applyImpulse(x + offset[i]);
     constraint->excite();
   }
-
-  delete[] offset;
-
-  delete[] A;
-  delete[] x;
-  delete[] b;
-  delete[] w;
-  delete[] lo;
-  delete[] hi;
-  delete[] findex;
 }
 
 //==============================================================================
@@ -54,6 +54,12 @@ public:
   // Documentation inherited
   void solve(ConstrainedGroup* _group) override;
 
+  // Documentation inherited
+  void solve(ConstrainedGroup* _group, LCPWorkspace* _workspace) override;
+
+  // Documentation inherited
+  bool isThreadSafe() const override;
+
 #ifndef NDEBUG
 private:
   /// Return true if the matrix is symmetric
@@ -235,6 +235,39 @@ void JointCoulombFrictionConstraint::getVelocityChange(double* _delVel,
   assert(localIndex == mDim);
 }
 
+//==============================================================================
+bool JointCoulombFrictionConstraint::getJacobian(ConstraintJacobian* _jacobian)
+{
+  assert(_jacobian != nullptr && "Null pointer is not allowed.");
+
+  dynamics::Skeleton* skeleton = mJoint->getSkeleton().get();
+  if (!isFullyDynamic(skeleton))
+    return false;
+
+  _jacobian->numSkeletons = 1u;
+  _jacobian->skeletons[0] = skeleton;
+  _jacobian->cfm = mConstraintForceMixing;
+
+  // The constraint impulses act directly on the active generalized coordinates
+  Eigen::MatrixXd& jacobian = _jacobian->jacobians[0];
+  jacobian.setZero(mDim, skeleton->getNumDofs());
+
+  std::size_t localIndex = 0;
+  std::size_t dof = mJoint->getNumDofs();
+  for (std::size_t i = 0; i < dof ; ++i)
+  {
+    if (mActive[i] == false)
+      continue;
+
+    jacobian(localIndex, mJoint->getIndexInSkeleton(i)) = 1.0;
+    ++localIndex;
+  }
+
+  assert(localIndex == mDim);
+
+  return true;
+}
+
 //==============================================================================
 void JointCoulombFrictionConstraint::excite()
 {
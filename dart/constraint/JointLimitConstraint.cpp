@@ -345,6 +345,39 @@ void JointLimitConstraint::getVelocityChange(double* _delVel, bool _withCfm)
   assert(localIndex == mDim);
 }
 
+//==============================================================================
+bool JointLimitConstraint::getJacobian(ConstraintJacobian* _jacobian)
+{
+  assert(_jacobian != nullptr && "Null pointer is not allowed.");
+
+  dynamics::Skeleton* skeleton = mJoint->getSkeleton().get();
+  if (!isFullyDynamic(skeleton))
+    return false;
+
+  _jacobian->numSkeletons = 1u;
+  _jacobian->skeletons[0] = skeleton;
+  _jacobian->cfm = mConstraintForceMixing;
+
+  // The constraint impulses act directly on the active generalized coordinates
+  Eigen::MatrixXd& jacobian = _jacobian->jacobians[0];
+  jacobian.setZero(mDim, skeleton->getNumDofs());
+
+  std::size_t localIndex = 0;
+  std::size_t dof = mJoint->getNumDofs();
+  for (std::size_t i = 0; i < dof ; ++i)
+  {
+    if (mActive[i] == false)
+      continue;
+
+    jacobian(localIndex, mJoint->getIndexInSkeleton(i)) = 1.0;
+    ++localIndex;
+  }
+
+  assert(localIndex == mDim);
+
+  return true;
+}
+
 //==============================================================================
 void JointLimitConstraint::excite()
 {
@@ -31,11 +31,193 @@
 
 #include "dart/constraint/LCPSolver.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <utility>
+
+#include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/dynamics/Skeleton.hpp"
 
 namespace dart {
 namespace constraint {
 
+namespace {
+
+//==============================================================================
+std::size_t alignSize(std::size_t size)
+{
+  const std::size_t alignment = LCPWorkspace::Alignment;
+  return (size + alignment - 1u) / alignment * alignment;
+}
+
+}  // anonymous namespace
+
+//==============================================================================
+constexpr std::size_t LCPWorkspace::Alignment;
+
+//==============================================================================
+LCPWorkspace::LCPWorkspace()
+  : A(nullptr),
+    x(nullptr),
+    b(nullptr),
+    w(nullptr),
+    lo(nullptr),
+    hi(nullptr),
+    findex(nullptr),
+    order(nullptr),
+    offset(nullptr),
+    scratch(nullptr),
+    numIterations(0u),
+    residual(0.0),
+    mMemory(nullptr),
+    mCapacity(0u),
+    mNumAllocations(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LCPWorkspace::LCPWorkspace(LCPWorkspace&& other) noexcept
+  : LCPWorkspace()
+{
+  *this = std::move(other);
+}
+
+//==============================================================================
+LCPWorkspace& LCPWorkspace::operator=(LCPWorkspace&& other) noexcept
+{
+  if (this == &other)
+    return *this;
+
+  delete[] mMemory;
+
+  A = other.A;
+  x = other.x;
+  b = other.b;
+  w = other.w;
+  lo = other.lo;
+  hi = other.hi;
+  findex = other.findex;
+  order = other.order;
+  offset = other.offset;
+  scratch = other.scratch;
+  numIterations = other.numIterations;
+  residual = other.residual;
+  jacobians = std::move(other.jacobians);
+  invMassJacobians = std::move(other.invMassJacobians);
+  mMemory = other.mMemory;
+  mCapacity = other.mCapacity;
+  mNumAllocations = other.mNumAllocations;
+
+  other.mMemory = nullptr;
+  other.mCapacity = 0u;
+
+  return *this;
+}
+
+//==============================================================================
+LCPWorkspace::~LCPWorkspace()
+{
+  delete[] mMemory;
+}
+
+//==============================================================================
+void LCPWorkspace::reserve(std::size_t n, std::size_t nSkip,
+                           std::size_t numConstraints, std::size_t scratchSize)
+{
+  const std::size_t required
+      = alignSize(n * nSkip * sizeof(double))
+      + 5u * alignSize(n * sizeof(double))
+      + 2u * alignSize(n * sizeof(int))
+      + alignSize(numConstraints * sizeof(std::size_t))
+      + alignSize(scratchSize);
+
+  if (required > mCapacity)
+  {
+    // Grow geometrically so that a slowly growing scene doesn't reallocate
+    // on every step
+    const std::size_t capacity = std::max(required, mCapacity + mCapacity / 2u);
+
+    delete[] mMemory;
+    mMemory = new char[capacity + Alignment - 1u];
+    mCapacity = capacity;
+    ++mNumAllocations;
+  }
+
+  assignBuffers(n, nSkip, numConstraints);
+}
+
+//==============================================================================
+std::size_t LCPWorkspace::getNumAllocations() const
+{
+  return mNumAllocations;
+}
+
+//==============================================================================
+std::size_t LCPWorkspace::getCapacity() const
+{
+  return mCapacity;
+}
+
+//==============================================================================
+void LCPWorkspace::resetStatistics()
+{
+  numIterations = 0u;
+  residual = 0.0;
+}
+
+//==============================================================================
+void LCPWorkspace::assignBuffers(
+    std::size_t n, std::size_t nSkip, std::size_t numConstraints)
+{
+  const auto address = reinterpret_cast<std::uintptr_t>(mMemory);
+  char* current = mMemory + (alignSize(address) - address);
+
+  const auto take = [&current](std::size_t size)
+  {
+    char* buffer = current;
+    current += alignSize(size);
+    return buffer;
+  };
+
+  A = reinterpret_cast<double*>(take(n * nSkip * sizeof(double)));
+  x = reinterpret_cast<double*>(take(n * sizeof(double)));
+  b = reinterpret_cast<double*>(take(n * sizeof(double)));
+  w = reinterpret_cast<double*>(take(n * sizeof(double)));
+  lo = reinterpret_cast<double*>(take(n * sizeof(double)));
+  hi = reinterpret_cast<double*>(take(n * sizeof(double)));
+  findex = reinterpret_cast<int*>(take(n * sizeof(int)));
+  order = reinterpret_cast<int*>(take(n * sizeof(int)));
+  offset = reinterpret_cast<std::size_t*>(
+        take(numConstraints * sizeof(std::size_t)));
+  scratch = current;
+}
+
+//==============================================================================
+void LCPSolver::solve(ConstrainedGroup* _group, LCPWorkspace* /*_workspace*/)
+{
+  solve(_group);
+}
+
+//==============================================================================
+bool LCPSolver::isThreadSafe() const
+{
+  return false;
+}
+
+//==============================================================================
+LCPWorkspace& LCPSolver::getWorkspace()
+{
+  return mWorkspace;
+}
+
+//==============================================================================
+const LCPWorkspace& LCPSolver::getWorkspace() const
+{
+  return mWorkspace;
+}
+
 //==============================================================================
 void LCPSolver::setTimeStep(double _timeStep)
 {
@@ -50,7 +232,104 @@ double LCPSolver::getTimeStep() const
 }
 
 //==============================================================================
-LCPSolver::LCPSolver(double _timeStep) : mTimeStep(_timeStep)
+void LCPSolver::setMatrixAssembly(MatrixAssembly _assembly)
+{
+  mMatrixAssembly = _assembly;
+}
+
+//==============================================================================
+LCPSolver::MatrixAssembly LCPSolver::getMatrixAssembly() const
+{
+  return mMatrixAssembly;
+}
+
+//==============================================================================
+bool LCPSolver::computeMatrixFromJacobians(ConstrainedGroup* _group,
+                                           const std::size_t* _offset,
+                                           std::size_t _nSkip,
+                                           double* _A,
+                                           LCPWorkspace* _workspace) const
+{
+  using RowMajorMatrix
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  using Block = Eigen::Map<RowMajorMatrix, 0, Eigen::OuterStride<>>;
+
+  const std::size_t numConstraints = _group->getNumConstraints();
+
+  std::vector<ConstraintJacobian>& jacobians = _workspace->jacobians;
+  std::vector<Eigen::MatrixXd>& invMassJacobians
+      = _workspace->invMassJacobians;
+  if (jacobians.size() < numConstraints)
+  {
+    jacobians.resize(numConstraints);
+    invMassJacobians.resize(2u * numConstraints);
+  }
+
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    if (!_group->getConstraint(i)->getJacobian(&jacobians[i]))
+      return false;
+  }
+
+  // J * M^-1 for each skeleton that a constraint acts on
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const ConstraintJacobian& jacobian = jacobians[i];
+    for (std::size_t s = 0; s < jacobian.numSkeletons; ++s)
+    {
+      invMassJacobians[2u * i + s].noalias()
+          = jacobian.jacobians[s] * jacobian.skeletons[s]->getInvMassMatrix();
+    }
+  }
+
+  // The block of a pair of constraints is the sum over their common skeletons
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const ConstraintJacobian& jacobianI = jacobians[i];
+    const std::size_t dimI = _group->getConstraint(i)->getDimension();
+
+    for (std::size_t k = i; k < numConstraints; ++k)
+    {
+      const ConstraintJacobian& jacobianK = jacobians[k];
+      const std::size_t dimK = _group->getConstraint(k)->getDimension();
+
+      Block block(_A + _nSkip * _offset[i] + _offset[k], dimI, dimK,
+                  Eigen::OuterStride<>(_nSkip));
+      block.setZero();
+
+      for (std::size_t s = 0; s < jacobianI.numSkeletons; ++s)
+      {
+        for (std::size_t t = 0; t < jacobianK.numSkeletons; ++t)
+        {
+          if (jacobianI.skeletons[s] != jacobianK.skeletons[t])
+            continue;
+
+          block.noalias() += invMassJacobians[2u * i + s]
+                             * jacobianK.jacobians[t].transpose();
+        }
+      }
+
+      if (k == i)
+      {
+        // Add small values to the diagonal to keep it away from singular,
+        // similar to cfm variable in ODE
+        block.diagonal() *= 1.0 + jacobianI.cfm;
+      }
+      else
+      {
+        Block(_A + _nSkip * _offset[k] + _offset[i], dimK, dimI,
+              Eigen::OuterStride<>(_nSkip)) = block.transpose();
+      }
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+LCPSolver::LCPSolver(double _timeStep)
+  : mTimeStep(_timeStep),
+    mMatrixAssembly(UNIT_IMPULSE)
 {
 }
 
@@ -32,24 +32,181 @@
 #ifndef DART_CONSTRAINT_LCPSOLVER_HPP_
 #define DART_CONSTRAINT_LCPSOLVER_HPP_
 
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/constraint/ConstraintBase.hpp"
+
 namespace dart {
 namespace constraint {
 
 class ConstrainedGroup;
 
+/// LCPWorkspace holds the scratch memory that an LCPSolver needs to assemble
+/// and solve the LCP of a ConstrainedGroup. Solving several groups at the same
+/// time requires one workspace per thread.
+///
+/// All the buffers live in a single block of memory that only ever grows, and
+/// each buffer starts on a 64-byte boundary. Once a workspace has been used for
+/// the largest group of a scene, solving doesn't allocate any more.
+class LCPWorkspace
+{
+public:
+  /// Alignment of the buffers in bytes
+  static constexpr std::size_t Alignment = 64u;
+
+  /// Constructor
+  LCPWorkspace();
+
+  /// Move constructor
+  LCPWorkspace(LCPWorkspace&& other) noexcept;
+
+  /// Move assignment operator
+  LCPWorkspace& operator=(LCPWorkspace&& other) noexcept;
+
+  LCPWorkspace(const LCPWorkspace&) = delete;
+  LCPWorkspace& operator=(const LCPWorkspace&) = delete;
+
+  /// Destructor
+  ~LCPWorkspace();
+
+  /// Make the buffers large enough for an LCP of dimension n whose matrix rows
+  /// are nSkip entries apart, for numConstraints constraints, and for
+  /// scratchSize bytes of scratch memory of the LCP algorithm. Memory is only
+  /// allocated when the current block is too small.
+  void reserve(std::size_t n, std::size_t nSkip, std::size_t numConstraints,
+               std::size_t scratchSize = 0u);
+
+  /// Return the number of times this workspace has allocated memory
+  std::size_t getNumAllocations() const;
+
+  /// Return the size of the memory block in bytes
+  std::size_t getCapacity() const;
+
+  /// Reset numIterations and residual to zero
+  void resetStatistics();
+
+  /// LCP matrix, n x nSkip
+  double* A;
+
+  /// Solution
+  double* x;
+
+  /// Right hand side
+  double* b;
+
+  /// Slack variables
+  double* w;
+
+  /// Lower bounds
+  double* lo;
+
+  /// Upper bounds
+  double* hi;
+
+  /// Friction indices
+  int* findex;
+
+  /// Iteration order of iterative solvers
+  int* order;
+
+  /// Offsets of the constraints in the LCP
+  std::size_t* offset;
+
+  /// Scratch memory of the LCP algorithm, e.g., the factorization of
+  /// dSolveLCP()
+  void* scratch;
+
+  /// Total number of iterations that an iterative solver spent on the LCPs
+  /// solved with this workspace since the last resetStatistics()
+  std::size_t numIterations;
+
+  /// Largest residual of the LCPs solved with this workspace since the last
+  /// resetStatistics(). The residual of a solution x is the largest change of
+  /// an element of x by one more projected Gauss-Seidel update, i.e., the
+  /// largest violation of the LCP conditions in impulse units. Direct solvers
+  /// like DantzigLCPSolver don't report it and leave it at zero.
+  double residual;
+
+  /// Jacobians of the constraints, used to compute the LCP matrix
+  std::vector<ConstraintJacobian> jacobians;
+
+  /// Products of the Jacobians and the inverse mass matrices, two per
+  /// constraint
+  std::vector<Eigen::MatrixXd> invMassJacobians;
+
+private:
+  /// Point the buffers into mMemory
+  void assignBuffers(
+      std::size_t n, std::size_t nSkip, std::size_t numConstraints);
+
+  /// Memory block, as returned by the allocator
+  char* mMemory;
+
+  /// Size of mMemory in bytes, excluding the padding used for alignment
+  std::size_t mCapacity;
+
+  /// Number of times mMemory has been allocated
+  std::size_t mNumAllocations;
+};
+
 /// LCPSolver
 class LCPSolver
 {
 public:
+  /// Methods to compute the LCP matrix, also known as the Delassus matrix
+  enum MatrixAssembly
+  {
+    /// Apply a unit impulse per dimension of each constraint and measure the
+    /// velocity changes of all the constraints. Each column costs an impulse
+    /// propagation through the skeletons.
+    UNIT_IMPULSE = 0,
+
+    /// Compute J * M^-1 * J^T from the Jacobians of the constraints and the
+    /// cached inverse mass matrices of the skeletons. Groups that have a
+    /// constraint without Jacobian (see ConstraintBase::getJacobian()) fall
+    /// back to UNIT_IMPULSE.
+    JACOBIAN
+  };
+
   /// Solve constriant impulses for a constrained group
   virtual void solve(ConstrainedGroup* _group) = 0;
 
+  /// Solve constraint impulses for a constrained group using the scratch
+  /// memory of workspace.
+  ///
+  /// If isThreadSafe() returns true, ConstraintSolver calls this function
+  /// from several threads at once for disjoint groups, each thread with its
+  /// own workspace, so overrides must not modify any state of the LCPSolver.
+  /// The default implementation ignores the workspace and calls
+  /// solve(ConstrainedGroup*).
+  virtual void solve(ConstrainedGroup* _group, LCPWorkspace* _workspace);
+
+  /// Return true if solve(ConstrainedGroup*, LCPWorkspace*) may be called from
+  /// several threads at once. ConstraintSolver solves the groups one after
+  /// another otherwise. The default is false.
+  virtual bool isThreadSafe() const;
+
   /// Set time step
   void setTimeStep(double _timeStep);
 
   /// Return time step
   double getTimeStep() const;
 
+  /// Set the method to compute the LCP matrix. The default is UNIT_IMPULSE.
+  void setMatrixAssembly(MatrixAssembly _assembly);
+
+  /// Return the method to compute the LCP matrix
+  MatrixAssembly getMatrixAssembly() const;
+
+  /// Return the workspace that solve(ConstrainedGroup*) uses
+  LCPWorkspace& getWorkspace();
+
+  /// Return the workspace that solve(ConstrainedGroup*) uses
+  const LCPWorkspace& getWorkspace() const;
+
   /// Destructor
   virtual ~LCPSolver();
 
@@ -57,9 +214,25 @@ protected:
   /// Constructor
   LCPSolver(double _timeStep);
 
+  /// Compute the LCP matrix of _group as J * M^-1 * J^T, where the rows of
+  /// the matrix are _nSkip entries apart and _offset holds the offsets of the
+  /// constraints. Return false without modifying _A if a constraint of the
+  /// group doesn't provide its Jacobian.
+  bool computeMatrixFromJacobians(ConstrainedGroup* _group,
+                                  const std::size_t* _offset,
+                                  std::size_t _nSkip,
+                                  double* _A,
+                                  LCPWorkspace* _workspace) const;
+
 protected:
   /// Simulation time step
   double mTimeStep;
+
+  /// Method to compute the LCP matrix
+  MatrixAssembly mMatrixAssembly;
+
+  /// Workspace that persists across the calls of solve(ConstrainedGroup*)
+  LCPWorkspace mWorkspace;
 };
 
 } // namespace constraint
@@ -31,6 +31,9 @@
 
 #include "dart/constraint/PGSLCPSolver.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #ifndef NDEBUG
 #include <iomanip>
 #include <iostream>
@@ -59,6 +62,20 @@ PGSLCPSolver::~PGSLCPSolver()
 //==============================================================================
 void PGSLCPSolver::solve(ConstrainedGroup* _group)
 {
+  solve(_group, &mWorkspace);
+}
+
+//==============================================================================
+bool PGSLCPSolver::isThreadSafe() const
+{
+  return true;
+}
+
+//==============================================================================
+void PGSLCPSolver::solve(ConstrainedGroup* _group, LCPWorkspace* _workspace)
+{
+  assert(_workspace);
+
   // If there is no constraint, then just return true.
   std::size_t numConstraints = _group->getNumConstraints();
   if (numConstraints == 0)
@@ -67,13 +84,14 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
   // Build LCP terms by aggregating them from constraints
   std::size_t n = _group->getTotalDimension();
   int nSkip = dPAD(n);
-  double* A = new double[n * nSkip];
-  double* x = new double[n];
-  double* b = new double[n];
-  double* w = new double[n];
-  double* lo = new double[n];
-  double* hi = new double[n];
-  int* findex = new int[n];
+  _workspace->reserve(n, nSkip, numConstraints);
+  double* A = _workspace->A;
+  double* x = _workspace->x;
+  double* b = _workspace->b;
+  double* w = _workspace->w;
+  double* lo = _workspace->lo;
+  double* hi = _workspace->hi;
+  int* findex = _workspace->findex;
 
   // Set w to 0 and findex to -1
 #ifndef NDEBUG
@@ -83,7 +101,7 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
   std::memset(findex, -1, n * sizeof(int));
 
   // Compute offset indices
-  std::size_t* offset = new std::size_t[n];
+  std::size_t* offset = _workspace->offset;
   offset[0] = 0;
   //  std::cout << "offset[" << 0 << "]: " << offset[0] << std::endl;
   for (std::size_t i = 1; i < numConstraints; ++i)
@@ -94,6 +112,11 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
     //    std::cout << "offset[" << i << "]: " << offset[i] << std::endl;
   }
 
+  // Compute A from the Jacobians if the constraints provide them
+  const bool hasMatrix
+      = mMatrixAssembly == JACOBIAN
+        && computeMatrixFromJacobians(_group, offset, nSkip, A, _workspace);
+
   // For each constraint
   ConstraintInfo constInfo;
   constInfo.invTimeStep = 1.0 / mTimeStep;
@@ -111,6 +134,18 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
     // Fill vectors: lo, hi, b, w
     constraint->getInformation(&constInfo);
 
+    if (hasMatrix)
+    {
+      // Adjust findex for global index
+      for (std::size_t j = 0; j < constraint->getDimension(); ++j)
+      {
+        if (findex[offset[i] + j] >= 0)
+          findex[offset[i] + j] += offset[i];
+      }
+
+      continue;
+    }
+
     // Fill a matrix by impulse tests: A
     constraint->excite();
     for (std::size_t j = 0; j < constraint->getDimension(); ++j)
@@ -161,7 +196,12 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
 //  dSolveLCP(n, A, x, b, w, 0, lo, hi, findex);
   PGSOption option;
   option.setDefault();
-  solvePGS(n, nSkip, 0, A, x, b, lo, hi, findex, &option);
+  int numIterations = 0;
+  double residual = 0.0;
+  solvePGS(n, nSkip, 0, A, x, b, lo, hi, findex, &option, _workspace->order,
+           &numIterations, &residual);
+  _workspace->numIterations += static_cast<std::size_t>(numIterations);
+  _workspace->residual = std::max(_workspace->residual, residual);
 
   // Print LCP formulation
   //  dtdbg << "After solve:" << std::endl;
@@ -175,16 +215,6 @@ void PGSLCPSolver::solve(ConstrainedGroup* _group)
     constraint->applyImpulse(x + offset[i]);
     constraint->excite();
   }
-
-  delete[] offset;
-
-  delete[] A;
-  delete[] x;
-  delete[] b;
-  delete[] w;
-  delete[] lo;
-  delete[] hi;
-  delete[] findex;
 }
 
 //==============================================================================
@@ -340,8 +370,60 @@ void PGSLCPSolver::print(std::size_t _n, double* _A, double* _x,
 }
 #endif
 
-bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
+bool solvePGS(int n, int nskip, int nub, double * A, double * x, double * b,
               double * lo, double * hi, int * findex, PGSOption * option)
+{
+  int* order = new int[n];
+  const bool result = solvePGS(
+      n, nskip, nub, A, x, b, lo, hi, findex, option, order, nullptr, nullptr);
+  delete[] order;
+
+  return result;
+}
+
+//==============================================================================
+namespace {
+
+/// Return the largest change of an element of x by one projected Gauss-Seidel
+/// update without relaxation
+double computePGSResidual(int n, int nskip, const double* A, const double* x,
+                          const double* b, const double* lo, const double* hi,
+                          const int* findex, double eps_div)
+{
+  double residual = 0.0;
+
+  for (int i = 0; i < n; ++i)
+  {
+    const double* A_ptr = A + nskip*i;
+    if (A_ptr[i] < eps_div)
+      continue;
+
+    double new_x = b[i];
+    for (int j = 0; j < n; ++j)
+      new_x -= A_ptr[j]*x[j];
+    new_x = x[i] + new_x/A_ptr[i];
+
+    double lo_tmp = lo[i];
+    double hi_tmp = hi[i];
+    if (findex[i] >= 0)
+    {
+      hi_tmp = hi[i] * x[findex[i]];
+      lo_tmp = -hi_tmp;
+    }
+    new_x = std::min(std::max(new_x, lo_tmp), hi_tmp);
+
+    residual = std::max(residual, std::abs(new_x - x[i]));
+  }
+
+  return residual;
+}
+
+}  // anonymous namespace
+
+//==============================================================================
+bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
+              double * lo, double * hi, int * findex, PGSOption * option,
+              int * order, int * numIterations, double * residual)
 {
   // LDLT solver will work !!!
   //if (nub == n)
@@ -356,7 +438,6 @@ bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
   double one_minus_sor_w = 1.0 - (option->sor_w);
 
   //--- ORDERING & SCALING & INITIAL LOOP & Test
-  int* order = new int[n];
 
   n_new = 0;
   sentinel = true;
@@ -414,7 +495,13 @@ bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
   }
   if (sentinel)
   {
-    delete[] order;
+    if (numIterations)
+      *numIterations = 1;
+    if (residual)
+    {
+      *residual = computePGSResidual(
+            n, nskip, A, x, b, lo, hi, findex, option->eps_div);
+    }
     return true;
   }
 
@@ -498,7 +585,18 @@ bool solvePGS(int n, int nskip, int /*nub*/, double * A, double * x, double * b,
     if (sentinel)
       break;
   }
-  delete[] order;
+
+  // The initial loop counts as the first iteration
+  if (numIterations)
+    *numIterations = sentinel ? iter + 1 : iter;
+  if (residual)
+  {
+    // A and b are scaled by the inverse diagonal at this point, which doesn't
+    // change the residual
+    *residual = computePGSResidual(
+          n, nskip, A, x, b, lo, hi, findex, option->eps_div);
+  }
+
   return sentinel;
 }
 
@@ -53,6 +53,12 @@ public:
   // Documentation inherited
   void solve(ConstrainedGroup* _group) override;
 
+  // Documentation inherited
+  void solve(ConstrainedGroup* _group, LCPWorkspace* _workspace) override;
+
+  // Documentation inherited
+  bool isThreadSafe() const override;
+
 #ifndef NDEBUG
 private:
   /// Return true if the matrix is symmetric
@@ -83,6 +89,16 @@ bool solvePGS(int n, int nskip, int /*nub*/, double* A,
                             double * lo, double * hi, int * findex,
                             PGSOption * option);
 
+/// Same as above, but uses order, an array of n integers, as scratch memory
+/// instead of allocating it. If they aren't nullptr, numIterations and
+/// residual are set to the number of iterations and the residual of the
+/// solution (see LCPWorkspace::residual).
+bool solvePGS(int n, int nskip, int /*nub*/, double* A,
+                            double* x, double * b,
+                            double * lo, double * hi, int * findex,
+                            PGSOption * option, int * order,
+                            int * numIterations, double * residual);
+
 
 } // namespace constraint
 } // namespace dart
@@ -237,6 +237,39 @@ void ServoMotorConstraint::getVelocityChange(double* delVel, bool withCfm)
   assert(localIndex == mDim);
 }
 
+//==============================================================================
+bool ServoMotorConstraint::getJacobian(ConstraintJacobian* jacobian)
+{
+  assert(jacobian != nullptr && "Null pointer is not allowed.");
+
+  dynamics::Skeleton* skeleton = mJoint->getSkeleton().get();
+  if (!isFullyDynamic(skeleton))
+    return false;
+
+  jacobian->numSkeletons = 1u;
+  jacobian->skeletons[0] = skeleton;
+  jacobian->cfm = mConstraintForceMixing;
+
+  // The constraint impulses act directly on the active generalized coordinates
+  Eigen::MatrixXd& matrix = jacobian->jacobians[0];
+  matrix.setZero(mDim, skeleton->getNumDofs());
+
+  std::size_t localIndex = 0;
+  std::size_t dof = mJoint->getNumDofs();
+  for (std::size_t i = 0; i < dof ; ++i)
+  {
+    if (mActive[i] == false)
+      continue;
+
+    matrix(localIndex, mJoint->getIndexInSkeleton(i)) = 1.0;
+    ++localIndex;
+  }
+
+  assert(localIndex == mDim);
+
+  return true;
+}
+
 //==============================================================================
 void ServoMotorConstraint::excite()
 {
@@ -87,6 +87,9 @@ protected:
   // Documentation inherited
   void getVelocityChange(double* delVel, bool withCfm) override;
 
+  // Documentation inherited
+  bool getJacobian(ConstraintJacobian* jacobian) override;
+
   // Documentation inherited
   void excite() override;
 
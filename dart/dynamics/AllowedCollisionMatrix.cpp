@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/AllowedCollisionMatrix.hpp"
+
+#include <cassert>
+#include <fstream>
+
+#include "dart/common/Console.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+AllowedCollisionMatrix::AllowedCollisionMatrix(std::size_t numBodyNodes)
+  : mNumBodyNodes(numBodyNodes),
+    mNumWordsPerRow((numBodyNodes + 63u) / 64u),
+    mBits(numBodyNodes * mNumWordsPerRow, 0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::size_t AllowedCollisionMatrix::getNumBodyNodes() const
+{
+  return mNumBodyNodes;
+}
+
+//==============================================================================
+void AllowedCollisionMatrix::setCollisionAllowed(
+    std::size_t index1, std::size_t index2, bool allowed)
+{
+  assert(index1 < mNumBodyNodes);
+  assert(index2 < mNumBodyNodes);
+
+  const std::uint64_t bit1 = std::uint64_t(1u) << (index2 % 64u);
+  const std::uint64_t bit2 = std::uint64_t(1u) << (index1 % 64u);
+  std::uint64_t& word1 = mBits[index1 * mNumWordsPerRow + index2 / 64u];
+  std::uint64_t& word2 = mBits[index2 * mNumWordsPerRow + index1 / 64u];
+
+  if (allowed)
+  {
+    word1 |= bit1;
+    word2 |= bit2;
+  }
+  else
+  {
+    word1 &= ~bit1;
+    word2 &= ~bit2;
+  }
+}
+
+//==============================================================================
+bool AllowedCollisionMatrix::isCollisionAllowed(
+    std::size_t index1, std::size_t index2) const
+{
+  assert(index1 < mNumBodyNodes);
+  assert(index2 < mNumBodyNodes);
+
+  return (mBits[index1 * mNumWordsPerRow + index2 / 64u]
+          >> (index2 % 64u)) & 1u;
+}
+
+//==============================================================================
+std::size_t AllowedCollisionMatrix::getNumAllowedPairs() const
+{
+  std::size_t numPairs = 0u;
+  for (std::size_t i = 0u; i < mNumBodyNodes; ++i)
+  {
+    for (std::size_t j = i + 1u; j < mNumBodyNodes; ++j)
+    {
+      if (isCollisionAllowed(i, j))
+        ++numPairs;
+    }
+  }
+
+  return numPairs;
+}
+
+//==============================================================================
+bool AllowedCollisionMatrix::save(
+    const std::string& fileName, const Skeleton* skel) const
+{
+  assert(skel);
+
+  if (skel->getNumBodyNodes() != mNumBodyNodes)
+  {
+    dterr << "[AllowedCollisionMatrix::save] The Skeleton [" << skel->getName()
+          << "] has " << skel->getNumBodyNodes() << " BodyNodes, but this "
+          << "matrix was created for " << mNumBodyNodes << " BodyNodes.\n";
+    return false;
+  }
+
+  std::ofstream file(fileName.c_str());
+  if (!file.is_open())
+  {
+    dterr << "[AllowedCollisionMatrix::save] Failed to open file ["
+          << fileName << "].\n";
+    return false;
+  }
+
+  // The names are separated by a tab since they may contain spaces
+  for (std::size_t i = 0u; i < mNumBodyNodes; ++i)
+  {
+    for (std::size_t j = i + 1u; j < mNumBodyNodes; ++j)
+    {
+      if (isCollisionAllowed(i, j))
+      {
+        file << skel->getBodyNode(i)->getName() << "\t"
+             << skel->getBodyNode(j)->getName() << "\n";
+      }
+    }
+  }
+
+  return file.good();
+}
+
+//==============================================================================
+std::shared_ptr<AllowedCollisionMatrix> AllowedCollisionMatrix::load(
+    const std::string& fileName, const Skeleton* skel)
+{
+  assert(skel);
+
+  std::ifstream file(fileName.c_str());
+  if (!file.is_open())
+  {
+    dterr << "[AllowedCollisionMatrix::load] Failed to open file ["
+          << fileName << "].\n";
+    return nullptr;
+  }
+
+  auto matrix = std::make_shared<AllowedCollisionMatrix>(
+        skel->getNumBodyNodes());
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.empty())
+      continue;
+
+    const auto separator = line.find('\t');
+    const auto bodyNode1 = skel->getBodyNode(line.substr(0u, separator));
+    const auto bodyNode2 = (separator == std::string::npos)
+        ? nullptr : skel->getBodyNode(line.substr(separator + 1u));
+
+    if (!bodyNode1 || !bodyNode2)
+    {
+      dtwarn << "[AllowedCollisionMatrix::load] Ignoring the line [" << line
+             << "] of file [" << fileName << "] since the Skeleton ["
+             << skel->getName() << "] doesn't have the BodyNodes.\n";
+      continue;
+    }
+
+    matrix->setCollisionAllowed(bodyNode1->getIndexInSkeleton(),
+                                bodyNode2->getIndexInSkeleton());
+  }
+
+  return matrix;
+}
+
+}  // namespace dynamics
+}  // namespace dart
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_ALLOWEDCOLLISIONMATRIX_HPP_
+#define DART_DYNAMICS_ALLOWEDCOLLISIONMATRIX_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dart {
+namespace dynamics {
+
+class Skeleton;
+
+/// AllowedCollisionMatrix records the pairs of BodyNodes of a Skeleton whose
+/// self-collisions are allowed, i.e., never need to be checked. A pair is
+/// typically allowed because the two BodyNodes can never collide or because
+/// they collide in every configuration (e.g., overlapping adjacent links).
+///
+/// The BodyNodes are identified by their indices in the Skeleton. Each row of
+/// the matrix is stored as a bitmask so that BodyNodeCollisionFilter can
+/// reject a pair with a single bit test in the broad phase of any collision
+/// detector. See collision::generateAllowedCollisionMatrix() for creating the
+/// matrix by sampling the configurations of a Skeleton.
+class AllowedCollisionMatrix
+{
+public:
+  /// Constructor. No pair of the numBodyNodes BodyNodes is allowed to collide
+  /// initially.
+  explicit AllowedCollisionMatrix(std::size_t numBodyNodes = 0u);
+
+  /// Get the number of BodyNodes that this matrix was created for
+  std::size_t getNumBodyNodes() const;
+
+  /// Set whether the collision between the BodyNodes with the given indices
+  /// is allowed. The matrix is kept symmetric.
+  void setCollisionAllowed(
+      std::size_t index1, std::size_t index2, bool allowed = true);
+
+  /// Return true if the collision between the BodyNodes with the given indices
+  /// is allowed and therefore doesn't need to be checked
+  bool isCollisionAllowed(std::size_t index1, std::size_t index2) const;
+
+  /// Get the number of distinct pairs whose collision is allowed
+  std::size_t getNumAllowedPairs() const;
+
+  /// Save the allowed pairs of skel to a text file, one pair of BodyNode names
+  /// per line. Returns false if the file cannot be written or if skel doesn't
+  /// have as many BodyNodes as this matrix.
+  bool save(const std::string& fileName, const Skeleton* skel) const;
+
+  /// Load the allowed pairs of skel from a text file written by save(). Pairs
+  /// that refer to BodyNodes not found in skel are ignored with a warning.
+  /// Returns nullptr if the file cannot be read.
+  static std::shared_ptr<AllowedCollisionMatrix> load(
+      const std::string& fileName, const Skeleton* skel);
+
+protected:
+  /// Number of BodyNodes
+  std::size_t mNumBodyNodes;
+
+  /// Number of 64-bit words in each row of mBits
+  std::size_t mNumWordsPerRow;
+
+  /// Rows of the matrix stored as bitmasks
+  std::vector<std::uint64_t> mBits;
+};
+
+}  // namespace dynamics
+}  // namespace dart
+
+#endif  // DART_DYNAMICS_ALLOWEDCOLLISIONMATRIX_HPP_
@@ -232,6 +232,7 @@ void ArrowShape::configureArrow(const Eigen::Vector3d& _tail,
 
   _updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
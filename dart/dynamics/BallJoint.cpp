@@ -115,7 +115,17 @@ Joint* BallJoint::clone() const
 Eigen::Matrix<double, 6, 3> BallJoint::getRelativeJacobianStatic(
     const Eigen::Vector3d& /*positions*/) const
 {
-  return mJacobian;
+  return math::getAdTMatrix(
+        Joint::mAspectProperties.mT_ChildBodyToJoint).leftCols<3>();
+}
+
+//==============================================================================
+Eigen::Isometry3d BallJoint::computeRelativeTransformStatic(
+    const Eigen::Vector3d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * convertToTransform(_positions)
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
 }
 
 //==============================================================================
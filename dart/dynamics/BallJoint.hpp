@@ -92,6 +92,10 @@ public:
   Eigen::Matrix<double, 6, 3> getRelativeJacobianStatic(
       const Eigen::Vector3d& _positions) const override;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Eigen::Vector3d& _positions) const override;
+
   // Documentation inherited
   Eigen::Vector3d getPositionDifferencesStatic(
       const Eigen::Vector3d& _q2, const Eigen::Vector3d& _q1) const override;
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/BatchForwardKinematics.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "dart/common/ThreadPool.hpp"
+#include "dart/math/Geometry.hpp"
+#include "dart/math/Helpers.hpp"
+#include "dart/math/MathTypes.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/InvalidIndex.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/ScrewJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+namespace dart {
+namespace dynamics {
+
+namespace {
+
+using RowArray = Eigen::Array<double, 1, Eigen::Dynamic>;
+using Matrix34 = Eigen::Matrix<double, 3, 4>;
+
+/// How the relative transform of the parent Joint of a BodyNode is evaluated
+/// for a batch of positions q. In closed form, the top three rows of the
+/// transform are
+///
+///   C0 + q * Cq + sin(w * q) * Cs + cos(w * q) * Cc
+struct BatchJoint
+{
+  /// The Joint, which is evaluated one configuration at a time if it has no
+  /// closed form
+  const Joint* joint;
+
+  /// Whether the closed form is used
+  bool isClosedForm;
+
+  /// Whether the closed form has the Cq term
+  bool hasLinearTerm;
+
+  /// Whether the closed form has the Cs and Cc terms
+  bool hasTrigonometricTerms;
+
+  /// Angular velocity of the rotation per unit of q
+  double w;
+
+  /// Coefficients of the closed form
+  Matrix34 C0;
+  Matrix34 Cq;
+  Matrix34 Cs;
+  Matrix34 Cc;
+
+  /// Index of the parent BodyNode, or INVALID_INDEX
+  std::size_t parentIndex;
+
+  /// Index of the first degree of freedom of the Joint
+  std::size_t dofIndex;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//==============================================================================
+/// Set up the closed form of a rotation of angle w * q about _axis followed
+/// by a translation of q * _translation, between the fixed transforms of
+/// _joint
+void setClosedForm(BatchJoint& _batchJoint, const Joint* _joint,
+                   const Eigen::Vector3d& _axis,
+                   const Eigen::Vector3d& _translation)
+{
+  // Rodrigues' formula: R = (I + K^2) + sin(w * q) * K - cos(w * q) * K^2
+  const double w = _axis.norm();
+  const Eigen::Matrix3d K = w > 0.0 ? math::makeSkewSymmetric(_axis / w)
+                                    : Eigen::Matrix3d::Zero();
+
+  Eigen::Matrix4d E0 = Eigen::Matrix4d::Identity();
+  Eigen::Matrix4d Eq = Eigen::Matrix4d::Zero();
+  Eigen::Matrix4d Es = Eigen::Matrix4d::Zero();
+  Eigen::Matrix4d Ec = Eigen::Matrix4d::Zero();
+  E0.topLeftCorner<3, 3>() += K * K;
+  Eq.topRightCorner<3, 1>() = _translation;
+  Es.topLeftCorner<3, 3>() = K;
+  Ec.topLeftCorner<3, 3>() = -K * K;
+
+  const Eigen::Matrix4d& Tp = _joint->getTransformFromParentBodyNode().matrix();
+  const Eigen::Matrix4d Tc
+      = _joint->getTransformFromChildBodyNode().inverse().matrix();
+
+  _batchJoint.isClosedForm = true;
+  _batchJoint.hasLinearTerm = !_translation.isZero(0.0);
+  _batchJoint.hasTrigonometricTerms = w > 0.0;
+  _batchJoint.w = w;
+  _batchJoint.C0 = (Tp * E0 * Tc).topRows<3>();
+  _batchJoint.Cq = (Tp * Eq * Tc).topRows<3>();
+  _batchJoint.Cs = (Tp * Es * Tc).topRows<3>();
+  _batchJoint.Cc = (Tp * Ec * Tc).topRows<3>();
+}
+
+//==============================================================================
+BatchJoint createBatchJoint(const BodyNode* _bodyNode)
+{
+  const Joint* joint = _bodyNode->getParentJoint();
+  const BodyNode* parent = _bodyNode->getParentBodyNode();
+
+  BatchJoint batchJoint;
+  batchJoint.joint = joint;
+  batchJoint.isClosedForm = false;
+  batchJoint.hasLinearTerm = false;
+  batchJoint.hasTrigonometricTerms = false;
+  batchJoint.w = 0.0;
+  batchJoint.parentIndex
+      = parent ? parent->getIndexInSkeleton() : INVALID_INDEX;
+  batchJoint.dofIndex
+      = joint->getNumDofs() > 0 ? joint->getIndexInSkeleton(0) : 0;
+
+  const std::string& type = joint->getType();
+  if (joint->getNumDofs() == 0)
+  {
+    batchJoint.isClosedForm = true;
+    batchJoint.C0 = joint->computeRelativeTransform(
+          Eigen::VectorXd()).matrix().topRows<3>();
+  }
+  else if (type == RevoluteJoint::getStaticType())
+  {
+    setClosedForm(batchJoint, joint,
+                  static_cast<const RevoluteJoint*>(joint)->getAxis(),
+                  Eigen::Vector3d::Zero());
+  }
+  else if (type == PrismaticJoint::getStaticType())
+  {
+    setClosedForm(batchJoint, joint, Eigen::Vector3d::Zero(),
+                  static_cast<const PrismaticJoint*>(joint)->getAxis());
+  }
+  else if (type == ScrewJoint::getStaticType())
+  {
+    using namespace dart::math::suffixes;
+
+    // Same screw motion as ScrewJoint::computeRelativeTransformStatic()
+    const ScrewJoint* screwJoint = static_cast<const ScrewJoint*>(joint);
+    setClosedForm(batchJoint, joint, screwJoint->getAxis(),
+                  screwJoint->getAxis() * screwJoint->getPitch() * 0.5_pi);
+  }
+
+  return batchJoint;
+}
+
+//==============================================================================
+/// Compute the transforms of configurations [_begin, _end)
+void computeForwardKinematicsRange(
+    const Eigen::aligned_vector<BatchJoint>& _joints,
+    const Eigen::MatrixXd& _positions,
+    BatchTransforms& _transforms,
+    std::size_t _begin, std::size_t _end)
+{
+  const Eigen::Index n = static_cast<Eigen::Index>(_end - _begin);
+
+  RowArray q(n);
+  RowArray s(n);
+  RowArray c(n);
+  Eigen::Array<double, 12, Eigen::Dynamic, Eigen::RowMajor> rel(12, n);
+  Eigen::VectorXd jointPositions;
+
+  for (std::size_t i = 0; i < _joints.size(); ++i)
+  {
+    const BatchJoint& joint = _joints[i];
+
+    // Relative transforms, entry (r, k) in row 3 * k + r
+    if (joint.isClosedForm)
+    {
+      if (joint.hasLinearTerm || joint.hasTrigonometricTerms)
+        q = _positions.row(joint.dofIndex).segment(_begin, n).array();
+
+      if (joint.hasTrigonometricTerms)
+      {
+        s = (joint.w * q).sin();
+        c = (joint.w * q).cos();
+      }
+
+      for (int k = 0; k < 4; ++k)
+      {
+        for (int r = 0; r < 3; ++r)
+        {
+          auto entry = rel.row(3 * k + r);
+          entry.setConstant(joint.C0(r, k));
+          if (joint.hasLinearTerm)
+            entry += joint.Cq(r, k) * q;
+          if (joint.hasTrigonometricTerms)
+            entry += joint.Cs(r, k) * s + joint.Cc(r, k) * c;
+        }
+      }
+    }
+    else
+    {
+      const std::size_t dof = joint.joint->getNumDofs();
+      for (Eigen::Index j = 0; j < n; ++j)
+      {
+        jointPositions
+            = _positions.col(_begin + j).segment(joint.dofIndex, dof);
+        const Eigen::Isometry3d T
+            = joint.joint->computeRelativeTransform(jointPositions);
+        for (int k = 0; k < 4; ++k)
+        {
+          for (int r = 0; r < 3; ++r)
+            rel(3 * k + r, j) = T(r, k);
+        }
+      }
+    }
+
+    // World transforms
+    for (int k = 0; k < 4; ++k)
+    {
+      for (int r = 0; r < 3; ++r)
+      {
+        Eigen::Map<RowArray> world(
+              _transforms.getEntries(i, r, k) + _begin, n);
+
+        if (joint.parentIndex == INVALID_INDEX)
+        {
+          world = rel.row(3 * k + r);
+          continue;
+        }
+
+        const BatchTransforms& transforms = _transforms;
+        Eigen::Map<const RowArray> P0(
+              transforms.getEntries(joint.parentIndex, r, 0) + _begin, n);
+        Eigen::Map<const RowArray> P1(
+              transforms.getEntries(joint.parentIndex, r, 1) + _begin, n);
+        Eigen::Map<const RowArray> P2(
+              transforms.getEntries(joint.parentIndex, r, 2) + _begin, n);
+
+        world = P0 * rel.row(3 * k) + P1 * rel.row(3 * k + 1)
+                + P2 * rel.row(3 * k + 2);
+
+        if (k == 3)
+        {
+          world += Eigen::Map<const RowArray>(
+                transforms.getEntries(joint.parentIndex, r, 3) + _begin, n);
+        }
+      }
+    }
+  }
+}
+
+} // anonymous namespace
+
+//==============================================================================
+BatchTransforms::BatchTransforms()
+  : mNumBodyNodes(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void BatchTransforms::resize(std::size_t _numBodyNodes,
+                             std::size_t _numSamples)
+{
+  mNumBodyNodes = _numBodyNodes;
+  mData.resize(12 * _numBodyNodes, _numSamples);
+}
+
+//==============================================================================
+std::size_t BatchTransforms::getNumBodyNodes() const
+{
+  return mNumBodyNodes;
+}
+
+//==============================================================================
+std::size_t BatchTransforms::getNumSamples() const
+{
+  return static_cast<std::size_t>(mData.cols());
+}
+
+//==============================================================================
+double* BatchTransforms::getEntries(std::size_t _bodyNodeIndex,
+                                    std::size_t _row, std::size_t _col)
+{
+  assert(_bodyNodeIndex < mNumBodyNodes && _row < 3 && _col < 4);
+  return mData.row(12 * _bodyNodeIndex + 3 * _col + _row).data();
+}
+
+//==============================================================================
+const double* BatchTransforms::getEntries(std::size_t _bodyNodeIndex,
+                                          std::size_t _row,
+                                          std::size_t _col) const
+{
+  assert(_bodyNodeIndex < mNumBodyNodes && _row < 3 && _col < 4);
+  return mData.row(12 * _bodyNodeIndex + 3 * _col + _row).data();
+}
+
+//==============================================================================
+Eigen::Isometry3d BatchTransforms::getTransform(std::size_t _bodyNodeIndex,
+                                                std::size_t _sample) const
+{
+  assert(_sample < getNumSamples());
+
+  Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+  for (std::size_t k = 0; k < 4; ++k)
+  {
+    for (std::size_t r = 0; r < 3; ++r)
+      T(r, k) = getEntries(_bodyNodeIndex, r, k)[_sample];
+  }
+
+  return T;
+}
+
+//==============================================================================
+void computeForwardKinematics(const Skeleton& _skeleton,
+                              const Eigen::MatrixXd& _positions,
+                              BatchTransforms& _transforms,
+                              common::ThreadPool* _threadPool)
+{
+  assert(static_cast<std::size_t>(_positions.rows())
+         == _skeleton.getNumDofs());
+
+  const std::size_t numBodyNodes = _skeleton.getNumBodyNodes();
+  const std::size_t numSamples = static_cast<std::size_t>(_positions.cols());
+  _transforms.resize(numBodyNodes, numSamples);
+
+  Eigen::aligned_vector<BatchJoint> joints;
+  joints.reserve(numBodyNodes);
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+    joints.push_back(createBatchJoint(_skeleton.getBodyNode(i)));
+
+  const std::size_t numThreads
+      = _threadPool ? _threadPool->getNumThreads() : 1u;
+  const std::size_t numRanges = std::min(numThreads, numSamples);
+  if (numRanges <= 1u)
+  {
+    computeForwardKinematicsRange(joints, _positions, _transforms,
+                                  0u, numSamples);
+    return;
+  }
+
+  _threadPool->parallelFor(0u, numRanges, [&](std::size_t i) {
+    computeForwardKinematicsRange(joints, _positions, _transforms,
+                                  numSamples * i / numRanges,
+                                  numSamples * (i + 1) / numRanges);
+  });
+}
+
+} // namespace dynamics
+} // namespace dart
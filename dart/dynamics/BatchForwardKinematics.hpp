@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_BATCHFORWARDKINEMATICS_HPP_
+#define DART_DYNAMICS_BATCHFORWARDKINEMATICS_HPP_
+
+#include <Eigen/Dense>
+
+namespace dart {
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
+namespace dynamics {
+
+class Skeleton;
+
+/// BatchTransforms holds the world transforms of the BodyNodes of a Skeleton
+/// for a batch of configurations, as a structure of arrays.
+///
+/// Each of the twelve entries of the top three rows of each transform is
+/// stored as one contiguous array with an element per configuration, so that
+/// the same entry of consecutive configurations can be processed with SIMD
+/// instructions.
+class BatchTransforms
+{
+public:
+  /// Constructor. Creates an empty batch.
+  BatchTransforms();
+
+  /// Size the batch for _numBodyNodes BodyNodes and _numSamples configurations
+  void resize(std::size_t _numBodyNodes, std::size_t _numSamples);
+
+  /// Get the number of BodyNodes
+  std::size_t getNumBodyNodes() const;
+
+  /// Get the number of configurations
+  std::size_t getNumSamples() const;
+
+  /// Get entry (_row, _col) of the world transform of BodyNode _bodyNodeIndex
+  /// for every configuration, as an array of getNumSamples() elements. _row
+  /// must be less than 3 and _col less than 4; the fourth column is the
+  /// translation.
+  double* getEntries(std::size_t _bodyNodeIndex,
+                     std::size_t _row, std::size_t _col);
+
+  /// Const version of getEntries()
+  const double* getEntries(std::size_t _bodyNodeIndex,
+                           std::size_t _row, std::size_t _col) const;
+
+  /// Get the world transform of BodyNode _bodyNodeIndex for configuration
+  /// _sample
+  Eigen::Isometry3d getTransform(std::size_t _bodyNodeIndex,
+                                 std::size_t _sample) const;
+
+protected:
+  /// Number of BodyNodes
+  std::size_t mNumBodyNodes;
+
+  /// Twelve rows per BodyNode, one column per configuration. Entry (r, c) of
+  /// the transform of BodyNode b is row 12 * b + 3 * c + r.
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> mData;
+};
+
+/// Compute the world transforms of the BodyNodes of _skeleton for every column
+/// of _positions, which holds one configuration of all the degrees of freedom
+/// of _skeleton per column, and store them in _transforms. The Skeleton itself
+/// is only read, as in computeForwardKinematics() of SkeletonWorkspace.
+///
+/// The configurations are processed entry by entry rather than configuration
+/// by configuration. RevoluteJoints, PrismaticJoints, ScrewJoints, and
+/// ZeroDofJoints are evaluated in closed form for the whole batch; the other
+/// Joint types are evaluated one configuration at a time. If _threadPool is
+/// given, the configurations are split into one contiguous range per thread.
+void computeForwardKinematics(const Skeleton& _skeleton,
+                              const Eigen::MatrixXd& _positions,
+                              BatchTransforms& _transforms,
+                              common::ThreadPool* _threadPool = nullptr);
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_BATCHFORWARDKINEMATICS_HPP_
@@ -1094,7 +1094,10 @@ const Eigen::Vector6d& BodyNode::getPrimaryRelativeAcceleration() const
 //==============================================================================
 const Eigen::Vector6d& BodyNode::getPartialAcceleration() const
 {
-  if(mIsPartialAccelerationDirty)
+  // The partial acceleration also depends on the velocities of the ancestors,
+  // which do not dirty it directly anymore
+  if(mIsPartialAccelerationDirty
+     || getSpatialVelocityVersion() != mPartialAccelerationVelocityVersion)
     updatePartialAcceleration();
 
   return mPartialAcceleration;
@@ -1237,6 +1240,7 @@ BodyNode::BodyNode(BodyNode* _parentBodyNode, Joint* _parentJoint,
     mParentBodyNode(nullptr),
     mPartialAcceleration(Eigen::Vector6d::Zero()),
     mIsPartialAccelerationDirty(true),
+    mPartialAccelerationVelocityVersion(0u),
     mF(Eigen::Vector6d::Zero()),
     mFgravity(Eigen::Vector6d::Zero()),
     mArtInertia(Eigen::Matrix6d::Identity()),
@@ -1449,6 +1453,7 @@ void BodyNode::dirtyTransform()
     return;
 
   mNeedTransformUpdate = true;
+  incrementGeneration(TRANSFORM_GENERATION);
 
   const SkeletonPtr& skel = getSkeleton();
   if(skel)
@@ -1461,15 +1466,16 @@ void BodyNode::dirtyTransform()
     SET_FLAGS(mGravityForces);
     SET_FLAGS(mCoriolisAndGravityForces);
     SET_FLAGS(mExternalForces);
-  }
 
-  // Child BodyNodes and other generic Entities are notified separately to allow
-  // some optimizations
-  for(std::size_t i=0; i<mChildBodyNodes.size(); ++i)
-    mChildBodyNodes[i]->dirtyTransform();
+    // The EndEffectors of this tree are not notified when their ancestors
+    // move, so the support polygon is dirtied here on their behalf
+    SET_FLAGS(mSupport);
+  }
 
-  for(Entity* entity : mNonBodyNodeEntities)
-    entity->dirtyTransform();
+  // Descendant BodyNodes and other Entities compare the transform version of
+  // this BodyNode with the one they cached when they are queried. Only the ones
+  // that require eager notification are visited.
+  dirtyEagerDescendants(&Entity::dirtyTransform);
 }
 
 //==============================================================================
@@ -1482,6 +1488,7 @@ void BodyNode::dirtyVelocity()
 
   mNeedVelocityUpdate = true;
   mIsPartialAccelerationDirty = true;
+  incrementGeneration(VELOCITY_GENERATION);
 
   const SkeletonPtr& skel = getSkeleton();
   if(skel)
@@ -1490,13 +1497,7 @@ void BodyNode::dirtyVelocity()
     SET_FLAGS(mCoriolisAndGravityForces);
   }
 
-  // Child BodyNodes and other generic Entities are notified separately to allow
-  // some optimizations
-  for(std::size_t i=0; i<mChildBodyNodes.size(); ++i)
-    mChildBodyNodes[i]->dirtyVelocity();
-
-  for(Entity* entity : mNonBodyNodeEntities)
-    entity->dirtyVelocity();
+  dirtyEagerDescendants(&Entity::dirtyVelocity);
 }
 
 //==============================================================================
@@ -1507,12 +1508,9 @@ void BodyNode::dirtyAcceleration()
     return;
 
   mNeedAccelerationUpdate = true;
+  incrementGeneration(ACCELERATION_GENERATION);
 
-  for(std::size_t i=0; i<mChildBodyNodes.size(); ++i)
-    mChildBodyNodes[i]->dirtyAcceleration();
-
-  for(Entity* entity : mNonBodyNodeEntities)
-    entity->dirtyAcceleration();
+  dirtyEagerDescendants(&Entity::dirtyAcceleration);
 }
 
 //==============================================================================
@@ -1576,6 +1574,7 @@ void BodyNode::updatePartialAcceleration() const
   // Compute partial acceleration
   mParentJoint->setPartialAccelerationTo(mPartialAcceleration,
                                          getSpatialVelocity());
+  mPartialAccelerationVelocityVersion = getSpatialVelocityVersion();
   mIsPartialAccelerationDirty = false;
 }
 
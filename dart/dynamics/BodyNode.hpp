@@ -1127,6 +1127,10 @@ protected:
   /// Is the partial acceleration vector dirty
   mutable bool mIsPartialAccelerationDirty;
 
+  /// Velocity version of this BodyNode when the partial acceleration was last
+  /// computed
+  mutable std::size_t mPartialAccelerationVelocityVersion;
+
   /// Transmitted wrench from parent to the bodynode expressed in body-fixed
   /// frame
   Eigen::Vector6d mF;
@@ -1161,6 +1165,10 @@ protected:
   Eigen::Vector6d mM_dV;
   Eigen::Vector6d mM_F;
 
+  /// Cache data for the composite rigid body inertia of the subtree rooted at
+  /// this BodyNode, used by the Composite Rigid Body Algorithm.
+  math::Inertia mCompositeInertia;
+
   /// Cache data for inverse mass matrix of the system.
   Eigen::Vector6d mInvM_c;
   Eigen::Vector6d mInvM_U;
@@ -89,6 +89,7 @@ void BoxShape::setSize(const Eigen::Vector3d& _size) {
   mBoundingBox.setMin(-_size * 0.5);
   mBoundingBox.setMax(_size * 0.5);
   updateVolume();
+  incrementVersion();
 }
 
 const Eigen::Vector3d& BoxShape::getSize() const {
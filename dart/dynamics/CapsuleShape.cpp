@@ -77,6 +77,7 @@ void CapsuleShape::setRadius(double radius)
   mRadius = radius;
   updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -92,6 +93,7 @@ void CapsuleShape::setHeight(double height)
   mHeight = height;
   updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
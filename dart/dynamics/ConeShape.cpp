@@ -77,6 +77,7 @@ void ConeShape::setRadius(double radius)
   mRadius = radius;
   updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -92,6 +93,7 @@ void ConeShape::setHeight(double height)
   mHeight = height;
   updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
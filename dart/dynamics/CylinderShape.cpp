@@ -69,6 +69,7 @@ void CylinderShape::setRadius(double _radius) {
   mRadius = _radius;
   _updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 double CylinderShape::getHeight() const {
@@ -80,6 +81,7 @@ void CylinderShape::setHeight(double _height) {
   mHeight = _height;
   _updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -87,6 +87,7 @@ void EllipsoidShape::setDiameters(const Eigen::Vector3d& diameters)
   mBoundingBox.setMax(diameters * 0.5);
 
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -99,6 +100,7 @@ const Eigen::Vector3d& EllipsoidShape::getDiameters() const
 void EllipsoidShape::setRadii(const Eigen::Vector3d& radii)
 {
   mDiameters = radii * 2.0;
+  incrementVersion();
 }
 
 //==============================================================================
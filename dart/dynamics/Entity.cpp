@@ -42,12 +42,39 @@ namespace dynamics {
 //==============================================================================
 typedef std::set<Entity*> EntityPtrSet;
 
+//==============================================================================
+Entity::KinematicSlotRegister::KinematicSlotRegister(
+    EntitySignal& _signal, Entity* _entity)
+  : common::SlotRegister<EntitySignal>(_signal),
+    mEntity(_entity)
+{
+  // Do nothing
+}
+
+//==============================================================================
+common::Connection Entity::KinematicSlotRegister::connect(
+    const SlotType& _slot)
+{
+  mEntity->requireEagerNotification();
+  return common::SlotRegister<EntitySignal>::connect(_slot);
+}
+
 //==============================================================================
 Entity::Entity(Frame* _refFrame, bool _quiet)
   : mParentFrame(nullptr),
     mNeedTransformUpdate(true),
     mNeedVelocityUpdate(true),
     mNeedAccelerationUpdate(true),
+    mParentTransformVersion(0u),
+    mParentVelocityVersion(0u),
+    mParentAccelerationVersion(0u),
+    mGeneration{{1u}, {1u}, {1u}},
+    mTreeGeneration(mGeneration),
+    mTransformGeneration(0u),
+    mVelocityGeneration(0u),
+    mAccelerationGeneration(0u),
+    mRequiresEagerNotification(false),
+    mNumEagerEntities(0u),
     mFrameChangedSignal(),
     mNameChangedSignal(),
     mTransformUpdatedSignal(),
@@ -55,9 +82,9 @@ Entity::Entity(Frame* _refFrame, bool _quiet)
     mAccelerationChangedSignal(),
     onFrameChanged(mFrameChangedSignal),
     onNameChanged(mNameChangedSignal),
-    onTransformUpdated(mTransformUpdatedSignal),
-    onVelocityChanged(mVelocityChangedSignal),
-    onAccelerationChanged(mAccelerationChangedSignal),
+    onTransformUpdated(mTransformUpdatedSignal, this),
+    onVelocityChanged(mVelocityChangedSignal, this),
+    onAccelerationChanged(mAccelerationChangedSignal, this),
     mAmQuiet(_quiet),
     mAmFrame(false)
 {
@@ -136,7 +163,11 @@ void Entity::notifyTransformUpdate()
 //==============================================================================
 void Entity::dirtyTransform()
 {
-  mNeedTransformUpdate = true;
+  if(!mNeedTransformUpdate)
+  {
+    mNeedTransformUpdate = true;
+    incrementGeneration(TRANSFORM_GENERATION);
+  }
 
   // The actual transform hasn't updated yet. But when its getter is called,
   // the transformation will be updated automatically.
@@ -146,7 +177,21 @@ void Entity::dirtyTransform()
 //==============================================================================
 bool Entity::needsTransformUpdate() const
 {
-  return mNeedTransformUpdate;
+  if(mNeedTransformUpdate)
+    return true;
+
+  // If nothing in this tree has been dirtied since the last check, then the
+  // parent Frame cannot have changed either
+  const std::size_t generation = getTreeGeneration(TRANSFORM_GENERATION);
+  if(generation != 0u
+     && mTransformGeneration.load(std::memory_order_relaxed) == generation)
+    return false;
+
+  if(mParentFrame && mParentFrame->getWorldTransformVersion() != mParentTransformVersion)
+    return true;
+
+  mTransformGeneration.store(generation, std::memory_order_relaxed);
+  return false;
 }
 
 //==============================================================================
@@ -158,7 +203,11 @@ void Entity::notifyVelocityUpdate()
 //==============================================================================
 void Entity::dirtyVelocity()
 {
-  mNeedVelocityUpdate = true;
+  if(!mNeedVelocityUpdate)
+  {
+    mNeedVelocityUpdate = true;
+    incrementGeneration(VELOCITY_GENERATION);
+  }
 
   // The actual velocity hasn't updated yet. But when its getter is called,
   // the velocity will be updated automatically.
@@ -168,7 +217,21 @@ void Entity::dirtyVelocity()
 //==============================================================================
 bool Entity::needsVelocityUpdate() const
 {
-  return mNeedVelocityUpdate;
+  if(mNeedVelocityUpdate)
+    return true;
+
+  // If nothing in this tree has been dirtied since the last check, then the
+  // parent Frame cannot have changed either
+  const std::size_t generation = getTreeGeneration(VELOCITY_GENERATION);
+  if(generation != 0u
+     && mVelocityGeneration.load(std::memory_order_relaxed) == generation)
+    return false;
+
+  if(mParentFrame && mParentFrame->getSpatialVelocityVersion() != mParentVelocityVersion)
+    return true;
+
+  mVelocityGeneration.store(generation, std::memory_order_relaxed);
+  return false;
 }
 
 //==============================================================================
@@ -180,7 +243,11 @@ void Entity::notifyAccelerationUpdate()
 //==============================================================================
 void Entity::dirtyAcceleration()
 {
-  mNeedAccelerationUpdate = true;
+  if(!mNeedAccelerationUpdate)
+  {
+    mNeedAccelerationUpdate = true;
+    incrementGeneration(ACCELERATION_GENERATION);
+  }
 
   // The actual acceleration hasn't updated yet. But when its getter is called,
   // the acceleration will be updated automatically.
@@ -190,7 +257,138 @@ void Entity::dirtyAcceleration()
 //==============================================================================
 bool Entity::needsAccelerationUpdate() const
 {
-  return mNeedAccelerationUpdate;
+  if(mNeedAccelerationUpdate)
+    return true;
+
+  // If nothing in this tree has been dirtied since the last check, then the
+  // parent Frame cannot have changed either
+  const std::size_t generation = getTreeGeneration(ACCELERATION_GENERATION);
+  if(generation != 0u
+     && mAccelerationGeneration.load(std::memory_order_relaxed) == generation)
+    return false;
+
+  if(mParentFrame && mParentFrame->getSpatialAccelerationVersion() != mParentAccelerationVersion)
+    return true;
+
+  mAccelerationGeneration.store(generation, std::memory_order_relaxed);
+  return false;
+}
+
+//==============================================================================
+void Entity::clearTransformUpdate() const
+{
+  const std::size_t generation = getTreeGeneration(TRANSFORM_GENERATION);
+  if(mParentFrame)
+    mParentTransformVersion = mParentFrame->getWorldTransformVersion();
+
+  mNeedTransformUpdate = false;
+  mTransformGeneration.store(generation, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void Entity::clearVelocityUpdate() const
+{
+  const std::size_t generation = getTreeGeneration(VELOCITY_GENERATION);
+  if(mParentFrame)
+    mParentVelocityVersion = mParentFrame->getSpatialVelocityVersion();
+
+  mNeedVelocityUpdate = false;
+  mVelocityGeneration.store(generation, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void Entity::clearAccelerationUpdate() const
+{
+  const std::size_t generation = getTreeGeneration(ACCELERATION_GENERATION);
+  if(mParentFrame)
+    mParentAccelerationVersion = mParentFrame->getSpatialAccelerationVersion();
+
+  mNeedAccelerationUpdate = false;
+  mAccelerationGeneration.store(generation, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void Entity::incrementGeneration(GenerationKind _kind)
+{
+  if(mTreeGeneration)
+    mTreeGeneration[_kind].fetch_add(1u, std::memory_order_relaxed);
+}
+
+//==============================================================================
+std::size_t Entity::getTreeGeneration(GenerationKind _kind) const
+{
+  if(mTreeGeneration)
+    return mTreeGeneration[_kind].load(std::memory_order_relaxed);
+
+  // Zero is never the generation of a tree, so nothing will be skipped
+  return 0u;
+}
+
+//==============================================================================
+void Entity::updateGenerationScope()
+{
+  std::atomic<std::size_t>* treeGeneration;
+  if(nullptr == mParentFrame || mParentFrame->isWorld())
+    treeGeneration = mGeneration;
+  else if(mAmQuiet)
+    treeGeneration = nullptr;
+  else
+    treeGeneration = mParentFrame->mTreeGeneration;
+
+  if(treeGeneration == mTreeGeneration)
+    return;
+
+  // The generations recorded so far belong to the previous tree, so they must
+  // not be mistaken for generations of the new one
+  mTreeGeneration = treeGeneration;
+  mTransformGeneration.store(0u, std::memory_order_relaxed);
+  mVelocityGeneration.store(0u, std::memory_order_relaxed);
+  mAccelerationGeneration.store(0u, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void Entity::requireEagerNotification()
+{
+  if(mRequiresEagerNotification)
+    return;
+
+  mRequiresEagerNotification = true;
+  ++mNumEagerEntities;
+
+  if(!mAmQuiet)
+    addEagerEntitiesToAncestors(1u);
+}
+
+//==============================================================================
+void Entity::addEagerEntitiesToAncestors(std::size_t _count)
+{
+  Frame* frame = mParentFrame;
+  while(frame && !frame->isWorld())
+  {
+    frame->mNumEagerEntities += _count;
+
+    // A quiet Frame is not visited by its own parent
+    if(frame->mAmQuiet)
+      break;
+
+    frame = frame->mParentFrame;
+  }
+}
+
+//==============================================================================
+void Entity::removeEagerEntitiesFromAncestors(std::size_t _count)
+{
+  Frame* frame = mParentFrame;
+  while(frame && !frame->isWorld())
+  {
+    assert(frame->mNumEagerEntities >= _count);
+    frame->mNumEagerEntities -= _count;
+
+    if(frame->mAmQuiet)
+      break;
+
+    frame = frame->mParentFrame;
+  }
 }
 
 //==============================================================================
@@ -199,6 +397,16 @@ Entity::Entity(ConstructFrameTag)
     mNeedTransformUpdate(true),
     mNeedVelocityUpdate(true),
     mNeedAccelerationUpdate(true),
+    mParentTransformVersion(0u),
+    mParentVelocityVersion(0u),
+    mParentAccelerationVersion(0u),
+    mGeneration{{1u}, {1u}, {1u}},
+    mTreeGeneration(mGeneration),
+    mTransformGeneration(0u),
+    mVelocityGeneration(0u),
+    mAccelerationGeneration(0u),
+    mRequiresEagerNotification(false),
+    mNumEagerEntities(0u),
     mFrameChangedSignal(),
     mNameChangedSignal(),
     mTransformUpdatedSignal(),
@@ -206,9 +414,9 @@ Entity::Entity(ConstructFrameTag)
     mAccelerationChangedSignal(),
     onFrameChanged(mFrameChangedSignal),
     onNameChanged(mNameChangedSignal),
-    onTransformUpdated(mTransformUpdatedSignal),
-    onVelocityChanged(mVelocityChangedSignal),
-    onAccelerationChanged(mAccelerationChangedSignal),
+    onTransformUpdated(mTransformUpdatedSignal, this),
+    onVelocityChanged(mVelocityChangedSignal, this),
+    onAccelerationChanged(mAccelerationChangedSignal, this),
     mAmQuiet(false),
     mAmFrame(false) // The Frame class will change this to true
 {
@@ -219,9 +427,9 @@ Entity::Entity(ConstructFrameTag)
 Entity::Entity(ConstructAbstractTag)
   : onFrameChanged(mFrameChangedSignal),
     onNameChanged(mNameChangedSignal),
-    onTransformUpdated(mTransformUpdatedSignal),
-    onVelocityChanged(mVelocityChangedSignal),
-    onAccelerationChanged(mAccelerationChangedSignal),
+    onTransformUpdated(mTransformUpdatedSignal, this),
+    onVelocityChanged(mVelocityChangedSignal, this),
+    onAccelerationChanged(mAccelerationChangedSignal, this),
     mAmQuiet(false)
 {
   dterr << "[Entity::Entity] Your class implementation is calling the Entity "
@@ -237,6 +445,9 @@ void Entity::changeParentFrame(Frame* _newParentFrame)
 
   const Frame* oldParentFrame = mParentFrame;
 
+  if (!mAmQuiet && mNumEagerEntities > 0u)
+    removeEagerEntitiesFromAncestors(mNumEagerEntities);
+
   if (!mAmQuiet && nullptr != mParentFrame && !mParentFrame->isWorld())
   {
     // If this entity has a parent Frame, tell that parent that it is losing
@@ -250,6 +461,10 @@ void Entity::changeParentFrame(Frame* _newParentFrame)
   }
 
   mParentFrame =_newParentFrame;
+  updateGenerationScope();
+
+  if (!mAmQuiet && mNumEagerEntities > 0u)
+    addEagerEntitiesToAncestors(mNumEagerEntities);
 
   if (!mAmQuiet && nullptr != mParentFrame)
   {
@@ -33,6 +33,7 @@
 #define DART_DYNAMICS_ENTITY_HPP_
 
 #include <Eigen/Core>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -70,6 +71,24 @@ public:
                             const std::string& _oldName,
                             const std::string& _newName)>;
 
+  /// SlotRegister for the transform, velocity and acceleration signals of an
+  /// Entity. Connecting a slot makes the ancestors of the Entity dirty it as
+  /// soon as they change, so the signal is raised even if the Entity itself is
+  /// never queried.
+  class KinematicSlotRegister : public common::SlotRegister<EntitySignal>
+  {
+  public:
+    /// Constructor
+    KinematicSlotRegister(EntitySignal& _signal, Entity* _entity);
+
+    /// Connect a slot to the signal
+    common::Connection connect(const SlotType& _slot);
+
+  private:
+    /// The Entity that owns the signal
+    Entity* mEntity;
+  };
+
   /// Constructor for typical usage
   explicit Entity(Frame* _refFrame, bool _quiet);
 
@@ -122,7 +141,9 @@ public:
   /// pose is needed
   virtual void dirtyTransform();
 
-  /// Returns true iff a transform update is needed for this Entity
+  /// Returns true iff a transform update is needed for this Entity. This is
+  /// the case if the transform was dirtied directly, or if the transform of
+  /// the parent Frame has been recomputed since this Entity was last updated.
   bool needsTransformUpdate() const;
 
   /// Notify the velocity update of this Entity that its parent Frame's velocity
@@ -134,7 +155,9 @@ public:
   /// is needed
   virtual void dirtyVelocity();
 
-  /// Returns true iff a velocity update is needed for this Entity
+  /// Returns true iff a velocity update is needed for this Entity. This is the
+  /// case if the velocity was dirtied directly, or if the velocity of the
+  /// parent Frame has been recomputed since this Entity was last updated.
   bool needsVelocityUpdate() const;
 
   /// Notify the acceleration of this Entity that its parent Frame's
@@ -146,7 +169,10 @@ public:
   /// acceleration is needed
   virtual void dirtyAcceleration();
 
-  /// Returns true iff an acceleration update is needed for this Entity
+  /// Returns true iff an acceleration update is needed for this Entity. This
+  /// is the case if the acceleration was dirtied directly, or if the
+  /// acceleration of the parent Frame has been recomputed since this Entity was
+  /// last updated.
   bool needsAccelerationUpdate() const;
 
 protected:
@@ -166,6 +192,58 @@ protected:
   /// Used by derived classes to change their parent frames
   virtual void changeParentFrame(Frame* _newParentFrame);
 
+  /// Record that the transform of this Entity is up to date with the current
+  /// transform of its parent Frame
+  void clearTransformUpdate() const;
+
+  /// Record that the velocity of this Entity is up to date with the current
+  /// velocity of its parent Frame
+  void clearVelocityUpdate() const;
+
+  /// Record that the acceleration of this Entity is up to date with the
+  /// current acceleration of its parent Frame
+  void clearAccelerationUpdate() const;
+
+  /// Kinds of changes that the generation of a kinematic tree counts
+  /// separately, so that dirtying the velocities of a tree doesn't make its
+  /// transforms look out of date
+  enum GenerationKind
+  {
+    TRANSFORM_GENERATION = 0,
+    VELOCITY_GENERATION,
+    ACCELERATION_GENERATION,
+    NUM_GENERATION_KINDS
+  };
+
+  /// Advance the generation of the given kind of the kinematic tree of this
+  /// Entity. This must be called whenever the corresponding update flag of an
+  /// Entity goes from clean to dirty, because it tells every Entity below it
+  /// that its parent Frame might have changed since it was last checked.
+  void incrementGeneration(GenerationKind _kind);
+
+  /// Get the current generation of the given kind of the kinematic tree of
+  /// this Entity, or zero if the tree generation cannot be used
+  std::size_t getTreeGeneration(GenerationKind _kind) const;
+
+  /// Point this Entity at the generation of its kinematic tree. This must be
+  /// called whenever the parent Frame changes. Frames pass it on to their
+  /// children.
+  virtual void updateGenerationScope();
+
+  /// Make the ancestors of this Entity dirty it whenever they are dirtied,
+  /// instead of leaving it to compare versions when it is queried. This is
+  /// needed when something must react to a change right away, such as the
+  /// slots that are connected to the signals of this Entity.
+  void requireEagerNotification();
+
+  /// Add _count to the number of Entities that require eager notification in
+  /// the subtrees of the ancestors of this Entity
+  void addEagerEntitiesToAncestors(std::size_t _count);
+
+  /// Subtract _count from the number of Entities that require eager
+  /// notification in the subtrees of the ancestors of this Entity
+  void removeEagerEntitiesFromAncestors(std::size_t _count);
+
 protected:
 
   /// Parent frame of this Entity
@@ -183,6 +261,58 @@ protected:
   mutable bool mNeedAccelerationUpdate;
   // TODO(JS): Rename this to mIsAccelerationDirty in DART 7
 
+  /// Transform version of the parent Frame when the transform of this Entity
+  /// was last updated
+  mutable std::size_t mParentTransformVersion;
+
+  /// Velocity version of the parent Frame when the velocity of this Entity was
+  /// last updated
+  mutable std::size_t mParentVelocityVersion;
+
+  /// Acceleration version of the parent Frame when the acceleration of this
+  /// Entity was last updated
+  mutable std::size_t mParentAccelerationVersion;
+
+  /// Generations of each kind of the kinematic tree that this Entity is the
+  /// root of. They are only used when the parent Frame is the World Frame or
+  /// nullptr.
+  std::atomic<std::size_t> mGeneration[NUM_GENERATION_KINDS];
+
+  /// Generations of the kinematic tree of this Entity, which are the
+  /// mGeneration of its root. This is nullptr for a quiet Entity that is not a
+  /// root and for everything below it, because its parent Frame does not tell
+  /// it when the tree changes. In that case the parent Frame is always checked.
+  std::atomic<std::size_t>* mTreeGeneration;
+
+  /// The transform generation at which the transform of this Entity was last
+  /// confirmed to be up to date. While it matches the transform generation of
+  /// the tree, no transform in the tree has been dirtied, so the parent Frame
+  /// does not need to be checked again.
+  ///
+  /// These are atomic because they are the only state that a query writes
+  /// when everything above the Entity is already up to date. Querying an
+  /// Entity whose parent Frame has changed recomputes cached kinematics, so
+  /// that is not safe to do from several threads at once. Querying the
+  /// transform of an up-to-date Entity writes nothing, even while the
+  /// velocities of its tree are being dirtied.
+  mutable std::atomic<std::size_t> mTransformGeneration;
+
+  /// The velocity generation at which the velocity of this Entity was last
+  /// confirmed to be up to date
+  mutable std::atomic<std::size_t> mVelocityGeneration;
+
+  /// The acceleration generation at which the acceleration of this Entity was
+  /// last confirmed to be up to date
+  mutable std::atomic<std::size_t> mAccelerationGeneration;
+
+  /// Whether the ancestors of this Entity dirty it whenever they are dirtied
+  bool mRequiresEagerNotification;
+
+  /// Number of Entities that require eager notification in the subtree of this
+  /// Entity, including itself. A dirtied Frame only visits the children whose
+  /// count is not zero.
+  std::size_t mNumEagerEntities;
+
   /// Frame changed signal
   FrameChangedSignal mFrameChangedSignal;
 
@@ -210,13 +340,13 @@ public:
   common::SlotRegister<NameChangedSignal> onNameChanged;
 
   /// Slot register for transform updated signal
-  common::SlotRegister<EntitySignal> onTransformUpdated;
+  KinematicSlotRegister onTransformUpdated;
 
   /// Slot register for velocity updated signal
-  common::SlotRegister<EntitySignal> onVelocityChanged;
+  KinematicSlotRegister onVelocityChanged;
 
   /// Slot register for acceleration updated signal
-  common::SlotRegister<EntitySignal> onAccelerationChanged;
+  KinematicSlotRegister onAccelerationChanged;
 
 private:
   /// Whether or not this Entity is set to be quiet
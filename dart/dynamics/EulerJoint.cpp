@@ -265,8 +265,8 @@ Eigen::Matrix<double, 6, 3> EulerJoint::getRelativeJacobianStatic(
   assert(!math::isNan(J));
 
 #ifndef NDEBUG
-  Eigen::MatrixXd JTJ = J.transpose() * J;
-  Eigen::FullPivLU<Eigen::MatrixXd> luJTJ(JTJ);
+  const Eigen::Matrix3d JTJ = J.transpose() * J;
+  Eigen::FullPivLU<Eigen::Matrix3d> luJTJ(JTJ);
   //    Eigen::FullPivLU<Eigen::MatrixXd> luS(mS);
   double det = luJTJ.determinant();
   if (det < 1e-5)
@@ -331,11 +331,19 @@ void EulerJoint::updateDegreeOfFreedomNames()
   }
 }
 
+//==============================================================================
+Eigen::Isometry3d EulerJoint::computeRelativeTransformStatic(
+    const Eigen::Vector3d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * convertToTransform(_positions)
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 void EulerJoint::updateRelativeTransform() const
 {
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint * convertToTransform(getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   assert(math::verifyTransform(mT));
 }
@@ -347,17 +355,17 @@ void EulerJoint::updateRelativeJacobian(bool) const
 }
 
 //==============================================================================
-void EulerJoint::updateRelativeJacobianTimeDeriv() const
+Eigen::Matrix<double, 6, 3> EulerJoint::computeRelativeJacobianTimeDerivStatic(
+    const Eigen::Vector3d& _positions,
+    const Eigen::Vector3d& _velocities) const
 {
-  // double q0 = mPositions[0];
-  const Eigen::Vector3d& positions = getPositionsStatic();
-  double q1 = positions[1];
-  double q2 = positions[2];
+  // double q0 = _positions[0];
+  double q1 = _positions[1];
+  double q2 = _positions[2];
 
-  // double dq0 = mVelocities[0];
-  const Eigen::Vector3d& velocities = getVelocitiesStatic();
-  double dq1 = velocities[1];
-  double dq2 = velocities[2];
+  // double dq0 = _velocities[0];
+  double dq1 = _velocities[1];
+  double dq2 = _velocities[2];
 
   // double c0 = cos(q0);
   double c1 = cos(q1);
@@ -414,11 +422,93 @@ void EulerJoint::updateRelativeJacobianTimeDeriv() const
     }
   }
 
-  mJacobianDeriv.col(0) = math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint, dJ0);
-  mJacobianDeriv.col(1) = math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint, dJ1);
-  mJacobianDeriv.col(2) = math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint, dJ2);
+  Eigen::Matrix<double, 6, 3> dJ;
+  dJ.col(0) = math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint, dJ0);
+  dJ.col(1) = math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint, dJ1);
+  dJ.col(2) = math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint, dJ2);
+
+  assert(!math::isNan(dJ));
+
+  return dJ;
+}
 
-  assert(!math::isNan(mJacobianDeriv));
+//==============================================================================
+Eigen::Matrix<double, 6, 3>
+EulerJoint::computeRelativeJacobianTimeDerivDerivStatic(
+    const Eigen::Vector3d& _positions,
+    const Eigen::Vector3d& _velocities,
+    std::size_t _index) const
+{
+  double q1 = _positions[1];
+  double q2 = _positions[2];
+
+  double dq1 = _velocities[1];
+  double dq2 = _velocities[2];
+
+  double c1 = cos(q1);
+  double c2 = cos(q2);
+
+  double s1 = sin(q1);
+  double s2 = sin(q2);
+
+  // Derivatives of the columns of dS with respect to the position _index.
+  // dS doesn't depend on the first position, and its last column is zero.
+  Eigen::Vector6d ddJ0 = Eigen::Vector6d::Zero();
+  Eigen::Vector6d ddJ1 = Eigen::Vector6d::Zero();
+
+  switch (getAxisOrder())
+  {
+    case AxisOrder::XYZ:
+    {
+      if (_index == 1)
+      {
+        ddJ0 << -(dq1*c2*c1) + dq2*s1*s2, dq2*s1*c2 + dq1*c1*s2, -(dq1*s1),
+                0.0, 0.0, 0.0;
+      }
+      else if (_index == 2)
+      {
+        ddJ0 << dq1*s2*s1 - dq2*c1*c2, dq2*c1*s2 + dq1*s1*c2, 0.0,
+                0.0, 0.0, 0.0;
+        ddJ1 << -(dq2*s2), -(dq2*c2), 0.0, 0.0, 0.0, 0.0;
+      }
+      break;
+    }
+    case AxisOrder::ZYX:
+    {
+      if (_index == 1)
+      {
+        ddJ0 << s1*dq1, -c2*s1*dq2 - s2*c1*dq1, -c1*c2*dq1 + s1*s2*dq2,
+                0.0, 0.0, 0.0;
+      }
+      else if (_index == 2)
+      {
+        ddJ0 << 0.0, -s2*c1*dq2 - c2*s1*dq1, s1*s2*dq1 - c1*c2*dq2,
+                0.0, 0.0, 0.0;
+        ddJ1 << 0.0, -c2*dq2, s2*dq2, 0.0, 0.0, 0.0;
+      }
+      break;
+    }
+    default:
+    {
+      dterr << "Undefined Euler axis order\n";
+      break;
+    }
+  }
+
+  Eigen::Matrix<double, 6, 3> ddJ = Eigen::Matrix<double, 6, 3>::Zero();
+  ddJ.col(0) = math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint, ddJ0);
+  ddJ.col(1) = math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint, ddJ1);
+
+  assert(!math::isNan(ddJ));
+
+  return ddJ;
+}
+
+//==============================================================================
+void EulerJoint::updateRelativeJacobianTimeDeriv() const
+{
+  mJacobianDeriv = computeRelativeJacobianTimeDerivStatic(
+        getPositionsStatic(), getVelocitiesStatic());
 }
 
 }  // namespace dynamics
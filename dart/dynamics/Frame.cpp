@@ -80,15 +80,23 @@ const Eigen::Isometry3d& Frame::getWorldTransform() const
   if(mAmWorld)
     return mWorldTransform;
 
-  if(mNeedTransformUpdate)
+  if(needsTransformUpdate())
   {
     mWorldTransform = mParentFrame->getWorldTransform()*getRelativeTransform();
-    mNeedTransformUpdate = false;
+    clearTransformUpdate();
+    ++mWorldTransformVersion;
   }
 
   return mWorldTransform;
 }
 
+//==============================================================================
+std::size_t Frame::getWorldTransformVersion() const
+{
+  getWorldTransform();
+  return mWorldTransformVersion;
+}
+
 //==============================================================================
 Eigen::Isometry3d Frame::getTransform(const Frame* _withRespectTo) const
 {
@@ -126,18 +134,26 @@ const Eigen::Vector6d& Frame::getSpatialVelocity() const
   if(mAmWorld)
     return mVelocity;
 
-  if(mNeedVelocityUpdate)
+  if(needsVelocityUpdate())
   {
     mVelocity = math::AdInvT(getRelativeTransform(),
                              getParentFrame()->getSpatialVelocity())
                 + getRelativeSpatialVelocity();
 
-    mNeedVelocityUpdate = false;
+    clearVelocityUpdate();
+    ++mVelocityVersion;
   }
 
   return mVelocity;
 }
 
+//==============================================================================
+std::size_t Frame::getSpatialVelocityVersion() const
+{
+  getSpatialVelocity();
+  return mVelocityVersion;
+}
+
 //==============================================================================
 Eigen::Vector6d Frame::getSpatialVelocity(const Frame* _relativeTo,
                                           const Frame* _inCoordinatesOf) const
@@ -231,19 +247,27 @@ const Eigen::Vector6d& Frame::getSpatialAcceleration() const
   if(mAmWorld)
     return mAcceleration;
 
-  if(mNeedAccelerationUpdate)
+  if(needsAccelerationUpdate())
   {
     mAcceleration = math::AdInvT(getRelativeTransform(),
                                  getParentFrame()->getSpatialAcceleration())
         + getPrimaryRelativeAcceleration()
         + getPartialAcceleration();
 
-    mNeedAccelerationUpdate = false;
+    clearAccelerationUpdate();
+    ++mAccelerationVersion;
   }
 
   return mAcceleration;
 }
 
+//==============================================================================
+std::size_t Frame::getSpatialAccelerationVersion() const
+{
+  getSpatialAcceleration();
+  return mAccelerationVersion;
+}
+
 //==============================================================================
 Eigen::Vector6d Frame::getSpatialAcceleration(
     const Frame* _relativeTo, const Frame* _inCoordinatesOf) const
@@ -460,9 +484,9 @@ void Frame::dirtyTransform()
     return;
 
   mNeedTransformUpdate = true;
+  incrementGeneration(TRANSFORM_GENERATION);
 
-  for(Entity* entity : mChildEntities)
-    entity->dirtyTransform();
+  dirtyEagerDescendants(&Entity::dirtyTransform);
 }
 
 //==============================================================================
@@ -479,9 +503,9 @@ void Frame::dirtyVelocity()
     return;
 
   mNeedVelocityUpdate = true;
+  incrementGeneration(VELOCITY_GENERATION);
 
-  for(Entity* entity : mChildEntities)
-    entity->dirtyVelocity();
+  dirtyEagerDescendants(&Entity::dirtyVelocity);
 }
 
 //==============================================================================
@@ -496,17 +520,20 @@ void Frame::dirtyAcceleration()
     return;
 
   mNeedAccelerationUpdate = true;
+  incrementGeneration(ACCELERATION_GENERATION);
 
-  for(Entity* entity : mChildEntities)
-    entity->dirtyAcceleration();
+  dirtyEagerDescendants(&Entity::dirtyAcceleration);
 }
 
 //==============================================================================
 Frame::Frame(Frame* _refFrame)
   : Entity(ConstructFrame),
     mWorldTransform(Eigen::Isometry3d::Identity()),
+    mWorldTransformVersion(0u),
     mVelocity(Eigen::Vector6d::Zero()),
+    mVelocityVersion(0u),
     mAcceleration(Eigen::Vector6d::Zero()),
+    mAccelerationVersion(0u),
     mAmWorld(false),
     mAmShapeFrame(false)
 {
@@ -524,6 +551,9 @@ Frame::Frame()
 //==============================================================================
 Frame::Frame(ConstructAbstractTag)
   : Entity(Entity::ConstructAbstract),
+    mWorldTransformVersion(0u),
+    mVelocityVersion(0u),
+    mAccelerationVersion(0u),
     mAmWorld(false),
     mAmShapeFrame(false)
 {
@@ -574,6 +604,40 @@ void Frame::changeParentFrame(Frame* _newParentFrame)
   Entity::changeParentFrame(_newParentFrame);
 }
 
+//==============================================================================
+void Frame::updateGenerationScope()
+{
+  const std::atomic<std::size_t>* oldTreeGeneration = mTreeGeneration;
+  Entity::updateGenerationScope();
+
+  // If this Frame stayed in its tree, then so did everything below it
+  if(mTreeGeneration == oldTreeGeneration)
+    return;
+
+  for(Entity* entity : mChildEntities)
+    entity->updateGenerationScope();
+}
+
+//==============================================================================
+void Frame::dirtyEagerDescendants(void (Entity::*_dirty)())
+{
+  // Nothing below this Frame needs to be visited
+  if(mNumEagerEntities == (mRequiresEagerNotification ? 1u : 0u))
+    return;
+
+  for(Entity* entity : mChildEntities)
+  {
+    if(entity->mRequiresEagerNotification)
+      (entity->*_dirty)();
+  }
+
+  for(Frame* frame : mChildFrames)
+  {
+    if(!frame->mRequiresEagerNotification && frame->mNumEagerEntities > 0u)
+      frame->dirtyEagerDescendants(_dirty);
+  }
+}
+
 //==============================================================================
 void Frame::processNewEntity(Entity*)
 {
@@ -590,8 +654,11 @@ void Frame::processRemovedEntity(Entity*)
 Frame::Frame(ConstructWorldTag)
   : Entity(this, true),
     mWorldTransform(Eigen::Isometry3d::Identity()),
+    mWorldTransformVersion(0u),
     mVelocity(Eigen::Vector6d::Zero()),
+    mVelocityVersion(0u),
     mAcceleration(Eigen::Vector6d::Zero()),
+    mAccelerationVersion(0u),
     mAmWorld(true),
     mAmShapeFrame(false)
 {
@@ -76,6 +76,12 @@ public:
   /// Get the transform of this Frame with respect to the World Frame
   const Eigen::Isometry3d& getWorldTransform() const;
 
+  /// Get the number of times the transform of this Frame with respect to the
+  /// World Frame has been recomputed. If this value is the same as the last
+  /// time it was checked, then this Frame has not moved since then. Calling
+  /// this function brings the world transform up to date.
+  std::size_t getWorldTransformVersion() const;
+
   /// Get the transform of this Frame with respect to some other Frame
   Eigen::Isometry3d getTransform(
       const Frame* _withRespectTo = Frame::World()) const;
@@ -97,6 +103,10 @@ public:
   /// Frame.
   const Eigen::Vector6d& getSpatialVelocity() const;
 
+  /// Get the number of times the total spatial velocity of this Frame has been
+  /// recomputed. Calling this function brings the velocity up to date.
+  std::size_t getSpatialVelocityVersion() const;
+
   /// Get the spatial velocity of this Frame relative to some other Frame. It
   /// can be expressed in the coordinates of any Frame.
   Eigen::Vector6d getSpatialVelocity(const Frame* _relativeTo,
@@ -160,6 +170,11 @@ public:
   /// this Frame.
   const Eigen::Vector6d& getSpatialAcceleration() const;
 
+  /// Get the number of times the total spatial acceleration of this Frame has
+  /// been recomputed. Calling this function brings the acceleration up to
+  /// date.
+  std::size_t getSpatialAccelerationVersion() const;
+
   /// Get the spatial acceleration of this Frame relative to some other Frame.
   /// It can be expressed in the coordinates of any Frame.
   Eigen::Vector6d getSpatialAcceleration(const Frame* _relativeTo,
@@ -238,15 +253,20 @@ public:
   /// Returns true if this Frame is the World Frame
   bool isWorld() const;
 
-  /// Notify the transformation updates of this Frame and all its children are
-  /// needed
+  /// Notify that the transformation update of this Frame is needed. Only the
+  /// descendants that require eager notification, such as those with
+  /// connected slots, are dirtied as well. The others notice the change by
+  /// comparing the transform version of this Frame with the one they cached.
   virtual void dirtyTransform() override;
 
-  /// Notify the velocity updates of this Frame and all its children are needed
+  /// Notify that the velocity update of this Frame is needed. The descendants
+  /// that do not require eager notification notice the change through the
+  /// velocity version.
   virtual void dirtyVelocity() override;
 
-  /// Notify the acceleration updates of this Frame and all its children are
-  /// needed
+  /// Notify that the acceleration update of this Frame is needed. The
+  /// descendants that do not require eager notification notice the change
+  /// through the acceleration version.
   virtual void dirtyAcceleration() override;
 
 protected:
@@ -267,6 +287,14 @@ protected:
   // Documentation inherited
   virtual void changeParentFrame(Frame* _newParentFrame) override;
 
+  /// Point this Frame and all of its descendants at the generation of their
+  /// kinematic tree
+  virtual void updateGenerationScope() override;
+
+  /// Call _dirty on the nearest descendants of this Frame that require eager
+  /// notification. They pass it on to the ones below them.
+  void dirtyEagerDescendants(void (Entity::*_dirty)());
+
   /// Called during a parent Frame change to allow extensions of the Frame class
   /// to handle new children in customized ways. This function is a no op unless
   /// an inheriting class (such as BodyNode) overrides it.
@@ -291,16 +319,34 @@ protected:
   /// Do not use directly! Use getWorldTransform() to access this quantity
   mutable Eigen::Isometry3d mWorldTransform;
 
+  /// Incremented every time mWorldTransform is recomputed
+  ///
+  /// Do not use directly! Use getWorldTransformVersion() to access this
+  /// quantity
+  mutable std::size_t mWorldTransformVersion;
+
   /// Total velocity of this Frame, in the coordinates of this Frame
   ///
   /// Do not use directly! Use getSpatialVelocity() to access this quantity
   mutable Eigen::Vector6d mVelocity;
 
+  /// Incremented every time mVelocity is recomputed
+  ///
+  /// Do not use directly! Use getSpatialVelocityVersion() to access this
+  /// quantity
+  mutable std::size_t mVelocityVersion;
+
   /// Total acceleration of this Frame, in the coordinates of this Frame
   ///
   /// Do not use directly! Use getSpatialAcceleration() to access this quantity
   mutable Eigen::Vector6d mAcceleration;
 
+  /// Incremented every time mAcceleration is recomputed
+  ///
+  /// Do not use directly! Use getSpatialAccelerationVersion() to access this
+  /// quantity
+  mutable std::size_t mAccelerationVersion;
+
   /// Container of this Frame's child Frames.
   std::set<Frame*> mChildFrames;
 
@@ -505,7 +505,16 @@ void FreeJoint::setAngularAcceleration(
 Eigen::Matrix6d FreeJoint::getRelativeJacobianStatic(
     const Eigen::Vector6d& /*positions*/) const
 {
-  return mJacobian;
+  return math::getAdTMatrix(Joint::mAspectProperties.mT_ChildBodyToJoint);
+}
+
+//==============================================================================
+Eigen::Isometry3d FreeJoint::computeRelativeTransformStatic(
+    const Eigen::Vector6d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * convertToTransform(_positions)
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
 }
 
 //==============================================================================
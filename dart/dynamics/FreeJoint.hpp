@@ -260,6 +260,10 @@ public:
   Eigen::Matrix6d getRelativeJacobianStatic(
       const Eigen::Vector6d& _positions) const override;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Eigen::Vector6d& _positions) const override;
+
   // Documentation inherited
   Eigen::Vector6d getPositionDifferencesStatic(
       const Eigen::Vector6d& _q2, const Eigen::Vector6d& _q1) const override;
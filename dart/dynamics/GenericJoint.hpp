@@ -458,12 +458,68 @@ public:
   virtual JacobianMatrix getRelativeJacobianStatic(
       const Vector& positions) const = 0;
 
+  // Documentation inherited
+  void computeRelativeJacobian(
+      const Eigen::VectorXd& positions,
+      Eigen::Ref<math::Jacobian> jacobian) const override;
+
   // Documentation inherited
   const math::Jacobian getRelativeJacobianTimeDeriv() const override;
 
   /// Fixed-size version of getRelativeJacobianTimeDeriv()
   const JacobianMatrix& getRelativeJacobianTimeDerivStatic() const;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransform(
+      const Eigen::VectorXd& positions) const override;
+
+  /// Fixed-size version of computeRelativeTransform(positions). Joint types
+  /// that don't override this fall back to Joint::computeRelativeTransform(),
+  /// which sets the positions of the Joint temporarily.
+  virtual Eigen::Isometry3d computeRelativeTransformStatic(
+      const Vector& positions) const;
+
+  // Documentation inherited
+  math::Jacobian computeRelativeJacobianTimeDeriv(
+      const Eigen::VectorXd& positions,
+      const Eigen::VectorXd& velocities) const override;
+
+  // Documentation inherited
+  void computeRelativeJacobianTimeDeriv(
+      const Eigen::VectorXd& positions,
+      const Eigen::VectorXd& velocities,
+      Eigen::Ref<math::Jacobian> jacobianDeriv) const override;
+
+  /// Fixed-size version of computeRelativeJacobianTimeDeriv(positions,
+  /// velocities). The default returns zero, which is only right for the joint
+  /// types whose relative Jacobian doesn't depend on the positions.
+  virtual JacobianMatrix computeRelativeJacobianTimeDerivStatic(
+      const Vector& positions, const Vector& velocities) const;
+
+  // Documentation inherited
+  math::Jacobian computeRelativeJacobianDeriv(
+      const Eigen::VectorXd& positions, std::size_t index) const override;
+
+  /// Fixed-size version of computeRelativeJacobianDeriv(positions, index).
+  /// The time derivative of the relative Jacobian is linear in the velocities,
+  /// so this is computeRelativeJacobianTimeDerivStatic() for a unit velocity
+  /// of the index-th degree of freedom.
+  JacobianMatrix computeRelativeJacobianDerivStatic(
+      const Vector& positions, std::size_t index) const;
+
+  // Documentation inherited
+  math::Jacobian computeRelativeJacobianTimeDerivDeriv(
+      const Eigen::VectorXd& positions,
+      const Eigen::VectorXd& velocities,
+      std::size_t index) const override;
+
+  /// Fixed-size version of computeRelativeJacobianTimeDerivDeriv(positions,
+  /// velocities, index). The default returns zero, which is only right for the
+  /// joint types whose relative Jacobian is at most linear in each position.
+  virtual JacobianMatrix computeRelativeJacobianTimeDerivDerivStatic(
+      const Vector& positions, const Vector& velocities,
+      std::size_t index) const;
+
   /// \}
 
 protected:
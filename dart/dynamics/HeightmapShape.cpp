@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/HeightmapShape.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "dart/dynamics/BoxShape.hpp"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+HeightmapShape::HeightmapShape(
+    const HeightField& heights, const Eigen::Vector3d& scale)
+  : Shape(),
+    mHeights(heights),
+    mScale(scale),
+    mThickness(-1.0)
+{
+  assert(heights.rows() >= 2 && heights.cols() >= 2);
+  assert(scale[0] > 0.0 && scale[1] > 0.0 && scale[2] > 0.0);
+  updateBoundingBoxDim();
+  updateVolume();
+}
+
+//==============================================================================
+const std::string& HeightmapShape::getType() const
+{
+  return getStaticType();
+}
+
+//==============================================================================
+const std::string& HeightmapShape::getStaticType()
+{
+  static const std::string type("HeightmapShape");
+  return type;
+}
+
+//==============================================================================
+void HeightmapShape::setHeightField(const HeightField& heights)
+{
+  assert(heights.rows() >= 2 && heights.cols() >= 2);
+  mHeights = heights;
+  updateBoundingBoxDim();
+  updateVolume();
+  incrementVersion();
+}
+
+//==============================================================================
+const HeightmapShape::HeightField& HeightmapShape::getHeightField() const
+{
+  return mHeights;
+}
+
+//==============================================================================
+void HeightmapShape::setScale(const Eigen::Vector3d& scale)
+{
+  assert(scale[0] > 0.0 && scale[1] > 0.0 && scale[2] > 0.0);
+  mScale = scale;
+  updateBoundingBoxDim();
+  updateVolume();
+  incrementVersion();
+}
+
+//==============================================================================
+const Eigen::Vector3d& HeightmapShape::getScale() const
+{
+  return mScale;
+}
+
+//==============================================================================
+void HeightmapShape::setThickness(double thickness)
+{
+  mThickness = thickness;
+  updateBoundingBoxDim();
+  updateVolume();
+  incrementVersion();
+}
+
+//==============================================================================
+double HeightmapShape::getThickness() const
+{
+  if (mThickness >= 0.0)
+    return mThickness;
+
+  return std::max(mScale[2],
+                  (mHeights.maxCoeff() - mHeights.minCoeff()) * mScale[2]);
+}
+
+//==============================================================================
+std::size_t HeightmapShape::getNumRows() const
+{
+  return static_cast<std::size_t>(mHeights.rows());
+}
+
+//==============================================================================
+std::size_t HeightmapShape::getNumColumns() const
+{
+  return static_cast<std::size_t>(mHeights.cols());
+}
+
+//==============================================================================
+Eigen::Vector3d HeightmapShape::getVertex(
+    std::size_t row, std::size_t column) const
+{
+  return Eigen::Vector3d(
+        (column - 0.5 * (mHeights.cols() - 1)) * mScale[0],
+        (row - 0.5 * (mHeights.rows() - 1)) * mScale[1],
+        mHeights(row, column) * mScale[2]);
+}
+
+//==============================================================================
+bool HeightmapShape::computeCellRange(
+    const Eigen::Vector2d& min, const Eigen::Vector2d& max,
+    std::size_t& minRow, std::size_t& maxRow,
+    std::size_t& minColumn, std::size_t& maxColumn) const
+{
+  const double lastColumn = static_cast<double>(mHeights.cols() - 1);
+  const double lastRow = static_cast<double>(mHeights.rows() - 1);
+
+  const double columnMin = min[0] / mScale[0] + 0.5 * lastColumn;
+  const double columnMax = max[0] / mScale[0] + 0.5 * lastColumn;
+  const double rowMin = min[1] / mScale[1] + 0.5 * lastRow;
+  const double rowMax = max[1] / mScale[1] + 0.5 * lastRow;
+
+  if (columnMax < 0.0 || columnMin > lastColumn
+      || rowMax < 0.0 || rowMin > lastRow)
+  {
+    return false;
+  }
+
+  // The last vertex of each direction starts no cell
+  minColumn = static_cast<std::size_t>(
+        std::floor(std::max(columnMin, 0.0)));
+  maxColumn = static_cast<std::size_t>(
+        std::floor(std::min(columnMax, lastColumn - 1.0)));
+  minRow = static_cast<std::size_t>(std::floor(std::max(rowMin, 0.0)));
+  maxRow = static_cast<std::size_t>(
+        std::floor(std::min(rowMax, lastRow - 1.0)));
+
+  return true;
+}
+
+//==============================================================================
+bool HeightmapShape::computeHeight(
+    double x, double y, double& height, Eigen::Vector3d* normal) const
+{
+  const double lastColumn = static_cast<double>(mHeights.cols() - 1);
+  const double lastRow = static_cast<double>(mHeights.rows() - 1);
+
+  const double column = x / mScale[0] + 0.5 * lastColumn;
+  const double row = y / mScale[1] + 0.5 * lastRow;
+
+  if (column < 0.0 || column > lastColumn || row < 0.0 || row > lastRow)
+    return false;
+
+  const auto j = static_cast<HeightField::Index>(
+        std::min(std::floor(column), lastColumn - 1.0));
+  const auto i = static_cast<HeightField::Index>(
+        std::min(std::floor(row), lastRow - 1.0));
+  const double u = column - j;
+  const double v = row - i;
+
+  const double h00 = mHeights(i, j);
+  const double h01 = mHeights(i, j + 1);
+  const double h10 = mHeights(i + 1, j);
+  const double h11 = mHeights(i + 1, j + 1);
+
+  // Slopes of the triangle along the columns and the rows
+  double du;
+  double dv;
+  if (u >= v)
+  {
+    du = h01 - h00;
+    dv = h11 - h01;
+  }
+  else
+  {
+    du = h11 - h10;
+    dv = h10 - h00;
+  }
+
+  height = (h00 + u * du + v * dv) * mScale[2];
+
+  if (normal)
+  {
+    *normal = Eigen::Vector3d(-du * mScale[2] / mScale[0],
+                              -dv * mScale[2] / mScale[1],
+                              1.0).normalized();
+  }
+
+  return true;
+}
+
+//==============================================================================
+Eigen::Matrix3d HeightmapShape::computeInertia(double mass) const
+{
+  // Use bounding box to represent the terrain
+  return BoxShape::computeInertia(mBoundingBox.computeFullExtents(), mass);
+}
+
+//==============================================================================
+void HeightmapShape::updateVolume()
+{
+  const Eigen::Vector3d bounds = mBoundingBox.computeFullExtents();
+  mVolume = bounds.x() * bounds.y() * bounds.z();
+}
+
+//==============================================================================
+void HeightmapShape::updateBoundingBoxDim()
+{
+  const double halfWidth = 0.5 * (mHeights.cols() - 1) * mScale[0];
+  const double halfDepth = 0.5 * (mHeights.rows() - 1) * mScale[1];
+
+  mBoundingBox.setMin(Eigen::Vector3d(
+        -halfWidth, -halfDepth,
+        mHeights.minCoeff() * mScale[2] - getThickness()));
+  mBoundingBox.setMax(Eigen::Vector3d(
+        halfWidth, halfDepth, mHeights.maxCoeff() * mScale[2]));
+}
+
+}  // namespace dynamics
+}  // namespace dart
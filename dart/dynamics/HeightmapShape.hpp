@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_HEIGHTMAPSHAPE_HPP_
+#define DART_DYNAMICS_HEIGHTMAPSHAPE_HPP_
+
+#include "dart/dynamics/Shape.hpp"
+
+namespace dart {
+namespace dynamics {
+
+/// HeightmapShape represents a terrain given by the heights of the vertices of
+/// a regular grid on the x-y plane, centered at the origin of the shape frame.
+///
+/// The vertex of row i and column j of the height field is at
+/// x = (j - (numColumns - 1) / 2) * scale.x(),
+/// y = (i - (numRows - 1) / 2) * scale.y(), and
+/// z = heights(i, j) * scale.z().
+/// Each cell of the grid is split into two triangles along the diagonal from
+/// vertex (i, j) to vertex (i + 1, j + 1). The terrain is solid below its
+/// surface.
+///
+/// Since the grid is regular, the cells below any point are found in constant
+/// time, which makes HeightmapShape much cheaper to collide with than a
+/// MeshShape of the same terrain.
+class HeightmapShape : public Shape
+{
+public:
+
+  using HeightField = Eigen::MatrixXd;
+
+  /// Constructor. The height field needs at least two rows and two columns.
+  explicit HeightmapShape(
+      const HeightField& heights,
+      const Eigen::Vector3d& scale = Eigen::Vector3d::Ones());
+
+  // Documentation inherited.
+  const std::string& getType() const override;
+
+  /// Returns shape type for this class
+  static const std::string& getStaticType();
+
+  /// Set the unscaled heights of the vertices
+  void setHeightField(const HeightField& heights);
+
+  /// Get the unscaled heights of the vertices
+  const HeightField& getHeightField() const;
+
+  /// Set the spacing of the grid along x and y, and the scale of the heights
+  void setScale(const Eigen::Vector3d& scale);
+
+  /// Get the spacing of the grid along x and y, and the scale of the heights
+  const Eigen::Vector3d& getScale() const;
+
+  /// Set how far below its lowest vertex the terrain is solid, which is how
+  /// far the bounding box extends below it. This keeps the bounding box of a
+  /// flat terrain from having zero thickness, so that shapes that sank below
+  /// the surface still overlap it. A negative thickness, which is the default,
+  /// selects the larger of scale.z() and the range of the scaled heights.
+  void setThickness(double thickness);
+
+  /// Get how far below its lowest vertex the terrain is solid
+  double getThickness() const;
+
+  /// Get the number of rows of the grid, which are along y
+  std::size_t getNumRows() const;
+
+  /// Get the number of columns of the grid, which are along x
+  std::size_t getNumColumns() const;
+
+  /// Get the position of the vertex of the given row and column
+  Eigen::Vector3d getVertex(std::size_t row, std::size_t column) const;
+
+  /// Compute the range of the cells that overlap the rectangle between min and
+  /// max on the x-y plane. Return false if the rectangle is off the grid.
+  bool computeCellRange(
+      const Eigen::Vector2d& min, const Eigen::Vector2d& max,
+      std::size_t& minRow, std::size_t& maxRow,
+      std::size_t& minColumn, std::size_t& maxColumn) const;
+
+  /// Compute the height of the surface above the point (x, y) and, if normal
+  /// is not null, the upward normal of the triangle there. Return false if the
+  /// point is off the grid.
+  bool computeHeight(double x, double y, double& height,
+                     Eigen::Vector3d* normal = nullptr) const;
+
+  // Documentation inherited.
+  Eigen::Matrix3d computeInertia(double mass) const override;
+
+protected:
+
+  // Documentation inherited.
+  void updateVolume() override;
+
+private:
+
+  /// Update bounding box (in the local coordinate frame) of the shape.
+  void updateBoundingBoxDim();
+
+  /// Unscaled heights of the vertices
+  HeightField mHeights;
+
+  /// Spacing of the grid along x and y, and scale of the heights
+  Eigen::Vector3d mScale;
+
+  /// Thickness of the terrain below its lowest vertex, or a negative number to
+  /// select it automatically
+  double mThickness;
+
+public:
+  // To get byte-aligned Eigen vectors
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+}  // namespace dynamics
+}  // namespace dart
+
+#endif  // DART_DYNAMICS_HEIGHTMAPSHAPE_HPP_
@@ -199,6 +199,8 @@ InverseKinematics::ErrorMethod::ErrorMethod(
   : mIK(_ik),
     mMethodName(_methodName),
     mLastError(Eigen::Vector6d::Constant(std::nan(""))),
+    mLastNodeVersion(0u),
+    mLastTargetVersion(0u),
     mErrorP(_properties)
 {
   // Do nothing
@@ -245,6 +247,12 @@ const Eigen::Vector6d& InverseKinematics::ErrorMethod::evalError(
       }
     }
 
+    // The node or the target may also have been moved by something other than
+    // these positions
+    repeat = repeat
+        && mIK->getNode()->getWorldTransformVersion() == mLastNodeVersion
+        && mIK->getTarget()->getWorldTransformVersion() == mLastTargetVersion;
+
     if(repeat)
       return mLastError;
   }
@@ -253,6 +261,8 @@ const Eigen::Vector6d& InverseKinematics::ErrorMethod::evalError(
   mLastPositions = _q;
 
   mLastError = computeError();
+  mLastNodeVersion = mIK->getNode()->getWorldTransformVersion();
+  mLastTargetVersion = mIK->getTarget()->getWorldTransformVersion();
   return mLastError;
 }
 
@@ -591,6 +601,8 @@ InverseKinematics::GradientMethod::GradientMethod(InverseKinematics* _ik,
     const std::string& _methodName, const Properties& _properties)
   : mIK(_ik),
     mMethodName(_methodName),
+    mLastNodeVersion(0u),
+    mLastTargetVersion(0u),
     mGradientP(_properties)
 {
   // Do nothing
@@ -634,6 +646,12 @@ void InverseKinematics::GradientMethod::evalGradient(
       }
     }
 
+    // The node or the target may also have been moved by something other than
+    // these positions
+    repeat = repeat
+        && mIK->getNode()->getWorldTransformVersion() == mLastNodeVersion
+        && mIK->getTarget()->getWorldTransformVersion() == mLastTargetVersion;
+
     if(repeat)
     {
       _grad = mLastGradient;
@@ -645,6 +663,8 @@ void InverseKinematics::GradientMethod::evalGradient(
   mIK->setPositions(_q);
   mLastGradient.resize(_grad.size());
   computeGradient(error, mLastGradient);
+  mLastNodeVersion = mIK->getNode()->getWorldTransformVersion();
+  mLastTargetVersion = mIK->getTarget()->getWorldTransformVersion();
   _grad = mLastGradient;
 }
 
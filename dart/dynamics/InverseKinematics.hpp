@@ -648,6 +648,12 @@ protected:
   /// The last error vector computed by this ErrorMethod
   Eigen::Vector6d mLastError;
 
+  /// The world transform version of the node when mLastError was computed
+  std::size_t mLastNodeVersion;
+
+  /// The world transform version of the target when mLastError was computed
+  std::size_t mLastTargetVersion;
+
   /// The properties of this ErrorMethod
   Properties mErrorP;
 
@@ -840,6 +846,13 @@ protected:
   /// The last gradient that was computed by this GradientMethod
   Eigen::VectorXd mLastGradient;
 
+  /// The world transform version of the node when mLastGradient was computed
+  std::size_t mLastNodeVersion;
+
+  /// The world transform version of the target when mLastGradient was
+  /// computed
+  std::size_t mLastTargetVersion;
+
   /// Properties for this GradientMethod
   Properties mGradientP;
 
@@ -349,6 +349,128 @@ const Eigen::Vector6d& Joint::getRelativePrimaryAcceleration() const
   return mPrimaryAcceleration;
 }
 
+//==============================================================================
+static bool checkDimension(const Joint* joint, const char* func,
+                           const char* arg, const Eigen::VectorXd& vector)
+{
+  if (static_cast<std::size_t>(vector.size()) == joint->getNumDofs())
+    return true;
+
+  dterr << "[Joint::" << func << "] Mismatch between size of " << arg << " ["
+        << vector.size() << "] and the number of DOFs ["
+        << joint->getNumDofs() << "] for Joint named [" << joint->getName()
+        << "].\n";
+  return false;
+}
+
+//==============================================================================
+void Joint::computeRelativeJacobian(
+    const Eigen::VectorXd& positions,
+    Eigen::Ref<math::Jacobian> jacobian) const
+{
+  assert(static_cast<std::size_t>(jacobian.cols()) == getNumDofs());
+
+  if (!checkDimension(this, "computeRelativeJacobian", "positions", positions))
+  {
+    jacobian.setZero();
+    return;
+  }
+
+  jacobian = getRelativeJacobian(positions);
+}
+
+//==============================================================================
+Eigen::Isometry3d Joint::computeRelativeTransform(
+    const Eigen::VectorXd& positions) const
+{
+  if (!checkDimension(this, "computeRelativeTransform", "positions", positions))
+    return Eigen::Isometry3d::Identity();
+
+  // Evaluate the transform at the given positions, and then restore the state
+  // of this Joint
+  Joint* joint = const_cast<Joint*>(this);
+  const Eigen::VectorXd oldPositions = getPositions();
+
+  joint->setPositions(positions);
+  const Eigen::Isometry3d transform = getRelativeTransform();
+  joint->setPositions(oldPositions);
+
+  return transform;
+}
+
+//==============================================================================
+math::Jacobian Joint::computeRelativeJacobianTimeDeriv(
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& velocities) const
+{
+  math::Jacobian jacobianDeriv(6, getNumDofs());
+  computeRelativeJacobianTimeDeriv(positions, velocities, jacobianDeriv);
+
+  return jacobianDeriv;
+}
+
+//==============================================================================
+void Joint::computeRelativeJacobianTimeDeriv(
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& velocities,
+    Eigen::Ref<math::Jacobian> jacobianDeriv) const
+{
+  assert(static_cast<std::size_t>(jacobianDeriv.cols()) == getNumDofs());
+
+  if (!checkDimension(this, "computeRelativeJacobianTimeDeriv", "positions",
+                      positions)
+      || !checkDimension(this, "computeRelativeJacobianTimeDeriv", "velocities",
+                         velocities))
+  {
+    jacobianDeriv.setZero();
+    return;
+  }
+
+  // Evaluate the derivative at the given state, and then restore the state of
+  // this Joint
+  Joint* joint = const_cast<Joint*>(this);
+  const Eigen::VectorXd oldPositions = getPositions();
+  const Eigen::VectorXd oldVelocities = getVelocities();
+
+  joint->setPositions(positions);
+  joint->setVelocities(velocities);
+  jacobianDeriv = getRelativeJacobianTimeDeriv();
+  joint->setPositions(oldPositions);
+  joint->setVelocities(oldVelocities);
+}
+
+//==============================================================================
+math::Jacobian Joint::computeRelativeJacobianDeriv(
+    const Eigen::VectorXd& positions, std::size_t index) const
+{
+  if (index >= getNumDofs())
+  {
+    dterr << "[Joint::computeRelativeJacobianDeriv] index [" << index
+          << "] is out of range for Joint named [" << getName()
+          << "], which has " << getNumDofs() << " DOFs.\n";
+    return math::Jacobian::Zero(6, getNumDofs());
+  }
+
+  // The time derivative of the relative Jacobian is linear in the velocities
+  return computeRelativeJacobianTimeDeriv(
+        positions,
+        Eigen::VectorXd::Unit(
+          static_cast<int>(getNumDofs()), static_cast<int>(index)));
+}
+
+//==============================================================================
+math::Jacobian Joint::computeRelativeJacobianTimeDerivDeriv(
+    const Eigen::VectorXd& /*positions*/,
+    const Eigen::VectorXd& /*velocities*/,
+    std::size_t /*index*/) const
+{
+  dterr << "[Joint::computeRelativeJacobianTimeDerivDeriv] Joint named ["
+        << getName() << "] of type [" << getType() << "] doesn't support "
+        << "this derivative. Its joint type must override this function.\n";
+
+  return math::Jacobian::Zero(6, getNumDofs());
+}
+
 //==============================================================================
 void Joint::setPositionLimitEnforced(bool _isPositionLimitEnforced)
 {
@@ -594,10 +594,61 @@ public:
   virtual math::Jacobian getRelativeJacobian(
       const Eigen::VectorXd& positions) const = 0;
 
+  /// Same as getRelativeJacobian(positions), but writes the result into
+  /// jacobian, which must have one column per degree of freedom of this Joint.
+  /// Joint types should override this so that it doesn't allocate memory.
+  virtual void computeRelativeJacobian(
+      const Eigen::VectorXd& positions,
+      Eigen::Ref<math::Jacobian> jacobian) const;
+
   /// Get time derivative of spatial Jacobian of the child BodyNode relative to
   /// the parent BodyNode expressed in the child BodyNode frame
   virtual const math::Jacobian getRelativeJacobianTimeDeriv() const = 0;
 
+  /// Compute the transform of the child BodyNode relative to the parent
+  /// BodyNode at the given positions of this Joint. The joint types of DART
+  /// override this so that it only reads the properties of the Joint, and can
+  /// be called concurrently.
+  ///
+  /// The default implementation sets the positions of this Joint temporarily
+  /// and restores them afterwards, so it is not safe to call concurrently with
+  /// anything else that uses the Skeleton.
+  virtual Eigen::Isometry3d computeRelativeTransform(
+      const Eigen::VectorXd& positions) const;
+
+  /// Compute the time derivative of the spatial Jacobian of the child BodyNode
+  /// relative to the parent BodyNode at the given positions and velocities of
+  /// this Joint. Like computeRelativeTransform(), the default implementation
+  /// sets the state of this Joint temporarily.
+  virtual math::Jacobian computeRelativeJacobianTimeDeriv(
+      const Eigen::VectorXd& positions,
+      const Eigen::VectorXd& velocities) const;
+
+  /// Same as computeRelativeJacobianTimeDeriv(positions, velocities), but
+  /// writes the result into jacobianDeriv, which must have one column per
+  /// degree of freedom of this Joint.
+  virtual void computeRelativeJacobianTimeDeriv(
+      const Eigen::VectorXd& positions,
+      const Eigen::VectorXd& velocities,
+      Eigen::Ref<math::Jacobian> jacobianDeriv) const;
+
+  /// Compute the derivative of the relative Jacobian of this Joint with
+  /// respect to positions[index]. The default implementation evaluates
+  /// computeRelativeJacobianTimeDeriv() for a unit velocity of the index-th
+  /// degree of freedom.
+  virtual math::Jacobian computeRelativeJacobianDeriv(
+      const Eigen::VectorXd& positions, std::size_t index) const;
+
+  /// Compute the derivative of computeRelativeJacobianTimeDeriv() with respect
+  /// to positions[index]. Its derivative with respect to velocities[index] is
+  /// computeRelativeJacobianDeriv(positions, index). There is no generic way
+  /// to compute this, so the default implementation reports an error and
+  /// returns zero.
+  virtual math::Jacobian computeRelativeJacobianTimeDerivDeriv(
+      const Eigen::VectorXd& positions,
+      const Eigen::VectorXd& velocities,
+      std::size_t index) const;
+
   /// Get constraint wrench expressed in body node frame
   virtual Eigen::Vector6d getBodyConstraintWrench() const = 0;
   // TODO: Need more informative name.
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/MassMatrixFactorization.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "dart/dynamics/InvalidIndex.hpp"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+MassMatrixFactorization::MassMatrixFactorization()
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool MassMatrixFactorization::compute(const Eigen::MatrixXd& _M,
+                                      const std::vector<std::size_t>& _parents)
+{
+  const std::size_t n = _parents.size();
+  assert(static_cast<std::size_t>(_M.rows()) == n
+         && static_cast<std::size_t>(_M.cols()) == n);
+
+  mParents = _parents;
+
+  // Only the entries between a degree of freedom and its ancestors can be
+  // nonzero, so nothing else is copied over.
+  mL.setZero(n, n);
+  for (std::size_t k = 0; k < n; ++k)
+  {
+    assert(mParents[k] == INVALID_INDEX || mParents[k] < k);
+
+    mL(k, k) = _M(k, k);
+    for (std::size_t i = mParents[k]; i != INVALID_INDEX; i = mParents[i])
+      mL(k, i) = _M(k, i);
+  }
+
+  for (std::size_t k = n; k-- > 0;)
+  {
+    if (mL(k, k) <= 0.0)
+    {
+      mL.resize(0, 0);
+      mParents.clear();
+      return false;
+    }
+
+    mL(k, k) = std::sqrt(mL(k, k));
+
+    for (std::size_t i = mParents[k]; i != INVALID_INDEX; i = mParents[i])
+      mL(k, i) /= mL(k, k);
+
+    for (std::size_t i = mParents[k]; i != INVALID_INDEX; i = mParents[i])
+    {
+      for (std::size_t j = i; j != INVALID_INDEX; j = mParents[j])
+        mL(i, j) -= mL(k, i) * mL(k, j);
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+std::size_t MassMatrixFactorization::getSize() const
+{
+  return mParents.size();
+}
+
+//==============================================================================
+const std::vector<std::size_t>& MassMatrixFactorization::getParents() const
+{
+  return mParents;
+}
+
+//==============================================================================
+const Eigen::MatrixXd& MassMatrixFactorization::getMatrixL() const
+{
+  return mL;
+}
+
+//==============================================================================
+Eigen::MatrixXd MassMatrixFactorization::solve(const Eigen::MatrixXd& _b) const
+{
+  Eigen::MatrixXd x = _b;
+  solveInPlace(x);
+
+  return x;
+}
+
+//==============================================================================
+void MassMatrixFactorization::solveInPlace(Eigen::Ref<Eigen::MatrixXd> _x) const
+{
+  // M^{-1} = L^{-1} * L^{-T}
+  solveTransposeInPlace(_x);
+  solveLowerInPlace(_x);
+}
+
+//==============================================================================
+Eigen::MatrixXd MassMatrixFactorization::multiply(
+    const Eigen::MatrixXd& _v) const
+{
+  Eigen::MatrixXd x = _v;
+  multiplyInPlace(x);
+
+  return x;
+}
+
+//==============================================================================
+void MassMatrixFactorization::multiplyInPlace(
+    Eigen::Ref<Eigen::MatrixXd> _x) const
+{
+  const std::size_t n = getSize();
+  assert(static_cast<std::size_t>(_x.rows()) == n);
+
+  // _x <- L * _x. Going backwards leaves the rows of the ancestors untouched
+  // until they are no longer needed.
+  for (std::size_t i = n; i-- > 0;)
+  {
+    _x.row(i) *= mL(i, i);
+    for (std::size_t j = mParents[i]; j != INVALID_INDEX; j = mParents[j])
+      _x.row(i) += mL(i, j) * _x.row(j);
+  }
+
+  // _x <- L^T * _x. Going forwards, row i has not received any contribution
+  // from its descendants yet when it is distributed to its ancestors.
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    for (std::size_t j = mParents[i]; j != INVALID_INDEX; j = mParents[j])
+      _x.row(j) += mL(i, j) * _x.row(i);
+    _x.row(i) *= mL(i, i);
+  }
+}
+
+//==============================================================================
+Eigen::MatrixXd MassMatrixFactorization::getInverse(
+    const std::vector<std::size_t>& _indices) const
+{
+  const std::size_t n = getSize();
+  const std::size_t m = _indices.size();
+
+  // Column c of Y is L^{-T} * e_k where k = _indices[c]. It can only be
+  // nonzero for k and its ancestors, so only that path is visited.
+  Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(n, m);
+  for (std::size_t c = 0; c < m; ++c)
+  {
+    const std::size_t k = _indices[c];
+    assert(k < n);
+
+    Y(k, c) = 1.0;
+    for (std::size_t i = k; i != INVALID_INDEX; i = mParents[i])
+    {
+      Y(i, c) /= mL(i, i);
+      for (std::size_t j = mParents[i]; j != INVALID_INDEX; j = mParents[j])
+        Y(j, c) -= mL(i, j) * Y(i, c);
+    }
+  }
+
+  // M^{-1} = L^{-1} * L^{-T} = (L^{-T})^T * L^{-T}
+  Eigen::MatrixXd inverse(m, m);
+  inverse.triangularView<Eigen::Lower>() = Y.transpose() * Y;
+  inverse.triangularView<Eigen::StrictlyUpper>() = inverse.transpose();
+
+  return inverse;
+}
+
+//==============================================================================
+Eigen::MatrixXd MassMatrixFactorization::getInverse() const
+{
+  std::vector<std::size_t> indices(getSize());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    indices[i] = i;
+
+  return getInverse(indices);
+}
+
+//==============================================================================
+Eigen::MatrixXd MassMatrixFactorization::getInverseProjection(
+    const Eigen::MatrixXd& _J) const
+{
+  assert(static_cast<std::size_t>(_J.cols()) == getSize());
+
+  // J * M^{-1} * J^T = (L^{-T} * J^T)^T * (L^{-T} * J^T)
+  Eigen::MatrixXd Y = _J.transpose();
+  solveTransposeInPlace(Y);
+
+  Eigen::MatrixXd projection(_J.rows(), _J.rows());
+  projection.triangularView<Eigen::Lower>() = Y.transpose() * Y;
+  projection.triangularView<Eigen::StrictlyUpper>() = projection.transpose();
+
+  return projection;
+}
+
+//==============================================================================
+void MassMatrixFactorization::solveTransposeInPlace(
+    Eigen::Ref<Eigen::MatrixXd> _x) const
+{
+  const std::size_t n = getSize();
+  assert(static_cast<std::size_t>(_x.rows()) == n);
+
+  for (std::size_t i = n; i-- > 0;)
+  {
+    _x.row(i) /= mL(i, i);
+    for (std::size_t j = mParents[i]; j != INVALID_INDEX; j = mParents[j])
+      _x.row(j) -= mL(i, j) * _x.row(i);
+  }
+}
+
+//==============================================================================
+void MassMatrixFactorization::solveLowerInPlace(
+    Eigen::Ref<Eigen::MatrixXd> _x) const
+{
+  const std::size_t n = getSize();
+  assert(static_cast<std::size_t>(_x.rows()) == n);
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    for (std::size_t j = mParents[i]; j != INVALID_INDEX; j = mParents[j])
+      _x.row(i) -= mL(i, j) * _x.row(j);
+    _x.row(i) /= mL(i, i);
+  }
+}
+
+} // namespace dynamics
+} // namespace dart
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_MASSMATRIXFACTORIZATION_HPP_
+#define DART_DYNAMICS_MASSMATRIXFACTORIZATION_HPP_
+
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace dynamics {
+
+/// MassMatrixFactorization holds the factorization M = L^T * L of the mass
+/// matrix of a kinematic tree, where L is lower triangular.
+///
+/// Entry (i, j) of the mass matrix of a tree can only be nonzero if one of the
+/// degrees of freedom i and j is an ancestor of the other. When the degrees of
+/// freedom are ordered so that every ancestor comes before its descendants,
+/// the factor L has exactly the same sparsity pattern as the lower triangle of
+/// M, so the factorization creates no fill-in and every operation only visits
+/// the ancestors of each degree of freedom. See "Efficient Factorization of
+/// the Joint-Space Inertia Matrix for Branched Kinematic Trees" by Roy
+/// Featherstone.
+///
+/// This makes solve() considerably cheaper than forming the dense inverse of
+/// the mass matrix, especially for branched Skeletons.
+class MassMatrixFactorization
+{
+public:
+  /// Default constructor. Creates an empty factorization.
+  MassMatrixFactorization();
+
+  /// Factorize the mass matrix _M. _parents[i] must be the index of the
+  /// nearest ancestor of degree of freedom i, i.e., the previous degree of
+  /// freedom of the same Joint or the last degree of freedom of the nearest
+  /// parent Joint that has any, or INVALID_INDEX if there is none. Every
+  /// ancestor index must be smaller than the index of its descendant.
+  ///
+  /// Returns false if _M is not positive definite, in which case this
+  /// factorization is left empty.
+  bool compute(const Eigen::MatrixXd& _M,
+               const std::vector<std::size_t>& _parents);
+
+  /// Get the number of degrees of freedom of the factorized matrix
+  std::size_t getSize() const;
+
+  /// Get the index of the nearest ancestor of each degree of freedom
+  const std::vector<std::size_t>& getParents() const;
+
+  /// Get the lower triangular factor L. Its strictly upper triangular part is
+  /// zero.
+  const Eigen::MatrixXd& getMatrixL() const;
+
+  /// Compute M^{-1} * _b
+  Eigen::MatrixXd solve(const Eigen::MatrixXd& _b) const;
+
+  /// Overwrite _x with M^{-1} * _x
+  void solveInPlace(Eigen::Ref<Eigen::MatrixXd> _x) const;
+
+  /// Compute M * _v
+  Eigen::MatrixXd multiply(const Eigen::MatrixXd& _v) const;
+
+  /// Overwrite _x with M * _x
+  void multiplyInPlace(Eigen::Ref<Eigen::MatrixXd> _x) const;
+
+  /// Get the rows and columns of M^{-1} that correspond to _indices, without
+  /// computing the rest of the inverse.
+  Eigen::MatrixXd getInverse(const std::vector<std::size_t>& _indices) const;
+
+  /// Get the whole inverse M^{-1}
+  Eigen::MatrixXd getInverse() const;
+
+  /// Compute _J * M^{-1} * _J^T, which is the inverse of the operational space
+  /// inertia of a Jacobian _J, without computing M^{-1}.
+  Eigen::MatrixXd getInverseProjection(const Eigen::MatrixXd& _J) const;
+
+protected:
+  /// Overwrite _x with L^{-T} * _x
+  void solveTransposeInPlace(Eigen::Ref<Eigen::MatrixXd> _x) const;
+
+  /// Overwrite _x with L^{-1} * _x
+  void solveLowerInPlace(Eigen::Ref<Eigen::MatrixXd> _x) const;
+
+  /// Lower triangular factor
+  Eigen::MatrixXd mL;
+
+  /// Index of the nearest ancestor of each degree of freedom
+  std::vector<std::size_t> mParents;
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_MASSMATRIXFACTORIZATION_HPP_
@@ -195,6 +195,7 @@ void MeshShape::setMesh(
   const common::ResourceRetrieverPtr& _resourceRetriever)
 {
   mMesh = _mesh;
+  incrementVersion();
 
   if(nullptr == _mesh) {
     mMeshPath = "";
@@ -231,6 +232,7 @@ void MeshShape::setScale(const Eigen::Vector3d& _scale) {
   mScale = _scale;
   updateVolume();
   _updateBoundingBoxDim();
+  incrementVersion();
 }
 
 const Eigen::Vector3d& MeshShape::getScale() const {
@@ -71,6 +71,7 @@ void MultiSphereShape::addSpheres(const MultiSphereShape::Spheres& spheres)
 
   updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -80,6 +81,7 @@ void MultiSphereShape::addSphere(const MultiSphereShape::Sphere& sphere)
 
   updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -95,6 +97,7 @@ void MultiSphereShape::removeAllSpheres()
 
   updateBoundingBoxDim();
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
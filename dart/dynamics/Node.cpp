@@ -109,6 +109,18 @@ ConstBodyNodePtr Node::getBodyNodePtr() const
   return mBodyNode;
 }
 
+//==============================================================================
+BodyNode* Node::getRawBodyNode()
+{
+  return mBodyNode;
+}
+
+//==============================================================================
+const BodyNode* Node::getRawBodyNode() const
+{
+  return mBodyNode;
+}
+
 //==============================================================================
 bool Node::isRemoved() const
 {
@@ -168,6 +168,15 @@ public:
   /// Get a pointer to the BodyNode that this Node is associated with
   ConstBodyNodePtr getBodyNodePtr() const;
 
+  /// Get the BodyNode that this Node is associated with as a raw pointer.
+  /// Unlike getBodyNodePtr(), this doesn't change the reference count of the
+  /// Skeleton, so it can be used by code that must not modify the Skeleton,
+  /// e.g., a collision query that runs in a worker thread.
+  BodyNode* getRawBodyNode();
+
+  /// Get the BodyNode that this Node is associated with as a raw pointer
+  const BodyNode* getRawBodyNode() const;
+
   /// Returns true if this Node has been staged for removal from its BodyNode.
   /// It will be deleted once all strong references to it expire. If it is an
   /// AccessoryNode, you can call reattach() to prevent that from happening.
@@ -208,6 +208,68 @@ Eigen::Matrix<double, 6, 3> PlanarJoint::getRelativeJacobianStatic(
   return J;
 }
 
+//==============================================================================
+Eigen::Isometry3d PlanarJoint::computeRelativeTransformStatic(
+    const Eigen::Vector3d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * Eigen::Translation3d(mAspectProperties.mTransAxis1 * _positions[0])
+      * Eigen::Translation3d(mAspectProperties.mTransAxis2 * _positions[1])
+      * math::expAngular    (mAspectProperties.mRotAxis    * _positions[2])
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
+//==============================================================================
+Eigen::Matrix<double, 6, 3> PlanarJoint::computeRelativeJacobianTimeDerivStatic(
+    const Eigen::Vector3d& _positions,
+    const Eigen::Vector3d& _velocities) const
+{
+  Eigen::Matrix<double, 6, 3> J = Eigen::Matrix<double, 6, 3>::Zero();
+  J.block<3, 1>(3, 0) = mAspectProperties.mTransAxis1;
+  J.block<3, 1>(3, 1) = mAspectProperties.mTransAxis2;
+  J.block<3, 1>(0, 2) = mAspectProperties.mRotAxis;
+
+  const Eigen::Matrix<double, 6, 3> Jacobian
+      = getRelativeJacobianStatic(_positions);
+  const Eigen::Isometry3d T = Joint::mAspectProperties.mT_ChildBodyToJoint
+      * math::expAngular(mAspectProperties.mRotAxis * -_positions[2]);
+
+  Eigen::Matrix<double, 6, 3> dJ = Eigen::Matrix<double, 6, 3>::Zero();
+  dJ.col(0) = -math::ad(Jacobian.col(2) * _velocities[2],
+                        math::AdT(T, J.col(0)));
+  dJ.col(1) = -math::ad(Jacobian.col(2) * _velocities[2],
+                        math::AdT(T, J.col(1)));
+
+  assert(!math::isNan(dJ.col(0)));
+  assert(!math::isNan(dJ.col(1)));
+
+  return dJ;
+}
+
+//==============================================================================
+Eigen::Matrix<double, 6, 3>
+PlanarJoint::computeRelativeJacobianTimeDerivDerivStatic(
+    const Eigen::Vector3d& _positions,
+    const Eigen::Vector3d& _velocities,
+    std::size_t _index) const
+{
+  Eigen::Matrix<double, 6, 3> ddJ = Eigen::Matrix<double, 6, 3>::Zero();
+
+  // Only the translational columns depend on the rotation, and the derivative
+  // of column k with respect to it is -ad(S2, Sk)
+  if (_index == 2)
+  {
+    const Eigen::Matrix<double, 6, 3> J = getRelativeJacobianStatic(_positions);
+    const Eigen::Vector6d dS2 = J.col(2) * _velocities[2];
+    ddJ.col(0) = math::ad(dS2, math::ad(J.col(2), J.col(0)));
+    ddJ.col(1) = math::ad(dS2, math::ad(J.col(2), J.col(1)));
+  }
+
+  assert(!math::isNan(ddJ));
+
+  return ddJ;
+}
+
 //==============================================================================
 PlanarJoint::PlanarJoint(const Properties& properties)
   : detail::PlanarJointBase(properties)
@@ -266,12 +328,7 @@ void PlanarJoint::updateDegreeOfFreedomNames()
 //==============================================================================
 void PlanarJoint::updateRelativeTransform() const
 {
-  const Eigen::Vector3d& positions = getPositionsStatic();
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::Translation3d(mAspectProperties.mTransAxis1 * positions[0])
-       * Eigen::Translation3d(mAspectProperties.mTransAxis2 * positions[1])
-       * math::expAngular    (mAspectProperties.mRotAxis    * positions[2])
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
@@ -286,30 +343,8 @@ void PlanarJoint::updateRelativeJacobian(bool) const
 //==============================================================================
 void PlanarJoint::updateRelativeJacobianTimeDeriv() const
 {
-  Eigen::Matrix<double, 6, 3> J = Eigen::Matrix<double, 6, 3>::Zero();
-  J.block<3, 1>(3, 0) = mAspectProperties.mTransAxis1;
-  J.block<3, 1>(3, 1) = mAspectProperties.mTransAxis2;
-  J.block<3, 1>(0, 2) = mAspectProperties.mRotAxis;
-
-  const Eigen::Matrix<double, 6, 3>& Jacobian = getRelativeJacobianStatic();
-  const Eigen::Vector3d& velocities = getVelocitiesStatic();
-  mJacobianDeriv.col(0)
-      = -math::ad(Jacobian.col(2) * velocities[2],
-                  math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint
-                            * math::expAngular(mAspectProperties.mRotAxis
-                                               * -getPositionsStatic()[2]),
-                            J.col(0)));
-
-  mJacobianDeriv.col(1)
-      = -math::ad(Jacobian.col(2) * velocities[2],
-                  math::AdT(Joint::mAspectProperties.mT_ChildBodyToJoint
-                            * math::expAngular(mAspectProperties.mRotAxis
-                                               * -getPositionsStatic()[2]),
-                            J.col(1)));
-
-  assert(mJacobianDeriv.col(2) == Eigen::Vector6d::Zero());
-  assert(!math::isNan(mJacobianDeriv.col(0)));
-  assert(!math::isNan(mJacobianDeriv.col(1)));
+  mJacobianDeriv = computeRelativeJacobianTimeDerivStatic(
+        getPositionsStatic(), getVelocitiesStatic());
 }
 
 }  // namespace dynamics
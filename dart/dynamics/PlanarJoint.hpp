@@ -129,6 +129,21 @@ public:
   Eigen::Matrix<double, 6, 3> getRelativeJacobianStatic(
       const Eigen::Vector3d& _positions) const override;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Eigen::Vector3d& _positions) const override;
+
+  // Documentation inherited
+  Eigen::Matrix<double, 6, 3> computeRelativeJacobianTimeDerivStatic(
+      const Eigen::Vector3d& _positions,
+      const Eigen::Vector3d& _velocities) const override;
+
+  // Documentation inherited
+  Eigen::Matrix<double, 6, 3> computeRelativeJacobianTimeDerivDerivStatic(
+      const Eigen::Vector3d& _positions,
+      const Eigen::Vector3d& _velocities,
+      std::size_t _index) const override;
+
 protected:
 
   /// Constructor called by Skeleton class
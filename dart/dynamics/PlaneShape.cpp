@@ -74,6 +74,7 @@ Eigen::Matrix3d PlaneShape::computeInertia(double /*mass*/) const
 void PlaneShape::setNormal(const Eigen::Vector3d& _normal)
 {
   mNormal = _normal.normalized();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -86,6 +87,7 @@ const Eigen::Vector3d& PlaneShape::getNormal() const
 void PlaneShape::setOffset(double _offset)
 {
   mOffset = _offset;
+  incrementVersion();
 }
 
 //==============================================================================
@@ -1080,6 +1080,7 @@ PointMassNotifier::PointMassNotifier(SoftBodyNode* _parentSoftBody,
                                      const std::string& _name)
   : Entity(_parentSoftBody, false),
     mNeedPartialAccelerationUpdate(true),
+    mPartialAccelerationVelocityVersion(0u),
     mParentSoftBodyNode(_parentSoftBody)
 {
   setName(_name);
@@ -1088,31 +1089,35 @@ PointMassNotifier::PointMassNotifier(SoftBodyNode* _parentSoftBody,
 //==============================================================================
 bool PointMassNotifier::needsPartialAccelerationUpdate() const
 {
-  return mNeedPartialAccelerationUpdate;
+  return mNeedPartialAccelerationUpdate
+      || mParentSoftBodyNode->getSpatialVelocityVersion()
+         != mPartialAccelerationVelocityVersion;
 }
 
 //==============================================================================
 void PointMassNotifier::clearTransformNotice()
 {
-  mNeedTransformUpdate = false;
+  clearTransformUpdate();
 }
 
 //==============================================================================
 void PointMassNotifier::clearVelocityNotice()
 {
-  mNeedVelocityUpdate = false;
+  clearVelocityUpdate();
 }
 
 //==============================================================================
 void PointMassNotifier::clearPartialAccelerationNotice()
 {
+  mPartialAccelerationVelocityVersion
+      = mParentSoftBodyNode->getSpatialVelocityVersion();
   mNeedPartialAccelerationUpdate = false;
 }
 
 //==============================================================================
 void PointMassNotifier::clearAccelerationNotice()
 {
-  mNeedAccelerationUpdate = false;
+  clearAccelerationUpdate();
 }
 
 //==============================================================================
@@ -1122,6 +1127,9 @@ void PointMassNotifier::dirtyTransform()
   mNeedVelocityUpdate = true;
   mNeedPartialAccelerationUpdate = true;
   mNeedAccelerationUpdate = true;
+  incrementGeneration(TRANSFORM_GENERATION);
+  incrementGeneration(VELOCITY_GENERATION);
+  incrementGeneration(ACCELERATION_GENERATION);
 
   mParentSoftBodyNode->dirtyArticulatedInertia();
   mParentSoftBodyNode->dirtyExternalForces();
@@ -1133,6 +1141,8 @@ void PointMassNotifier::dirtyVelocity()
   mNeedVelocityUpdate = true;
   mNeedPartialAccelerationUpdate = true;
   mNeedAccelerationUpdate = true;
+  incrementGeneration(VELOCITY_GENERATION);
+  incrementGeneration(ACCELERATION_GENERATION);
 
   mParentSoftBodyNode->dirtyCoriolisForces();
 }
@@ -1141,6 +1151,7 @@ void PointMassNotifier::dirtyVelocity()
 void PointMassNotifier::dirtyAcceleration()
 {
   mNeedAccelerationUpdate = true;
+  incrementGeneration(ACCELERATION_GENERATION);
 }
 
 //==============================================================================
@@ -702,6 +702,8 @@ protected:
   bool mNeedPartialAccelerationUpdate;
   // TODO(JS): Rename this to mIsPartialAccelerationDirty in DART 7
 
+  std::size_t mPartialAccelerationVelocityVersion;
+
   SoftBodyNode* mParentSoftBodyNode;
 
 };
@@ -149,6 +149,15 @@ PrismaticJoint::getRelativeJacobianStatic(
   return jacobian;
 }
 
+//==============================================================================
+Eigen::Isometry3d PrismaticJoint::computeRelativeTransformStatic(
+    const GenericJoint<math::R1Space>::Vector& positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * Eigen::Translation3d(getAxis() * positions)
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 PrismaticJoint::PrismaticJoint(const Properties& properties)
   : detail::PrismaticJointBase(properties)
@@ -177,9 +186,7 @@ void PrismaticJoint::updateDegreeOfFreedomNames()
 //==============================================================================
 void PrismaticJoint::updateRelativeTransform() const
 {
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::Translation3d(getAxis() * getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
@@ -150,6 +150,15 @@ RevoluteJoint::getRelativeJacobianStatic(
   return jacobian;
 }
 
+//==============================================================================
+Eigen::Isometry3d RevoluteJoint::computeRelativeTransformStatic(
+    const GenericJoint<math::R1Space>::Vector& positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * math::expAngular(getAxis() * positions)
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 RevoluteJoint::RevoluteJoint(const Properties& properties)
   : detail::RevoluteJointBase(properties)
@@ -178,9 +187,7 @@ void RevoluteJoint::updateDegreeOfFreedomNames()
 //==============================================================================
 void RevoluteJoint::updateRelativeTransform() const
 {
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * math::expAngular(getAxis() * getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
@@ -172,6 +172,21 @@ ScrewJoint::getRelativeJacobianStatic(
   return jacobian;
 }
 
+//==============================================================================
+Eigen::Isometry3d ScrewJoint::computeRelativeTransformStatic(
+    const GenericJoint<math::R1Space>::Vector& positions) const
+{
+  using namespace dart::math::suffixes;
+
+  Eigen::Vector6d S = Eigen::Vector6d::Zero();
+  S.head<3>() = getAxis();
+  S.tail<3>() = getAxis()*getPitch()*0.5_pi;
+
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * math::expMap(S * positions)
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
 //==============================================================================
 ScrewJoint::ScrewJoint(const Properties& properties)
   : detail::ScrewJointBase(properties)
@@ -200,14 +215,7 @@ void ScrewJoint::updateDegreeOfFreedomNames()
 //==============================================================================
 void ScrewJoint::updateRelativeTransform() const
 {
-  using namespace dart::math::suffixes;
-
-  Eigen::Vector6d S = Eigen::Vector6d::Zero();
-  S.head<3>() = getAxis();
-  S.tail<3>() = getAxis()*getPitch()*0.5_pi;
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * math::expMap(S * getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
   assert(math::verifyTransform(mT));
 }
 
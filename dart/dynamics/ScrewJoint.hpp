@@ -100,6 +100,10 @@ public:
   GenericJoint<math::R1Space>::JacobianMatrix getRelativeJacobianStatic(
       const GenericJoint<math::R1Space>::Vector& positions) const override;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const GenericJoint<math::R1Space>::Vector& positions) const override;
+
 protected:
 
   /// Constructor called by Skeleton class
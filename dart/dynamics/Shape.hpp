@@ -38,13 +38,18 @@
 
 #include "dart/common/Deprecated.hpp"
 #include "dart/common/Subject.hpp"
+#include "dart/common/VersionCounter.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
 
 namespace dart {
 namespace dynamics {
 
-class Shape : public virtual common::Subject
+/// Shape is the geometry of a ShapeFrame. The setters that change the geometry
+/// of a Shape increment its version, so users that cache data derived from
+/// the geometry (e.g., the collision detectors) can tell when to refresh it.
+class Shape : public virtual common::Subject,
+              public virtual common::VersionCounter
 {
 public:
 
@@ -47,8 +47,9 @@ VisualAspectProperties::VisualAspectProperties(const Eigen::Vector4d& color,
 
 //==============================================================================
 CollisionAspectProperties::CollisionAspectProperties(
-    const bool collidable)
-  : mCollidable(collidable)
+    const bool collidable, const bool continuous)
+  : mCollidable(collidable),
+    mContinuous(continuous)
 {
   // Do nothing
 }
@@ -171,6 +172,12 @@ bool CollisionAspect::isCollidable() const
   return getCollidable();
 }
 
+//==============================================================================
+bool CollisionAspect::isContinuous() const
+{
+  return getContinuous();
+}
+
 //==============================================================================
 DynamicsAspect::DynamicsAspect(
     const PropertiesData& properties)
@@ -128,6 +128,14 @@ public:
   /// Return true if this body can collide with others bodies
   bool isCollidable() const;
 
+  DART_COMMON_SET_GET_ASPECT_PROPERTY( bool, Continuous )
+  // void setContinuous(const bool& value);
+  // const bool& getContinuous() const;
+
+  /// Return true if the ConstraintSolver creates speculative contacts ahead of
+  /// this body, see detail::CollisionAspectProperties::mContinuous
+  bool isContinuous() const;
+
 };
 
 //==============================================================================
@@ -32,6 +32,7 @@
 #include "dart/dynamics/Skeleton.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <queue>
 #include <string>
 #include <vector>
@@ -169,13 +170,15 @@ SkeletonAspectProperties::SkeletonAspectProperties(
     const Eigen::Vector3d& _gravity,
     double _timeStep,
     bool _enabledSelfCollisionCheck,
-    bool _enableAdjacentBodyCheck)
+    bool _enableAdjacentBodyCheck,
+    MassMatrixAlgorithm _massMatrixAlgorithm)
   : mName(_name),
     mIsMobile(_isMobile),
     mGravity(_gravity),
     mTimeStep(_timeStep),
     mEnabledSelfCollisionCheck(_enabledSelfCollisionCheck),
-    mEnabledAdjacentBodyCheck(_enableAdjacentBodyCheck)
+    mEnabledAdjacentBodyCheck(_enableAdjacentBodyCheck),
+    mMassMatrixAlgorithm(_massMatrixAlgorithm)
 {
   // Do nothing
 }
@@ -256,6 +259,10 @@ BodyNodePropertiesVector getAllJointProperties(const Skeleton* skel)
 
 } // namespace detail
 
+//==============================================================================
+constexpr Skeleton::MassMatrixAlgorithm Skeleton::UNIT_ACCELERATION;
+constexpr Skeleton::MassMatrixAlgorithm Skeleton::COMPOSITE_RIGID_BODY;
+
 //==============================================================================
 Skeleton::Configuration::Configuration(
     const Eigen::VectorXd& positions,
@@ -448,6 +455,7 @@ SkeletonPtr Skeleton::clone(const std::string& cloneName) const
   skelClone->setProperties(getAspectProperties());
   skelClone->setName(cloneName);
   skelClone->setState(getState());
+  skelClone->setAllowedCollisionMatrix(mAllowedCollisionMatrix);
 
   return skelClone;
 }
@@ -553,6 +561,7 @@ void Skeleton::setAspectProperties(const AspectProperties& properties)
   setTimeStep(properties.mTimeStep);
   setSelfCollisionCheck(properties.mEnabledSelfCollisionCheck);
   setAdjacentBodyCheck(properties.mEnabledAdjacentBodyCheck);
+  setMassMatrixAlgorithm(properties.mMassMatrixAlgorithm);
 }
 
 //==============================================================================
@@ -700,6 +709,28 @@ bool Skeleton::isEnabledAdjacentBodyCheck() const
   return getAdjacentBodyCheck();
 }
 
+//==============================================================================
+void Skeleton::setAllowedCollisionMatrix(
+    const std::shared_ptr<const AllowedCollisionMatrix>& matrix)
+{
+  if (matrix && matrix->getNumBodyNodes() != getNumBodyNodes())
+  {
+    dtwarn << "[Skeleton::setAllowedCollisionMatrix] The matrix was created "
+           << "for " << matrix->getNumBodyNodes() << " BodyNodes, but the "
+           << "Skeleton [" << getName() << "] has " << getNumBodyNodes()
+           << ". The matrix will be ignored until the numbers match.\n";
+  }
+
+  mAllowedCollisionMatrix = matrix;
+}
+
+//==============================================================================
+const std::shared_ptr<const AllowedCollisionMatrix>&
+Skeleton::getAllowedCollisionMatrix() const
+{
+  return mAllowedCollisionMatrix;
+}
+
 //==============================================================================
 void Skeleton::setMobile(bool _isMobile)
 {
@@ -712,6 +743,28 @@ bool Skeleton::isMobile() const
   return mAspectProperties.mIsMobile;
 }
 
+//==============================================================================
+void Skeleton::setSleeping(bool sleeping)
+{
+  if (sleeping == mIsSleeping)
+    return;
+
+  mIsSleeping = sleeping;
+  mRestingTime = 0.0;
+
+  if (mIsSleeping)
+  {
+    setVelocities(Eigen::VectorXd::Zero(getNumDofs()));
+    mSleepingPositions = getPositions();
+  }
+}
+
+//==============================================================================
+bool Skeleton::isSleeping() const
+{
+  return mIsSleeping;
+}
+
 //==============================================================================
 void Skeleton::setTimeStep(double _timeStep)
 {
@@ -728,6 +781,23 @@ double Skeleton::getTimeStep() const
   return mAspectProperties.mTimeStep;
 }
 
+//==============================================================================
+void Skeleton::setMassMatrixAlgorithm(MassMatrixAlgorithm _algorithm)
+{
+  if (mAspectProperties.mMassMatrixAlgorithm == _algorithm)
+    return;
+
+  mAspectProperties.mMassMatrixAlgorithm = _algorithm;
+  SET_ALL_FLAGS(mMassMatrix);
+  SET_ALL_FLAGS(mMassMatrixFactorization);
+}
+
+//==============================================================================
+Skeleton::MassMatrixAlgorithm Skeleton::getMassMatrixAlgorithm() const
+{
+  return mAspectProperties.mMassMatrixAlgorithm;
+}
+
 //==============================================================================
 void Skeleton::setGravity(const Eigen::Vector3d& _gravity)
 {
@@ -1307,6 +1377,12 @@ bool Skeleton::checkIndexingConsistency() const
   return consistent;
 }
 
+//==============================================================================
+std::size_t Skeleton::getStructureVersion() const
+{
+  return mStructureVersion;
+}
+
 //==============================================================================
 const std::shared_ptr<WholeBodyIK>& Skeleton::getIK(bool _createIfNull)
 {
@@ -1823,6 +1899,25 @@ const Eigen::MatrixXd& Skeleton::getInvMassMatrix() const
   return mSkelCache.mInvM;
 }
 
+//==============================================================================
+const MassMatrixFactorization& Skeleton::getMassMatrixFactorization(
+    std::size_t _treeIdx) const
+{
+  if (mTreeCache[_treeIdx].mDirty.mMassMatrixFactorization)
+    updateMassMatrixFactorization(_treeIdx);
+
+  return mTreeCache[_treeIdx].mFactorizedM;
+}
+
+//==============================================================================
+const MassMatrixFactorization& Skeleton::getMassMatrixFactorization() const
+{
+  if (mSkelCache.mDirty.mMassMatrixFactorization)
+    updateMassMatrixFactorization();
+
+  return mSkelCache.mFactorizedM;
+}
+
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getInvAugMassMatrix(std::size_t _treeIdx) const
 {
@@ -1932,11 +2027,23 @@ const Eigen::VectorXd& Skeleton::getConstraintForces() const
 //  return mFd;
 //}
 
+//==============================================================================
+/// Return a structure version that no Skeleton has used yet
+static std::size_t issueStructureVersion()
+{
+  static std::atomic<std::size_t> nextVersion(1u);
+  return nextVersion++;
+}
+
 //==============================================================================
 Skeleton::Skeleton(const AspectPropertiesData& properties)
   : mTotalMass(0.0),
     mIsImpulseApplied(false),
-    mUnionSize(1)
+    mIsSleeping(false),
+    mStructureVersion(issueStructureVersion()),
+    mUnionSize(1),
+    mRestingTime(0.0),
+    mIslandIndex(0u)
 {
   createAspect<Aspect>(properties);
   createAspect<detail::BodyNodeVectorProxyAspect>();
@@ -2028,6 +2135,7 @@ void Skeleton::registerBodyNode(BodyNode* _newBodyNode)
 
   updateTotalMass();
   updateCacheDimensions(_newBodyNode->mTreeIndex);
+  mStructureVersion = issueStructureVersion();
 
 #ifndef NDEBUG // Debug mode
   for(std::size_t i=0; i<mSkelCache.mBodyNodes.size(); ++i)
@@ -2235,6 +2343,7 @@ void Skeleton::unregisterBodyNode(BodyNode* _oldBodyNode)
   }
 
   updateTotalMass();
+  mStructureVersion = issueStructureVersion();
 }
 
 //==============================================================================
@@ -2616,6 +2725,13 @@ void Skeleton::updateMassMatrix(std::size_t _treeIdx) const
     return;
   }
 
+  if (mAspectProperties.mMassMatrixAlgorithm == COMPOSITE_RIGID_BODY
+      && updateCompositeRigidBodyMassMatrix(_treeIdx))
+  {
+    cache.mDirty.mMassMatrix = false;
+    return;
+  }
+
   cache.mM.setZero();
 
   // Backup the original internal force
@@ -2664,6 +2780,83 @@ void Skeleton::updateMassMatrix(std::size_t _treeIdx) const
   cache.mDirty.mMassMatrix = false;
 }
 
+//==============================================================================
+bool Skeleton::updateCompositeRigidBodyMassMatrix(std::size_t _treeIdx) const
+{
+  DataCache& cache = mTreeCache[_treeIdx];
+
+  // Point masses are not rigidly attached to their SoftBodyNodes, so they do
+  // not fit into a composite rigid body inertia.
+  for (const BodyNode* bodyNode : cache.mBodyNodes)
+  {
+    if (bodyNode->asSoftBodyNode())
+      return false;
+  }
+
+  // Backward pass: composite inertia of the subtree rooted at each BodyNode,
+  // expressed in the frame of that BodyNode
+  for (std::vector<BodyNode*>::const_reverse_iterator it =
+       cache.mBodyNodes.rbegin(); it != cache.mBodyNodes.rend(); ++it)
+  {
+    BodyNode* bodyNode = *it;
+    bodyNode->mCompositeInertia
+        = bodyNode->mAspectProperties.mInertia.getSpatialTensor();
+
+    for (const BodyNode* child : bodyNode->mChildBodyNodes)
+    {
+      bodyNode->mCompositeInertia += math::transformInertia(
+            child->mParentJoint->getRelativeTransform().inverse(),
+            child->mCompositeInertia);
+    }
+  }
+
+  // Column pass: the spatial force needed to give each DOF a unit acceleration
+  // is propagated from its BodyNode towards the root only. Entries coupling
+  // DOFs of different branches are zero and are never touched.
+  Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 6> F;
+  cache.mM.setZero();
+
+  for (BodyNode* bodyNode : cache.mBodyNodes)
+  {
+    const Joint* joint = bodyNode->mParentJoint;
+    const std::size_t dof = joint->getNumDofs();
+    if (dof == 0)
+      continue;
+
+    const std::size_t iStart = joint->getIndexInTree(0);
+    const math::Jacobian& S = joint->getRelativeJacobian();
+
+    F.noalias() = bodyNode->mCompositeInertia * S;
+    cache.mM.block(iStart, iStart, dof, dof).noalias() = S.transpose() * F;
+
+    const BodyNode* child = bodyNode;
+    const BodyNode* parent = bodyNode->mParentBodyNode;
+    while (parent)
+    {
+      const Eigen::Isometry3d& T = child->mParentJoint->getRelativeTransform();
+      for (std::size_t k = 0; k < dof; ++k)
+        F.col(k) = math::dAdInvT(T, F.col(k));
+
+      const Joint* parentJoint = parent->mParentJoint;
+      const std::size_t parentDof = parentJoint->getNumDofs();
+      if (parentDof > 0)
+      {
+        cache.mM.block(iStart, parentJoint->getIndexInTree(0), dof, parentDof)
+            .noalias() = F.transpose() * parentJoint->getRelativeJacobian();
+      }
+
+      child = parent;
+      parent = parent->mParentBodyNode;
+    }
+  }
+
+  // Ancestors always have smaller tree indices, so only the lower triangle
+  // has been filled in.
+  cache.mM.triangularView<Eigen::StrictlyUpper>() = cache.mM.transpose();
+
+  return true;
+}
+
 //==============================================================================
 void Skeleton::updateMassMatrix() const
 {
@@ -2889,6 +3082,75 @@ void Skeleton::updateInvMassMatrix() const
   mSkelCache.mDirty.mInvMassMatrix = false;
 }
 
+//==============================================================================
+/// Returns the index of the nearest ancestor of _dof within its tree or within
+/// the whole Skeleton, or INVALID_INDEX if it has none.
+static std::size_t getParentDofIndex(const DegreeOfFreedom* _dof,
+                                     bool _inSkeleton)
+{
+  const Joint* joint = _dof->getJoint();
+  const DegreeOfFreedom* parent = nullptr;
+
+  if (_dof->getIndexInJoint() > 0)
+  {
+    parent = joint->getDof(_dof->getIndexInJoint() - 1);
+  }
+  else
+  {
+    const BodyNode* bodyNode = joint->getParentBodyNode();
+    while (bodyNode && bodyNode->getParentJoint()->getNumDofs() == 0)
+      bodyNode = bodyNode->getParentBodyNode();
+
+    if (bodyNode)
+    {
+      const Joint* parentJoint = bodyNode->getParentJoint();
+      parent = parentJoint->getDof(parentJoint->getNumDofs() - 1);
+    }
+  }
+
+  if (nullptr == parent)
+    return INVALID_INDEX;
+
+  return _inSkeleton ? parent->getIndexInSkeleton() : parent->getIndexInTree();
+}
+
+//==============================================================================
+void Skeleton::updateMassMatrixFactorization(std::size_t _treeIdx) const
+{
+  DataCache& cache = mTreeCache[_treeIdx];
+
+  std::vector<std::size_t> parents(cache.mDofs.size());
+  for (std::size_t i = 0; i < parents.size(); ++i)
+    parents[i] = getParentDofIndex(cache.mDofs[i], false);
+
+  if (!cache.mFactorizedM.compute(getMassMatrix(_treeIdx), parents))
+  {
+    dtwarn << "[Skeleton::updateMassMatrixFactorization] The mass matrix of "
+           << "tree [" << _treeIdx << "] of Skeleton [" << getName()
+           << "] is not positive definite.\n";
+  }
+
+  cache.mDirty.mMassMatrixFactorization = false;
+}
+
+//==============================================================================
+void Skeleton::updateMassMatrixFactorization() const
+{
+  // The DOFs of the Skeleton are registered after the DOFs of their ancestors,
+  // so the ancestors of every DOF come first here as well.
+  std::vector<std::size_t> parents(mSkelCache.mDofs.size());
+  for (std::size_t i = 0; i < parents.size(); ++i)
+    parents[i] = getParentDofIndex(mSkelCache.mDofs[i], true);
+
+  if (!mSkelCache.mFactorizedM.compute(getMassMatrix(), parents))
+  {
+    dtwarn << "[Skeleton::updateMassMatrixFactorization] The mass matrix of "
+           << "Skeleton [" << getName() << "] is not positive definite.\n";
+  }
+
+  mSkelCache.mDirty.mMassMatrixFactorization = false;
+}
+
 //==============================================================================
 void Skeleton::updateInvAugMassMatrix(std::size_t _treeIdx) const
 {
@@ -3519,6 +3781,7 @@ void Skeleton::dirtyArticulatedInertia(std::size_t _treeIdx)
   SET_FLAG(_treeIdx, mMassMatrix);
   SET_FLAG(_treeIdx, mAugMassMatrix);
   SET_FLAG(_treeIdx, mInvMassMatrix);
+  SET_FLAG(_treeIdx, mMassMatrixFactorization);
   SET_FLAG(_treeIdx, mInvAugMassMatrix);
   SET_FLAG(_treeIdx, mCoriolisForces);
   SET_FLAG(_treeIdx, mGravityForces);
@@ -3942,6 +4205,7 @@ Skeleton::DirtyFlags::DirtyFlags()
     mMassMatrix(true),
     mAugMassMatrix(true),
     mInvMassMatrix(true),
+    mMassMatrixFactorization(true),
     mInvAugMassMatrix(true),
     mGravityForces(true),
     mCoriolisForces(true),
@@ -42,6 +42,8 @@
 #include "dart/dynamics/ShapeNode.hpp"
 #include "dart/dynamics/EndEffector.hpp"
 #include "dart/dynamics/Marker.hpp"
+#include "dart/dynamics/MassMatrixFactorization.hpp"
+#include "dart/dynamics/AllowedCollisionMatrix.hpp"
 #include "dart/dynamics/detail/BodyNodeAspect.hpp"
 #include "dart/dynamics/SpecializedNodeManager.hpp"
 #include "dart/dynamics/detail/SkeletonAspect.hpp"
@@ -64,6 +66,12 @@ public:
   using State = common::Composite::State;
   using Properties = common::Composite::Properties;
 
+  typedef detail::MassMatrixAlgorithm MassMatrixAlgorithm;
+  static constexpr MassMatrixAlgorithm UNIT_ACCELERATION
+      = detail::UNIT_ACCELERATION;
+  static constexpr MassMatrixAlgorithm COMPOSITE_RIGID_BODY
+      = detail::COMPOSITE_RIGID_BODY;
+
   enum ConfigFlags
   {
     CONFIG_NOTHING       = 0,
@@ -262,6 +270,17 @@ public:
   /// Return true if self-collision check is enabled including adjacent bodies.
   bool isEnabledAdjacentBodyCheck() const;
 
+  /// Set the matrix of BodyNode pairs whose self-collisions don't need to be
+  /// checked. The matrix is ignored if it wasn't created for the current
+  /// number of BodyNodes of this Skeleton. Pass nullptr to remove it.
+  void setAllowedCollisionMatrix(
+      const std::shared_ptr<const AllowedCollisionMatrix>& matrix);
+
+  /// Get the matrix of BodyNode pairs whose self-collisions don't need to be
+  /// checked, or nullptr if there is none
+  const std::shared_ptr<const AllowedCollisionMatrix>&
+  getAllowedCollisionMatrix() const;
+
   /// Set whether this skeleton will be updated by forward dynamics.
   /// \param[in] _isMobile True if this skeleton is mobile.
   void setMobile(bool _isMobile);
@@ -270,6 +289,16 @@ public:
   /// \return True if this skeleton is mobile.
   bool isMobile() const;
 
+  /// Put this Skeleton to sleep or wake it up. World::step() skips the
+  /// dynamics of a sleeping Skeleton until it is woken up. Putting a Skeleton
+  /// to sleep sets its velocities to zero. The ConstraintSolver puts resting
+  /// Skeletons to sleep and wakes them up automatically when sleeping is
+  /// enabled, see ConstraintSolver::setSleepingEnabled().
+  void setSleeping(bool sleeping);
+
+  /// Return true if this Skeleton is sleeping
+  bool isSleeping() const;
+
   /// Set time step. This timestep is used for implicit joint damping
   /// force.
   void setTimeStep(double _timeStep);
@@ -277,6 +306,14 @@ public:
   /// Get time step.
   double getTimeStep() const;
 
+  /// Set the algorithm used to compute the mass matrix. Both algorithms give
+  /// the same result; COMPOSITE_RIGID_BODY is faster for Skeletons with many
+  /// degrees of freedom, especially when they have several branches.
+  void setMassMatrixAlgorithm(MassMatrixAlgorithm _algorithm);
+
+  /// Get the algorithm used to compute the mass matrix
+  MassMatrixAlgorithm getMassMatrixAlgorithm() const;
+
   /// Set 3-dim gravitational acceleration. The gravity is used for
   /// calculating gravity force vector of the skeleton.
   void setGravity(const Eigen::Vector3d& _gravity);
@@ -444,6 +481,12 @@ public:
   /// indexing.
   bool checkIndexingConsistency() const;
 
+  /// Get a number that changes whenever BodyNodes or Joints are added to,
+  /// removed from, or moved within this Skeleton. No two Skeletons ever share
+  /// a number, so a cached number identifies both the Skeleton and its
+  /// structure.
+  std::size_t getStructureVersion() const;
+
   /// Get a pointer to a WholeBodyIK module for this Skeleton. If _createIfNull
   /// is true, then the IK module will be generated if one does not already
   /// exist.
@@ -774,6 +817,15 @@ public:
   // Documentation inherited
   const Eigen::MatrixXd& getInvMassMatrix() const override;
 
+  /// Get the L^T * L factorization of the mass matrix of a specific tree in
+  /// the Skeleton. Solving with the factorization is cheaper than forming the
+  /// inverse mass matrix.
+  const MassMatrixFactorization& getMassMatrixFactorization(
+      std::size_t _treeIdx) const;
+
+  /// Get the L^T * L factorization of the mass matrix of the Skeleton
+  const MassMatrixFactorization& getMassMatrixFactorization() const;
+
   /// Get the inverse augmented mass matrix of a tree
   const Eigen::MatrixXd& getInvAugMassMatrix(std::size_t _treeIdx) const;
 
@@ -1026,6 +1078,11 @@ protected:
   /// Update the mass matrix of a tree
   void updateMassMatrix(std::size_t _treeIdx) const;
 
+  /// Update the mass matrix of a tree using the Composite Rigid Body
+  /// Algorithm. Returns false without touching the mass matrix if the tree
+  /// cannot be handled by this algorithm.
+  bool updateCompositeRigidBodyMassMatrix(std::size_t _treeIdx) const;
+
   /// Update mass matrix of the skeleton.
   void updateMassMatrix() const;
 
@@ -1040,6 +1097,12 @@ protected:
   /// Update inverse of mass matrix of the skeleton.
   void updateInvMassMatrix() const;
 
+  /// Update the factorization of the mass matrix of a tree
+  void updateMassMatrixFactorization(std::size_t _treeIdx) const;
+
+  /// Update the factorization of the mass matrix of the skeleton.
+  void updateMassMatrixFactorization() const;
+
   /// Update the inverse augmented mass matrix of a tree
   void updateInvAugMassMatrix(std::size_t _treeIdx) const;
 
@@ -1126,6 +1189,9 @@ protected:
     /// Dirty flag for the inverse of mass matrix.
     bool mInvMassMatrix;
 
+    /// Dirty flag for the factorization of the mass matrix.
+    bool mMassMatrixFactorization;
+
     /// Dirty flag for the inverse of augmented mass matrix.
     bool mInvAugMassMatrix;
 
@@ -1177,6 +1243,9 @@ protected:
     /// Inverse of mass matrix for the skeleton.
     Eigen::MatrixXd mInvM;
 
+    /// Factorization of the mass matrix for the skeleton.
+    MassMatrixFactorization mFactorizedM;
+
     /// Inverse of augmented mass matrix for the skeleton.
     Eigen::MatrixXd mInvAugM;
 
@@ -1232,6 +1301,15 @@ protected:
   /// Flag for status of impulse testing.
   bool mIsImpulseApplied;
 
+  /// Whether this Skeleton is sleeping
+  bool mIsSleeping;
+
+  /// Number that changes whenever the structure of this Skeleton changes
+  std::size_t mStructureVersion;
+
+  /// BodyNode pairs whose self-collisions don't need to be checked
+  std::shared_ptr<const AllowedCollisionMatrix> mAllowedCollisionMatrix;
+
   mutable std::mutex mMutex;
 
 public:
@@ -1254,6 +1332,19 @@ public:
   ///
   std::size_t mUnionIndex;
 
+  //--------------------------------------------------------------------------
+  // Sleeping
+  //--------------------------------------------------------------------------
+  /// How long this Skeleton has been resting for while awake
+  double mRestingTime;
+
+  /// Positions of this Skeleton when it was put to sleep
+  Eigen::VectorXd mSleepingPositions;
+
+  /// Index of the Skeleton that represents the island of Skeletons in contact
+  /// with this Skeleton in the last step of the ConstraintSolver
+  std::size_t mIslandIndex;
+
 public:
   // To get byte-aligned Eigen vectors
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -0,0 +1,730 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/SkeletonWorkspace.hpp"
+
+#include <cassert>
+
+#include "dart/common/Console.hpp"
+#include "dart/math/Geometry.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/InvalidIndex.hpp"
+#include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+namespace dart {
+namespace dynamics {
+
+namespace {
+
+//==============================================================================
+/// Compute the transforms of the BodyNodes and the relative Jacobians of their
+/// parent Joints
+void updateTransforms(const Skeleton& _skeleton,
+                      SkeletonWorkspace& _workspace,
+                      const Eigen::Ref<const Eigen::VectorXd>& _positions)
+{
+  assert(static_cast<std::size_t>(_positions.size())
+         == _skeleton.getNumDofs());
+
+  for (std::size_t i = 0; i < _workspace.parentIndices.size(); ++i)
+  {
+    const Joint* joint = _skeleton.getBodyNode(i)->getParentJoint();
+    Eigen::VectorXd& q = _workspace.jointPositions[i];
+    q = _positions.segment(_workspace.dofIndices[i], _workspace.numDofs[i]);
+
+    _workspace.relativeTransforms[i] = joint->computeRelativeTransform(q);
+    joint->computeRelativeJacobian(q, _workspace.relativeJacobians[i]);
+
+    const std::size_t parent = _workspace.parentIndices[i];
+    if (parent == INVALID_INDEX)
+    {
+      _workspace.worldTransforms[i] = _workspace.relativeTransforms[i];
+    }
+    else
+    {
+      _workspace.worldTransforms[i] = _workspace.worldTransforms[parent]
+                                      * _workspace.relativeTransforms[i];
+    }
+  }
+}
+
+//==============================================================================
+/// Compute the spatial velocities and the partial accelerations of the
+/// BodyNodes. The transforms must be up to date.
+void updateVelocities(const Skeleton& _skeleton,
+                      SkeletonWorkspace& _workspace,
+                      const Eigen::Ref<const Eigen::VectorXd>& _velocities)
+{
+  assert(static_cast<std::size_t>(_velocities.size())
+         == _skeleton.getNumDofs());
+
+  for (std::size_t i = 0; i < _workspace.parentIndices.size(); ++i)
+  {
+    const Joint* joint = _skeleton.getBodyNode(i)->getParentJoint();
+    Eigen::VectorXd& dq = _workspace.jointVelocities[i];
+    dq = _velocities.segment(_workspace.dofIndices[i], _workspace.numDofs[i]);
+
+    const Eigen::Vector6d relativeVelocity
+        = _workspace.relativeJacobians[i] * dq;
+
+    Eigen::Vector6d& V = _workspace.spatialVelocities[i];
+    const std::size_t parent = _workspace.parentIndices[i];
+    if (parent == INVALID_INDEX)
+    {
+      V = relativeVelocity;
+    }
+    else
+    {
+      V = math::AdInvT(_workspace.relativeTransforms[i],
+                       _workspace.spatialVelocities[parent])
+          + relativeVelocity;
+    }
+
+    // ad(V, S * dq) + dS * dq
+    math::Jacobian& dS = _workspace.relativeJacobianDerivs[i];
+    joint->computeRelativeJacobianTimeDeriv(
+          _workspace.jointPositions[i], dq, dS);
+
+    Eigen::Vector6d& c = _workspace.partialAccelerations[i];
+    c = math::ad(V, relativeVelocity);
+    c.noalias() += dS * dq;
+  }
+}
+
+//==============================================================================
+/// Compute the gravity force of _bodyNode whose world transform is _T
+Eigen::Vector6d computeGravityForce(const Skeleton& _skeleton,
+                                    const BodyNode* _bodyNode,
+                                    const Eigen::Isometry3d& _T)
+{
+  if (!_bodyNode->getGravityMode())
+    return Eigen::Vector6d::Zero();
+
+  return _bodyNode->getSpatialInertia()
+      * math::AdInvRLinear(_T, _skeleton.getGravity());
+}
+
+} // anonymous namespace
+
+//==============================================================================
+SkeletonWorkspace::SkeletonWorkspace()
+  : mStructureVersion(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+SkeletonWorkspace::SkeletonWorkspace(const Skeleton& _skeleton)
+  : mStructureVersion(0u)
+{
+  resize(_skeleton);
+}
+
+//==============================================================================
+void SkeletonWorkspace::resize(const Skeleton& _skeleton)
+{
+  // The structure version identifies the Skeleton too, so the workspace is
+  // already sized for it if the versions match
+  const std::size_t structureVersion = _skeleton.getStructureVersion();
+  if (structureVersion == mStructureVersion)
+    return;
+
+  mStructureVersion = structureVersion;
+
+  const std::size_t numBodyNodes = _skeleton.getNumBodyNodes();
+
+  parentIndices.resize(numBodyNodes);
+  dofIndices.resize(numBodyNodes);
+  numDofs.resize(numBodyNodes);
+  jointPositions.resize(numBodyNodes);
+  jointVelocities.resize(numBodyNodes);
+  relativeTransforms.resize(numBodyNodes);
+  worldTransforms.resize(numBodyNodes);
+  relativeJacobians.resize(numBodyNodes);
+  relativeJacobianDerivs.resize(numBodyNodes);
+  spatialVelocities.resize(numBodyNodes);
+  partialAccelerations.resize(numBodyNodes);
+  spatialAccelerations.resize(numBodyNodes);
+  bodyForces.resize(numBodyNodes);
+  biasForces.resize(numBodyNodes);
+  inertias.resize(numBodyNodes);
+  invProjectedInertias.resize(numBodyNodes);
+  totalForces.resize(numBodyNodes);
+  velocityDerivs.resize(numBodyNodes);
+  accelerationDerivs.resize(numBodyNodes);
+  bodyForceDerivs.resize(numBodyNodes);
+  dofMotions.resize(numBodyNodes);
+
+  const std::size_t dof = _skeleton.getNumDofs();
+  dofParents.resize(dof);
+
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+  {
+    const BodyNode* bodyNode = _skeleton.getBodyNode(i);
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+    parentIndices[i] = parent ? parent->getIndexInSkeleton() : INVALID_INDEX;
+
+    // The algorithms visit the parents before their children
+    assert(parentIndices[i] == INVALID_INDEX || parentIndices[i] < i);
+
+    const Joint* joint = bodyNode->getParentJoint();
+    const std::size_t jointDof = joint->getNumDofs();
+    numDofs[i] = jointDof;
+    dofIndices[i] = jointDof > 0 ? joint->getIndexInSkeleton(0) : 0;
+
+    jointPositions[i].resize(jointDof);
+    jointVelocities[i].resize(jointDof);
+    relativeJacobians[i].resize(6, jointDof);
+    relativeJacobianDerivs[i].resize(6, jointDof);
+    invProjectedInertias[i].resize(jointDof, jointDof);
+    totalForces[i].resize(jointDof);
+
+    if (jointDof == 0)
+      continue;
+
+    // The first degree of freedom of a Joint follows the last one of the
+    // nearest ancestor Joint that has any
+    std::size_t ancestor = parentIndices[i];
+    while (ancestor != INVALID_INDEX && numDofs[ancestor] == 0)
+      ancestor = parentIndices[ancestor];
+
+    dofParents[dofIndices[i]] = ancestor == INVALID_INDEX
+        ? INVALID_INDEX : dofIndices[ancestor] + numDofs[ancestor] - 1;
+    for (std::size_t k = 1; k < jointDof; ++k)
+      dofParents[dofIndices[i] + k] = dofIndices[i] + k - 1;
+  }
+
+  forces.resize(dof);
+  accelerations.resize(dof);
+  massMatrix.resize(dof, dof);
+  forcesPositionDeriv.resize(dof, dof);
+  forcesVelocityDeriv.resize(dof, dof);
+  accelerationsPositionDeriv.resize(dof, dof);
+  accelerationsVelocityDeriv.resize(dof, dof);
+  accelerationsForceDeriv.resize(dof, dof);
+}
+
+//==============================================================================
+void computeForwardKinematics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities)
+{
+  _workspace.resize(_skeleton);
+  updateTransforms(_skeleton, _workspace, _positions);
+  updateVelocities(_skeleton, _workspace, _velocities);
+}
+
+//==============================================================================
+const Eigen::VectorXd& computeInverseDynamics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _accelerations)
+{
+  _workspace.resize(_skeleton);
+  computeInverseDynamics(_skeleton, _workspace, _positions, _velocities,
+                         _accelerations, _workspace.forces);
+
+  return _workspace.forces;
+}
+
+//==============================================================================
+void computeInverseDynamics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _accelerations,
+    Eigen::Ref<Eigen::VectorXd> _forces)
+{
+  assert(static_cast<std::size_t>(_accelerations.size())
+         == _skeleton.getNumDofs());
+  assert(static_cast<std::size_t>(_forces.size()) == _skeleton.getNumDofs());
+
+  computeForwardKinematics(_skeleton, _workspace, _positions, _velocities);
+
+  const std::size_t numBodyNodes = _workspace.parentIndices.size();
+
+  // Forward pass: spatial accelerations
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+  {
+    Eigen::Vector6d& A = _workspace.spatialAccelerations[i];
+    A = _workspace.partialAccelerations[i];
+    A.noalias() += _workspace.relativeJacobians[i]
+        * _accelerations.segment(_workspace.dofIndices[i],
+                                 _workspace.numDofs[i]);
+
+    const std::size_t parent = _workspace.parentIndices[i];
+    if (parent != INVALID_INDEX)
+    {
+      A += math::AdInvT(_workspace.relativeTransforms[i],
+                        _workspace.spatialAccelerations[parent]);
+    }
+  }
+
+  // Backward pass: body forces, which children add to their parents once they
+  // are complete
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+  {
+    const BodyNode* bodyNode = _skeleton.getBodyNode(i);
+    const Eigen::Matrix6d& I = bodyNode->getSpatialInertia();
+    const Eigen::Vector6d& V = _workspace.spatialVelocities[i];
+
+    _workspace.bodyForces[i]
+        = I * _workspace.spatialAccelerations[i]
+          - math::dad(V, I * V)
+          - computeGravityForce(_skeleton, bodyNode,
+                                _workspace.worldTransforms[i]);
+  }
+
+  for (std::size_t i = numBodyNodes; i-- > 0;)
+  {
+    const Eigen::Vector6d& F = _workspace.bodyForces[i];
+    _forces.segment(_workspace.dofIndices[i], _workspace.numDofs[i])
+        .noalias() = _workspace.relativeJacobians[i].transpose() * F;
+
+    const std::size_t parent = _workspace.parentIndices[i];
+    if (parent != INVALID_INDEX)
+    {
+      _workspace.bodyForces[parent]
+          += math::dAdInvT(_workspace.relativeTransforms[i], F);
+    }
+  }
+}
+
+//==============================================================================
+const Eigen::VectorXd& computeForwardDynamics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _forces)
+{
+  _workspace.resize(_skeleton);
+  computeForwardDynamics(_skeleton, _workspace, _positions, _velocities,
+                         _forces, _workspace.accelerations);
+
+  return _workspace.accelerations;
+}
+
+//==============================================================================
+void computeForwardDynamics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _forces,
+    Eigen::Ref<Eigen::VectorXd> _accelerations)
+{
+  assert(static_cast<std::size_t>(_forces.size()) == _skeleton.getNumDofs());
+  assert(static_cast<std::size_t>(_accelerations.size())
+         == _skeleton.getNumDofs());
+
+  computeForwardKinematics(_skeleton, _workspace, _positions, _velocities);
+
+  const std::size_t numBodyNodes = _workspace.parentIndices.size();
+
+  // Joints have at most six degrees of freedom, so these never allocate
+  Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 6> AIS;
+  Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 6> AISinvD;
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, 6, 6> D;
+  Eigen::Matrix<double, Eigen::Dynamic, 1, 0, 6, 1> u;
+
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+  {
+    const BodyNode* bodyNode = _skeleton.getBodyNode(i);
+    const Eigen::Matrix6d& I = bodyNode->getSpatialInertia();
+    const Eigen::Vector6d& V = _workspace.spatialVelocities[i];
+
+    _workspace.inertias[i] = I;
+    _workspace.biasForces[i]
+        = -math::dad(V, I * V)
+          - computeGravityForce(_skeleton, bodyNode,
+                                _workspace.worldTransforms[i]);
+  }
+
+  // Backward pass: articulated inertias and bias forces
+  for (std::size_t i = numBodyNodes; i-- > 0;)
+  {
+    const Eigen::Matrix6d& AI = _workspace.inertias[i];
+    const math::Jacobian& S = _workspace.relativeJacobians[i];
+    const Eigen::Vector6d& c = _workspace.partialAccelerations[i];
+
+    Eigen::Matrix6d PI = AI;
+    Eigen::Vector6d beta = _workspace.biasForces[i] + AI * c;
+
+    if (_workspace.numDofs[i] > 0)
+    {
+      AIS.noalias() = AI * S;
+      D.noalias() = S.transpose() * AIS;
+      Eigen::MatrixXd& invD = _workspace.invProjectedInertias[i];
+      invD = D.inverse();
+
+      Eigen::VectorXd& totalForce = _workspace.totalForces[i];
+      totalForce
+          = _forces.segment(_workspace.dofIndices[i], _workspace.numDofs[i]);
+      totalForce.noalias() -= S.transpose() * beta;
+
+      AISinvD.noalias() = AIS * invD;
+      PI.noalias() -= AISinvD * AIS.transpose();
+      beta.noalias() += AISinvD * totalForce;
+    }
+
+    const std::size_t parent = _workspace.parentIndices[i];
+    if (parent != INVALID_INDEX)
+    {
+      const Eigen::Isometry3d& T = _workspace.relativeTransforms[i];
+      _workspace.inertias[parent] += math::transformInertia(T.inverse(), PI);
+      _workspace.biasForces[parent] += math::dAdInvT(T, beta);
+    }
+  }
+
+  // Forward pass: joint and spatial accelerations
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+  {
+    Eigen::Vector6d& A = _workspace.spatialAccelerations[i];
+    const std::size_t parent = _workspace.parentIndices[i];
+    if (parent == INVALID_INDEX)
+    {
+      A.setZero();
+    }
+    else
+    {
+      A = math::AdInvT(_workspace.relativeTransforms[i],
+                       _workspace.spatialAccelerations[parent]);
+    }
+
+    const std::size_t dof = _workspace.numDofs[i];
+    if (dof > 0)
+    {
+      const math::Jacobian& S = _workspace.relativeJacobians[i];
+      auto ddq = _accelerations.segment(_workspace.dofIndices[i], dof);
+
+      u = _workspace.totalForces[i];
+      u.noalias() -= S.transpose() * (_workspace.inertias[i] * A);
+      ddq.noalias() = _workspace.invProjectedInertias[i] * u;
+      A.noalias() += S * ddq;
+    }
+
+    A += _workspace.partialAccelerations[i];
+  }
+}
+
+//==============================================================================
+const Eigen::MatrixXd& computeMassMatrix(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions)
+{
+  _workspace.resize(_skeleton);
+  updateTransforms(_skeleton, _workspace, _positions);
+
+  const std::size_t numBodyNodes = _workspace.parentIndices.size();
+
+  // Backward pass: composite inertia of the subtree rooted at each BodyNode
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+    _workspace.inertias[i] = _skeleton.getBodyNode(i)->getSpatialInertia();
+
+  for (std::size_t i = numBodyNodes; i-- > 0;)
+  {
+    const std::size_t parent = _workspace.parentIndices[i];
+    if (parent != INVALID_INDEX)
+    {
+      _workspace.inertias[parent] += math::transformInertia(
+            _workspace.relativeTransforms[i].inverse(),
+            _workspace.inertias[i]);
+    }
+  }
+
+  // Column pass: the spatial force needed to give each DOF a unit acceleration
+  // is propagated from its BodyNode towards the root only
+  Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 6> F;
+  Eigen::MatrixXd& M = _workspace.massMatrix;
+  M.setZero();
+
+  for (std::size_t i = 0; i < numBodyNodes; ++i)
+  {
+    const std::size_t dof = _workspace.numDofs[i];
+    if (dof == 0)
+      continue;
+
+    const std::size_t iStart = _workspace.dofIndices[i];
+    const math::Jacobian& S = _workspace.relativeJacobians[i];
+
+    F.noalias() = _workspace.inertias[i] * S;
+    M.block(iStart, iStart, dof, dof).noalias() = S.transpose() * F;
+
+    std::size_t child = i;
+    std::size_t parent = _workspace.parentIndices[i];
+    while (parent != INVALID_INDEX)
+    {
+      const Eigen::Isometry3d& T = _workspace.relativeTransforms[child];
+      for (std::size_t k = 0; k < dof; ++k)
+        F.col(k) = math::dAdInvT(T, F.col(k));
+
+      const std::size_t parentDof = _workspace.numDofs[parent];
+      if (parentDof > 0)
+      {
+        const std::size_t jStart = _workspace.dofIndices[parent];
+        M.block(iStart, jStart, dof, parentDof).noalias()
+            = F.transpose() * _workspace.relativeJacobians[parent];
+        M.block(jStart, iStart, parentDof, dof)
+            = M.block(iStart, jStart, dof, parentDof).transpose();
+      }
+
+      child = parent;
+      parent = _workspace.parentIndices[parent];
+    }
+  }
+
+  return M;
+}
+
+//==============================================================================
+void computeInverseDynamicsDerivatives(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _accelerations)
+{
+  computeInverseDynamics(_skeleton, _workspace, _positions, _velocities,
+                         _accelerations);
+
+  const std::size_t numBodyNodes = _workspace.parentIndices.size();
+  const Eigen::Vector3d& gravity = _skeleton.getGravity();
+
+  std::vector<bool> isAffected(numBodyNodes);
+
+  // One column per degree of freedom j of the Joint of BodyNode b. Only b and
+  // its descendants move when j moves, and their forces reach the ancestors of
+  // b through the backward pass.
+  for (std::size_t b = 0; b < numBodyNodes; ++b)
+  {
+    const std::size_t dof = _workspace.numDofs[b];
+    if (dof == 0)
+      continue;
+
+    const Joint* joint = _skeleton.getBodyNode(b)->getParentJoint();
+    const Eigen::VectorXd& q = _workspace.jointPositions[b];
+    const Eigen::VectorXd& dq = _workspace.jointVelocities[b];
+    const auto ddq = _accelerations.segment(_workspace.dofIndices[b], dof);
+    const math::Jacobian& S = _workspace.relativeJacobians[b];
+    const math::Jacobian& dS = _workspace.relativeJacobianDerivs[b];
+    const Eigen::Vector6d& V = _workspace.spatialVelocities[b];
+    const Eigen::Vector6d& F = _workspace.bodyForces[b];
+    const Eigen::Vector6d Sdq = S * dq;
+
+    // Velocity and acceleration of the parent BodyNode in the frame of b
+    const Eigen::Vector6d parentV = V - Sdq;
+    const Eigen::Vector6d parentA = _workspace.spatialAccelerations[b]
+        - S * ddq - _workspace.partialAccelerations[b];
+
+    for (std::size_t l = 0; l < dof; ++l)
+    {
+      const std::size_t j = _workspace.dofIndices[b] + l;
+      const Eigen::Vector6d Sj = S.col(l);
+      const math::Jacobian dSj = joint->computeRelativeJacobianDeriv(q, l);
+      const Eigen::Vector6d dSjdq = dSj * dq;
+
+      for (int pass = 0; pass < 2; ++pass)
+      {
+        const bool isPositionPass = pass == 0;
+
+        // Forward pass
+        for (std::size_t i = 0; i < numBodyNodes; ++i)
+        {
+          const std::size_t parent = _workspace.parentIndices[i];
+          isAffected[i] = i == b
+              || (i > b && parent != INVALID_INDEX && isAffected[parent]);
+
+          Eigen::Vector6d& dV_i = _workspace.velocityDerivs[i];
+          Eigen::Vector6d& dA_i = _workspace.accelerationDerivs[i];
+          Eigen::Vector6d& dF_i = _workspace.bodyForceDerivs[i];
+          Eigen::Vector6d& motion = _workspace.dofMotions[i];
+
+          if (!isAffected[i])
+          {
+            dF_i.setZero();
+            continue;
+          }
+
+          const Eigen::Vector6d& V_i = _workspace.spatialVelocities[i];
+          if (i == b)
+          {
+            motion = Sj;
+            if (isPositionPass)
+            {
+              dV_i = -math::ad(Sj, parentV) + dSjdq;
+              dA_i = -math::ad(Sj, parentA) + dSj * ddq
+                  + math::ad(dV_i, Sdq) + math::ad(V_i, dSjdq)
+                  + joint->computeRelativeJacobianTimeDerivDeriv(q, dq, l)
+                    * dq;
+            }
+            else
+            {
+              dV_i = Sj;
+              dA_i = math::ad(Sj, Sdq) + math::ad(V_i, Sj) + dSjdq
+                  + dS.col(l);
+            }
+          }
+          else
+          {
+            const Eigen::Isometry3d& T = _workspace.relativeTransforms[i];
+            motion = math::AdInvT(T, _workspace.dofMotions[parent]);
+            dV_i = math::AdInvT(T, _workspace.velocityDerivs[parent]);
+            dA_i = math::AdInvT(T, _workspace.accelerationDerivs[parent])
+                + math::ad(dV_i, _workspace.relativeJacobians[i]
+                                 * _workspace.jointVelocities[i]);
+          }
+
+          const BodyNode* bodyNode = _skeleton.getBodyNode(i);
+          const Eigen::Matrix6d& I = bodyNode->getSpatialInertia();
+          dF_i = I * dA_i - math::dad(dV_i, I * V_i)
+              - math::dad(V_i, I * dV_i);
+
+          // The gravity in the frame of the BodyNode turns against its motion
+          if (isPositionPass && bodyNode->getGravityMode())
+          {
+            const Eigen::Vector3d g
+                = _workspace.worldTransforms[i].linear().transpose() * gravity;
+            Eigen::Vector6d dg = Eigen::Vector6d::Zero();
+            dg.tail<3>() = -motion.head<3>().cross(g);
+            dF_i -= I * dg;
+          }
+        }
+
+        // Backward pass
+        Eigen::MatrixXd& deriv = isPositionPass
+            ? _workspace.forcesPositionDeriv : _workspace.forcesVelocityDeriv;
+        for (std::size_t i = numBodyNodes; i-- > 0;)
+        {
+          const Eigen::Vector6d& dF_i = _workspace.bodyForceDerivs[i];
+          auto column = deriv.col(j).segment(_workspace.dofIndices[i],
+                                             _workspace.numDofs[i]);
+          column.noalias() = _workspace.relativeJacobians[i].transpose() * dF_i;
+          if (isPositionPass && i == b)
+            column.noalias() += dSj.transpose() * F;
+
+          const std::size_t parent = _workspace.parentIndices[i];
+          if (parent == INVALID_INDEX)
+            continue;
+
+          const Eigen::Isometry3d& T = _workspace.relativeTransforms[i];
+          _workspace.bodyForceDerivs[parent] += math::dAdInvT(T, dF_i);
+          if (isPositionPass && i == b)
+          {
+            _workspace.bodyForceDerivs[parent]
+                -= math::dAdInvT(T, math::dad(Sj, F));
+          }
+        }
+      }
+    }
+  }
+}
+
+//==============================================================================
+void computeForwardDynamicsDerivatives(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _forces)
+{
+  computeForwardDynamics(_skeleton, _workspace, _positions, _velocities,
+                         _forces);
+
+  // Neither of these writes to _workspace.accelerations
+  computeInverseDynamicsDerivatives(_skeleton, _workspace, _positions,
+                                    _velocities, _workspace.accelerations);
+  computeMassMatrix(_skeleton, _workspace, _positions);
+
+  MassMatrixFactorization& factorization = _workspace.massMatrixFactorization;
+  if (!factorization.compute(_workspace.massMatrix, _workspace.dofParents))
+  {
+    dtwarn << "[computeForwardDynamicsDerivatives] The mass matrix of "
+           << "Skeleton [" << _skeleton.getName() << "] is not positive "
+           << "definite.\n";
+    return;
+  }
+
+  _workspace.accelerationsPositionDeriv = -_workspace.forcesPositionDeriv;
+  factorization.solveInPlace(_workspace.accelerationsPositionDeriv);
+
+  _workspace.accelerationsVelocityDeriv = -_workspace.forcesVelocityDeriv;
+  factorization.solveInPlace(_workspace.accelerationsVelocityDeriv);
+
+  _workspace.accelerationsForceDeriv = factorization.getInverse();
+}
+
+//==============================================================================
+math::Jacobian computeJacobian(const Skeleton& _skeleton,
+                               const SkeletonWorkspace& _workspace,
+                               const BodyNode* _bodyNode)
+{
+  assert(_bodyNode->getSkeleton().get() == &_skeleton);
+
+  math::Jacobian J = math::Jacobian::Zero(6, _skeleton.getNumDofs());
+
+  // Transform from _bodyNode to the BodyNode whose Joint is being visited
+  Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+  std::size_t index = _bodyNode->getIndexInSkeleton();
+  while (index != INVALID_INDEX)
+  {
+    const std::size_t dof = _workspace.numDofs[index];
+    if (dof > 0)
+    {
+      J.middleCols(_workspace.dofIndices[index], dof)
+          = math::AdInvTJac(T, _workspace.relativeJacobians[index]);
+    }
+
+    T = _workspace.relativeTransforms[index] * T;
+    index = _workspace.parentIndices[index];
+  }
+
+  return J;
+}
+
+//==============================================================================
+math::Jacobian computeWorldJacobian(const Skeleton& _skeleton,
+                                    const SkeletonWorkspace& _workspace,
+                                    const BodyNode* _bodyNode)
+{
+  return math::AdRJac(
+        _workspace.worldTransforms[_bodyNode->getIndexInSkeleton()],
+        computeJacobian(_skeleton, _workspace, _bodyNode));
+}
+
+} // namespace dynamics
+} // namespace dart
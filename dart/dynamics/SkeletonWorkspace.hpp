@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_SKELETONWORKSPACE_HPP_
+#define DART_DYNAMICS_SKELETONWORKSPACE_HPP_
+
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/math/MathTypes.hpp"
+#include "dart/dynamics/MassMatrixFactorization.hpp"
+
+namespace dart {
+namespace dynamics {
+
+class BodyNode;
+class Skeleton;
+
+/// SkeletonWorkspace holds everything that the algorithms below compute for a
+/// Skeleton, so that the Skeleton itself is only read. Evaluating the same
+/// Skeleton from several threads at the same time requires one workspace per
+/// thread.
+///
+/// The algorithms read the structure, the inertias, the gravity, and the
+/// properties of the Joints of the Skeleton, but none of its state. They treat
+/// every Joint as force-actuated and ignore joint springs, damping, Coulomb
+/// friction, external forces, and the point masses of SoftBodyNodes.
+///
+/// The per-BodyNode entries are indexed by BodyNode::getIndexInSkeleton(), and
+/// all spatial quantities are expressed in the frame of their BodyNode, like
+/// the ones that BodyNode computes. The buffers keep their size between calls,
+/// so a workspace that is reused for the same Skeleton doesn't reallocate
+/// them. Once the workspace is sized, computeForwardKinematics(),
+/// computeInverseDynamics(), computeForwardDynamics(), and computeMassMatrix()
+/// don't allocate any memory, which makes them suitable for real-time control
+/// loops.
+class SkeletonWorkspace
+{
+public:
+  /// Constructor. Creates an empty workspace.
+  SkeletonWorkspace();
+
+  /// Constructor. Sizes the workspace for _skeleton.
+  explicit SkeletonWorkspace(const Skeleton& _skeleton);
+
+  /// Size the buffers for _skeleton and read its structure. The algorithms
+  /// below call this themselves. Nothing is done if the workspace was last
+  /// sized for the same Skeleton and its structure hasn't changed since.
+  void resize(const Skeleton& _skeleton);
+
+  /// Index of the parent of each BodyNode, or INVALID_INDEX for root BodyNodes
+  std::vector<std::size_t> parentIndices;
+
+  /// Index of the first degree of freedom of the parent Joint of each BodyNode
+  std::vector<std::size_t> dofIndices;
+
+  /// Number of degrees of freedom of the parent Joint of each BodyNode
+  std::vector<std::size_t> numDofs;
+
+  /// Index of the nearest ancestor of each degree of freedom, or INVALID_INDEX
+  std::vector<std::size_t> dofParents;
+
+  /// Positions of the parent Joint of each BodyNode
+  std::vector<Eigen::VectorXd> jointPositions;
+
+  /// Velocities of the parent Joint of each BodyNode
+  std::vector<Eigen::VectorXd> jointVelocities;
+
+  /// Transform of each BodyNode relative to its parent
+  Eigen::aligned_vector<Eigen::Isometry3d> relativeTransforms;
+
+  /// Transform of each BodyNode relative to the World
+  Eigen::aligned_vector<Eigen::Isometry3d> worldTransforms;
+
+  /// Relative Jacobian of the parent Joint of each BodyNode
+  std::vector<math::Jacobian> relativeJacobians;
+
+  /// Time derivative of the relative Jacobian of the parent Joint of each
+  /// BodyNode
+  std::vector<math::Jacobian> relativeJacobianDerivs;
+
+  /// Spatial velocity of each BodyNode
+  Eigen::aligned_vector<Eigen::Vector6d> spatialVelocities;
+
+  /// Partial acceleration of each BodyNode, i.e., its spatial acceleration
+  /// when the parent BodyNode and the parent Joint don't accelerate
+  Eigen::aligned_vector<Eigen::Vector6d> partialAccelerations;
+
+  /// Spatial acceleration of each BodyNode
+  Eigen::aligned_vector<Eigen::Vector6d> spatialAccelerations;
+
+  /// Spatial force that each BodyNode receives from its parent Joint
+  Eigen::aligned_vector<Eigen::Vector6d> bodyForces;
+
+  /// Bias force of the articulated body of each BodyNode
+  Eigen::aligned_vector<Eigen::Vector6d> biasForces;
+
+  /// Articulated inertia of each BodyNode in computeForwardDynamics(), and
+  /// composite inertia of its subtree in computeMassMatrix()
+  Eigen::aligned_vector<Eigen::Matrix6d> inertias;
+
+  /// Inverse of the articulated inertia projected onto the parent Joint of each
+  /// BodyNode
+  std::vector<Eigen::MatrixXd> invProjectedInertias;
+
+  /// Total force of the parent Joint of each BodyNode in the articulated body
+  /// algorithm
+  std::vector<Eigen::VectorXd> totalForces;
+
+  /// Generalized forces, computed by computeInverseDynamics()
+  Eigen::VectorXd forces;
+
+  /// Generalized accelerations, computed by computeForwardDynamics()
+  Eigen::VectorXd accelerations;
+
+  /// Mass matrix, computed by computeMassMatrix()
+  Eigen::MatrixXd massMatrix;
+
+  /// Factorization of massMatrix, computed by
+  /// computeForwardDynamicsDerivatives()
+  MassMatrixFactorization massMatrixFactorization;
+
+  /// Derivatives of the spatial velocity, the spatial acceleration, and the
+  /// body force of each BodyNode with respect to one degree of freedom
+  Eigen::aligned_vector<Eigen::Vector6d> velocityDerivs;
+  Eigen::aligned_vector<Eigen::Vector6d> accelerationDerivs;
+  Eigen::aligned_vector<Eigen::Vector6d> bodyForceDerivs;
+
+  /// Column of the Jacobian of each BodyNode for one degree of freedom, i.e.,
+  /// the motion of the BodyNode when that degree of freedom moves
+  Eigen::aligned_vector<Eigen::Vector6d> dofMotions;
+
+  /// Derivatives of forces with respect to the generalized positions and
+  /// velocities, computed by computeInverseDynamicsDerivatives(). The
+  /// derivative with respect to the generalized accelerations is the mass
+  /// matrix.
+  Eigen::MatrixXd forcesPositionDeriv;
+  Eigen::MatrixXd forcesVelocityDeriv;
+
+  /// Derivatives of accelerations with respect to the generalized positions,
+  /// velocities, and forces, computed by computeForwardDynamicsDerivatives().
+  /// The derivative with respect to the forces is the inverse of the mass
+  /// matrix.
+  Eigen::MatrixXd accelerationsPositionDeriv;
+  Eigen::MatrixXd accelerationsVelocityDeriv;
+  Eigen::MatrixXd accelerationsForceDeriv;
+
+private:
+  /// Structure version of the Skeleton that the workspace was last sized for,
+  /// or zero if it hasn't been sized yet
+  std::size_t mStructureVersion;
+};
+
+/// Compute the transforms and the spatial velocities of the BodyNodes of
+/// _skeleton at the given generalized positions and velocities, and store them
+/// in _workspace.
+void computeForwardKinematics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities);
+
+/// Compute the generalized forces that give _skeleton the generalized
+/// accelerations _accelerations at the given generalized positions and
+/// velocities, using the recursive Newton-Euler algorithm. The result is
+/// stored in _workspace.forces.
+const Eigen::VectorXd& computeInverseDynamics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _accelerations);
+
+/// Same as above, but the generalized forces are written into _forces, which
+/// must have one entry per degree of freedom of _skeleton, instead of
+/// _workspace.forces.
+void computeInverseDynamics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _accelerations,
+    Eigen::Ref<Eigen::VectorXd> _forces);
+
+/// Compute the generalized accelerations of _skeleton under the generalized
+/// forces _forces at the given generalized positions and velocities, using the
+/// articulated body algorithm. The result is stored in
+/// _workspace.accelerations.
+const Eigen::VectorXd& computeForwardDynamics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _forces);
+
+/// Same as above, but the generalized accelerations are written into
+/// _accelerations, which must have one entry per degree of freedom of
+/// _skeleton, instead of _workspace.accelerations.
+void computeForwardDynamics(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _forces,
+    Eigen::Ref<Eigen::VectorXd> _accelerations);
+
+/// Compute the mass matrix of _skeleton at the given generalized positions,
+/// using the composite rigid body algorithm. The result is stored in
+/// _workspace.massMatrix.
+const Eigen::MatrixXd& computeMassMatrix(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions);
+
+/// Compute the derivatives of computeInverseDynamics() with respect to the
+/// generalized positions and velocities, using the recursive Newton-Euler
+/// algorithm differentiated pass by pass. The forces are stored in
+/// _workspace.forces and their derivatives in _workspace.forcesPositionDeriv
+/// and _workspace.forcesVelocityDeriv.
+///
+/// A position derivative is taken along the relative Jacobian of its Joint,
+/// which is the direction in which the Joint moves under a unit velocity of
+/// that degree of freedom. That is the ordinary partial derivative for every
+/// Joint type except BallJoint and FreeJoint, whose velocities are not the
+/// time derivatives of their positions.
+void computeInverseDynamicsDerivatives(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _accelerations);
+
+/// Compute the derivatives of computeForwardDynamics() with respect to the
+/// generalized positions, velocities, and forces. The accelerations are stored
+/// in _workspace.accelerations and their derivatives in
+/// _workspace.accelerationsPositionDeriv, accelerationsVelocityDeriv, and
+/// accelerationsForceDeriv.
+///
+/// Since M(q) * ddq + c(q, dq) = tau, these are -M^{-1} times the derivatives
+/// of computeInverseDynamics() at the computed accelerations, and M^{-1}. The
+/// position derivatives are taken as in computeInverseDynamicsDerivatives().
+void computeForwardDynamicsDerivatives(
+    const Skeleton& _skeleton,
+    SkeletonWorkspace& _workspace,
+    const Eigen::Ref<const Eigen::VectorXd>& _positions,
+    const Eigen::Ref<const Eigen::VectorXd>& _velocities,
+    const Eigen::Ref<const Eigen::VectorXd>& _forces);
+
+/// Compute the Jacobian of _bodyNode expressed in its own frame, with one
+/// column per degree of freedom of _skeleton, from the transforms that the
+/// last of the algorithms above has stored in _workspace.
+math::Jacobian computeJacobian(const Skeleton& _skeleton,
+                               const SkeletonWorkspace& _workspace,
+                               const BodyNode* _bodyNode);
+
+/// Same as computeJacobian(), but expressed in the World frame
+math::Jacobian computeWorldJacobian(const Skeleton& _skeleton,
+                                    const SkeletonWorkspace& _workspace,
+                                    const BodyNode* _bodyNode);
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_SKELETONWORKSPACE_HPP_
@@ -245,10 +245,15 @@ SoftBodyNode::SoftBodyNode(BodyNode* _parentBodyNode,
   : Entity(Frame::World(), false),
     Frame(Frame::World()),
     Base(std::make_tuple(_parentBodyNode, _parentJoint, _properties)),
+    mNotifier(nullptr),
     mSoftShapeNode(nullptr)
 {
   createSoftBodyAspect();
   mNotifier = new PointMassNotifier(this, getName()+"_PointMassNotifier");
+
+  // The point masses must be dirtied together with this SoftBodyNode, even
+  // when it is moved by one of its ancestors
+  requireEagerNotification();
   ShapeNode* softNode = createShapeNodeWith<
       VisualAspect, CollisionAspect, DynamicsAspect>(
         std::make_shared<SoftMeshShape>(this), getName()+"_SoftMeshShape");
@@ -1217,6 +1222,17 @@ void SoftBodyNode::clearInternalForces()
     mPointMasses[i]->resetForces();
 }
 
+//==============================================================================
+void SoftBodyNode::dirtyTransform()
+{
+  BodyNode::dirtyTransform();
+
+  // BodyNode::dirtyTransform() does not visit the child Entities, so the point
+  // masses are notified here
+  if(mNotifier)
+    mNotifier->dirtyTransform();
+}
+
 //==============================================================================
 void SoftBodyNode::_addPiToArtInertia(const Eigen::Vector3d& _p, double _Pi) const
 {
@@ -293,6 +293,10 @@ protected:
 
   void clearInternalForces() override;
 
+  /// Notify the transformation update of this SoftBodyNode and of its point
+  /// masses, which cache inertia and forces that depend on it
+  void dirtyTransform() override;
+
 protected:
 
   /// \brief List of point masses composing deformable mesh.
@@ -73,6 +73,7 @@ void SphereShape::setRadius(double radius)
   mBoundingBox.setMax(Eigen::Vector3d::Constant(radius));
 
   updateVolume();
+  incrementVersion();
 }
 
 //==============================================================================
@@ -58,7 +58,20 @@ Eigen::Matrix<double, 6, 3> TranslationalJoint::getRelativeJacobianStatic(
     const Eigen::Vector3d& /*_positions*/) const
 {
   // The Jacobian is always constant w.r.t. the generalized coordinates.
-  return getRelativeJacobianStatic();
+  Eigen::Matrix<double, 6, 3> jacobian = Eigen::Matrix<double, 6, 3>::Zero();
+  jacobian.bottomRows<3>()
+      = Joint::mAspectProperties.mT_ChildBodyToJoint.linear();
+
+  return jacobian;
+}
+
+//==============================================================================
+Eigen::Isometry3d TranslationalJoint::computeRelativeTransformStatic(
+    const Eigen::Vector3d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * Eigen::Translation3d(_positions)
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
 }
 
 //==============================================================================
@@ -117,9 +130,7 @@ void TranslationalJoint::updateDegreeOfFreedomNames()
 //==============================================================================
 void TranslationalJoint::updateRelativeTransform() const
 {
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::Translation3d(getPositionsStatic())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
 
   // Verification
   assert(math::verifyTransform(mT));
@@ -158,6 +158,62 @@ Eigen::Matrix<double, 6, 2> UniversalJoint::getRelativeJacobianStatic(
   return J;
 }
 
+//==============================================================================
+Eigen::Isometry3d UniversalJoint::computeRelativeTransformStatic(
+    const Eigen::Vector2d& _positions) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * Eigen::AngleAxisd(_positions[0], getAxis1())
+      * Eigen::AngleAxisd(_positions[1], getAxis2())
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
+//==============================================================================
+Eigen::Matrix<double, 6, 2>
+UniversalJoint::computeRelativeJacobianTimeDerivStatic(
+    const Eigen::Vector2d& _positions,
+    const Eigen::Vector2d& _velocities) const
+{
+  Eigen::Matrix<double, 6, 2> dJ = Eigen::Matrix<double, 6, 2>::Zero();
+
+  Eigen::Vector6d tmpV1 = getRelativeJacobianStatic(_positions).col(1)
+                        * _velocities[1];
+
+  Eigen::Isometry3d tmpT = math::expAngular(-getAxis2() * _positions[1]);
+
+  Eigen::Vector6d tmpV2 = math::AdTAngular(
+        Joint::mAspectProperties.mT_ChildBodyToJoint * tmpT, getAxis1());
+
+  dJ.col(0) = -math::ad(tmpV1, tmpV2);
+
+  assert(!math::isNan(dJ.col(0)));
+
+  return dJ;
+}
+
+//==============================================================================
+Eigen::Matrix<double, 6, 2>
+UniversalJoint::computeRelativeJacobianTimeDerivDerivStatic(
+    const Eigen::Vector2d& _positions,
+    const Eigen::Vector2d& _velocities,
+    std::size_t _index) const
+{
+  Eigen::Matrix<double, 6, 2> ddJ = Eigen::Matrix<double, 6, 2>::Zero();
+
+  // Only the first column depends on the second position, and its derivative
+  // with respect to that position is -ad(S1, S0)
+  if (_index == 1)
+  {
+    const Eigen::Matrix<double, 6, 2> J = getRelativeJacobianStatic(_positions);
+    ddJ.col(0) = math::ad(J.col(1) * _velocities[1],
+                          math::ad(J.col(1), J.col(0)));
+  }
+
+  assert(!math::isNan(ddJ));
+
+  return ddJ;
+}
+
 //==============================================================================
 UniversalJoint::UniversalJoint(const Properties& properties)
   : detail::UniversalJointBase(properties)
@@ -187,11 +243,7 @@ void UniversalJoint::updateDegreeOfFreedomNames()
 //==============================================================================
 void UniversalJoint::updateRelativeTransform() const
 {
-  const Eigen::Vector2d& positions = getPositionsStatic();
-  mT = Joint::mAspectProperties.mT_ParentBodyToJoint
-       * Eigen::AngleAxisd(positions[0], getAxis1())
-       * Eigen::AngleAxisd(positions[1], getAxis2())
-       * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+  mT = computeRelativeTransformStatic(getPositionsStatic());
   assert(math::verifyTransform(mT));
 }
 
@@ -204,19 +256,8 @@ void UniversalJoint::updateRelativeJacobian(bool) const
 //==============================================================================
 void UniversalJoint::updateRelativeJacobianTimeDeriv() const
 {
-  Eigen::Vector6d tmpV1 = getRelativeJacobianStatic().col(1)
-                        * getVelocitiesStatic()[1];
-
-  Eigen::Isometry3d tmpT = math::expAngular(
-        -getAxis2() * getPositionsStatic()[1]);
-
-  Eigen::Vector6d tmpV2
-      = math::AdTAngular(Joint::mAspectProperties.mT_ChildBodyToJoint * tmpT, getAxis1());
-
-  mJacobianDeriv.col(0) = -math::ad(tmpV1, tmpV2);
-
-  assert(!math::isNan(mJacobianDeriv.col(0)));
-  assert(mJacobianDeriv.col(1) == Eigen::Vector6d::Zero());
+  mJacobianDeriv = computeRelativeJacobianTimeDerivStatic(
+        getPositionsStatic(), getVelocitiesStatic());
 }
 
 }  // namespace dynamics
@@ -100,6 +100,21 @@ public:
   Eigen::Matrix<double, 6, 2> getRelativeJacobianStatic(
       const Eigen::Vector2d& _positions) const override;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransformStatic(
+      const Eigen::Vector2d& _positions) const override;
+
+  // Documentation inherited
+  Eigen::Matrix<double, 6, 2> computeRelativeJacobianTimeDerivStatic(
+      const Eigen::Vector2d& _positions,
+      const Eigen::Vector2d& _velocities) const override;
+
+  // Documentation inherited
+  Eigen::Matrix<double, 6, 2> computeRelativeJacobianTimeDerivDerivStatic(
+      const Eigen::Vector2d& _positions,
+      const Eigen::Vector2d& _velocities,
+      std::size_t _index) const override;
+
 protected:
 
   /// Constructor called by Skeleton class
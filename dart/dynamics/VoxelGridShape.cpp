@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/VoxelGridShape.hpp"
+
+#include <cmath>
+
+#include "dart/dynamics/BoxShape.hpp"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+std::size_t VoxelGridShape::KeyHash::operator()(const Key& key) const
+{
+  // Spatial hash of Teschner et al., "Optimized Spatial Hashing for Collision
+  // Detection of Deformable Objects"
+  return (static_cast<std::size_t>(key[0]) * 73856093u)
+      ^ (static_cast<std::size_t>(key[1]) * 19349663u)
+      ^ (static_cast<std::size_t>(key[2]) * 83492791u);
+}
+
+//==============================================================================
+VoxelGridShape::VoxelGridShape(double resolution)
+  : Shape(),
+    mResolution(resolution),
+    mMinKey(Key::Zero()),
+    mMaxKey(Key::Zero())
+{
+  assert(resolution > 0.0);
+  updateBoundingBoxDim();
+  updateVolume();
+}
+
+//==============================================================================
+const std::string& VoxelGridShape::getType() const
+{
+  return getStaticType();
+}
+
+//==============================================================================
+const std::string& VoxelGridShape::getStaticType()
+{
+  static const std::string type("VoxelGridShape");
+  return type;
+}
+
+//==============================================================================
+double VoxelGridShape::getResolution() const
+{
+  return mResolution;
+}
+
+//==============================================================================
+VoxelGridShape::Key VoxelGridShape::computeKey(
+    const Eigen::Vector3d& point) const
+{
+  return Key(static_cast<int>(std::floor(point[0] / mResolution)),
+             static_cast<int>(std::floor(point[1] / mResolution)),
+             static_cast<int>(std::floor(point[2] / mResolution)));
+}
+
+//==============================================================================
+Eigen::Vector3d VoxelGridShape::computeVoxelCenter(const Key& key) const
+{
+  return (key.cast<double>().array() + 0.5) * mResolution;
+}
+
+//==============================================================================
+void VoxelGridShape::occupy(const Eigen::Vector3d& point)
+{
+  if (!occupyKey(computeKey(point)))
+    return;
+
+  updateBoundingBoxDim();
+  updateVolume();
+  incrementVersion();
+}
+
+//==============================================================================
+void VoxelGridShape::occupy(const std::vector<Eigen::Vector3d>& points,
+                            const Eigen::Isometry3d& transform)
+{
+  bool changed = false;
+  mVoxels.reserve(mVoxels.size() + points.size());
+  for (const auto& point : points)
+    changed |= occupyKey(computeKey(transform * point));
+
+  if (!changed)
+    return;
+
+  updateBoundingBoxDim();
+  updateVolume();
+  incrementVersion();
+}
+
+//==============================================================================
+void VoxelGridShape::unoccupy(const Eigen::Vector3d& point)
+{
+  const Key key = computeKey(point);
+  if (!isOccupied(key))
+    return;
+
+  if (unoccupyKey(key))
+  {
+    updateKeyRange();
+    updateBoundingBoxDim();
+  }
+
+  updateVolume();
+  incrementVersion();
+}
+
+//==============================================================================
+void VoxelGridShape::unoccupy(const std::vector<Eigen::Vector3d>& points,
+                              const Eigen::Isometry3d& transform)
+{
+  bool changed = false;
+  bool shrunk = false;
+  for (const auto& point : points)
+  {
+    const Key key = computeKey(transform * point);
+    if (!isOccupied(key))
+      continue;
+
+    shrunk |= unoccupyKey(key);
+    changed = true;
+  }
+
+  if (!changed)
+    return;
+
+  if (shrunk)
+  {
+    updateKeyRange();
+    updateBoundingBoxDim();
+  }
+
+  updateVolume();
+  incrementVersion();
+}
+
+//==============================================================================
+void VoxelGridShape::clear()
+{
+  if (mVoxels.empty())
+    return;
+
+  mVoxels.clear();
+  updateBoundingBoxDim();
+  updateVolume();
+  incrementVersion();
+}
+
+//==============================================================================
+bool VoxelGridShape::isOccupied(const Eigen::Vector3d& point) const
+{
+  return isOccupied(computeKey(point));
+}
+
+//==============================================================================
+bool VoxelGridShape::isOccupied(const Key& key) const
+{
+  return mVoxels.find(key) != mVoxels.end();
+}
+
+//==============================================================================
+std::size_t VoxelGridShape::getNumOccupiedVoxels() const
+{
+  return mVoxels.size();
+}
+
+//==============================================================================
+const VoxelGridShape::KeySet& VoxelGridShape::getOccupiedVoxels() const
+{
+  return mVoxels;
+}
+
+//==============================================================================
+Eigen::Matrix3d VoxelGridShape::computeInertia(double mass) const
+{
+  // Use bounding box to represent the voxels
+  return BoxShape::computeInertia(mBoundingBox.computeFullExtents(), mass);
+}
+
+//==============================================================================
+void VoxelGridShape::updateVolume()
+{
+  mVolume = mVoxels.size() * mResolution * mResolution * mResolution;
+}
+
+//==============================================================================
+bool VoxelGridShape::occupyKey(const Key& key)
+{
+  if (!mVoxels.insert(key).second)
+    return false;
+
+  if (mVoxels.size() == 1u)
+  {
+    mMinKey = key;
+    mMaxKey = key;
+  }
+  else
+  {
+    mMinKey = mMinKey.cwiseMin(key);
+    mMaxKey = mMaxKey.cwiseMax(key);
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool VoxelGridShape::unoccupyKey(const Key& key)
+{
+  mVoxels.erase(key);
+
+  return (key.array() == mMinKey.array()).any()
+      || (key.array() == mMaxKey.array()).any();
+}
+
+//==============================================================================
+void VoxelGridShape::updateKeyRange()
+{
+  if (mVoxels.empty())
+    return;
+
+  mMinKey = *mVoxels.begin();
+  mMaxKey = mMinKey;
+  for (const auto& key : mVoxels)
+  {
+    mMinKey = mMinKey.cwiseMin(key);
+    mMaxKey = mMaxKey.cwiseMax(key);
+  }
+}
+
+//==============================================================================
+void VoxelGridShape::updateBoundingBoxDim()
+{
+  if (mVoxels.empty())
+  {
+    mMinKey.setZero();
+    mMaxKey.setZero();
+    mBoundingBox.setMin(Eigen::Vector3d::Zero());
+    mBoundingBox.setMax(Eigen::Vector3d::Zero());
+    return;
+  }
+
+  mBoundingBox.setMin(mMinKey.cast<double>() * mResolution);
+  mBoundingBox.setMax((mMaxKey.cast<double>().array() + 1.0) * mResolution);
+}
+
+}  // namespace dynamics
+}  // namespace dart
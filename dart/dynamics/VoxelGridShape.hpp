@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_VOXELGRIDSHAPE_HPP_
+#define DART_DYNAMICS_VOXELGRIDSHAPE_HPP_
+
+#include <unordered_set>
+#include <vector>
+
+#include "dart/dynamics/Shape.hpp"
+
+namespace dart {
+namespace dynamics {
+
+/// VoxelGridShape represents the occupied cells of a regular grid of cubic
+/// voxels, such as the obstacles seen in a point cloud.
+///
+/// Only the occupied voxels are stored, in a hash set keyed by their integer
+/// coordinates. The voxel of key k spans from k * resolution to
+/// (k + 1) * resolution in the frame of the shape. Occupying or freeing a
+/// batch of points updates the bounding box and increments the version once
+/// for the whole batch, so the collision detectors only need to refresh their
+/// data once per batch.
+class VoxelGridShape : public Shape
+{
+public:
+
+  /// Integer coordinates of a voxel
+  using Key = Eigen::Vector3i;
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  using KeySet = std::unordered_set<Key, KeyHash>;
+
+  /// Constructor. The resolution is the edge length of the voxels.
+  explicit VoxelGridShape(double resolution = 0.01);
+
+  // Documentation inherited.
+  const std::string& getType() const override;
+
+  /// Returns shape type for this class
+  static const std::string& getStaticType();
+
+  /// Get the edge length of the voxels
+  double getResolution() const;
+
+  /// Get the key of the voxel that contains the point
+  Key computeKey(const Eigen::Vector3d& point) const;
+
+  /// Get the center of the voxel of the key
+  Eigen::Vector3d computeVoxelCenter(const Key& key) const;
+
+  /// Mark the voxel that contains the point as occupied
+  void occupy(const Eigen::Vector3d& point);
+
+  /// Mark the voxels that contain the points as occupied, where the points are
+  /// given in the frame 'transform' relative to the frame of this shape
+  void occupy(const std::vector<Eigen::Vector3d>& points,
+              const Eigen::Isometry3d& transform
+                  = Eigen::Isometry3d::Identity());
+
+  /// Mark the voxel that contains the point as free
+  void unoccupy(const Eigen::Vector3d& point);
+
+  /// Mark the voxels that contain the points as free, where the points are
+  /// given in the frame 'transform' relative to the frame of this shape
+  void unoccupy(const std::vector<Eigen::Vector3d>& points,
+                const Eigen::Isometry3d& transform
+                    = Eigen::Isometry3d::Identity());
+
+  /// Mark all the voxels as free
+  void clear();
+
+  /// Return true if the voxel that contains the point is occupied
+  bool isOccupied(const Eigen::Vector3d& point) const;
+
+  /// Return true if the voxel of the key is occupied
+  bool isOccupied(const Key& key) const;
+
+  /// Get the number of occupied voxels
+  std::size_t getNumOccupiedVoxels() const;
+
+  /// Get the keys of the occupied voxels
+  const KeySet& getOccupiedVoxels() const;
+
+  // Documentation inherited.
+  Eigen::Matrix3d computeInertia(double mass) const override;
+
+protected:
+
+  // Documentation inherited.
+  void updateVolume() override;
+
+private:
+
+  /// Add the voxel of the key without updating the bounding box. Return true
+  /// if the voxel was free.
+  bool occupyKey(const Key& key);
+
+  /// Remove the voxel of the key without updating the bounding box. Return
+  /// true if the voxel was on the boundary of the bounding box.
+  bool unoccupyKey(const Key& key);
+
+  /// Recompute the range of the keys after removing voxels on its boundary
+  void updateKeyRange();
+
+  /// Update bounding box (in the local coordinate frame) of the shape.
+  void updateBoundingBoxDim();
+
+  /// Edge length of the voxels
+  double mResolution;
+
+  /// Keys of the occupied voxels
+  KeySet mVoxels;
+
+  /// Range of the keys of the occupied voxels
+  Key mMinKey;
+  Key mMaxKey;
+};
+
+}  // namespace dynamics
+}  // namespace dart
+
+#endif  // DART_DYNAMICS_VOXELGRIDSHAPE_HPP_
@@ -599,12 +599,69 @@ math::Jacobian ZeroDofJoint::getRelativeJacobian(
   return Eigen::Matrix<double, 6, 0>();
 }
 
+//==============================================================================
+void ZeroDofJoint::computeRelativeJacobian(
+    const Eigen::VectorXd& /*_positions*/,
+    Eigen::Ref<math::Jacobian> /*_jacobian*/) const
+{
+  // Do nothing
+}
+
 //==============================================================================
 const math::Jacobian ZeroDofJoint::getRelativeJacobianTimeDeriv() const
 {
   return Eigen::Matrix<double, 6, 0>();
 }
 
+//==============================================================================
+Eigen::Isometry3d ZeroDofJoint::computeRelativeTransform(
+    const Eigen::VectorXd& /*_positions*/) const
+{
+  return Joint::mAspectProperties.mT_ParentBodyToJoint
+      * Joint::mAspectProperties.mT_ChildBodyToJoint.inverse();
+}
+
+//==============================================================================
+math::Jacobian ZeroDofJoint::computeRelativeJacobianTimeDeriv(
+    const Eigen::VectorXd& /*_positions*/,
+    const Eigen::VectorXd& /*_velocities*/) const
+{
+  return Eigen::Matrix<double, 6, 0>();
+}
+
+//==============================================================================
+void ZeroDofJoint::computeRelativeJacobianTimeDeriv(
+    const Eigen::VectorXd& /*_positions*/,
+    const Eigen::VectorXd& /*_velocities*/,
+    Eigen::Ref<math::Jacobian> /*_jacobianDeriv*/) const
+{
+  // Do nothing
+}
+
+//==============================================================================
+math::Jacobian ZeroDofJoint::computeRelativeJacobianDeriv(
+    const Eigen::VectorXd& /*_positions*/, std::size_t /*_index*/) const
+{
+  dterr << "[ZeroDofJoint::computeRelativeJacobianDeriv] Joint ["
+        << getName() << "] has no degrees of freedom.\n";
+  assert(false);
+
+  return Eigen::Matrix<double, 6, 0>();
+}
+
+//==============================================================================
+math::Jacobian ZeroDofJoint::computeRelativeJacobianTimeDerivDeriv(
+    const Eigen::VectorXd& /*_positions*/,
+    const Eigen::VectorXd& /*_velocities*/,
+    std::size_t /*_index*/) const
+{
+  dterr << "[ZeroDofJoint::computeRelativeJacobianTimeDerivDeriv] Joint ["
+        << getName() << "] has no degrees of freedom.\n";
+  assert(false);
+
+  return Eigen::Matrix<double, 6, 0>();
+}
+
 //==============================================================================
 void ZeroDofJoint::addVelocityTo(Eigen::Vector6d& /*_vel*/)
 {
@@ -763,20 +820,24 @@ void ZeroDofJoint::updateConstrainedTerms(double /*_timeStep*/)
 
 //==============================================================================
 void ZeroDofJoint::addChildBiasForceForInvMassMatrix(
-    Eigen::Vector6d& /*_parentBiasForce*/,
+    Eigen::Vector6d& _parentBiasForce,
     const Eigen::Matrix6d& /*_childArtInertia*/,
-    const Eigen::Vector6d& /*_childBiasForce*/)
+    const Eigen::Vector6d& _childBiasForce)
 {
-  // TODO(JS)
+  // Add child body's bias force to parent body's bias force. Note that mT
+  // should be updated.
+  _parentBiasForce += math::dAdInvT(getRelativeTransform(), _childBiasForce);
 }
 
 //==============================================================================
 void ZeroDofJoint::addChildBiasForceForInvAugMassMatrix(
-    Eigen::Vector6d& /*_parentBiasForce*/,
+    Eigen::Vector6d& _parentBiasForce,
     const Eigen::Matrix6d& /*_childArtInertia*/,
-    const Eigen::Vector6d& /*_childBiasForce*/)
+    const Eigen::Vector6d& _childBiasForce)
 {
-  // TODO(JS)
+  // Add child body's bias force to parent body's bias force. Note that mT
+  // should be updated.
+  _parentBiasForce += math::dAdInvT(getRelativeTransform(), _childBiasForce);
 }
 
 //==============================================================================
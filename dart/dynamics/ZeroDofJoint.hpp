@@ -367,9 +367,39 @@ protected:
   math::Jacobian getRelativeJacobian(
       const Eigen::VectorXd& _positions) const override;
 
+  // Documentation inherited
+  void computeRelativeJacobian(
+      const Eigen::VectorXd& _positions,
+      Eigen::Ref<math::Jacobian> _jacobian) const override;
+
   // Documentation inherited
   const math::Jacobian getRelativeJacobianTimeDeriv() const override;
 
+  // Documentation inherited
+  Eigen::Isometry3d computeRelativeTransform(
+      const Eigen::VectorXd& _positions) const override;
+
+  // Documentation inherited
+  math::Jacobian computeRelativeJacobianTimeDeriv(
+      const Eigen::VectorXd& _positions,
+      const Eigen::VectorXd& _velocities) const override;
+
+  // Documentation inherited
+  void computeRelativeJacobianTimeDeriv(
+      const Eigen::VectorXd& _positions,
+      const Eigen::VectorXd& _velocities,
+      Eigen::Ref<math::Jacobian> _jacobianDeriv) const override;
+
+  // Documentation inherited
+  math::Jacobian computeRelativeJacobianDeriv(
+      const Eigen::VectorXd& _positions, std::size_t _index) const override;
+
+  // Documentation inherited
+  math::Jacobian computeRelativeJacobianTimeDerivDeriv(
+      const Eigen::VectorXd& _positions,
+      const Eigen::VectorXd& _velocities,
+      std::size_t _index) const override;
+
   // Documentation inherited
   void addVelocityTo(Eigen::Vector6d& _vel) override;
 
@@ -1413,6 +1413,24 @@ math::Jacobian GenericJoint<ConfigSpaceT>::getRelativeJacobian(
   return getRelativeJacobianStatic(positions);
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::computeRelativeJacobian(
+    const Eigen::VectorXd& positions,
+    Eigen::Ref<math::Jacobian> jacobian) const
+{
+  assert(static_cast<std::size_t>(jacobian.cols()) == getNumDofs());
+
+  if (static_cast<std::size_t>(positions.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(computeRelativeJacobian, positions);
+    jacobian.setZero();
+    return;
+  }
+
+  jacobian = getRelativeJacobianStatic(positions);
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 const math::Jacobian
@@ -1435,6 +1453,162 @@ GenericJoint<ConfigSpaceT>::getRelativeJacobianTimeDerivStatic() const
   return mJacobianDeriv;
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+Eigen::Isometry3d GenericJoint<ConfigSpaceT>::computeRelativeTransform(
+    const Eigen::VectorXd& positions) const
+{
+  if (static_cast<std::size_t>(positions.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(computeRelativeTransform, positions);
+    return Eigen::Isometry3d::Identity();
+  }
+
+  return computeRelativeTransformStatic(positions);
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+Eigen::Isometry3d GenericJoint<ConfigSpaceT>::computeRelativeTransformStatic(
+    const Vector& positions) const
+{
+  return Joint::computeRelativeTransform(positions);
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+math::Jacobian GenericJoint<ConfigSpaceT>::computeRelativeJacobianTimeDeriv(
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& velocities) const
+{
+  if (static_cast<std::size_t>(positions.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(
+          computeRelativeJacobianTimeDeriv, positions);
+    return JacobianMatrix::Zero();
+  }
+
+  if (static_cast<std::size_t>(velocities.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(
+          computeRelativeJacobianTimeDeriv, velocities);
+    return JacobianMatrix::Zero();
+  }
+
+  return computeRelativeJacobianTimeDerivStatic(positions, velocities);
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::computeRelativeJacobianTimeDeriv(
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& velocities,
+    Eigen::Ref<math::Jacobian> jacobianDeriv) const
+{
+  assert(static_cast<std::size_t>(jacobianDeriv.cols()) == getNumDofs());
+
+  if (static_cast<std::size_t>(positions.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(
+          computeRelativeJacobianTimeDeriv, positions);
+    jacobianDeriv.setZero();
+    return;
+  }
+
+  if (static_cast<std::size_t>(velocities.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(
+          computeRelativeJacobianTimeDeriv, velocities);
+    jacobianDeriv.setZero();
+    return;
+  }
+
+  jacobianDeriv
+      = computeRelativeJacobianTimeDerivStatic(positions, velocities);
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+typename GenericJoint<ConfigSpaceT>::JacobianMatrix
+GenericJoint<ConfigSpaceT>::computeRelativeJacobianTimeDerivStatic(
+    const Vector& /*positions*/, const Vector& /*velocities*/) const
+{
+  return JacobianMatrix::Zero();
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+math::Jacobian GenericJoint<ConfigSpaceT>::computeRelativeJacobianDeriv(
+    const Eigen::VectorXd& positions, std::size_t index) const
+{
+  if (static_cast<std::size_t>(positions.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(computeRelativeJacobianDeriv, positions);
+    return JacobianMatrix::Zero();
+  }
+
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(computeRelativeJacobianDeriv, index);
+    return JacobianMatrix::Zero();
+  }
+
+  return computeRelativeJacobianDerivStatic(positions, index);
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+typename GenericJoint<ConfigSpaceT>::JacobianMatrix
+GenericJoint<ConfigSpaceT>::computeRelativeJacobianDerivStatic(
+    const Vector& positions, std::size_t index) const
+{
+  return computeRelativeJacobianTimeDerivStatic(
+        positions, Vector::Unit(static_cast<int>(index)));
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+math::Jacobian
+GenericJoint<ConfigSpaceT>::computeRelativeJacobianTimeDerivDeriv(
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& velocities,
+    std::size_t index) const
+{
+  if (static_cast<std::size_t>(positions.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(
+          computeRelativeJacobianTimeDerivDeriv, positions);
+    return JacobianMatrix::Zero();
+  }
+
+  if (static_cast<std::size_t>(velocities.size()) != getNumDofs())
+  {
+    GenericJoint_REPORT_DIM_MISMATCH(
+          computeRelativeJacobianTimeDerivDeriv, velocities);
+    return JacobianMatrix::Zero();
+  }
+
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(
+          computeRelativeJacobianTimeDerivDeriv, index);
+    return JacobianMatrix::Zero();
+  }
+
+  return computeRelativeJacobianTimeDerivDerivStatic(
+        positions, velocities, index);
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+typename GenericJoint<ConfigSpaceT>::JacobianMatrix
+GenericJoint<ConfigSpaceT>::computeRelativeJacobianTimeDerivDerivStatic(
+    const Vector& /*positions*/, const Vector& /*velocities*/,
+    std::size_t /*index*/) const
+{
+  return JacobianMatrix::Zero();
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 GenericJoint<ConfigSpaceT>::GenericJoint(
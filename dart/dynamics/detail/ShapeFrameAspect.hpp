@@ -74,8 +74,14 @@ struct CollisionAspectProperties
   /// This object is collidable if true
   bool mCollidable;
 
+  /// The ConstraintSolver sweeps this object over each time step and creates
+  /// speculative contacts ahead of it if true, so that it doesn't tunnel
+  /// through thin objects when it moves fast
+  bool mContinuous;
+
   /// Constructor
-  CollisionAspectProperties(const bool collidable = true);
+  CollisionAspectProperties(const bool collidable = true,
+                            const bool continuous = false);
 
   /// Destructor
   virtual ~CollisionAspectProperties() = default;
@@ -45,6 +45,29 @@ class Skeleton;
 
 namespace detail {
 
+//==============================================================================
+/// Algorithm used by Skeleton to compute its mass matrix
+///
+/// \sa Skeleton::setMassMatrixAlgorithm(), Skeleton::getMassMatrixAlgorithm()
+enum MassMatrixAlgorithm
+{
+  /// Build the mass matrix one column at a time by running the inverse
+  /// dynamics recursion once per degree of freedom with a unit acceleration on
+  /// that degree of freedom. This requires O(n^2) passes over the BodyNodes.
+  UNIT_ACCELERATION,
+
+  /// Composite Rigid Body Algorithm. The composite inertias of all subtrees
+  /// are accumulated in a single backward pass, and each column is then
+  /// computed by walking from a BodyNode to the root only, so the entries
+  /// between degrees of freedom on different branches are never visited.
+  ///
+  /// Trees that contain SoftBodyNodes fall back to UNIT_ACCELERATION because
+  /// the point masses are not rigidly attached to their BodyNodes.
+  COMPOSITE_RIGID_BODY
+};
+
+const MassMatrixAlgorithm DefaultMassMatrixAlgorithm = UNIT_ACCELERATION;
+
 //==============================================================================
 /// The Properties of this Skeleton which are independent of the components
 /// within the Skeleton, such as its BodyNodes and Joints. This does not
@@ -74,6 +97,9 @@ struct SkeletonAspectProperties
   /// ignored.
   bool mEnabledAdjacentBodyCheck;
 
+  /// Algorithm used to compute the mass matrix
+  MassMatrixAlgorithm mMassMatrixAlgorithm;
+
   /// Default constructor
   SkeletonAspectProperties(
       const std::string& _name = "Skeleton",
@@ -81,7 +107,8 @@ struct SkeletonAspectProperties
       const Eigen::Vector3d& _gravity = Eigen::Vector3d(0.0, 0.0, -9.81),
       double _timeStep = 0.001,
       bool _enabledSelfCollisionCheck = false,
-      bool _enableAdjacentBodyCheck = false);
+      bool _enableAdjacentBodyCheck = false,
+      MassMatrixAlgorithm _massMatrixAlgorithm = DefaultMassMatrixAlgorithm);
 
   virtual ~SkeletonAspectProperties() = default;
 };
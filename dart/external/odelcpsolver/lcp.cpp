@@ -777,10 +777,31 @@ void dLCP::unpermute()
 //***************************************************************************
 // an optimized Dantzig LCP driver routine for the lo-hi LCP problem.
 
+// take the next `size' bytes of the scratch memory, keeping every buffer
+// aligned for dReal (the largest of the element types used below)
+
+static inline void *dTakeScratch (char *&cursor, size_t size)
+{
+  void *buffer = cursor;
+  cursor += (size + sizeof(dReal) - 1) / sizeof(dReal) * sizeof(dReal);
+  return buffer;
+}
+
+
 void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
                 dReal *outer_w/*=nullptr*/, int nub, dReal *lo, dReal *hi, int *findex)
 {
-  dAASSERT (n>0 && A && x && b && lo && hi && nub >= 0 && nub <= n);
+  char *scratch = new char[dEstimateSolveLCPMemoryReq(n, outer_w != nullptr)];
+  dSolveLCP (n, A, x, b, outer_w, nub, lo, hi, findex, scratch);
+  delete[] scratch;
+}
+
+
+void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
+                dReal *outer_w, int nub, dReal *lo, dReal *hi, int *findex,
+                void *scratch)
+{
+  dAASSERT (n>0 && A && x && b && lo && hi && nub >= 0 && nub <= n && scratch);
 # ifndef dNODEBUG
   {
     // check restrictions on lo and hi
@@ -788,11 +809,12 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   }
 # endif
 
+  char *cursor = (char *)scratch;
 
   // if all the variables are unbounded then we can just factor, solve,
   // and return
   if (nub >= n) {
-    dReal *d = new dReal[n];
+    dReal *d = (dReal *)dTakeScratch (cursor, sizeof(dReal) * n);
     dSetZero (d, n);
 
     int nskip = dPAD(n);
@@ -804,23 +826,25 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   }
 
   const int nskip = dPAD(n);
-  dReal *L = new dReal[ (n*nskip)];
-  dReal *d = new dReal[ (n)];
-  dReal *w = outer_w ? outer_w : (new dReal[n]);
-  dReal *delta_w = new dReal[ (n)];
-  dReal *delta_x = new dReal[ (n)];
-  dReal *Dell = new dReal[ (n)];
-  dReal *ell = new dReal[ (n)];
+  dReal *L = (dReal *)dTakeScratch (cursor, sizeof(dReal) * (n*nskip));
+  dReal *d = (dReal *)dTakeScratch (cursor, sizeof(dReal) * n);
+  dReal *w = outer_w ? outer_w : (dReal *)dTakeScratch (cursor, sizeof(dReal) * n);
+  dReal *delta_w = (dReal *)dTakeScratch (cursor, sizeof(dReal) * n);
+  dReal *delta_x = (dReal *)dTakeScratch (cursor, sizeof(dReal) * n);
+  dReal *Dell = (dReal *)dTakeScratch (cursor, sizeof(dReal) * n);
+  dReal *ell = (dReal *)dTakeScratch (cursor, sizeof(dReal) * n);
 #ifdef ROWPTRS
-  dReal **Arows = new dReal* [n];
+  dReal **Arows = (dReal **)dTakeScratch (cursor, sizeof(dReal *) * n);
 #else
   dReal **Arows = nullptr;
 #endif
-  int *p = new int[n];
-  int *C = new int[n];
+  void *transferbuf = dTakeScratch (cursor,
+    dLCP::estimate_transfer_i_from_C_to_N_mem_req(n, nskip));
+  int *p = (int *)dTakeScratch (cursor, sizeof(int) * n);
+  int *C = (int *)dTakeScratch (cursor, sizeof(int) * n);
 
   // for i in N, state[i] is 0 if x(i)==lo(i) or 1 if x(i)==hi(i)
-  bool *state = new bool[n];
+  bool *state = (bool *)dTakeScratch (cursor, sizeof(bool) * n);
 
   // create LCP object. note that tmp is set to delta_w to save space, this
   // optimization relies on knowledge of how tmp is used, so be careful!
@@ -1045,12 +1069,12 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
         case 5:		// keep going
           x[si] = lo[si];
           state[si] = false;
-          lcp.transfer_i_from_C_to_N (si, nullptr);
+          lcp.transfer_i_from_C_to_N (si, transferbuf);
           break;
         case 6:		// keep going
           x[si] = hi[si];
           state[si] = true;
-          lcp.transfer_i_from_C_to_N (si, nullptr);
+          lcp.transfer_i_from_C_to_N (si, transferbuf);
           break;
         }
 
@@ -1064,44 +1088,31 @@ void dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   } // for (int i=adj_nub; i<n; ++i)
 
   lcp.unpermute();
-
-  if (!outer_w)
-	  delete[] w;
-  delete[] L;
-  delete[] d;
-  delete[] delta_w;
-  delete[] delta_x;
-  delete[] Dell;
-  delete[] ell;
-#ifdef ROWPTRS
-  delete[] Arows;
-#endif
-  delete[] p;
-  delete[] C;
-
-  delete[] state;
 }
 
 size_t dEstimateSolveLCPMemoryReq(int n, bool outer_w_avail)
 {
   const int nskip = dPAD(n);
 
+  // every buffer is padded like in dTakeScratch()
+  const size_t real_n = sizeof(dReal) * n;
+  const size_t pad = sizeof(dReal) - 1;
   size_t res = 0;
 
   res += (sizeof(dReal) * (n * nskip)); // for L
-  res += 5 * (sizeof(dReal) * n); // for d, delta_w, delta_x, Dell, ell
+  res += 5 * real_n; // for d, delta_w, delta_x, Dell, ell
   if (!outer_w_avail) {
-    res += (sizeof(dReal) * n); // for w
+    res += real_n; // for w
   }
 #ifdef ROWPTRS
-  res += (sizeof(dReal *) * n); // for Arows
+  res += ((sizeof(dReal *) * n + pad) / sizeof(dReal)) * sizeof(dReal); // for Arows
 #endif
-  res += 2 * (sizeof(int) * n); // for p, C
-  res += (sizeof(bool) * n); // for state
+  res += 2 * (((sizeof(int) * n + pad) / sizeof(dReal)) * sizeof(dReal)); // for p, C
+  res += ((sizeof(bool) * n + pad) / sizeof(dReal)) * sizeof(dReal); // for state
 
   // Use n instead of nC as nC varies at runtime while n is greater or equal to nC
   size_t lcp_transfer_req = dLCP::estimate_transfer_i_from_C_to_N_mem_req(n, nskip);
-  res += (lcp_transfer_req); // for dLCP::transfer_i_from_C_to_N
+  res += ((lcp_transfer_req + pad) / sizeof(dReal)) * sizeof(dReal); // for dLCP::transfer_i_from_C_to_N
 
   return res;
 }
@@ -60,6 +60,12 @@ to be implemented. the first `nub' variables are assumed to have findex < 0.
 void dSolveLCP (int n, dReal *A, dReal *x, dReal *b, dReal *w,
 	int nub, dReal *lo, dReal *hi, int *findex);
 
+// same as above, but all the temporary arrays are taken from `scratch', which
+// must hold at least dEstimateSolveLCPMemoryReq(n, w != nullptr) bytes
+// aligned for dReal. this version doesn't allocate any memory.
+void dSolveLCP (int n, dReal *A, dReal *x, dReal *b, dReal *w,
+	int nub, dReal *lo, dReal *hi, int *findex, void *scratch);
+
 size_t dEstimateSolveLCPMemoryReq(int n, bool outer_w_avail);
 
 
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <osg/Geode>
+#include <osg/ShapeDrawable>
+
+#include "dart/gui/osg/render/HeightmapShapeNode.hpp"
+#include "dart/gui/osg/Utils.hpp"
+
+#include "dart/dynamics/HeightmapShape.hpp"
+#include "dart/dynamics/SimpleFrame.hpp"
+
+namespace dart {
+namespace gui {
+namespace osg {
+namespace render {
+
+class HeightmapShapeGeode : public ShapeNode, public ::osg::Geode
+{
+public:
+
+  HeightmapShapeGeode(
+      const std::shared_ptr<dart::dynamics::HeightmapShape>& shape,
+      ShapeFrameNode* parentShapeFrame);
+
+  void refresh();
+  void extractData();
+
+protected:
+
+  virtual ~HeightmapShapeGeode();
+
+  std::shared_ptr<dart::dynamics::HeightmapShape> mHeightmapShape;
+  HeightmapShapeDrawable* mDrawable;
+
+};
+
+//==============================================================================
+class HeightmapShapeDrawable : public ::osg::ShapeDrawable
+{
+public:
+
+  HeightmapShapeDrawable(dart::dynamics::HeightmapShape* shape,
+                         dart::dynamics::VisualAspect* visualAspect);
+
+  void refresh(bool firstTime);
+
+protected:
+
+  virtual ~HeightmapShapeDrawable();
+
+  dart::dynamics::HeightmapShape* mHeightmapShape;
+  dart::dynamics::VisualAspect* mVisualAspect;
+
+};
+
+//==============================================================================
+HeightmapShapeNode::HeightmapShapeNode(
+    std::shared_ptr<dart::dynamics::HeightmapShape> shape,
+    ShapeFrameNode* parent)
+  : ShapeNode(shape, parent, this),
+    mHeightmapShape(shape),
+    mGeode(nullptr)
+{
+  extractData(true);
+  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+}
+
+//==============================================================================
+void HeightmapShapeNode::refresh()
+{
+  mUtilized = true;
+
+  setNodeMask(mVisualAspect->isHidden()? 0x0 : ~0x0);
+
+  if(mShape->getDataVariance() == dart::dynamics::Shape::STATIC)
+    return;
+
+  extractData(false);
+}
+
+//==============================================================================
+void HeightmapShapeNode::extractData(bool /*firstTime*/)
+{
+  if(nullptr == mGeode)
+  {
+    mGeode = new HeightmapShapeGeode(mHeightmapShape, mParentShapeFrameNode);
+    addChild(mGeode);
+    return;
+  }
+
+  mGeode->refresh();
+}
+
+//==============================================================================
+HeightmapShapeNode::~HeightmapShapeNode()
+{
+  // Do nothing
+}
+
+//==============================================================================
+HeightmapShapeGeode::HeightmapShapeGeode(
+    const std::shared_ptr<dart::dynamics::HeightmapShape>& shape,
+    ShapeFrameNode* parentShapeFrame)
+  : ShapeNode(shape, parentShapeFrame, this),
+    mHeightmapShape(shape),
+    mDrawable(nullptr)
+{
+  getOrCreateStateSet()->setMode(GL_BLEND, ::osg::StateAttribute::ON);
+  extractData();
+}
+
+//==============================================================================
+void HeightmapShapeGeode::refresh()
+{
+  mUtilized = true;
+
+  extractData();
+}
+
+//==============================================================================
+void HeightmapShapeGeode::extractData()
+{
+  if(nullptr == mDrawable)
+  {
+    mDrawable
+        = new HeightmapShapeDrawable(mHeightmapShape.get(), mVisualAspect);
+    addDrawable(mDrawable);
+    return;
+  }
+
+  mDrawable->refresh(false);
+}
+
+//==============================================================================
+HeightmapShapeGeode::~HeightmapShapeGeode()
+{
+  // Do nothing
+}
+
+//==============================================================================
+HeightmapShapeDrawable::HeightmapShapeDrawable(
+    dart::dynamics::HeightmapShape* shape,
+    dart::dynamics::VisualAspect* visualAspect)
+  : mHeightmapShape(shape),
+    mVisualAspect(visualAspect)
+{
+  refresh(true);
+}
+
+//==============================================================================
+void HeightmapShapeDrawable::refresh(bool firstTime)
+{
+  if(mHeightmapShape->getDataVariance() == dart::dynamics::Shape::STATIC)
+    setDataVariance(::osg::Object::STATIC);
+  else
+    setDataVariance(::osg::Object::DYNAMIC);
+
+  if(mHeightmapShape->checkDataVariance(
+       dart::dynamics::Shape::DYNAMIC_PRIMITIVE) || firstTime)
+  {
+    const auto& heights = mHeightmapShape->getHeightField();
+    const Eigen::Vector3d& scale = mHeightmapShape->getScale();
+    const std::size_t numRows = mHeightmapShape->getNumRows();
+    const std::size_t numColumns = mHeightmapShape->getNumColumns();
+
+    // The columns of osg::HeightField are along x and its rows along y, just
+    // like the ones of HeightmapShape
+    ::osg::ref_ptr<::osg::HeightField> osg_shape = new ::osg::HeightField;
+    osg_shape->allocate(numColumns, numRows);
+    osg_shape->setXInterval(scale[0]);
+    osg_shape->setYInterval(scale[1]);
+    Eigen::Vector3d origin = mHeightmapShape->getVertex(0u, 0u);
+    origin[2] = 0.0;
+    osg_shape->setOrigin(eigToOsgVec3(origin));
+
+    for(std::size_t i = 0; i < numRows; ++i)
+    {
+      for(std::size_t j = 0; j < numColumns; ++j)
+        osg_shape->setHeight(j, i, heights(i, j) * scale[2]);
+    }
+
+    setShape(osg_shape);
+    dirtyDisplayList();
+  }
+
+  if(mHeightmapShape->checkDataVariance(dart::dynamics::Shape::DYNAMIC_COLOR)
+     || firstTime)
+  {
+    setColor(eigToOsgVec4(mVisualAspect->getRGBA()));
+  }
+}
+
+//==============================================================================
+HeightmapShapeDrawable::~HeightmapShapeDrawable()
+{
+  // Do nothing
+}
+
+} // namespace render
+} // namespace osg
+} // namespace gui
+} // namespace dart
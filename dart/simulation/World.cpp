@@ -60,6 +60,8 @@ World::World(const std::string& _name)
     mTime(0.0),
     mFrame(0),
     mConstraintSolver(new constraint::ConstraintSolver(mTimeStep)),
+    mThreadPool(std::make_shared<common::ThreadPool>(1u)),
+    mIsCollisionPipeliningEnabled(false),
     mRecording(new Recording(mSkeletons)),
     onNameChanged(mNameChangedSignal)
 {
@@ -86,6 +88,8 @@ WorldPtr World::clone() const
 
   worldClone->setGravity(mGravity);
   worldClone->setTimeStep(mTimeStep);
+  worldClone->setNumThreads(getNumThreads());
+  worldClone->setCollisionPipeliningEnabled(isCollisionPipeliningEnabled());
 
   auto cd = getConstraintSolver()->getCollisionDetector();
   worldClone->getConstraintSolver()->setCollisionDetector(
@@ -142,6 +146,47 @@ double World::getTimeStep() const
   return mTimeStep;
 }
 
+//==============================================================================
+void World::setNumThreads(std::size_t numThreads)
+{
+  if (numThreads == 0u)
+    numThreads = common::ThreadPool::getNumHardwareThreads();
+
+  if (numThreads == getNumThreads())
+    return;
+
+  mThreadPool = std::make_shared<common::ThreadPool>(numThreads);
+  mConstraintSolver->setThreadPool(mThreadPool);
+}
+
+//==============================================================================
+std::size_t World::getNumThreads() const
+{
+  return mThreadPool->getNumThreads();
+}
+
+//==============================================================================
+void World::setCollisionPipeliningEnabled(bool enabled)
+{
+  if (enabled == mIsCollisionPipeliningEnabled)
+    return;
+
+  mIsCollisionPipeliningEnabled = enabled;
+
+  // A pool of two threads has exactly one worker. With a single hardware
+  // thread the two phases can't overlap, so the step is kept serial.
+  if (enabled && common::ThreadPool::getNumHardwareThreads() > 1u)
+    mCollisionThreadPool.reset(new common::ThreadPool(2u));
+  else
+    mCollisionThreadPool.reset();
+}
+
+//==============================================================================
+bool World::isCollisionPipeliningEnabled() const
+{
+  return mIsCollisionPipeliningEnabled;
+}
+
 //==============================================================================
 void World::reset()
 {
@@ -153,25 +198,40 @@ void World::reset()
 //==============================================================================
 void World::step(bool _resetCommand)
 {
-  // Integrate velocity for unconstrained skeletons
-  for (auto& skel : mSkeletons)
+  // Wake up disturbed skeletons and put resting ones to sleep
+  mConstraintSolver->updateSleepingSkeletons();
+
+  // Detect collisions while the forward dynamics is computed
+  std::future<void> collision;
+  if (mCollisionThreadPool)
   {
-    if (!skel->isMobile())
-      continue;
+    // The world transforms are computed lazily. Compute them here so that the
+    // collision detection only reads them. The forward dynamics only dirties
+    // velocities and accelerations, which leaves these transforms valid.
+    const auto group = mConstraintSolver->getCollisionGroup();
+    for (std::size_t i = 0u; i < group->getNumShapeFrames(); ++i)
+      group->getShapeFrame(i)->getWorldTransform();
+
+    collision = mCollisionThreadPool->submit(
+          [this]() { mConstraintSolver->detectCollision(); });
+  }
 
+  // Integrate velocity for unconstrained skeletons
+  forEachMobileSkeleton([&](dynamics::Skeleton* skel)
+  {
     skel->computeForwardDynamics();
     skel->integrateVelocities(mTimeStep);
-  }
+  });
+
+  if (collision.valid())
+    collision.get();
 
   // Detect activated constraints and compute constraint impulses
   mConstraintSolver->solve();
 
   // Compute velocity changes given constraint impulses
-  for (auto& skel : mSkeletons)
+  forEachMobileSkeleton([&](dynamics::Skeleton* skel)
   {
-    if (!skel->isMobile())
-      continue;
-
     if (skel->isImpulseApplied())
     {
       skel->computeImpulseForwardDynamics();
@@ -186,7 +246,7 @@ void World::step(bool _resetCommand)
       skel->clearExternalForces();
       skel->resetCommands();
     }
-  }
+  });
 
   mTime += mTimeStep;
   mFrame++;
@@ -549,6 +609,20 @@ Recording* World::getRecording()
   return mRecording;
 }
 
+//==============================================================================
+void World::forEachMobileSkeleton(
+    const std::function<void(dynamics::Skeleton*)>& fn)
+{
+  // Skeletons don't share any state that is touched by the forward dynamics
+  // or the integration, so the order of evaluation doesn't matter.
+  mThreadPool->parallelFor(0u, mSkeletons.size(), [&](std::size_t i)
+  {
+    dynamics::Skeleton* skel = mSkeletons[i].get();
+    if (skel->isMobile() && !skel->isSleeping())
+      fn(skel);
+  });
+}
+
 //==============================================================================
 void World::handleSkeletonNameChange(
     const dynamics::ConstMetaSkeletonPtr& _skeleton)
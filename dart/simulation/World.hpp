@@ -47,6 +47,7 @@
 #include "dart/common/Timer.hpp"
 #include "dart/common/NameManager.hpp"
 #include "dart/common/Subject.hpp"
+#include "dart/common/ThreadPool.hpp"
 #include "dart/dynamics/SimpleFrame.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/collision/CollisionOption.hpp"
@@ -120,6 +121,32 @@ public:
   /// Get time step
   double getTimeStep() const;
 
+  /// Set the number of threads that step() uses to compute the dynamics of
+  /// the Skeletons. The per-Skeleton forward dynamics and integration phases
+  /// are independent of each other, so they are distributed over a pool of
+  /// worker threads when numThreads is greater than one. The same pool is
+  /// handed to the ConstraintSolver to solve independent constrained groups
+  /// concurrently. The result is identical to the serial result. Passing zero
+  /// selects the number of hardware threads. The default is one, which runs
+  /// everything on the calling thread.
+  void setNumThreads(std::size_t numThreads);
+
+  /// Get the number of threads that step() uses
+  std::size_t getNumThreads() const;
+
+  /// Set whether step() runs the collision detection on a dedicated thread
+  /// while the forward dynamics of the Skeletons is computed. The collision
+  /// detection only depends on the positions at the beginning of the step,
+  /// which the forward dynamics doesn't change, so the contacts are the same
+  /// as the ones of the serial step. The two are joined before the constraints
+  /// are solved. On a machine with a single hardware thread the step stays
+  /// serial. Disabled by default.
+  void setCollisionPipeliningEnabled(bool enabled);
+
+  /// Return true if step() runs the collision detection concurrently with the
+  /// forward dynamics
+  bool isCollisionPipeliningEnabled() const;
+
   //--------------------------------------------------------------------------
   // Structural Properties
   //--------------------------------------------------------------------------
@@ -230,6 +257,11 @@ public:
 
 protected:
 
+  /// Call fn(skel) for every mobile Skeleton that isn't sleeping, distributing
+  /// the calls over mThreadPool
+  void forEachMobileSkeleton(
+      const std::function<void(dynamics::Skeleton*)>& fn);
+
   /// Register when a Skeleton's name is changed
   void handleSkeletonNameChange(
       const dynamics::ConstMetaSkeletonPtr& _skeleton);
@@ -287,6 +319,17 @@ protected:
   /// Constraint solver
   constraint::ConstraintSolver* mConstraintSolver;
 
+  /// Thread pool used by step()
+  std::shared_ptr<common::ThreadPool> mThreadPool;
+
+  /// Whether step() runs the collision detection concurrently with the
+  /// forward dynamics
+  bool mIsCollisionPipeliningEnabled;
+
+  /// Thread that runs the collision detection when the collision pipelining is
+  /// enabled on a machine with several hardware threads, nullptr otherwise
+  std::unique_ptr<common::ThreadPool> mCollisionThreadPool;
+
   ///
   Recording* mRecording;
 
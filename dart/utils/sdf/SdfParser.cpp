@@ -39,6 +39,7 @@
 #include <Eigen/StdVector>
 #include <tinyxml2.h>
 
+#include "dart/external/lodepng/lodepng.h"
 #include "dart/common/Console.hpp"
 #include "dart/common/LocalResourceRetriever.hpp"
 #include "dart/common/ResourceRetriever.hpp"
@@ -49,6 +50,7 @@
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/CylinderShape.hpp"
 #include "dart/dynamics/MeshShape.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
 #include "dart/dynamics/WeldJoint.hpp"
 #include "dart/dynamics/PrismaticJoint.hpp"
 #include "dart/dynamics/RevoluteJoint.hpp"
@@ -957,6 +959,82 @@ dynamics::ShapePtr readShape(
       return nullptr;
     }
   }
+  else if (hasElement(geometryElement, "heightmap"))
+  {
+    tinyxml2::XMLElement* heightmapEle
+        = getElement(geometryElement, "heightmap");
+
+    if (!hasElement(heightmapEle, "uri"))
+    {
+      dtwarn << "[SdfParser::readShape] Heightmap is missing a URI, which is "
+             << "required in order to load it\n";
+      return nullptr;
+    }
+    const std::string uri = getValueString(heightmapEle, "uri");
+    const std::string imageUri = common::Uri::getRelativeUri(_skelPath, uri);
+
+    const Eigen::Vector3d size = hasElement(heightmapEle, "size")?
+          getValueVector3d(heightmapEle, "size") : Eigen::Vector3d::Ones();
+    const Eigen::Vector3d pos = hasElement(heightmapEle, "pos")?
+          getValueVector3d(heightmapEle, "pos") : Eigen::Vector3d::Zero();
+
+    if (pos[0] != 0.0 || pos[1] != 0.0)
+    {
+      dtwarn << "[SdfParser::readShape] The x-y offset of heightmap ["
+             << imageUri << "] is not supported and will be ignored. Offset "
+             << "the link of the heightmap instead.\n";
+    }
+
+    const common::ResourcePtr resource = _retriever->retrieve(imageUri);
+    if (!resource)
+    {
+      dtwarn << "[SdfParser::readShape] Failed to retrieve heightmap ["
+             << imageUri << "].\n";
+      return nullptr;
+    }
+
+    std::vector<unsigned char> png(resource->getSize());
+    if (resource->read(png.data(), 1, png.size()) != png.size())
+    {
+      dtwarn << "[SdfParser::readShape] Failed to read heightmap ["
+             << imageUri << "].\n";
+      return nullptr;
+    }
+
+    // Decode the image as 16-bit grayscale, whose samples are big-endian
+    std::vector<unsigned char> pixels;
+    unsigned width = 0u;
+    unsigned height = 0u;
+    const unsigned error
+        = lodepng::decode(pixels, width, height, png, LCT_GREY, 16u);
+    if (error || width < 2u || height < 2u)
+    {
+      dtwarn << "[SdfParser::readShape] Failed to decode heightmap ["
+             << imageUri << "]: "
+             << (error ? lodepng_error_text(error) : "image is too small")
+             << ".\n";
+      return nullptr;
+    }
+
+    // The top row of the image is the far end of the terrain along y, while
+    // the first row of the height field is the near end.
+    dynamics::HeightmapShape::HeightField heights(height, width);
+    for (unsigned i = 0u; i < height; ++i)
+    {
+      for (unsigned j = 0u; j < width; ++j)
+      {
+        const std::size_t index = 2u * ((height - 1u - i) * width + j);
+        const double value = (pixels[index] << 8 | pixels[index + 1u]);
+        heights(i, j) = value / 65535.0 * size[2] + pos[2];
+      }
+    }
+
+    const Eigen::Vector3d scale(
+          size[0] / (width - 1u), size[1] / (height - 1u), 1.0);
+
+    newShape = Eigen::make_aligned_shared<dynamics::HeightmapShape>(
+          heights, scale);
+  }
   else
   {
     std::cout << "Invalid shape type." << std::endl;
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "dart/dart.hpp"
+
+using namespace dart::dynamics;
+using namespace dart::collision;
+
+// Boxes and spheres scattered in a cube whose volume grows with the number of
+// objects, so that every object has roughly the same number of neighbors
+// regardless of how many objects there are.
+std::vector<SimpleFramePtr> createObjects(std::size_t numObjects)
+{
+  const double halfWidth = 0.5 * std::cbrt(static_cast<double>(numObjects));
+
+  std::vector<SimpleFramePtr> objects;
+  objects.reserve(numObjects);
+  for(std::size_t i=0; i<numObjects; ++i)
+  {
+    ShapePtr shape;
+    if(i % 2 == 0)
+      shape = std::make_shared<BoxShape>(
+            dart::math::randomVector<3>(0.05, 0.3));
+    else
+      shape = std::make_shared<SphereShape>(dart::math::random(0.025, 0.15));
+
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() = dart::math::randomVector<3>(-halfWidth, halfWidth);
+    tf.linear() = dart::math::expMapRot(dart::math::randomVector<3>(-M_PI, M_PI));
+
+    objects.push_back(std::make_shared<SimpleFrame>(
+          Frame::World(), "object_" + std::to_string(i), tf));
+    objects.back()->setShape(shape);
+  }
+
+  return objects;
+}
+
+void moveObjects(const std::vector<SimpleFramePtr>& objects)
+{
+  for(const SimpleFramePtr& object : objects)
+  {
+    Eigen::Isometry3d tf = object->getRelativeTransform();
+    tf.translation() += dart::math::randomVector<3>(-0.01, 0.01);
+    object->setRelativeTransform(tf);
+  }
+}
+
+// Checks every pair of objects against each other, which is what
+// DARTCollisionGroup used to do before it had a broad phase.
+std::size_t collideAllPairs(
+    const std::vector<std::shared_ptr<CollisionGroup>>& groups,
+    const CollisionOption& option)
+{
+  std::size_t numContacts = 0u;
+  CollisionResult result;
+  for(std::size_t i=0; i<groups.size(); ++i)
+  {
+    for(std::size_t j=i+1; j<groups.size(); ++j)
+    {
+      groups[i]->collide(groups[j].get(), option, &result);
+      numContacts += result.getNumContacts();
+    }
+  }
+
+  return numContacts;
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t numSteps = 100;
+  if(argc > 1)
+    numSteps = std::stoul(argv[1]);
+
+  // Checking all pairs grows quadratically, so skip it for large scenes
+  const std::size_t maxBruteForceObjects = 1000u;
+
+  std::shared_ptr<CollisionDetector> detector
+      = DARTCollisionDetector::create();
+
+  CollisionOption option;
+  option.maxNumContacts = 1000000u;
+
+  std::cout << "Colliding " << numSteps << " times\n";
+
+  for(std::size_t numObjects : {10u, 100u, 1000u, 10000u})
+  {
+    const std::vector<SimpleFramePtr> objects = createObjects(numObjects);
+
+    std::shared_ptr<CollisionGroup> group = detector->createCollisionGroup();
+    for(const SimpleFramePtr& object : objects)
+      group->addShapeFrame(object.get());
+
+    std::vector<std::shared_ptr<CollisionGroup>> singleGroups;
+    if(numObjects <= maxBruteForceObjects)
+    {
+      for(const SimpleFramePtr& object : objects)
+        singleGroups.push_back(detector->createCollisionGroup(object.get()));
+    }
+
+    std::chrono::duration<double> broadPhaseTime(0.0);
+    std::chrono::duration<double> bruteForceTime(0.0);
+    std::size_t numContacts = 0u;
+    bool consistent = true;
+
+    for(std::size_t i=0; i<numSteps; ++i)
+    {
+      moveObjects(objects);
+
+      CollisionResult result;
+      auto start = std::chrono::system_clock::now();
+      group->collide(option, &result);
+      broadPhaseTime += std::chrono::system_clock::now() - start;
+      numContacts += result.getNumContacts();
+
+      if(singleGroups.empty())
+        continue;
+
+      start = std::chrono::system_clock::now();
+      const std::size_t numPairContacts = collideAllPairs(singleGroups, option);
+      bruteForceTime += std::chrono::system_clock::now() - start;
+
+      // A group merges contacts of different pairs that land on the same point,
+      // so it can only ever report fewer contacts than the pairwise checks.
+      consistent &= (result.getNumContacts() <= numPairContacts);
+    }
+
+    std::cout << "\nObjects: " << numObjects << "\n"
+              << "  contacts per step: "
+              << static_cast<double>(numContacts) / numSteps << "\n"
+              << "  broad phase: " << broadPhaseTime.count() << "s\n";
+
+    if(!singleGroups.empty())
+    {
+      std::cout << "  all pairs:   " << bruteForceTime.count() << "s"
+                << "  speedup: "
+                << bruteForceTime.count() / broadPhaseTime.count()
+                << "  consistent: " << (consistent? "yes" : "NO") << "\n";
+    }
+  }
+}
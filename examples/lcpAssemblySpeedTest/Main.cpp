@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <chrono>
+#include <iostream>
+
+#include "dart/dart.hpp"
+
+using namespace dart::dynamics;
+using namespace dart::simulation;
+
+SkeletonPtr createBox(const std::string& name,
+                      const Eigen::Vector3d& size,
+                      const Eigen::Vector3d& position,
+                      bool isMobile)
+{
+  SkeletonPtr box = Skeleton::create(name);
+
+  auto pair = box->createJointAndBodyNodePair<FreeJoint>();
+  auto shape = std::make_shared<BoxShape>(size);
+  pair.second->createShapeNodeWith<
+      VisualAspect, CollisionAspect, DynamicsAspect>(shape);
+
+  Inertia inertia;
+  inertia.setMass(1.0);
+  inertia.setMoment(shape->computeInertia(1.0));
+  pair.second->setInertia(inertia);
+
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = position;
+  pair.first->setPositions(FreeJoint::convertToPositions(tf));
+
+  box->setMobile(isMobile);
+
+  return box;
+}
+
+// Towers of boxes standing on the ground. Each tower is one constrained group
+// whose number of contacts grows with its height.
+WorldPtr createWorld(std::size_t numTowers, std::size_t height)
+{
+  WorldPtr world(new World);
+  world->getConstraintSolver()->setCollisionDetector(
+        dart::collision::DARTCollisionDetector::create());
+
+  world->addSkeleton(createBox("ground", Eigen::Vector3d(100.0, 100.0, 0.1),
+                               Eigen::Vector3d(0.0, 0.0, -0.05), false));
+
+  const double size = 0.5;
+  for(std::size_t i=0; i<numTowers; ++i)
+  {
+    for(std::size_t j=0; j<height; ++j)
+    {
+      const Eigen::Vector3d position(2.0 * static_cast<double>(i), 0.0,
+                                     (static_cast<double>(j) + 0.5) * size);
+      world->addSkeleton(createBox(
+          "box_" + std::to_string(i) + "_" + std::to_string(j),
+          Eigen::Vector3d::Constant(size), position, true));
+    }
+  }
+
+  return world;
+}
+
+double testStepSpeed(const WorldPtr& world, std::size_t numSteps,
+                     std::size_t& numContacts)
+{
+  numContacts = 0u;
+
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+  start = std::chrono::system_clock::now();
+
+  for(std::size_t i=0; i<numSteps; ++i)
+  {
+    world->step();
+    numContacts += world->getLastCollisionResult().getNumContacts();
+  }
+
+  end = std::chrono::system_clock::now();
+
+  numContacts /= numSteps;
+
+  std::chrono::duration<double> elapsed_seconds = end-start;
+  return elapsed_seconds.count();
+}
+
+double getMaxDifference(const WorldPtr& worldA, const WorldPtr& worldB)
+{
+  double difference = 0.0;
+  for(std::size_t i=0; i<worldA->getNumSkeletons(); ++i)
+  {
+    const SkeletonPtr skelA = worldA->getSkeleton(i);
+    const SkeletonPtr skelB = worldB->getSkeleton(i);
+
+    difference = std::max(difference,
+        (skelA->getPositions() - skelB->getPositions()).cwiseAbs().maxCoeff());
+  }
+
+  return difference;
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t numSteps = 200;
+  if(argc > 1)
+    numSteps = std::stoul(argv[1]);
+
+  std::cout << "Stepping " << numSteps << " times\n";
+
+  for(std::size_t height : {2u, 5u, 10u, 20u})
+  {
+    const std::size_t numTowers = 5u;
+    std::cout << "\nTowers: " << numTowers << "  height: " << height << "\n";
+
+    std::size_t numContacts;
+
+    WorldPtr impulseWorld = createWorld(numTowers, height);
+    const double impulseTime
+        = testStepSpeed(impulseWorld, numSteps, numContacts);
+
+    WorldPtr jacobianWorld = createWorld(numTowers, height);
+    jacobianWorld->getConstraintSolver()->setLCPMatrixAssembly(
+          dart::constraint::LCPSolver::JACOBIAN);
+    const double jacobianTime
+        = testStepSpeed(jacobianWorld, numSteps, numContacts);
+
+    std::cout << "  contacts: " << numContacts
+              << "  unit impulse: " << impulseTime << "s"
+              << "  jacobian: " << jacobianTime << "s"
+              << "  speedup: " << impulseTime / jacobianTime
+              << "  max difference: "
+              << getMaxDifference(impulseWorld, jacobianWorld) << "\n";
+  }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "dart/dart.hpp"
+#include "dart/utils/utils.hpp"
+
+dart::simulation::WorldPtr createWorld(const dart::dynamics::SkeletonPtr& robot,
+                                       std::size_t numRobots,
+                                       std::size_t numThreads)
+{
+  dart::simulation::WorldPtr world(new dart::simulation::World);
+  world->setNumThreads(numThreads);
+
+  // Place the robots far apart from each other so that they never touch, which
+  // makes every Skeleton an independent unit of work.
+  for(std::size_t i=0; i<numRobots; ++i)
+  {
+    dart::dynamics::SkeletonPtr clone
+        = robot->clone(robot->getName() + "_" + std::to_string(i));
+
+    Eigen::VectorXd q = clone->getPositions();
+    q[3] += 2.0 * static_cast<double>(i % 20);
+    q[4] += 2.0 * static_cast<double>(i / 20);
+    clone->setPositions(q);
+
+    world->addSkeleton(clone);
+  }
+
+  return world;
+}
+
+double testStepSpeed(const dart::simulation::WorldPtr& world,
+                     std::size_t numSteps)
+{
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+  start = std::chrono::system_clock::now();
+
+  for(std::size_t i=0; i<numSteps; ++i)
+    world->step();
+
+  end = std::chrono::system_clock::now();
+
+  std::chrono::duration<double> elapsed_seconds = end-start;
+  return elapsed_seconds.count();
+}
+
+bool haveSameState(const dart::simulation::WorldPtr& worldA,
+                   const dart::simulation::WorldPtr& worldB)
+{
+  for(std::size_t i=0; i<worldA->getNumSkeletons(); ++i)
+  {
+    const dart::dynamics::SkeletonPtr skelA = worldA->getSkeleton(i);
+    const dart::dynamics::SkeletonPtr skelB = worldB->getSkeleton(i);
+
+    if(skelA->getPositions() != skelB->getPositions()
+       || skelA->getVelocities() != skelB->getVelocities())
+      return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t numSteps = 500;
+  if(argc > 1)
+    numSteps = std::stoul(argv[1]);
+
+  dart::simulation::WorldPtr source = dart::utils::SkelParser::readWorld(
+        DART_DATA_PATH"skel/fullbody1.skel");
+  dart::dynamics::SkeletonPtr robot = source->getSkeleton("fullbody1");
+
+  const std::size_t maxThreads
+      = dart::common::ThreadPool::getNumHardwareThreads();
+
+  std::vector<std::size_t> threadCounts;
+  for(std::size_t numThreads=1; numThreads<maxThreads; numThreads *= 2)
+    threadCounts.push_back(numThreads);
+  threadCounts.push_back(maxThreads);
+
+  std::cout << "Stepping " << numSteps << " times, "
+            << maxThreads << " hardware threads\n";
+
+  for(std::size_t numRobots : {1u, 10u, 50u, 100u, 200u})
+  {
+    std::cout << "\nRobots: " << numRobots << "\n";
+
+    dart::simulation::WorldPtr serialWorld
+        = createWorld(robot, numRobots, 1u);
+    const double serialTime = testStepSpeed(serialWorld, numSteps);
+
+    for(std::size_t numThreads : threadCounts)
+    {
+      dart::simulation::WorldPtr world
+          = createWorld(robot, numRobots, numThreads);
+      const double time = testStepSpeed(world, numSteps);
+
+      std::cout << "  threads: " << numThreads
+                << "  time: " << time << "s"
+                << "  speedup: " << serialTime / time
+                << "  identical: "
+                << (haveSameState(serialWorld, world)? "yes" : "NO") << "\n";
+    }
+  }
+}
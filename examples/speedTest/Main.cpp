@@ -106,6 +106,59 @@ void runKinematicsTest(std::vector<double>& results,
   std::cout << "Result: " << totalTime << "s" << std::endl;
 }
 
+double testBatchForwardKinematicSpeed(dart::dynamics::SkeletonPtr skel,
+                                      dart::common::ThreadPool* threadPool,
+                                      std::size_t numTests=100000)
+{
+  if(nullptr==skel)
+    return 0;
+
+  Eigen::MatrixXd positions(skel->getNumDofs(), numTests);
+  for(std::size_t i=0; i<numTests; ++i)
+  {
+    for(std::size_t j=0; j<skel->getNumDofs(); ++j)
+    {
+      dart::dynamics::DegreeOfFreedom* dof = skel->getDof(j);
+      positions(j, i) = dart::math::random(
+                          std::max(dof->getPositionLowerLimit(),-1.0),
+                          std::min(dof->getPositionUpperLimit(), 1.0));
+    }
+  }
+
+  dart::dynamics::BatchTransforms transforms;
+
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+  start = std::chrono::system_clock::now();
+
+  dart::dynamics::computeForwardKinematics(*skel, positions, transforms,
+                                           threadPool);
+
+  end = std::chrono::system_clock::now();
+
+  std::chrono::duration<double> elapsed_seconds = end-start;
+  return elapsed_seconds.count();
+}
+
+void runBatchKinematicsTest(
+    std::vector<double>& results,
+    const std::vector<dart::simulation::WorldPtr>& worlds,
+    dart::common::ThreadPool* threadPool)
+{
+  double totalTime = 0;
+  std::cout << "Testing: Batch Position ("
+            << (threadPool ? threadPool->getNumThreads() : 1)
+            << " threads)\n";
+
+  for(std::size_t i=0; i<worlds.size(); ++i)
+  {
+    dart::simulation::WorldPtr world = worlds[i];
+    totalTime += testBatchForwardKinematicSpeed(world->getSkeleton(0),
+                                                threadPool);
+  }
+  results.push_back(totalTime);
+  std::cout << "Result: " << totalTime << "s" << std::endl;
+}
+
 double testDynamicsSpeed(dart::simulation::WorldPtr world,
                          std::size_t numIterations = 10000)
 {
@@ -214,6 +267,11 @@ int main(int argc, char* argv[])
     std::vector<double> acceleration_results;
     std::vector<double> velocity_results;
     std::vector<double> position_results;
+    std::vector<double> batch_results;
+    std::vector<double> parallel_batch_results;
+
+    dart::common::ThreadPool threadPool(
+          dart::common::ThreadPool::getNumHardwareThreads());
 
     for(std::size_t i=0; i<10; ++i)
     {
@@ -221,6 +279,8 @@ int main(int argc, char* argv[])
       runKinematicsTest(acceleration_results, worlds, true, true, true);
       runKinematicsTest(velocity_results, worlds, true, true, false);
       runKinematicsTest(position_results, worlds, true, false, false);
+      runBatchKinematicsTest(batch_results, worlds, nullptr);
+      runBatchKinematicsTest(parallel_batch_results, worlds, &threadPool);
     }
 
     std::cout << "\n\n --- Final Kinematics Results --- \n\n";
@@ -234,6 +294,12 @@ int main(int argc, char* argv[])
     std::cout << "\nPosition\n";
     print_results(position_results);
 
+    std::cout << "\nBatch Position\n";
+    print_results(batch_results);
+
+    std::cout << "\nParallel Batch Position\n";
+    print_results(parallel_batch_results);
+
     return 0;
   }
 
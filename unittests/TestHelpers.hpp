@@ -45,6 +45,7 @@
 #include "dart/common/ResourceRetriever.hpp"
 #include "dart/common/Uri.hpp"
 #include "dart/math/Geometry.hpp"
+#include "dart/math/Helpers.hpp"
 #include "dart/dynamics/dynamics.hpp"
 #include "dart/collision/CollisionDetector.hpp"
 #include "dart/constraint/ConstraintSolver.hpp"
@@ -461,6 +462,125 @@ SkeletonPtr createBox(
   return box;
 }
 
+//==============================================================================
+BodyNode* addRandomBody(const SkeletonPtr& skel, BodyNode* parent,
+                        Joint::Properties jointProperties)
+{
+  jointProperties.mT_ParentBodyToJoint.translation()
+      = dart::math::randomVector<3>(-0.5, 0.5);
+  jointProperties.mT_ChildBodyToJoint.translation()
+      = dart::math::randomVector<3>(-0.5, 0.5);
+
+  BodyNode::Properties bodyProperties(
+        BodyNode::AspectProperties(jointProperties.mName + "_body"));
+  bodyProperties.mInertia.setMass(dart::math::random(0.1, 10.0));
+  bodyProperties.mInertia.setLocalCOM(dart::math::randomVector<3>(-0.2, 0.2));
+  bodyProperties.mInertia.setMoment(
+        dart::math::random(0.1, 1.0), dart::math::random(0.1, 1.0),
+        dart::math::random(0.1, 1.0), dart::math::random(-0.05, 0.05),
+        dart::math::random(-0.05, 0.05), dart::math::random(-0.05, 0.05));
+
+  BodyNode* bn = nullptr;
+  if (jointProperties.mName.find("free") == 0)
+  {
+    bn = skel->createJointAndBodyNodePair<FreeJoint>(
+          parent, FreeJoint::Properties(jointProperties),
+          bodyProperties).second;
+  }
+  else if (jointProperties.mName.find("ball") == 0)
+  {
+    bn = skel->createJointAndBodyNodePair<BallJoint>(
+          parent, BallJoint::Properties(jointProperties),
+          bodyProperties).second;
+  }
+  else if (jointProperties.mName.find("weld") == 0)
+  {
+    bn = skel->createJointAndBodyNodePair<WeldJoint>(
+          parent, WeldJoint::Properties(jointProperties),
+          bodyProperties).second;
+  }
+  else if (jointProperties.mName.find("prismatic") == 0)
+  {
+    PrismaticJoint::Properties properties(jointProperties);
+    properties.mAxis = dart::math::randomVector<3>(-1.0, 1.0).normalized();
+    bn = skel->createJointAndBodyNodePair<PrismaticJoint>(
+          parent, properties, bodyProperties).second;
+  }
+  else if (jointProperties.mName.find("screw") == 0)
+  {
+    ScrewJoint::Properties properties(jointProperties);
+    properties.mAxis = dart::math::randomVector<3>(-1.0, 1.0).normalized();
+    properties.mPitch = dart::math::random(-1.0, 1.0);
+    bn = skel->createJointAndBodyNodePair<ScrewJoint>(
+          parent, properties, bodyProperties).second;
+  }
+  else if (jointProperties.mName.find("universal") == 0)
+  {
+    UniversalJoint::Properties properties(jointProperties);
+    properties.mAxis[0] = dart::math::randomVector<3>(-1.0, 1.0).normalized();
+    properties.mAxis[1] = dart::math::randomVector<3>(-1.0, 1.0).normalized();
+    bn = skel->createJointAndBodyNodePair<UniversalJoint>(
+          parent, properties, bodyProperties).second;
+  }
+  else if (jointProperties.mName.find("euler") == 0)
+  {
+    EulerJoint::Properties properties(jointProperties);
+    properties.mAxisOrder = EulerJoint::AxisOrder::ZYX;
+    bn = skel->createJointAndBodyNodePair<EulerJoint>(
+          parent, properties, bodyProperties).second;
+  }
+  else if (jointProperties.mName.find("planar") == 0)
+  {
+    PlanarJoint::Properties properties(jointProperties);
+    properties.setZXPlane();
+    bn = skel->createJointAndBodyNodePair<PlanarJoint>(
+          parent, properties, bodyProperties).second;
+  }
+  else if (jointProperties.mName.find("translational") == 0)
+  {
+    bn = skel->createJointAndBodyNodePair<TranslationalJoint>(
+          parent, TranslationalJoint::Properties(jointProperties),
+          bodyProperties).second;
+  }
+  else
+  {
+    RevoluteJoint::Properties properties(jointProperties);
+    properties.mAxis = dart::math::randomVector<3>(-1.0, 1.0).normalized();
+    bn = skel->createJointAndBodyNodePair<RevoluteJoint>(
+          parent, properties, bodyProperties).second;
+  }
+
+  return bn;
+}
+
+//==============================================================================
+/// Creates a Skeleton with a floating base and a limb of every other joint type
+SkeletonPtr createSkeletonWithAllJointTypes()
+{
+  SkeletonPtr skel = Skeleton::create("all_joint_types");
+
+  Joint::Properties properties;
+  properties.mName = "free";
+  BodyNode* base = addRandomBody(skel, nullptr, properties);
+
+  BodyNode* bn = base;
+  for (const std::string& type : {"revolute", "prismatic", "screw",
+                                  "universal", "euler", "ball", "weld"})
+  {
+    properties.mName = type;
+    bn = addRandomBody(skel, bn, properties);
+  }
+
+  bn = base;
+  for (const std::string& type : {"planar", "translational", "revolute_tip"})
+  {
+    properties.mName = type;
+    bn = addRandomBody(skel, bn, properties);
+  }
+
+  return skel;
+}
+
 //==============================================================================
 struct TestResource : public dart::common::Resource
 {
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <cstddef>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "dart/dynamics/SkeletonWorkspace.hpp"
+#include "dart/dynamics/dynamics.hpp"
+#include "dart/math/Helpers.hpp"
+
+#include "TestHelpers.hpp"
+
+using namespace dart;
+using namespace dynamics;
+
+// Count the heap allocations of the whole process by replacing malloc() with
+// a version that forwards to the one of the C library. Operator new and Eigen
+// both allocate through malloc().
+#if defined(__GLIBC__)
+#define DART_TEST_COUNT_ALLOCATIONS
+
+namespace {
+bool gIsCountingAllocations = false;
+std::size_t gNumAllocations = 0;
+}
+
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_calloc(std::size_t num, std::size_t size);
+extern "C" void* __libc_realloc(void* ptr, std::size_t size);
+
+extern "C" void* malloc(std::size_t size)
+{
+  if (gIsCountingAllocations)
+    ++gNumAllocations;
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t num, std::size_t size)
+{
+  if (gIsCountingAllocations)
+    ++gNumAllocations;
+  return __libc_calloc(num, size);
+}
+
+extern "C" void* realloc(void* ptr, std::size_t size)
+{
+  if (gIsCountingAllocations)
+    ++gNumAllocations;
+  return __libc_realloc(ptr, size);
+}
+#endif
+
+//==============================================================================
+TEST(Allocation, SkeletonWorkspace)
+{
+#ifndef DART_TEST_COUNT_ALLOCATIONS
+  std::cout << "Counting allocations is not supported on this platform.\n";
+  return;
+#else
+  SkeletonPtr skel = createSkeletonWithAllJointTypes();
+  const std::size_t dof = skel->getNumDofs();
+
+  // The state of a controller, with the positions, velocities, and
+  // accelerations stacked into one vector
+  const Eigen::VectorXd state = math::randomVectorXd(3 * dof, -1.0, 1.0);
+  const Eigen::VectorXd tau = math::randomVectorXd(dof, -10.0, 10.0);
+  Eigen::VectorXd forces(dof);
+  Eigen::VectorXd accelerations(dof);
+
+  SkeletonWorkspace workspace(*skel);
+
+  // Reading the state of the Skeleton allocates, which shows that the
+  // allocations are counted
+  gNumAllocations = 0;
+  gIsCountingAllocations = true;
+  const Eigen::VectorXd positions = skel->getPositions();
+  gIsCountingAllocations = false;
+  EXPECT_GT(gNumAllocations, 0u);
+  EXPECT_EQ(positions.size(), static_cast<int>(dof));
+
+  gNumAllocations = 0;
+  gIsCountingAllocations = true;
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    computeInverseDynamics(
+          *skel, workspace, state.segment(0, dof), state.segment(dof, dof),
+          state.segment(2 * dof, dof), forces);
+    computeForwardDynamics(
+          *skel, workspace, state.segment(0, dof), state.segment(dof, dof),
+          tau, accelerations);
+    computeMassMatrix(*skel, workspace, state.segment(0, dof));
+  }
+
+  gIsCountingAllocations = false;
+  EXPECT_EQ(gNumAllocations, 0u);
+
+  // The outputs match the ones that the workspace stores itself
+  EXPECT_TRUE(equals(forces, computeInverseDynamics(
+      *skel, workspace, state.segment(0, dof), state.segment(dof, dof),
+      state.segment(2 * dof, dof)), 0.0));
+  EXPECT_TRUE(equals(accelerations, computeForwardDynamics(
+      *skel, workspace, state.segment(0, dof), state.segment(dof, dof), tau),
+      0.0));
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
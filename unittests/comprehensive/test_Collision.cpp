@@ -816,6 +816,441 @@ TEST_F(COLLISION, BoxBox)
   testBoxBox(dart);
 }
 
+//==============================================================================
+bool checkContacts(const CollisionResult& result, std::size_t numContacts,
+                   const Eigen::Vector3d& normal, double penetrationDepth,
+                   double tol = 1e-9)
+{
+  if (result.getNumContacts() != numContacts)
+    return false;
+
+  for (const auto& contact : result.getContacts())
+  {
+    if (!contact.normal.isApprox(normal, tol)
+        || std::abs(contact.penetrationDepth - penetrationDepth) > tol)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+TEST_F(COLLISION, DARTCapsuleAndCylinder)
+{
+  std::shared_ptr<CollisionDetector> cd = DARTCollisionDetector::create();
+
+  auto frame1 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame2 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  frame1->setShape(std::make_shared<CapsuleShape>(0.1, 1.0));
+  frame2->setShape(std::make_shared<CapsuleShape>(0.1, 1.0));
+  auto group1 = cd->createCollisionGroup(frame1.get());
+  auto group2 = cd->createCollisionGroup(frame2.get());
+
+  CollisionOption option;
+  CollisionResult result;
+
+  const double halfPi = 0.5 * math::constantsd::pi();
+  const Eigen::Isometry3d alongX(
+        Eigen::AngleAxisd(halfPi, Eigen::Vector3d::UnitY()));
+  const Eigen::Isometry3d alongY(
+        Eigen::AngleAxisd(halfPi, Eigen::Vector3d::UnitX()));
+
+  // Parallel capsules touch along a line
+  frame2->setTranslation(Eigen::Vector3d(0.15, 0.0, 0.0));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 2u, -Eigen::Vector3d::UnitX(), 0.05));
+
+  // Crossing capsules touch at a single point
+  frame2->setRelativeTransform(alongY);
+  frame2->setTranslation(Eigen::Vector3d(0.15, 0.0, 0.0));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, -Eigen::Vector3d::UnitX(), 0.05));
+  EXPECT_TRUE(result.getContact(0).point.isApprox(
+                Eigen::Vector3d(0.075, 0.0, 0.0)));
+
+  frame2->setTranslation(Eigen::Vector3d(0.25, 0.0, 0.0));
+  EXPECT_FALSE(group1->collide(group2.get()));
+
+  // Capsule and sphere, in both orders
+  frame2->setShape(std::make_shared<SphereShape>(0.2));
+  frame2->setTransform(Eigen::Isometry3d::Identity());
+  frame2->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.75));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, -Eigen::Vector3d::UnitZ(), 0.05));
+  result.clear();
+  EXPECT_TRUE(group2->collide(group1.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, Eigen::Vector3d::UnitZ(), 0.05));
+
+  // Capsule lying on a box touches it at both ends
+  frame2->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(2.0, 2.0, 1.0)));
+  frame2->setTranslation(Eigen::Vector3d(0.0, 0.0, -0.5));
+  frame1->setRelativeTransform(alongX);
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.09));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 2u, Eigen::Vector3d::UnitZ(), 0.01));
+
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.11));
+  EXPECT_FALSE(group1->collide(group2.get()));
+
+  // Cylinder standing on a box touches it around the rim of its cap
+  frame1->setShape(std::make_shared<CylinderShape>(0.2, 0.4));
+  frame1->setTransform(Eigen::Isometry3d::Identity());
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.19));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 4u, Eigen::Vector3d::UnitZ(), 0.01));
+  for (const auto& contact : result.getContacts())
+  {
+    EXPECT_NEAR(contact.point.head<2>().norm(), 0.2, 1e-9);
+    EXPECT_NEAR(contact.point[2], -0.01, 1e-9);
+  }
+
+  // Cylinder lying on a box touches it along a line
+  frame1->setRelativeTransform(alongY);
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.19));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 2u, Eigen::Vector3d::UnitZ(), 0.01));
+
+  // Box whose corners rest on the cap of a cylinder
+  frame1->setTransform(Eigen::Isometry3d::Identity());
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.3));
+  frame2->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(0.2, 0.2, 0.2)));
+  frame2->setTranslation(Eigen::Vector3d(0.05, 0.05, 0.59));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 3u, -Eigen::Vector3d::UnitZ(), 0.01));
+
+  frame2->setTranslation(Eigen::Vector3d(0.4, 0.0, 0.3));
+  EXPECT_FALSE(group1->collide(group2.get()));
+
+  // Cylinder on a plane, standing and lying
+  auto plane = std::make_shared<PlaneShape>(Eigen::Vector3d::UnitZ(), 0.5);
+  frame2->setShape(plane);
+  frame2->setTranslation(Eigen::Vector3d(0.0, 0.0, -0.5));
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.19));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 4u, Eigen::Vector3d::UnitZ(), 0.01));
+
+  frame1->setRelativeTransform(alongY);
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.19));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 2u, Eigen::Vector3d::UnitZ(), 0.01));
+
+  // Capsule lying on a plane, with the plane as the first object
+  frame1->setShape(std::make_shared<CapsuleShape>(0.1, 1.0));
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.09));
+  result.clear();
+  EXPECT_TRUE(group2->collide(group1.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 2u, -Eigen::Vector3d::UnitZ(), 0.01));
+  for (const auto& contact : result.getContacts())
+    EXPECT_EQ(contact.collisionObject1->getShapeFrame(), frame2.get());
+
+  // Planes are unbounded
+  frame1->setTranslation(Eigen::Vector3d(1e+6, -1e+6, 0.09));
+  EXPECT_TRUE(group1->collide(group2.get()));
+}
+
+//==============================================================================
+TEST_F(COLLISION, DARTHeightmap)
+{
+  // A flat 4 x 4 terrain with a single bump of height 1 at its center
+  HeightmapShape::HeightField heights = HeightmapShape::HeightField::Zero(5, 5);
+  heights(2, 2) = 1.0;
+  auto heightmap = std::make_shared<HeightmapShape>(heights);
+
+  double height;
+  Eigen::Vector3d normal;
+  EXPECT_TRUE(heightmap->computeHeight(0.0, 0.0, height));
+  EXPECT_DOUBLE_EQ(height, 1.0);
+  EXPECT_TRUE(heightmap->computeHeight(0.5, 0.5, height));
+  EXPECT_DOUBLE_EQ(height, 0.5);
+  EXPECT_TRUE(heightmap->computeHeight(1.6, -1.4, height, &normal));
+  EXPECT_DOUBLE_EQ(height, 0.0);
+  EXPECT_TRUE(normal.isApprox(Eigen::Vector3d::UnitZ()));
+  EXPECT_FALSE(heightmap->computeHeight(2.1, 0.0, height));
+
+  std::size_t minRow, maxRow, minColumn, maxColumn;
+  EXPECT_TRUE(heightmap->computeCellRange(
+                Eigen::Vector2d(-0.5, 1.5), Eigen::Vector2d(0.5, 3.0),
+                minRow, maxRow, minColumn, maxColumn));
+  EXPECT_EQ(minRow, 3u);
+  EXPECT_EQ(maxRow, 3u);
+  EXPECT_EQ(minColumn, 1u);
+  EXPECT_EQ(maxColumn, 2u);
+  EXPECT_FALSE(heightmap->computeCellRange(
+                 Eigen::Vector2d(2.5, 0.0), Eigen::Vector2d(3.0, 1.0),
+                 minRow, maxRow, minColumn, maxColumn));
+
+  std::shared_ptr<CollisionDetector> cd = DARTCollisionDetector::create();
+
+  auto frame1 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame2 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  frame1->setShape(std::make_shared<SphereShape>(0.5));
+  frame2->setShape(heightmap);
+  auto group1 = cd->createCollisionGroup(frame1.get());
+  auto group2 = cd->createCollisionGroup(frame2.get());
+
+  CollisionOption option;
+  CollisionResult result;
+
+  // Sphere on the flat part, in both orders
+  frame1->setTranslation(Eigen::Vector3d(1.6, 1.4, 0.4));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, Eigen::Vector3d::UnitZ(), 0.1));
+  result.clear();
+  EXPECT_TRUE(group2->collide(group1.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, -Eigen::Vector3d::UnitZ(), 0.1));
+
+  frame1->setTranslation(Eigen::Vector3d(1.6, 1.4, 0.6));
+  EXPECT_FALSE(group1->collide(group2.get()));
+
+  frame1->setTranslation(Eigen::Vector3d(3.0, 0.0, 0.0));
+  EXPECT_FALSE(group1->collide(group2.get()));
+
+  // Sphere on top of the bump
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 1.4));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, Eigen::Vector3d::UnitZ(), 0.1));
+  EXPECT_TRUE(result.getContact(0).point.isApprox(Eigen::Vector3d::UnitZ()));
+
+  // Box on the flat part touches it at its bottom corners
+  frame1->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(0.4, 0.4, 0.4)));
+  frame1->setTranslation(Eigen::Vector3d(1.5, -1.5, 0.19));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 4u, Eigen::Vector3d::UnitZ(), 0.01));
+
+  // Box on top of the bump touches its peak
+  frame1->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(1.0, 1.0, 0.2)));
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 1.09));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, Eigen::Vector3d::UnitZ(), 0.01));
+  EXPECT_TRUE(result.getContact(0).point.isApprox(Eigen::Vector3d::UnitZ()));
+
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.0, 1.11));
+  EXPECT_FALSE(group1->collide(group2.get()));
+
+  // Cylinder standing on the flat part
+  frame1->setShape(std::make_shared<CylinderShape>(0.2, 0.4));
+  frame1->setTranslation(Eigen::Vector3d(1.5, -1.5, 0.19));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 4u, Eigen::Vector3d::UnitZ(), 0.01));
+
+  // Capsule lying on the flat part touches it at both ends
+  frame1->setShape(std::make_shared<CapsuleShape>(0.1, 0.4));
+  frame1->setRelativeTransform(Eigen::Isometry3d(
+      Eigen::AngleAxisd(0.5 * math::constantsd::pi(),
+                        Eigen::Vector3d::UnitY())));
+  frame1->setTranslation(Eigen::Vector3d(1.5, -1.5, 0.09));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 2u, Eigen::Vector3d::UnitZ(), 0.01));
+
+  // The height field follows its frame
+  frame2->setTranslation(Eigen::Vector3d(0.0, 0.0, -0.5));
+  EXPECT_FALSE(group1->collide(group2.get()));
+}
+
+//==============================================================================
+TEST_F(COLLISION, DARTHeightmapBuriedBox)
+{
+  // The bounding box of a flat terrain extends below its surface by the larger
+  // of the height scale and the range of the heights
+  auto heightmap = std::make_shared<HeightmapShape>(
+        HeightmapShape::HeightField::Zero(5, 5), Eigen::Vector3d(1.0, 1.0, 0.8));
+  EXPECT_DOUBLE_EQ(heightmap->getThickness(), 0.8);
+  EXPECT_DOUBLE_EQ(heightmap->getBoundingBox().getMin()[2], -0.8);
+  EXPECT_DOUBLE_EQ(heightmap->getBoundingBox().getMax()[2], 0.0);
+  EXPECT_GT(heightmap->getVolume(), 0.0);
+
+  std::shared_ptr<CollisionDetector> cd = DARTCollisionDetector::create();
+
+  auto frame1 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame2 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  frame1->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(0.4, 0.4, 0.2)));
+  frame2->setShape(heightmap);
+  auto group1 = cd->createCollisionGroup(frame1.get());
+  auto group2 = cd->createCollisionGroup(frame2.get());
+
+  CollisionOption option;
+  CollisionResult result;
+
+  // A box that sank completely below the surface is pushed back up by all of
+  // its corners
+  frame1->setTranslation(Eigen::Vector3d(1.5, -1.5, -0.5));
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_EQ(result.getNumContacts(), 8u);
+  for (const auto& contact : result.getContacts())
+  {
+    EXPECT_TRUE(contact.normal.isApprox(Eigen::Vector3d::UnitZ()));
+    EXPECT_NEAR(contact.penetrationDepth, -contact.point[2], 1e-12);
+    EXPECT_GE(contact.penetrationDepth, 0.4 - 1e-12);
+  }
+
+  // Below the thickness of the terrain, it is out of reach
+  heightmap->setThickness(0.2);
+  EXPECT_DOUBLE_EQ(heightmap->getThickness(), 0.2);
+  EXPECT_DOUBLE_EQ(heightmap->getBoundingBox().getMin()[2], -0.2);
+  EXPECT_FALSE(group1->collide(group2.get()));
+}
+
+//==============================================================================
+TEST_F(COLLISION, DARTVoxelGrid)
+{
+  // A 1 x 1 floor of 0.1 voxels right below the x-y plane, given in a frame
+  // that is 1 above the voxel grid
+  std::vector<Eigen::Vector3d> points;
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = 0; j < 10; ++j)
+      points.push_back(Eigen::Vector3d(-0.45 + 0.1 * i, -0.45 + 0.1 * j, 0.95));
+  }
+  Eigen::Isometry3d sensor = Eigen::Isometry3d::Identity();
+  sensor.translation() = -Eigen::Vector3d::UnitZ();
+
+  auto voxels = std::make_shared<VoxelGridShape>(0.1);
+  voxels->occupy(points, sensor);
+  EXPECT_EQ(voxels->getNumOccupiedVoxels(), 100u);
+  EXPECT_TRUE(voxels->isOccupied(Eigen::Vector3d(0.05, 0.05, -0.05)));
+  EXPECT_FALSE(voxels->isOccupied(Eigen::Vector3d(0.05, 0.05, 0.05)));
+  EXPECT_TRUE(voxels->getBoundingBox().getMin().isApprox(
+                Eigen::Vector3d(-0.5, -0.5, -0.1)));
+  EXPECT_TRUE(voxels->getBoundingBox().getMax().isApprox(
+                Eigen::Vector3d(0.5, 0.5, 0.0)));
+  EXPECT_NEAR(voxels->getVolume(), 0.1, 1e-12);
+
+  // Occupying an occupied voxel changes nothing
+  const std::size_t version = voxels->getVersion();
+  voxels->occupy(Eigen::Vector3d(0.01, 0.01, -0.01));
+  EXPECT_EQ(voxels->getVersion(), version);
+
+  std::shared_ptr<CollisionDetector> cd = DARTCollisionDetector::create();
+
+  auto frame1 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame2 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  frame1->setShape(std::make_shared<SphereShape>(0.04));
+  frame2->setShape(voxels);
+  auto group1 = cd->createCollisionGroup(frame1.get());
+  auto group2 = cd->createCollisionGroup(frame2.get());
+
+  CollisionOption option;
+  CollisionResult result;
+
+  // Sphere and box on a single voxel, in both orders
+  frame1->setTranslation(Eigen::Vector3d(0.05, 0.05, 0.03));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, Eigen::Vector3d::UnitZ(), 0.01));
+  result.clear();
+  EXPECT_TRUE(group2->collide(group1.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 1u, -Eigen::Vector3d::UnitZ(), 0.01));
+
+  frame1->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.08)));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_TRUE(checkContacts(result, 4u, Eigen::Vector3d::UnitZ(), 0.01));
+
+  frame1->setTranslation(Eigen::Vector3d(0.05, 0.05, 0.05));
+  EXPECT_FALSE(group1->collide(group2.get()));
+
+  // The faces between neighboring voxels don't push a capsule lying across
+  // them sideways
+  frame1->setShape(std::make_shared<CapsuleShape>(0.05, 0.4));
+  frame1->setRelativeTransform(Eigen::Isometry3d(
+      Eigen::AngleAxisd(0.5 * math::constantsd::pi(),
+                        Eigen::Vector3d::UnitY())));
+  frame1->setTranslation(Eigen::Vector3d(0.0, 0.05, 0.04));
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_LT(0u, result.getNumContacts());
+  for (const auto& contact : result.getContacts())
+    EXPECT_TRUE(contact.normal.isApprox(Eigen::Vector3d::UnitZ()));
+
+  // A sphere buried in the floor still collides with it
+  frame1->setShape(std::make_shared<SphereShape>(0.04));
+  frame1->setTransform(Eigen::Isometry3d::Identity());
+  frame1->setTranslation(Eigen::Vector3d(0.09, 0.05, -0.05));
+  EXPECT_TRUE(group1->collide(group2.get()));
+
+  // Removing the voxels below the sphere
+  frame1->setTranslation(Eigen::Vector3d(0.05, 0.05, 0.03));
+  voxels->unoccupy(Eigen::Vector3d(0.05, 0.05, -0.05));
+  EXPECT_EQ(voxels->getNumOccupiedVoxels(), 99u);
+  EXPECT_GT(voxels->getVersion(), version);
+  EXPECT_FALSE(group1->collide(group2.get()));
+
+  // Removing a row on the boundary shrinks the bounding box
+  points.clear();
+  for (int j = 0; j < 10; ++j)
+    points.push_back(Eigen::Vector3d(0.45, -0.45 + 0.1 * j, -0.05));
+  voxels->unoccupy(points);
+  EXPECT_EQ(voxels->getNumOccupiedVoxels(), 89u);
+  EXPECT_TRUE(voxels->getBoundingBox().getMax().isApprox(
+                Eigen::Vector3d(0.4, 0.5, 0.0)));
+
+  voxels->clear();
+  EXPECT_EQ(voxels->getNumOccupiedVoxels(), 0u);
+  frame1->setTranslation(Eigen::Vector3d(0.35, 0.35, 0.03));
+  EXPECT_FALSE(group1->collide(group2.get()));
+}
+
+//==============================================================================
+TEST_F(COLLISION, FCLEmptyVoxelGrid)
+{
+  // The bounding box of an empty voxel grid on a rotated frame degenerates to
+  // a point at the origin of the frame, which overlaps the sphere
+  auto voxels = std::make_shared<VoxelGridShape>(0.1);
+
+  auto frame1 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame2 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  frame1->setShape(std::make_shared<SphereShape>(0.2));
+  frame2->setShape(voxels);
+  frame2->setRotation((Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitX())
+                       * Eigen::AngleAxisd(0.4, Eigen::Vector3d::UnitZ()))
+                      .toRotationMatrix());
+
+  std::shared_ptr<CollisionDetector> cd = FCLCollisionDetector::create();
+  auto group1 = cd->createCollisionGroup(frame1.get());
+  auto group2 = cd->createCollisionGroup(frame2.get());
+  auto group = cd->createCollisionGroup(frame1.get(), frame2.get());
+
+  CollisionOption option;
+  CollisionResult result;
+
+  // The collision detectors notice the changes of the voxels from the version
+  // of the shape, so the grid doesn't need to be marked as dynamic
+  EXPECT_EQ(voxels->getDataVariance(), Shape::STATIC);
+
+  // Empty from the start
+  EXPECT_FALSE(group1->collide(group2.get(), option, &result));
+  EXPECT_FALSE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), 0u);
+
+  // Empty after the voxels are cleared
+  voxels->occupy(Eigen::Vector3d(0.05, 0.05, 0.05));
+  EXPECT_TRUE(group1->collide(group2.get()));
+  EXPECT_TRUE(group->collide());
+
+  voxels->clear();
+  result.clear();
+  EXPECT_FALSE(group1->collide(group2.get(), option, &result));
+  EXPECT_FALSE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), 0u);
+}
+
 //==============================================================================
 void testOptions(const std::shared_ptr<CollisionDetector>& cd)
 {
@@ -1093,6 +1528,598 @@ TEST_F(COLLISION, CreateCollisionGroupFromVariousObject)
   testCreateCollisionGroups(dart);
 }
 
+//==============================================================================
+void testStaticAndMovingObjects(const std::shared_ptr<CollisionDetector>& cd)
+{
+  // Immobile ground
+  auto ground = Skeleton::create("ground");
+  auto groundPair = ground->createJointAndBodyNodePair<FreeJoint>();
+  groundPair.second->createShapeNodeWith<CollisionAspect>(
+        std::make_shared<BoxShape>(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  ground->setMobile(false);
+
+  // Boxes that are never moved
+  std::vector<SimpleFramePtr> boxes;
+  for (auto i = 0u; i < 3u; ++i)
+  {
+    auto box = std::make_shared<SimpleFrame>(
+          Frame::World(), "box" + std::to_string(i));
+    box->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.5)));
+    box->setTranslation(Eigen::Vector3d(2.0 * (i + 1u), 0.0, 1.0));
+    boxes.push_back(box);
+  }
+
+  auto sphereShape = std::make_shared<SphereShape>(0.25);
+  auto sphere = std::make_shared<SimpleFrame>(Frame::World(), "sphere");
+  sphere->setShape(sphereShape);
+  sphere->setTranslation(Eigen::Vector3d(0.0, 0.0, 1.0));
+
+  auto group = cd->createCollisionGroup(ground.get());
+  for (const auto& box : boxes)
+    group->addShapeFrame(box.get());
+  group->addShapeFrame(sphere.get());
+
+  collision::CollisionOption option;
+  collision::CollisionResult result;
+
+  EXPECT_FALSE(group->collide(option, &result));
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Only the sphere moves from here on
+  sphere->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.2));
+  EXPECT_TRUE(group->collide(option, &result));
+
+  sphere->setTranslation(Eigen::Vector3d(2.0, 0.0, 1.3));
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_TRUE(result.getNumContacts() > 0u);
+  for (const auto& contact : result.getContacts())
+  {
+    EXPECT_TRUE(contact.collisionObject1->getShapeFrame() == boxes[0].get()
+        || contact.collisionObject2->getShapeFrame() == boxes[0].get());
+  }
+
+  sphere->setTranslation(Eigen::Vector3d(0.0, 0.0, 1.0));
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Immobile Skeletons can still be moved by setting their positions
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = Eigen::Vector3d(0.0, 0.0, 0.8);
+  ground->setPositions(FreeJoint::convertToPositions(tf));
+  EXPECT_TRUE(group->collide(option, &result));
+
+  ground->setPositions(Eigen::Vector6d::Zero());
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Static shapes that are modified in place are picked up by their versions
+  if (cd->getType() == DARTCollisionDetector::getStaticType())
+  {
+    auto boxShape = std::static_pointer_cast<BoxShape>(boxes[0]->getShape());
+    const std::size_t version = boxShape->getVersion();
+    boxShape->setSize(Eigen::Vector3d::Constant(3.8));
+    EXPECT_GT(boxShape->getVersion(), version);
+    EXPECT_TRUE(group->collide(option, &result));
+
+    boxShape->setSize(Eigen::Vector3d::Constant(0.5));
+    EXPECT_FALSE(group->collide(option, &result));
+
+    EXPECT_EQ(sphereShape->getDataVariance(), Shape::STATIC);
+    sphereShape->setRadius(1.2);
+    EXPECT_TRUE(group->collide(option, &result));
+  }
+}
+
+//==============================================================================
+TEST_F(COLLISION, StaticAndMovingObjects)
+{
+  auto fcl_mesh_dart = FCLCollisionDetector::create();
+  fcl_mesh_dart->setPrimitiveShapeType(FCLCollisionDetector::MESH);
+  fcl_mesh_dart->setContactPointComputationMethod(FCLCollisionDetector::DART);
+  testStaticAndMovingObjects(fcl_mesh_dart);
+
+#if HAVE_BULLET_COLLISION
+  auto bullet = BulletCollisionDetector::create();
+  testStaticAndMovingObjects(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testStaticAndMovingObjects(dart);
+}
+
+//==============================================================================
+void testRaycast(const std::shared_ptr<CollisionDetector>& cd)
+{
+  const double tol = 1e-3;
+
+  auto sphere = std::make_shared<SimpleFrame>(Frame::World(), "sphere");
+  sphere->setShape(std::make_shared<SphereShape>(0.5));
+
+  auto box = std::make_shared<SimpleFrame>(Frame::World(), "box");
+  box->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Constant(1.0)));
+  box->setTranslation(Eigen::Vector3d(3.0, 0.0, 0.0));
+
+  auto group = cd->createCollisionGroup(sphere.get(), box.get());
+
+  RaycastOption option;
+  RaycastResult result;
+
+  // Closest hit
+  EXPECT_TRUE(group->raycast(Eigen::Vector3d(-2.0, 0.0, 0.0),
+                             Eigen::Vector3d(5.0, 0.0, 0.0), option, &result));
+  ASSERT_EQ(result.rayHits.size(), 1u);
+  const RayHit& hit = result.rayHits[0];
+  EXPECT_EQ(hit.collisionObject->getShapeFrame(), sphere.get());
+  EXPECT_NEAR(hit.fraction, 1.5 / 7.0, tol);
+  EXPECT_TRUE(equals(hit.point, Eigen::Vector3d(-0.5, 0.0, 0.0), tol));
+  EXPECT_TRUE(equals(hit.normal, Eigen::Vector3d(-1.0, 0.0, 0.0), tol));
+
+  // All the hits sorted by the distance
+  option.enableAllHits = true;
+  EXPECT_TRUE(group->raycast(Eigen::Vector3d(-2.0, 0.0, 0.0),
+                             Eigen::Vector3d(5.0, 0.0, 0.0), option, &result));
+  ASSERT_EQ(result.rayHits.size(), 2u);
+  EXPECT_EQ(result.rayHits[0].collisionObject->getShapeFrame(), sphere.get());
+  EXPECT_EQ(result.rayHits[1].collisionObject->getShapeFrame(), box.get());
+  EXPECT_NEAR(result.rayHits[1].fraction, 4.5 / 7.0, tol);
+  EXPECT_TRUE(equals(result.rayHits[1].point,
+                     Eigen::Vector3d(2.5, 0.0, 0.0), tol));
+  EXPECT_TRUE(equals(result.rayHits[1].normal,
+                     Eigen::Vector3d(-1.0, 0.0, 0.0), tol));
+
+  // Missing, too short, and starting inside the sphere
+  EXPECT_FALSE(group->raycast(Eigen::Vector3d(-2.0, 1.0, 0.0),
+                              Eigen::Vector3d(5.0, 1.0, 0.0), option, &result));
+  EXPECT_FALSE(result.hasHit());
+  EXPECT_FALSE(group->raycast(Eigen::Vector3d(-2.0, 0.0, 0.0),
+                              Eigen::Vector3d(-1.0, 0.0, 0.0)));
+  EXPECT_TRUE(group->raycast(Eigen::Vector3d::Zero(),
+                             Eigen::Vector3d(5.0, 0.0, 0.0), option, &result));
+  ASSERT_EQ(result.rayHits.size(), 1u);
+  EXPECT_EQ(result.rayHits[0].collisionObject->getShapeFrame(), box.get());
+  EXPECT_NEAR(result.rayHits[0].fraction, 0.5, tol);
+
+  // The moved shapes are taken into account
+  sphere->setTranslation(Eigen::Vector3d(0.0, 1.0, 0.0));
+  EXPECT_TRUE(group->raycast(Eigen::Vector3d(-2.0, 1.0, 0.0),
+                             Eigen::Vector3d(5.0, 1.0, 0.0), option, &result));
+  EXPECT_EQ(result.rayHits.size(), 1u);
+  sphere->setTranslation(Eigen::Vector3d::Zero());
+
+  // A batch of rays gives the same hits with and without threads
+  std::vector<Ray> rays;
+  for (auto i = 0u; i <= 100u; ++i)
+  {
+    const double y = -1.0 + 0.02 * i;
+    rays.emplace_back(Eigen::Vector3d(-2.0, y, 0.1),
+                      Eigen::Vector3d(5.0, y, 0.1));
+  }
+
+  option.enableAllHits = false;
+  std::vector<RaycastResult> serialResults;
+  const std::size_t numHits = group->raycast(rays, option, &serialResults);
+  EXPECT_EQ(serialResults.size(), rays.size());
+  EXPECT_GE(numHits, 49u);
+  EXPECT_LE(numHits, 51u);
+
+  option.threadPool = std::make_shared<ThreadPool>(4u);
+  std::vector<RaycastResult> threadedResults;
+  EXPECT_EQ(group->raycast(rays, option, &threadedResults), numHits);
+  ASSERT_EQ(threadedResults.size(), rays.size());
+  for (auto i = 0u; i < rays.size(); ++i)
+  {
+    const auto& serialHits = serialResults[i].rayHits;
+    const auto& threadedHits = threadedResults[i].rayHits;
+    ASSERT_EQ(serialHits.size(), threadedHits.size());
+    if (serialHits.empty())
+      continue;
+
+    EXPECT_EQ(serialHits[0].collisionObject, threadedHits[0].collisionObject);
+    EXPECT_EQ(serialHits[0].fraction, threadedHits[0].fraction);
+  }
+}
+
+//==============================================================================
+TEST_F(COLLISION, Raycast)
+{
+  auto fcl_mesh_dart = FCLCollisionDetector::create();
+  fcl_mesh_dart->setPrimitiveShapeType(FCLCollisionDetector::MESH);
+  fcl_mesh_dart->setContactPointComputationMethod(FCLCollisionDetector::DART);
+  testRaycast(fcl_mesh_dart);
+
+#if HAVE_BULLET_COLLISION
+  auto bullet = BulletCollisionDetector::create();
+  testRaycast(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testRaycast(dart);
+}
+
+//==============================================================================
+TEST_F(COLLISION, DARTBroadPhase)
+{
+  // The broad phase of DARTCollisionGroup must report exactly the same
+  // contacts, in the same order, as checking every pair of objects.
+  std::shared_ptr<CollisionDetector> cd = DARTCollisionDetector::create();
+
+  const std::size_t numFrames = 200u;
+  std::vector<std::shared_ptr<SimpleFrame>> frames;
+  std::vector<std::unique_ptr<CollisionGroup>> singleGroups;
+  auto group = cd->createCollisionGroup();
+  auto group1 = cd->createCollisionGroup();
+  auto group2 = cd->createCollisionGroup();
+
+  for (std::size_t i = 0u; i < numFrames; ++i)
+  {
+    auto frame = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+    if (i % 2u == 0u)
+      frame->setShape(std::make_shared<BoxShape>(math::randomVector<3>(0.1, 1.0)));
+    else
+      frame->setShape(std::make_shared<SphereShape>(math::random(0.05, 0.5)));
+
+    frames.push_back(frame);
+    singleGroups.push_back(cd->createCollisionGroup(frame.get()));
+    group->addShapeFrame(frame.get());
+    if (i < numFrames / 3u)
+      group1->addShapeFrame(frame.get());
+    else
+      group2->addShapeFrame(frame.get());
+  }
+
+  CollisionOption option;
+  option.maxNumContacts = 100000u;
+
+  // A CollisionGroup reports contacts at the same point only once
+  const auto addContacts = [](CollisionResult& total,
+                              const CollisionResult& pairResult)
+  {
+    for (const auto& contact : pairResult.getContacts())
+    {
+      bool duplicate = false;
+      for (const auto& other : total.getContacts())
+        duplicate = duplicate || (contact.point - other.point).norm() < 3e-12;
+
+      if (!duplicate)
+        total.addContact(contact);
+    }
+  };
+
+  for (std::size_t step = 0u; step < 20u; ++step)
+  {
+    // Move the objects a little, with a large jump every now and then
+    const double range = (step % 5u == 0u) ? 5.0 : 0.2;
+    for (auto& frame : frames)
+    {
+      Eigen::Isometry3d tf = frame->getRelativeTransform();
+      tf.translation() += math::randomVector<3>(-range, range);
+      if (tf.translation().cwiseAbs().maxCoeff() > 5.0)
+        tf.translation() = math::randomVector<3>(-5.0, 5.0);
+      tf.linear() = tf.linear() * math::expMapRot(math::randomVector<3>(-0.3, 0.3));
+      frame->setRelativeTransform(tf);
+    }
+
+    CollisionResult expected;
+    CollisionResult pairResult;
+    for (std::size_t i = 0u; i < numFrames; ++i)
+    {
+      for (std::size_t j = i + 1u; j < numFrames; ++j)
+      {
+        if (singleGroups[i]->collide(singleGroups[j].get(), option, &pairResult))
+          addContacts(expected, pairResult);
+      }
+    }
+
+    CollisionResult result;
+    EXPECT_EQ(group->collide(option, &result), expected.isCollision());
+    ASSERT_EQ(result.getNumContacts(), expected.getNumContacts());
+    for (std::size_t i = 0u; i < result.getNumContacts(); ++i)
+    {
+      const Contact& contact = result.getContact(i);
+      const Contact& expectedContact = expected.getContact(i);
+      EXPECT_EQ(contact.collisionObject1->getShapeFrame(),
+                expectedContact.collisionObject1->getShapeFrame());
+      EXPECT_EQ(contact.collisionObject2->getShapeFrame(),
+                expectedContact.collisionObject2->getShapeFrame());
+      EXPECT_TRUE(equals(contact.point, expectedContact.point));
+    }
+
+    EXPECT_EQ(group->collide(), expected.isCollision());
+
+    expected.clear();
+    for (std::size_t i = 0u; i < numFrames / 3u; ++i)
+    {
+      for (std::size_t j = numFrames / 3u; j < numFrames; ++j)
+      {
+        if (singleGroups[i]->collide(singleGroups[j].get(), option, &pairResult))
+          addContacts(expected, pairResult);
+      }
+    }
+
+    group1->collide(group2.get(), option, &result);
+    EXPECT_EQ(result.getNumContacts(), expected.getNumContacts());
+    EXPECT_EQ(group1->collide(group2.get()), expected.isCollision());
+  }
+}
+
+//==============================================================================
+TEST_F(COLLISION, FCLMeshGeometryCache)
+{
+  const std::string path
+      = DART_DATA_PATH"urdf/drchubo/meshes/convhull_NK2.stl";
+
+  auto& cache = FCLMeshGeometryCache::getInstance();
+  cache.resetStatistics();
+  const auto numEntries = cache.getStatistics().numEntries;
+
+  // Two shapes loaded from the same file, as if from two copies of a robot
+  const Eigen::Vector3d scale = Eigen::Vector3d::Ones();
+  auto mesh1 = std::make_shared<MeshShape>(
+        scale, MeshShape::loadMesh(path), "file://" + path);
+  auto mesh2 = std::make_shared<MeshShape>(
+        scale, MeshShape::loadMesh(path), "file://" + path);
+  auto mesh3 = std::make_shared<MeshShape>(
+        2.0 * scale, MeshShape::loadMesh(path), "file://" + path);
+
+  auto frame1 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame2 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame3 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  frame1->setShape(mesh1);
+  frame2->setShape(mesh2);
+  frame3->setShape(mesh3);
+
+  // The BVH is shared across shapes and across collision detectors, i.e.,
+  // across worlds
+  auto cd1 = FCLCollisionDetector::create();
+  auto cd2 = FCLCollisionDetector::create();
+  auto group1 = cd1->createCollisionGroup(frame1.get(), frame2.get());
+  auto group2 = cd2->createCollisionGroup(frame2.get());
+
+  auto stats = cache.getStatistics();
+  EXPECT_EQ(stats.numMisses, 1u);
+  EXPECT_EQ(stats.numHits, 2u);
+  EXPECT_EQ(stats.numEntries, numEntries + 1u);
+  EXPECT_GT(stats.memoryUsage, 0u);
+  EXPECT_GE(stats.buildTime, 0.0);
+
+  // A different scale is baked into the BVH, so it needs its own copy
+  auto group3 = cd1->createCollisionGroup(frame3.get());
+  stats = cache.getStatistics();
+  EXPECT_EQ(stats.numMisses, 2u);
+  EXPECT_EQ(stats.numEntries, numEntries + 2u);
+
+  // The shared BVH is still placed by the transform of each object
+  frame2->setTranslation(Eigen::Vector3d(0.01, 0.0, 0.0));
+  EXPECT_TRUE(group1->collide());
+  frame2->setTranslation(Eigen::Vector3d(100.0, 0.0, 0.0));
+  EXPECT_FALSE(group1->collide());
+
+  // The BVHs are released with the last collision objects that use them
+  group1.reset();
+  group2.reset();
+  group3.reset();
+  EXPECT_EQ(cache.getStatistics().numEntries, numEntries);
+}
+
+//==============================================================================
+TEST_F(COLLISION, FCLSoftMesh)
+{
+  auto skel = Skeleton::create();
+  const SoftBodyNode::Properties properties(
+        BodyNode::AspectProperties("soft box"),
+        SoftBodyNodeHelper::makeBoxProperties(
+          Eigen::Vector3d::Ones(), Eigen::Isometry3d::Identity(),
+          Eigen::Vector3i(3, 3, 3), 1.0));
+  auto softBodyNode = skel->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>(
+        nullptr, FreeJoint::Properties(), properties).second;
+
+  auto ground = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  ground->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(10, 10, 0.1)));
+  ground->setTranslation(Eigen::Vector3d(0.0, 0.0, -0.6));
+
+  auto cd = FCLCollisionDetector::create();
+  auto group = cd->createCollisionGroup(skel.get(), ground.get());
+
+  // The soft box at rest is 0.05 above the ground
+  EXPECT_FALSE(group->collide());
+  EXPECT_FALSE(group->collide());
+
+  // Deform the soft box only; the body itself doesn't move
+  for (auto i = 0u; i < softBodyNode->getNumPointMasses(); ++i)
+    softBodyNode->getPointMass(i)->setPositions(Eigen::Vector3d(0, 0, -0.2));
+  EXPECT_TRUE(group->collide());
+  EXPECT_TRUE(group->collide());
+
+  for (auto i = 0u; i < softBodyNode->getNumPointMasses(); ++i)
+    softBodyNode->getPointMass(i)->resetPositions();
+  EXPECT_FALSE(group->collide());
+}
+
+//==============================================================================
+void testAllowedCollisionMatrix(const std::shared_ptr<CollisionDetector>& cd)
+{
+  // base: a long box
+  // link1: rotates about the center of base, always overlapping it
+  // link2: rotates far above base, never touching anything
+  // link3: rotates next to base, hitting it and link1 in some configurations
+  auto skel = Skeleton::create();
+  const Eigen::Vector3d size(0.2, 0.2, 1.0);
+  const Eigen::Vector3d offsets[3] = {
+    Eigen::Vector3d::Zero(), Eigen::Vector3d(0, 0, 5), Eigen::Vector3d(0.4, 0, 0)
+  };
+
+  auto base = skel->createJointAndBodyNodePair<WeldJoint>().second;
+  base->createShapeNodeWith<CollisionAspect>(std::make_shared<BoxShape>(size));
+  for (const auto& offset : offsets)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mAxis = Eigen::Vector3d::UnitY();
+    properties.mT_ParentBodyToJoint.translation() = offset;
+    auto link = skel->createJointAndBodyNodePair<RevoluteJoint>(
+          base, properties).second;
+
+    // Slightly smaller than base so that the contacts of link1 and base with
+    // link3 are not merged
+    link->createShapeNodeWith<CollisionAspect>(
+          std::make_shared<BoxShape>(0.8 * size));
+  }
+  skel->enableSelfCollisionCheck();
+  skel->enableAdjacentBodyCheck();
+
+  const Eigen::VectorXd positions = Eigen::VectorXd::Constant(3, 0.1);
+  skel->setPositions(positions);
+
+  auto matrix = generateAllowedCollisionMatrix(skel.get(), cd, 200u);
+  EXPECT_EQ(matrix->getNumBodyNodes(), 4u);
+  EXPECT_TRUE(skel->getPositions() == positions);
+
+  EXPECT_TRUE(matrix->isCollisionAllowed(0u, 1u));  // always colliding
+  EXPECT_TRUE(matrix->isCollisionAllowed(1u, 0u));
+  EXPECT_TRUE(matrix->isCollisionAllowed(0u, 2u));  // never colliding
+  EXPECT_TRUE(matrix->isCollisionAllowed(1u, 2u));
+  EXPECT_TRUE(matrix->isCollisionAllowed(2u, 3u));
+  EXPECT_FALSE(matrix->isCollisionAllowed(0u, 3u));  // sometimes colliding
+  EXPECT_FALSE(matrix->isCollisionAllowed(1u, 3u));
+  EXPECT_EQ(matrix->getNumAllowedPairs(), 4u);
+
+  // Only link3 swinging into base and link1 is reported
+  skel->setPositions(Eigen::Vector3d(0.0, 0.0, 0.5 * constantsd::pi()));
+  auto group = cd->createCollisionGroup(skel.get());
+  CollisionOption option(true, 1000u, std::make_shared<BodyNodeCollisionFilter>());
+  CollisionResult result;
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getCollidingBodyNodes().size(), 3u);
+
+  skel->setAllowedCollisionMatrix(matrix);
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getCollidingBodyNodes().size(), 3u);
+  for (const auto& contact : result.getContacts())
+  {
+    auto bodyNode1 = contact.collisionObject1->getShapeFrame()->asShapeNode()
+        ->getBodyNodePtr();
+    auto bodyNode2 = contact.collisionObject2->getShapeFrame()->asShapeNode()
+        ->getBodyNodePtr();
+    EXPECT_TRUE(bodyNode1->getIndexInSkeleton() == 3u
+                || bodyNode2->getIndexInSkeleton() == 3u);
+  }
+
+  // With only link3 left to check, the other pairs are rejected by the filter
+  // even when they touch
+  skel->setPositions(Eigen::Vector3d::Zero());
+  result.clear();
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Save and load
+  const std::string fileName = "allowed_collision_matrix_test.txt";
+  EXPECT_TRUE(matrix->save(fileName, skel.get()));
+  auto loaded = dynamics::AllowedCollisionMatrix::load(fileName, skel.get());
+  ASSERT_TRUE(loaded != nullptr);
+  for (auto i = 0u; i < 4u; ++i)
+  {
+    for (auto j = 0u; j < 4u; ++j)
+    {
+      EXPECT_EQ(loaded->isCollisionAllowed(i, j),
+                matrix->isCollisionAllowed(i, j));
+    }
+  }
+
+  // The matrix is ignored once it no longer matches the Skeleton
+  skel->createJointAndBodyNodePair<FreeJoint>();
+  skel->setPositions(Eigen::VectorXd::Zero(skel->getNumDofs()));
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+}
+
+//==============================================================================
+TEST_F(COLLISION, AllowedCollisionMatrix)
+{
+  auto fcl_mesh_dart = FCLCollisionDetector::create();
+  fcl_mesh_dart->setPrimitiveShapeType(FCLCollisionDetector::MESH);
+  fcl_mesh_dart->setContactPointComputationMethod(FCLCollisionDetector::DART);
+  testAllowedCollisionMatrix(fcl_mesh_dart);
+
+#if HAVE_BULLET_COLLISION
+  auto bullet = BulletCollisionDetector::create();
+  testAllowedCollisionMatrix(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testAllowedCollisionMatrix(dart);
+}
+
+//==============================================================================
+TEST_F(COLLISION, ReduceContacts)
+{
+  std::shared_ptr<CollisionDetector> cd = DARTCollisionDetector::create();
+
+  auto frame1 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame2 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto frame3 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  frame1->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  frame2->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  frame3->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  frame2->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.9));
+  frame3->setTranslation(Eigen::Vector3d(0.0, 0.0, -0.9));
+
+  auto group = cd->createCollisionGroup(frame1.get(), frame2.get(),
+                                        frame3.get());
+  CollisionOption option(true, 1000u);
+  CollisionResult result;
+  EXPECT_TRUE(group->collide(option, &result));
+  auto contact12 = result.getContact(0);
+  auto contact13 = contact12;
+  for (const auto& contact : result.getContacts())
+  {
+    if (contact.collisionObject2->getShapeFrame() == frame3.get()
+        || contact.collisionObject1->getShapeFrame() == frame3.get())
+    {
+      contact13 = contact;
+    }
+    else
+    {
+      contact12 = contact;
+    }
+  }
+
+  // A 5x5 grid of contacts between frame1 and frame2 whose deepest contact is
+  // at a corner, and two contacts between frame1 and frame3
+  result.clear();
+  for (int i = 0; i < 5; ++i)
+  {
+    for (int j = 0; j < 5; ++j)
+    {
+      auto contact = contact12;
+      contact.point = Eigen::Vector3d(0.1 * i, 0.1 * j, 0.45);
+      contact.penetrationDepth = (i == 0 && j == 0) ? 0.2 : 0.1;
+      result.addContact(contact);
+    }
+  }
+  result.addContact(contact13);
+  std::swap(contact13.collisionObject1, contact13.collisionObject2);
+  result.addContact(contact13);
+
+  EXPECT_EQ(result.reduceContacts(30u), 0u);
+  EXPECT_EQ(result.getNumContacts(), 27u);
+
+  // The four corners of the grid span the largest area
+  EXPECT_EQ(result.reduceContacts(4u), 21u);
+  ASSERT_EQ(result.getNumContacts(), 6u);
+  EXPECT_TRUE(equals(result.getContact(0).point,
+                     Eigen::Vector3d(0.0, 0.0, 0.45)));
+  EXPECT_TRUE(equals(result.getContact(1).point,
+                     Eigen::Vector3d(0.0, 0.4, 0.45)));
+  EXPECT_TRUE(equals(result.getContact(2).point,
+                     Eigen::Vector3d(0.4, 0.0, 0.45)));
+  EXPECT_TRUE(equals(result.getContact(3).point,
+                     Eigen::Vector3d(0.4, 0.4, 0.45)));
+  EXPECT_TRUE(result.inCollision(frame3.get()));
+
+  // The deepest contact is always kept
+  EXPECT_EQ(result.reduceContacts(1u), 4u);
+  ASSERT_EQ(result.getNumContacts(), 2u);
+  EXPECT_DOUBLE_EQ(result.getContact(0).penetrationDepth, 0.2);
+}
+
 //==============================================================================
 TEST_F(COLLISION, CollisionOfPrescribedJoints)
 {
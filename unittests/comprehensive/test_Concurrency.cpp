@@ -34,6 +34,7 @@
 
 #include <gtest/gtest.h>
 
+#include "dart/dynamics/SkeletonWorkspace.hpp"
 #include "dart/simulation/World.hpp"
 
 #include "TestHelpers.hpp"
@@ -77,6 +78,104 @@ TEST(Concurrency, FrameDeletion)
   EXPECT_EQ(Frame::World()->getNumChildFrames(), 0);
 }
 
+//==============================================================================
+SkeletonPtr createChain(std::size_t numBodyNodes)
+{
+  SkeletonPtr skel = Skeleton::create("chain");
+
+  BodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  for (std::size_t i = 1; i < numBodyNodes; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mName = "joint" + std::to_string(i);
+    properties.mAxis = i % 2 == 0 ? Eigen::Vector3d::UnitX()
+                                  : Eigen::Vector3d::UnitY();
+    properties.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0, 0, 0.5);
+    bn = skel->createJointAndBodyNodePair<RevoluteJoint>(
+          bn, properties,
+          BodyNode::AspectProperties("body" + std::to_string(i))).second;
+  }
+
+  return skel;
+}
+
+//==============================================================================
+struct SkeletonEvaluation
+{
+  Eigen::VectorXd forces;
+  Eigen::VectorXd accelerations;
+  Eigen::MatrixXd massMatrix;
+  math::Jacobian jacobian;
+};
+
+//==============================================================================
+std::vector<SkeletonEvaluation> evaluateSkeleton(
+    const Skeleton* skel,
+    const std::vector<Eigen::VectorXd>& states)
+{
+  const std::size_t dof = skel->getNumDofs();
+  const BodyNode* tip = skel->getBodyNode(skel->getNumBodyNodes() - 1);
+
+  SkeletonWorkspace workspace;
+  std::vector<SkeletonEvaluation> evaluations(states.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    const Eigen::VectorXd q = states[i].segment(0, dof);
+    const Eigen::VectorXd dq = states[i].segment(dof, dof);
+    const Eigen::VectorXd ddq = states[i].segment(2*dof, dof);
+
+    SkeletonEvaluation& evaluation = evaluations[i];
+    evaluation.forces = computeInverseDynamics(*skel, workspace, q, dq, ddq);
+    evaluation.jacobian = computeWorldJacobian(*skel, workspace, tip);
+    evaluation.accelerations = computeForwardDynamics(
+          *skel, workspace, q, dq, evaluation.forces);
+    evaluation.massMatrix = computeMassMatrix(*skel, workspace, q);
+  }
+
+  return evaluations;
+}
+
+//==============================================================================
+TEST(Concurrency, SharedSkeletonEvaluation)
+{
+  // Many threads evaluate the same Skeleton, each with its own workspace
+  SkeletonPtr skel = createChain(12);
+  const std::size_t dof = skel->getNumDofs();
+
+  std::vector<Eigen::VectorXd> states(50);
+  for (Eigen::VectorXd& state : states)
+    state = Eigen::VectorXd::Random(3*dof);
+
+  const std::vector<SkeletonEvaluation> expected
+      = evaluateSkeleton(skel.get(), states);
+
+  std::vector<std::future<std::vector<SkeletonEvaluation>>> futures;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    futures.push_back(std::async(std::launch::async,
+                                 &evaluateSkeleton, skel.get(), states));
+  }
+
+  for (auto& future : futures)
+  {
+    const std::vector<SkeletonEvaluation> evaluations = future.get();
+    ASSERT_EQ(evaluations.size(), expected.size());
+    for (std::size_t i = 0; i < evaluations.size(); ++i)
+    {
+      EXPECT_TRUE(equals(evaluations[i].forces, expected[i].forces, 0.0));
+      EXPECT_TRUE(equals(evaluations[i].accelerations,
+                         expected[i].accelerations, 0.0));
+      EXPECT_TRUE(equals(evaluations[i].massMatrix,
+                         expected[i].massMatrix, 0.0));
+      EXPECT_TRUE(equals(evaluations[i].jacobian, expected[i].jacobian, 0.0));
+    }
+  }
+
+  // Forward dynamics inverts inverse dynamics
+  const Eigen::VectorXd ddq = states.front().segment(2*dof, dof);
+  EXPECT_TRUE(equals(expected.front().accelerations, ddq, 1e-8));
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
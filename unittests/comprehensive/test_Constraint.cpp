@@ -29,7 +29,12 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <set>
+#include <thread>
 
 #include <Eigen/Dense>
 #include <gtest/gtest.h>
@@ -39,8 +44,13 @@
 #include "dart/common/Console.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/math/Helpers.hpp"
+#include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/constraint/DantzigLCPSolver.hpp"
+#include "dart/constraint/PGSLCPSolver.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/simulation/World.hpp"
 #include "dart/utils/SkelParser.hpp"
@@ -230,6 +240,547 @@ TEST_F(ConstraintTest, SingleContactTest)
   SingleContactTest(getList()[0]);
 }
 
+//==============================================================================
+dart::simulation::WorldPtr createStackedBoxesWorld()
+{
+  using namespace dart::collision;
+  using namespace dart::dynamics;
+  using namespace dart::simulation;
+
+  WorldPtr world(new World);
+  world->getConstraintSolver()->setCollisionDetector(
+        DARTCollisionDetector::create());
+
+  SkeletonPtr groundSkel = createGround(Eigen::Vector3d(100.0, 100.0, 0.1));
+  groundSkel->setMobile(false);
+  world->addSkeleton(groundSkel);
+
+  // Each stack of two boxes forms its own constrained group
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      const Eigen::Vector3d position(2.0 * i, 2.0 * j, 0.3);
+      world->addSkeleton(createBox(Eigen::Vector3d(0.5, 0.5, 0.5), position));
+      world->addSkeleton(createBox(
+          Eigen::Vector3d(0.5, 0.5, 0.5),
+          position + Eigen::Vector3d(0.1, 0.0, 0.55)));
+    }
+  }
+
+  return world;
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, ParallelConstrainedGroups)
+{
+  using namespace dart::simulation;
+
+  WorldPtr serialWorld = createStackedBoxesWorld();
+  WorldPtr parallelWorld = createStackedBoxesWorld();
+  parallelWorld->getConstraintSolver()->setThreadPool(
+        std::make_shared<dart::common::ThreadPool>(4u));
+
+  for (int i = 0; i < 300; ++i)
+  {
+    serialWorld->step();
+    parallelWorld->step();
+
+    EXPECT_EQ(
+        serialWorld->getLastCollisionResult().getNumContacts(),
+        parallelWorld->getLastCollisionResult().getNumContacts());
+  }
+
+  EXPECT_GT(serialWorld->getLastCollisionResult().getNumContacts(), 0u);
+
+  for (std::size_t i = 0; i < serialWorld->getNumSkeletons(); ++i)
+  {
+    const auto serialSkel = serialWorld->getSkeleton(i);
+    const auto parallelSkel = parallelWorld->getSkeleton(i);
+
+    EXPECT_TRUE(equals(
+        serialSkel->getPositions(), parallelSkel->getPositions(), 0.0));
+    EXPECT_TRUE(equals(
+        serialSkel->getVelocities(), parallelSkel->getVelocities(), 0.0));
+  }
+}
+
+//==============================================================================
+/// LCP solver that only implements the stateful solve() and records the
+/// threads it is called from
+class SerialLCPSolver : public dart::constraint::LCPSolver
+{
+public:
+  explicit SerialLCPSolver(double timeStep)
+    : LCPSolver(timeStep), mSolver(timeStep)
+  {
+    // Do nothing
+  }
+
+  void solve(dart::constraint::ConstrainedGroup* group) override
+  {
+    mThreadIds.insert(std::this_thread::get_id());
+    mSolver.solve(group);
+  }
+
+  std::set<std::thread::id> mThreadIds;
+
+private:
+  dart::constraint::DantzigLCPSolver mSolver;
+};
+
+//==============================================================================
+TEST_F(ConstraintTest, ParallelConstrainedGroupsWithSerialLCPSolver)
+{
+  using namespace dart::simulation;
+
+  WorldPtr world = createStackedBoxesWorld();
+  auto solver = world->getConstraintSolver();
+  solver->setThreadPool(std::make_shared<dart::common::ThreadPool>(4u));
+  solver->setLCPSolver(
+        dart::common::make_unique<SerialLCPSolver>(world->getTimeStep()));
+
+  auto lcpSolver = static_cast<SerialLCPSolver*>(solver->getLCPSolver());
+  EXPECT_FALSE(lcpSolver->isThreadSafe());
+
+  for (int i = 0; i < 100; ++i)
+    world->step();
+
+  EXPECT_GT(world->getLastCollisionResult().getNumContacts(), 0u);
+  ASSERT_EQ(lcpSolver->mThreadIds.size(), 1u);
+  EXPECT_EQ(*lcpSolver->mThreadIds.begin(), std::this_thread::get_id());
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, LCPWorkspace)
+{
+  using dart::constraint::LCPWorkspace;
+
+  LCPWorkspace workspace;
+  EXPECT_EQ(workspace.getNumAllocations(), 0u);
+
+  workspace.reserve(10u, 12u, 4u);
+  EXPECT_EQ(workspace.getNumAllocations(), 1u);
+
+  const double* buffers[] = {workspace.A, workspace.x, workspace.b,
+                             workspace.w, workspace.lo, workspace.hi};
+  for (const double* buffer : buffers)
+  {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer)
+              % LCPWorkspace::Alignment, 0u);
+  }
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(workspace.findex)
+            % LCPWorkspace::Alignment, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(workspace.order)
+            % LCPWorkspace::Alignment, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(workspace.offset)
+            % LCPWorkspace::Alignment, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(workspace.scratch)
+            % LCPWorkspace::Alignment, 0u);
+
+  // Smaller problems reuse the memory
+  const std::size_t capacity = workspace.getCapacity();
+  workspace.reserve(3u, 4u, 1u);
+  workspace.reserve(10u, 12u, 4u);
+  EXPECT_EQ(workspace.getNumAllocations(), 1u);
+  EXPECT_EQ(workspace.getCapacity(), capacity);
+
+  workspace.reserve(20u, 20u, 8u);
+  EXPECT_EQ(workspace.getNumAllocations(), 2u);
+  EXPECT_GT(workspace.getCapacity(), capacity);
+
+  // The scratch memory of the LCP algorithm shares the block with the buffers
+  const std::size_t scratchSize = 4u * workspace.getCapacity();
+  workspace.reserve(20u, 20u, 8u, scratchSize);
+  EXPECT_EQ(workspace.getNumAllocations(), 3u);
+  EXPECT_GT(workspace.getCapacity(), scratchSize);
+  workspace.reserve(20u, 20u, 8u, scratchSize);
+  EXPECT_EQ(workspace.getNumAllocations(), 3u);
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, NoLCPAllocationsInSteadyState)
+{
+  using namespace dart::constraint;
+  using namespace dart::simulation;
+
+  WorldPtr dantzigWorld = createStackedBoxesWorld();
+
+  WorldPtr pgsWorld = createStackedBoxesWorld();
+  pgsWorld->getConstraintSolver()->setLCPSolver(
+        dart::common::make_unique<PGSLCPSolver>(pgsWorld->getTimeStep()));
+
+  WorldPtr parallelWorld = createStackedBoxesWorld();
+  parallelWorld->getConstraintSolver()->setThreadPool(
+        std::make_shared<dart::common::ThreadPool>(4u));
+
+  const std::vector<WorldPtr> worlds = {dantzigWorld, pgsWorld, parallelWorld};
+
+  // Let the upper boxes land so that the constrained groups stop growing
+  for (const auto& world : worlds)
+  {
+    for (int i = 0; i < 300; ++i)
+      world->step();
+  }
+
+  for (const auto& world : worlds)
+  {
+    for (int i = 0; i < 200; ++i)
+    {
+      world->step();
+      EXPECT_EQ(world->getConstraintSolver()->getLastNumLCPAllocations(), 0u);
+    }
+  }
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, WarmStartedPGS)
+{
+  using namespace dart::constraint;
+  using namespace dart::simulation;
+
+  WorldPtr coldWorld = createStackedBoxesWorld();
+  WorldPtr warmWorld = createStackedBoxesWorld();
+  for (const auto& world : {coldWorld, warmWorld})
+  {
+    world->getConstraintSolver()->setLCPSolver(
+          dart::common::make_unique<PGSLCPSolver>(world->getTimeStep()));
+  }
+  coldWorld->getConstraintSolver()->setWarmStartingEnabled(false);
+  EXPECT_TRUE(warmWorld->getConstraintSolver()->isWarmStartingEnabled());
+
+  // Let the upper boxes land
+  for (int i = 0; i < 300; ++i)
+  {
+    coldWorld->step();
+    warmWorld->step();
+  }
+
+  std::size_t coldIterations = 0u;
+  std::size_t warmIterations = 0u;
+  for (int i = 0; i < 200; ++i)
+  {
+    coldWorld->step();
+    warmWorld->step();
+
+    const auto coldSolver = coldWorld->getConstraintSolver();
+    const auto warmSolver = warmWorld->getConstraintSolver();
+
+    EXPECT_EQ(coldSolver->getLastNumWarmStartedContacts(), 0u);
+    EXPECT_EQ(warmSolver->getLastNumWarmStartedContacts(),
+              warmWorld->getLastCollisionResult().getNumContacts());
+
+    coldIterations += coldSolver->getLastNumLCPIterations();
+    warmIterations += warmSolver->getLastNumLCPIterations();
+  }
+
+  EXPECT_GT(coldIterations, 0u);
+  EXPECT_LT(warmIterations, coldIterations);
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, WarmStartingAfterRemovingSkeletons)
+{
+  using namespace dart::dynamics;
+  using namespace dart::simulation;
+
+  WorldPtr world = createStackedBoxesWorld();
+  auto solver = world->getConstraintSolver();
+
+  // Let the upper boxes land
+  for (int i = 0; i < 300; ++i)
+    world->step();
+
+  // The impulses of a removed skeleton are dropped
+  const SkeletonPtr box = world->getSkeleton(world->getNumSkeletons() - 1u);
+  solver->removeSkeleton(box);
+  solver->addSkeleton(box);
+  world->step();
+
+  const auto& result = world->getLastCollisionResult();
+  std::size_t numBoxContacts = 0u;
+  for (const auto& contact : result.getContacts())
+  {
+    const auto shapeNode1 = static_cast<const ShapeNode*>(
+          contact.collisionObject1->getShapeFrame());
+    const auto shapeNode2 = static_cast<const ShapeNode*>(
+          contact.collisionObject2->getShapeFrame());
+    if (shapeNode1->getSkeleton() == box || shapeNode2->getSkeleton() == box)
+      ++numBoxContacts;
+  }
+  EXPECT_GT(numBoxContacts, 0u);
+  EXPECT_GT(solver->getLastNumWarmStartedContacts(), 0u);
+  EXPECT_LE(solver->getLastNumWarmStartedContacts(),
+            result.getNumContacts() - numBoxContacts);
+
+  // All the impulses are dropped when all the skeletons are removed
+  std::vector<SkeletonPtr> skeletons;
+  for (std::size_t i = 0u; i < world->getNumSkeletons(); ++i)
+    skeletons.push_back(world->getSkeleton(i));
+  solver->removeAllSkeletons();
+  solver->addSkeletons(skeletons);
+  world->step();
+
+  EXPECT_GT(world->getLastCollisionResult().getNumContacts(), 0u);
+  EXPECT_EQ(solver->getLastNumWarmStartedContacts(), 0u);
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, ContactReduction)
+{
+  using namespace dart::dynamics;
+  using namespace dart::simulation;
+
+  WorldPtr world = createStackedBoxesWorld();
+  auto solver = world->getConstraintSolver();
+  EXPECT_EQ(solver->getMaxNumContactsPerPair(), 0u);
+
+  const std::size_t maxNumContacts = 3u;
+  solver->setMaxNumContactsPerPair(maxNumContacts);
+  EXPECT_EQ(solver->getMaxNumContactsPerPair(), maxNumContacts);
+
+  std::size_t numReducedContacts = 0u;
+  for (int i = 0; i < 300; ++i)
+  {
+    world->step();
+    numReducedContacts += solver->getLastNumReducedContacts();
+
+    std::map<std::pair<const BodyNode*, const BodyNode*>, std::size_t> counts;
+    for (const auto& contact : world->getLastCollisionResult().getContacts())
+    {
+      auto bodyNode1 = contact.collisionObject1->getShapeFrame()
+          ->asShapeNode()->getBodyNodePtr().get();
+      auto bodyNode2 = contact.collisionObject2->getShapeFrame()
+          ->asShapeNode()->getBodyNodePtr().get();
+      ++counts[std::make_pair(std::min(bodyNode1, bodyNode2),
+                              std::max(bodyNode1, bodyNode2))];
+    }
+
+    for (const auto& count : counts)
+      EXPECT_LE(count.second, maxNumContacts);
+  }
+  EXPECT_GT(numReducedContacts, 0u);
+
+  // The boxes still rest on each other
+  for (std::size_t i = 1u; i < world->getNumSkeletons(); i += 2u)
+  {
+    EXPECT_NEAR(world->getSkeleton(i)->getBodyNode(0)->getWorldTransform()
+                .translation()[2], 0.3, 0.05);
+    EXPECT_NEAR(world->getSkeleton(i + 1u)->getBodyNode(0)->getWorldTransform()
+                .translation()[2], 0.8, 0.05);
+  }
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, JacobianMatrixAssembly)
+{
+  using namespace dart::constraint;
+  using namespace dart::dynamics;
+  using namespace dart::simulation;
+
+  const auto createWorld = []()
+  {
+    WorldPtr world = createStackedBoxesWorld();
+
+    // Articulated bodies hitting the ground and their joint limits
+    for (int i = 0; i < 4; ++i)
+    {
+      SkeletonPtr robot = createNLinkRobot(
+            4, Eigen::Vector3d(0.1, 0.1, 0.3), DOF_ROLL);
+      robot->getRootJoint()->setTransformFromParentBodyNode(
+            Eigen::Isometry3d(Eigen::Translation3d(2.0 * i, 10.0, 0.4)));
+      robot->getRootJoint()->setPosition(0, 0.3 * (i + 1));
+      for (std::size_t j = 1; j < robot->getNumJoints(); ++j)
+      {
+        Joint* joint = robot->getJoint(j);
+        joint->setPositionLimitEnforced(true);
+        joint->setPositionLowerLimit(0, -0.4);
+        joint->setPositionUpperLimit(0, 0.4);
+      }
+      world->addSkeleton(robot);
+    }
+
+    return world;
+  };
+
+  WorldPtr impulseWorld = createWorld();
+  WorldPtr jacobianWorld = createWorld();
+  jacobianWorld->getConstraintSolver()->setLCPMatrixAssembly(
+        LCPSolver::JACOBIAN);
+  EXPECT_EQ(impulseWorld->getConstraintSolver()->getLCPMatrixAssembly(),
+            LCPSolver::UNIT_IMPULSE);
+  EXPECT_EQ(jacobianWorld->getConstraintSolver()->getLCPMatrixAssembly(),
+            LCPSolver::JACOBIAN);
+
+  for (int i = 0; i < 200; ++i)
+  {
+    impulseWorld->step();
+    jacobianWorld->step();
+  }
+
+  EXPECT_GT(impulseWorld->getLastCollisionResult().getNumContacts(), 0u);
+
+  for (std::size_t i = 0; i < impulseWorld->getNumSkeletons(); ++i)
+  {
+    const auto impulseSkel = impulseWorld->getSkeleton(i);
+    const auto jacobianSkel = jacobianWorld->getSkeleton(i);
+
+    EXPECT_TRUE(equals(
+        impulseSkel->getPositions(), jacobianSkel->getPositions(), 1e-6));
+    EXPECT_TRUE(equals(
+        impulseSkel->getVelocities(), jacobianSkel->getVelocities(), 1e-6));
+  }
+
+  // The assembly is kept when the LCP solver is replaced
+  jacobianWorld->getConstraintSolver()->setLCPSolver(
+        dart::common::make_unique<PGSLCPSolver>(jacobianWorld->getTimeStep()));
+  EXPECT_EQ(jacobianWorld->getConstraintSolver()->getLCPSolver()
+            ->getMatrixAssembly(), LCPSolver::JACOBIAN);
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, SleepingIslands)
+{
+  using namespace dart::dynamics;
+  using namespace dart::simulation;
+
+  WorldPtr world = createStackedBoxesWorld();
+  auto solver = world->getConstraintSolver();
+  EXPECT_FALSE(solver->isSleepingEnabled());
+  solver->setSleepingEnabled(true);
+
+  const auto countSleepingSkeletons = [&world]()
+  {
+    std::size_t numSleeping = 0u;
+    for (std::size_t i = 0; i < world->getNumSkeletons(); ++i)
+    {
+      if (world->getSkeleton(i)->isSleeping())
+        ++numSleeping;
+    }
+    return numSleeping;
+  };
+
+  // Nothing sleeps while the upper boxes are landing
+  for (int i = 0; i < 100; ++i)
+  {
+    world->step();
+    EXPECT_EQ(countSleepingSkeletons(), 0u);
+  }
+
+  // Every box falls asleep once the stacks have settled. The ground is
+  // immobile, so it never sleeps.
+  for (int i = 0; i < 2000; ++i)
+    world->step();
+  EXPECT_EQ(countSleepingSkeletons(), world->getNumSkeletons() - 1u);
+
+  // Sleeping boxes don't move and their contacts aren't solved
+  std::vector<Eigen::VectorXd> positions;
+  for (std::size_t i = 0; i < world->getNumSkeletons(); ++i)
+    positions.push_back(world->getSkeleton(i)->getPositions());
+
+  world->step();
+  EXPECT_GT(world->getLastCollisionResult().getNumContacts(), 0u);
+  EXPECT_EQ(solver->getLastNumLCPIterations(), 0u);
+  for (std::size_t i = 0; i < world->getNumSkeletons(); ++i)
+  {
+    EXPECT_TRUE(equals(world->getSkeleton(i)->getPositions(), positions[i],
+                       0.0));
+  }
+
+  // Pushing the upper box of the first stack wakes up the whole stack but no
+  // other stack
+  SkeletonPtr lowerBox = world->getSkeleton(1);
+  SkeletonPtr upperBox = world->getSkeleton(2);
+  upperBox->getBodyNode(0)->addExtForce(Eigen::Vector3d(10.0, 0.0, 0.0));
+  world->step();
+  EXPECT_FALSE(lowerBox->isSleeping());
+  EXPECT_FALSE(upperBox->isSleeping());
+  EXPECT_EQ(countSleepingSkeletons(), world->getNumSkeletons() - 3u);
+
+  for (int i = 0; i < 2000; ++i)
+    world->step();
+  EXPECT_EQ(countSleepingSkeletons(), world->getNumSkeletons() - 1u);
+
+  // A box dropped on a sleeping stack wakes it up and lands on top of it
+  SkeletonPtr droppedBox = createBox(
+        Eigen::Vector3d(0.5, 0.5, 0.5), Eigen::Vector3d(2.0, 0.0, 1.6));
+  world->addSkeleton(droppedBox);
+
+  // Lower box of the stack at (2, 0), which comes after the ground and the
+  // four stacks at x = 0
+  SkeletonPtr hitStack = world->getSkeleton(1u + 2u * 4u);
+  bool isHitStackWokenUp = false;
+  for (int i = 0; i < 1000; ++i)
+  {
+    world->step();
+    isHitStackWokenUp = isHitStackWokenUp || !hitStack->isSleeping();
+  }
+  EXPECT_TRUE(isHitStackWokenUp);
+  EXPECT_GT(droppedBox->getCOM()[2], 1.0);
+
+  // Disabling sleeping wakes everything up
+  solver->setSleepingEnabled(false);
+  EXPECT_EQ(countSleepingSkeletons(), 0u);
+}
+
+//==============================================================================
+TEST_F(ConstraintTest, SpeculativeContacts)
+{
+  using namespace dart::collision;
+  using namespace dart::dynamics;
+  using namespace dart::simulation;
+
+  // A small box moves 0.2 per step toward a plate that is 0.02 thick
+  const auto createWorld = [](bool continuous)
+  {
+    WorldPtr world(new World);
+    world->setTimeStep(0.01);
+    world->setGravity(Eigen::Vector3d::Zero());
+    world->getConstraintSolver()->setCollisionDetector(
+          DARTCollisionDetector::create());
+
+    SkeletonPtr plate = createGround(Eigen::Vector3d(2.0, 2.0, 0.02));
+    plate->setMobile(false);
+    world->addSkeleton(plate);
+
+    SkeletonPtr box = createBox(
+          Eigen::Vector3d(0.1, 0.1, 0.1), Eigen::Vector3d(0.0, 0.0, 0.5));
+    box->getJoint(0)->setVelocity(5, -20.0);
+    box->getBodyNode(0)->getShapeNode(0)->getCollisionAspect()->setContinuous(
+          continuous);
+    world->addSkeleton(box);
+
+    return world;
+  };
+
+  // The discrete collision detection never sees the box touching the plate
+  WorldPtr world = createWorld(false);
+  for (int i = 0; i < 20; ++i)
+  {
+    world->step();
+    EXPECT_EQ(world->getConstraintSolver()->getLastNumSpeculativeContacts(),
+              0u);
+  }
+  EXPECT_LT(world->getSkeleton(1)->getCOM()[2], -1.0);
+
+  // The speculative contacts stop the box on the plate
+  world = createWorld(true);
+  std::size_t numSpeculativeContacts = 0u;
+  for (int i = 0; i < 20; ++i)
+  {
+    world->step();
+    numSpeculativeContacts
+        += world->getConstraintSolver()->getLastNumSpeculativeContacts();
+
+    // The speculative contacts don't show up in the collision result
+    for (const auto& contact : world->getLastCollisionResult().getContacts())
+      EXPECT_GE(contact.penetrationDepth, 0.0);
+  }
+  EXPECT_GT(numSpeculativeContacts, 0u);
+  EXPECT_NEAR(world->getSkeleton(1)->getCOM()[2], 0.06, 0.01);
+  EXPECT_NEAR(world->getSkeleton(1)->getCOMLinearVelocity()[2], 0.0, 1e-3);
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -290,6 +290,51 @@ TEST(Distance, SphereSphere)
   testSphereSphere(dart);
 }
 
+//==============================================================================
+TEST(Distance, VoxelGrid)
+{
+  auto cd = FCLCollisionDetector::create();
+
+  auto simpleFrame1 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+  auto simpleFrame2 = Eigen::make_aligned_shared<SimpleFrame>(Frame::World());
+
+  // A floor of 0.1 voxels right below the x-y plane
+  auto voxels = std::make_shared<VoxelGridShape>(0.1);
+  std::vector<Eigen::Vector3d> points;
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = 0; j < 10; ++j)
+      points.emplace_back(-0.45 + 0.1 * i, -0.45 + 0.1 * j, -0.05);
+  }
+  voxels->occupy(points);
+
+  simpleFrame1->setShape(std::make_shared<SphereShape>(0.2));
+  simpleFrame2->setShape(voxels);
+
+  auto group1 = cd->createCollisionGroup(simpleFrame1.get());
+  auto group2 = cd->createCollisionGroup(simpleFrame2.get());
+
+  collision::DistanceOption option;
+  collision::DistanceResult result;
+
+  simpleFrame1->setTranslation(Eigen::Vector3d(0.05, 0.05, 0.5));
+  group1->distance(group2.get(), option, &result);
+  EXPECT_NEAR(result.minDistance, 0.3, 1e-6);
+
+  // A column of voxels below the sphere is picked up on the next query
+  voxels->occupy(Eigen::Vector3d(0.05, 0.05, 0.05));
+  voxels->occupy(Eigen::Vector3d(0.05, 0.05, 0.15));
+  result.clear();
+  group1->distance(group2.get(), option, &result);
+  EXPECT_NEAR(result.minDistance, 0.1, 1e-6);
+
+  simpleFrame1->setTranslation(Eigen::Vector3d(0.05, 0.05, 0.35));
+  EXPECT_TRUE(group1->collide(group2.get()));
+
+  voxels->clear();
+  EXPECT_FALSE(group1->collide(group2.get()));
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
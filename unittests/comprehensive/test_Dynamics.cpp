@@ -37,11 +37,14 @@
 #include "TestHelpers.hpp"
 
 #include "dart/common/Console.hpp"
+#include "dart/common/ThreadPool.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/math/Helpers.hpp"
+#include "dart/dynamics/BatchForwardKinematics.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/dynamics/SimpleFrame.hpp"
+#include "dart/dynamics/SkeletonWorkspace.hpp"
 #include "dart/simulation/World.hpp"
 #include "dart/utils/SkelParser.hpp"
 
@@ -106,6 +109,9 @@ public:
   // Test impulse based dynamics
   void testImpulseBasedDynamics(const std::string& _fileName);
 
+  // Compare the mass matrices computed by all the mass matrix algorithms
+  void compareMassMatrixAlgorithms(const std::string& _fileName);
+
 protected:
   // Sets up the test fixture.
   void SetUp() override;
@@ -1908,6 +1914,85 @@ void DynamicsTest::testImpulseBasedDynamics(const std::string& _fileName)
   }
 }
 
+//==============================================================================
+void compareMassMatrixAlgorithmsForSkeleton(const dynamics::SkeletonPtr& skel)
+{
+  using namespace dynamics;
+
+#ifndef NDEBUG  // Debug mode
+  std::size_t nRandomItr = 2;
+#else
+  std::size_t nRandomItr = 100;
+#endif
+
+  double lb = -1.0 * math::constantsd::pi();
+  double ub =  1.0 * math::constantsd::pi();
+
+  const std::size_t dof = skel->getNumDofs();
+  if (dof == 0)
+    return;
+
+  const Skeleton::MassMatrixAlgorithm algorithm
+      = skel->getMassMatrixAlgorithm();
+
+  for (std::size_t i = 0; i < nRandomItr; ++i)
+  {
+    VectorXd q = VectorXd(dof);
+    VectorXd ddq = VectorXd(dof);
+    for (std::size_t k = 0; k < dof; ++k)
+    {
+      q[k] = math::random(lb, ub);
+      ddq[k] = math::random(lb, ub);
+    }
+    skel->setPositions(q);
+    skel->setAccelerations(ddq);
+
+    skel->setMassMatrixAlgorithm(Skeleton::UNIT_ACCELERATION);
+    const MatrixXd M1 = skel->getMassMatrix();
+
+    skel->setMassMatrixAlgorithm(Skeleton::COMPOSITE_RIGID_BODY);
+    const MatrixXd M2 = skel->getMassMatrix();
+
+    EXPECT_TRUE(equals(M1, M2, 1e-9));
+    if (!equals(M1, M2, 1e-9))
+    {
+      std::cout << "Skeleton: " << skel->getName() << std::endl;
+      std::cout << "M (unit acceleration): " << std::endl << M1 << std::endl;
+      std::cout << "M (composite rigid body): " << std::endl << M2 << std::endl;
+    }
+
+    // The mass matrix of each tree must agree with the whole Skeleton
+    for (std::size_t j = 0; j < skel->getNumTrees(); ++j)
+    {
+      const std::vector<DegreeOfFreedom*>& dofs = skel->getTreeDofs(j);
+      const MatrixXd& treeM = skel->getMassMatrix(j);
+      for (std::size_t r = 0; r < dofs.size(); ++r)
+      {
+        for (std::size_t c = 0; c < dofs.size(); ++c)
+        {
+          EXPECT_NEAR(treeM(r, c), M1(dofs[r]->getIndexInSkeleton(),
+                                      dofs[c]->getIndexInSkeleton()), 1e-9);
+        }
+      }
+    }
+
+    // Neither algorithm may leave the accelerations modified
+    EXPECT_TRUE(equals(skel->getAccelerations(), ddq));
+  }
+
+  skel->setMassMatrixAlgorithm(algorithm);
+}
+
+//==============================================================================
+void DynamicsTest::compareMassMatrixAlgorithms(const std::string& _fileName)
+{
+  simulation::WorldPtr world = utils::SkelParser::readWorld(_fileName);
+  EXPECT_TRUE(world != nullptr);
+
+  for (std::size_t i = 0; i < world->getNumSkeletons(); ++i)
+    compareMassMatrixAlgorithmsForSkeleton(world->getSkeleton(i));
+}
+
 //==============================================================================
 TEST_F(DynamicsTest, testJacobians)
 {
@@ -2130,6 +2215,445 @@ TEST_F(DynamicsTest, HybridDynamics)
   }
 }
 
+//==============================================================================
+TEST_F(DynamicsTest, compareMassMatrixAlgorithms)
+{
+  for (std::size_t i = 0; i < getList().size(); ++i)
+  {
+#ifndef NDEBUG
+    dtdbg << getList()[i] << std::endl;
+#endif
+    compareMassMatrixAlgorithms(getList()[i]);
+  }
+}
+
+//==============================================================================
+/// Creates a Skeleton made of a floating base with three limbs, one of which
+/// is attached through a WeldJoint, and a second fixed-base tree
+SkeletonPtr createBranchedSkeleton()
+{
+  SkeletonPtr skel = Skeleton::create("branched");
+
+  Joint::Properties properties;
+  properties.mName = "free";
+  BodyNode* base = addRandomBody(skel, nullptr, properties);
+
+  for (const std::string& limb : {"revolute", "ball", "weld"})
+  {
+    BodyNode* bn = base;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      properties.mName = (i == 0 ? limb : "revolute_" + limb)
+          + std::to_string(i);
+      bn = addRandomBody(skel, bn, properties);
+
+      if (i == 1)
+      {
+        properties.mName = "revolute_branch_" + limb;
+        addRandomBody(skel, bn, properties);
+      }
+    }
+  }
+
+  properties.mName = "ball_second_tree";
+  BodyNode* bn = addRandomBody(skel, nullptr, properties);
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    properties.mName = "revolute_second_tree" + std::to_string(i);
+    bn = addRandomBody(skel, bn, properties);
+  }
+
+  return skel;
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, CompositeRigidBodyMassMatrixOfBranchedTrees)
+{
+  SkeletonPtr skel = createBranchedSkeleton();
+  EXPECT_EQ(skel->getMassMatrixAlgorithm(), Skeleton::UNIT_ACCELERATION);
+  EXPECT_EQ(skel->getNumTrees(), 2u);
+  compareMassMatrixAlgorithmsForSkeleton(skel);
+
+  // The selected algorithm is part of the Properties of the Skeleton
+  skel->setMassMatrixAlgorithm(Skeleton::COMPOSITE_RIGID_BODY);
+  SkeletonPtr clone = skel->clone();
+  EXPECT_EQ(clone->getMassMatrixAlgorithm(), Skeleton::COMPOSITE_RIGID_BODY);
+  clone->setPositions(skel->getPositions());
+  EXPECT_TRUE(equals(skel->getMassMatrix(), clone->getMassMatrix(), 1e-9));
+}
+
+//==============================================================================
+void checkMassMatrixFactorization(const MassMatrixFactorization& factorization,
+                                  const MatrixXd& M, const MatrixXd& invM)
+{
+  const double tol = 1e-8;
+  const std::size_t n = static_cast<std::size_t>(M.rows());
+  ASSERT_EQ(factorization.getSize(), n);
+
+  // M = L^T * L, where L has no fill-in
+  const MatrixXd& L = factorization.getMatrixL();
+  EXPECT_TRUE(equals(MatrixXd(L.transpose() * L), M, tol));
+
+  const std::vector<std::size_t>& parents = factorization.getParents();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    std::vector<bool> isAncestor(n, false);
+    isAncestor[i] = true;
+    for (std::size_t j = parents[i]; j != INVALID_INDEX; j = parents[j])
+    {
+      EXPECT_LT(j, i);
+      isAncestor[j] = true;
+    }
+
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      if (!isAncestor[j])
+        EXPECT_EQ(L(i, j), 0.0);
+    }
+  }
+
+  const MatrixXd B = MatrixXd::Random(n, 3);
+  EXPECT_TRUE(equals(factorization.solve(B), MatrixXd(invM * B), tol));
+  EXPECT_TRUE(equals(factorization.multiply(B), MatrixXd(M * B), tol));
+
+  VectorXd x = B.col(0);
+  factorization.solveInPlace(x);
+  EXPECT_TRUE(equals(x, VectorXd(invM * B.col(0)), tol));
+  factorization.multiplyInPlace(x);
+  EXPECT_TRUE(equals(x, VectorXd(B.col(0)), tol));
+
+  EXPECT_TRUE(equals(factorization.getInverse(), invM, tol));
+
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < n; i += 3)
+    indices.push_back(n - 1 - i);
+
+  const MatrixXd partialInvM = factorization.getInverse(indices);
+  for (std::size_t r = 0; r < indices.size(); ++r)
+  {
+    for (std::size_t c = 0; c < indices.size(); ++c)
+      EXPECT_NEAR(partialInvM(r, c), invM(indices[r], indices[c]), tol);
+  }
+
+  const MatrixXd J = MatrixXd::Random(6, n);
+  EXPECT_TRUE(equals(factorization.getInverseProjection(J),
+                     MatrixXd(J * invM * J.transpose()), tol));
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, MassMatrixFactorization)
+{
+  SkeletonPtr skel = createBranchedSkeleton();
+  const std::size_t dof = skel->getNumDofs();
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    skel->setPositions(math::randomVectorXd(dof, -math::constantsd::pi(),
+                                            math::constantsd::pi()));
+
+    checkMassMatrixFactorization(skel->getMassMatrixFactorization(),
+                                 skel->getMassMatrix(),
+                                 skel->getInvMassMatrix());
+
+    for (std::size_t j = 0; j < skel->getNumTrees(); ++j)
+    {
+      checkMassMatrixFactorization(skel->getMassMatrixFactorization(j),
+                                   skel->getMassMatrix(j),
+                                   skel->getInvMassMatrix(j));
+    }
+  }
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, SkeletonWorkspace)
+{
+  SkeletonPtr skel = createSkeletonWithAllJointTypes();
+  skel->setMassMatrixAlgorithm(Skeleton::COMPOSITE_RIGID_BODY);
+  const std::size_t dof = skel->getNumDofs();
+  const double tol = 1e-8;
+
+  SkeletonWorkspace workspace;
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    const VectorXd q = math::randomVectorXd(dof, -1.5, 1.5);
+    const VectorXd dq = math::randomVectorXd(dof, -2.0, 2.0);
+    const VectorXd ddq = math::randomVectorXd(dof, -2.0, 2.0);
+    const VectorXd tau = math::randomVectorXd(dof, -10.0, 10.0);
+
+    skel->setPositions(q);
+    skel->setVelocities(dq);
+
+    computeForwardKinematics(*skel, workspace, q, dq);
+    for (std::size_t j = 0; j < skel->getNumBodyNodes(); ++j)
+    {
+      const BodyNode* bn = skel->getBodyNode(j);
+      EXPECT_TRUE(equals(workspace.worldTransforms[j].matrix(),
+                         bn->getWorldTransform().matrix(), tol));
+      EXPECT_TRUE(equals(workspace.spatialVelocities[j],
+                         bn->getSpatialVelocity(), tol));
+      EXPECT_TRUE(equals(workspace.partialAccelerations[j],
+                         bn->getPartialAcceleration(), tol));
+      EXPECT_TRUE(equals(computeJacobian(*skel, workspace, bn),
+                         skel->getJacobian(bn), tol));
+      EXPECT_TRUE(equals(computeWorldJacobian(*skel, workspace, bn),
+                         skel->getWorldJacobian(bn), tol));
+    }
+
+    EXPECT_TRUE(equals(computeMassMatrix(*skel, workspace, q),
+                       skel->getMassMatrix(), tol));
+
+    skel->setAccelerations(ddq);
+    skel->computeInverseDynamics();
+    EXPECT_TRUE(equals(computeInverseDynamics(*skel, workspace, q, dq, ddq),
+                       skel->getForces(), tol));
+
+    skel->setForces(tau);
+    skel->computeForwardDynamics();
+    EXPECT_TRUE(equals(computeForwardDynamics(*skel, workspace, q, dq, tau),
+                       skel->getAccelerations(), tol));
+
+    // The workspace never writes to the Skeleton
+    EXPECT_TRUE(equals(skel->getPositions(), q, 0.0));
+    EXPECT_TRUE(equals(skel->getVelocities(), dq, 0.0));
+    EXPECT_TRUE(equals(skel->getForces(), tau, 0.0));
+  }
+
+  // The workspace follows the structure of the Skeleton, but doesn't read it
+  // again while it is unchanged
+  const std::size_t version = skel->getStructureVersion();
+  EXPECT_NE(version, createSkeletonWithAllJointTypes()->getStructureVersion());
+  workspace.parentIndices.clear();
+  workspace.resize(*skel);
+  EXPECT_TRUE(workspace.parentIndices.empty());
+
+  Joint::Properties properties;
+  properties.mName = "ball_extra";
+  BodyNode* extra = addRandomBody(skel, skel->getBodyNode(0), properties);
+  EXPECT_NE(skel->getStructureVersion(), version);
+
+  const VectorXd q = math::randomVectorXd(skel->getNumDofs(), -1.5, 1.5);
+  const VectorXd dq = math::randomVectorXd(skel->getNumDofs(), -2.0, 2.0);
+  skel->setPositions(q);
+  skel->setVelocities(dq);
+  computeForwardKinematics(*skel, workspace, q, dq);
+  ASSERT_EQ(workspace.parentIndices.size(), skel->getNumBodyNodes());
+  EXPECT_TRUE(equals(
+      workspace.worldTransforms[extra->getIndexInSkeleton()].matrix(),
+      extra->getWorldTransform().matrix(), tol));
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, DefaultRelativeKinematicsOfJoints)
+{
+  // The default implementations of Joint evaluate the state of the Joint
+  // temporarily. They must agree with the overrides of the joint types.
+  SkeletonPtr skel = createSkeletonWithAllJointTypes();
+  const double tol = 1e-10;
+
+  for (std::size_t i = 0; i < skel->getNumJoints(); ++i)
+  {
+    Joint* joint = skel->getJoint(i);
+    const std::size_t dof = joint->getNumDofs();
+    if (dof == 0)
+      continue;
+
+    const VectorXd q = math::randomVectorXd(dof, -1.0, 1.0);
+    const VectorXd dq = math::randomVectorXd(dof, -2.0, 2.0);
+    const VectorXd oldQ = joint->getPositions();
+    const VectorXd oldDq = joint->getVelocities();
+
+    EXPECT_TRUE(equals(joint->Joint::computeRelativeTransform(q).matrix(),
+                       joint->computeRelativeTransform(q).matrix(), tol));
+
+    math::Jacobian jacobian(6, dof);
+    joint->Joint::computeRelativeJacobian(q, jacobian);
+    EXPECT_TRUE(equals(jacobian, joint->getRelativeJacobian(q), tol));
+
+    EXPECT_TRUE(equals(joint->Joint::computeRelativeJacobianTimeDeriv(q, dq),
+                       joint->computeRelativeJacobianTimeDeriv(q, dq), tol));
+
+    for (std::size_t k = 0; k < dof; ++k)
+    {
+      EXPECT_TRUE(equals(joint->Joint::computeRelativeJacobianDeriv(q, k),
+                         joint->computeRelativeJacobianDeriv(q, k), tol));
+    }
+
+    // The state of the Joint is restored
+    EXPECT_TRUE(equals(joint->getPositions(), oldQ, 0.0));
+    EXPECT_TRUE(equals(joint->getVelocities(), oldDq, 0.0));
+  }
+}
+
+//==============================================================================
+/// Returns the positions of skel after moving its degree of freedom index by h
+/// along the relative Jacobian of its Joint, which is the direction of the
+/// position derivatives of SkeletonWorkspace
+VectorXd perturbPositions(const SkeletonPtr& skel, const VectorXd& q,
+                          std::size_t index, double h)
+{
+  VectorXd dq = VectorXd::Zero(q.size());
+  dq[index] = h;
+
+  skel->setPositions(q);
+  skel->setVelocities(dq);
+  skel->integratePositions(1.0);
+
+  return skel->getPositions();
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, DynamicsDerivatives)
+{
+  SkeletonPtr skel = createSkeletonWithAllJointTypes();
+  const std::size_t dof = skel->getNumDofs();
+  const double h = 1e-6;
+  const double tol = 1e-5;
+
+  SkeletonWorkspace workspace;
+  SkeletonWorkspace fdWorkspace;
+
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    const VectorXd q = math::randomVectorXd(dof, -1.0, 1.0);
+    const VectorXd dq = math::randomVectorXd(dof, -2.0, 2.0);
+    const VectorXd ddq = math::randomVectorXd(dof, -2.0, 2.0);
+    const VectorXd tau = math::randomVectorXd(dof, -10.0, 10.0);
+
+    // Derivatives of the relative Jacobians of the Joints
+    for (std::size_t j = 0; j < skel->getNumJoints(); ++j)
+    {
+      const Joint* joint = skel->getJoint(j);
+      const std::size_t numJointDofs = joint->getNumDofs();
+      if (numJointDofs == 0)
+        continue;
+
+      const VectorXd jointQ = q.segment(joint->getIndexInSkeleton(0),
+                                        numJointDofs);
+      const VectorXd jointDq = dq.segment(joint->getIndexInSkeleton(0),
+                                          numJointDofs);
+      for (std::size_t k = 0; k < numJointDofs; ++k)
+      {
+        const VectorXd qPlus = jointQ + h * VectorXd::Unit(numJointDofs, k);
+        const VectorXd qMinus = jointQ - h * VectorXd::Unit(numJointDofs, k);
+
+        const math::Jacobian dJ
+            = (joint->getRelativeJacobian(qPlus)
+               - joint->getRelativeJacobian(qMinus)) / (2.0 * h);
+        EXPECT_TRUE(equals(joint->computeRelativeJacobianDeriv(jointQ, k),
+                           dJ, tol));
+
+        const math::Jacobian ddJ
+            = (joint->computeRelativeJacobianTimeDeriv(qPlus, jointDq)
+               - joint->computeRelativeJacobianTimeDeriv(qMinus, jointDq))
+              / (2.0 * h);
+        EXPECT_TRUE(equals(
+            joint->computeRelativeJacobianTimeDerivDeriv(jointQ, jointDq, k),
+            ddJ, tol));
+      }
+    }
+
+    // Central differences of the inverse and forward dynamics
+    MatrixXd forcesPositionDeriv(dof, dof);
+    MatrixXd forcesVelocityDeriv(dof, dof);
+    MatrixXd accelerationsPositionDeriv(dof, dof);
+    MatrixXd accelerationsVelocityDeriv(dof, dof);
+    MatrixXd accelerationsForceDeriv(dof, dof);
+    for (std::size_t j = 0; j < dof; ++j)
+    {
+      const VectorXd qPlus = perturbPositions(skel, q, j, h);
+      const VectorXd qMinus = perturbPositions(skel, q, j, -h);
+      const VectorXd dqPlus = dq + h * VectorXd::Unit(dof, j);
+      const VectorXd dqMinus = dq - h * VectorXd::Unit(dof, j);
+      const VectorXd tauPlus = tau + h * VectorXd::Unit(dof, j);
+      const VectorXd tauMinus = tau - h * VectorXd::Unit(dof, j);
+
+      VectorXd plus;
+      VectorXd minus;
+
+      plus = computeInverseDynamics(*skel, fdWorkspace, qPlus, dq, ddq);
+      minus = computeInverseDynamics(*skel, fdWorkspace, qMinus, dq, ddq);
+      forcesPositionDeriv.col(j) = (plus - minus) / (2.0 * h);
+
+      plus = computeInverseDynamics(*skel, fdWorkspace, q, dqPlus, ddq);
+      minus = computeInverseDynamics(*skel, fdWorkspace, q, dqMinus, ddq);
+      forcesVelocityDeriv.col(j) = (plus - minus) / (2.0 * h);
+
+      plus = computeForwardDynamics(*skel, fdWorkspace, qPlus, dq, tau);
+      minus = computeForwardDynamics(*skel, fdWorkspace, qMinus, dq, tau);
+      accelerationsPositionDeriv.col(j) = (plus - minus) / (2.0 * h);
+
+      plus = computeForwardDynamics(*skel, fdWorkspace, q, dqPlus, tau);
+      minus = computeForwardDynamics(*skel, fdWorkspace, q, dqMinus, tau);
+      accelerationsVelocityDeriv.col(j) = (plus - minus) / (2.0 * h);
+
+      plus = computeForwardDynamics(*skel, fdWorkspace, q, dq, tauPlus);
+      minus = computeForwardDynamics(*skel, fdWorkspace, q, dq, tauMinus);
+      accelerationsForceDeriv.col(j) = (plus - minus) / (2.0 * h);
+    }
+
+    computeInverseDynamicsDerivatives(*skel, workspace, q, dq, ddq);
+    EXPECT_TRUE(equals(workspace.forces,
+                       computeInverseDynamics(*skel, fdWorkspace, q, dq, ddq),
+                       tol));
+    EXPECT_TRUE(equals(workspace.forcesPositionDeriv, forcesPositionDeriv,
+                       tol));
+    EXPECT_TRUE(equals(workspace.forcesVelocityDeriv, forcesVelocityDeriv,
+                       tol));
+
+    computeForwardDynamicsDerivatives(*skel, workspace, q, dq, tau);
+    EXPECT_TRUE(equals(workspace.accelerations,
+                       computeForwardDynamics(*skel, fdWorkspace, q, dq, tau),
+                       tol));
+    EXPECT_TRUE(equals(workspace.accelerationsPositionDeriv,
+                       accelerationsPositionDeriv, tol));
+    EXPECT_TRUE(equals(workspace.accelerationsVelocityDeriv,
+                       accelerationsVelocityDeriv, tol));
+    EXPECT_TRUE(equals(workspace.accelerationsForceDeriv,
+                       accelerationsForceDeriv, tol));
+  }
+}
+
+//==============================================================================
+TEST_F(DynamicsTest, BatchForwardKinematics)
+{
+  SkeletonPtr skel = createSkeletonWithAllJointTypes();
+  const std::size_t numSamples = 37;
+  const MatrixXd positions
+      = MatrixXd::Random(skel->getNumDofs(), numSamples) * 2.0;
+
+  BatchTransforms transforms;
+  computeForwardKinematics(*skel, positions, transforms);
+  ASSERT_EQ(transforms.getNumBodyNodes(), skel->getNumBodyNodes());
+  ASSERT_EQ(transforms.getNumSamples(), numSamples);
+
+  for (std::size_t j = 0; j < numSamples; ++j)
+  {
+    skel->setPositions(positions.col(j));
+    skel->computeForwardKinematics(true, false, false);
+
+    for (std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+    {
+      EXPECT_TRUE(equals(transforms.getTransform(i, j).matrix(),
+                         skel->getBodyNode(i)->getWorldTransform().matrix(),
+                         1e-10));
+    }
+  }
+
+  // Splitting the batch across threads doesn't change the result
+  common::ThreadPool threadPool(4);
+  BatchTransforms parallelTransforms;
+  computeForwardKinematics(*skel, positions, parallelTransforms, &threadPool);
+  for (std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+  {
+    for (std::size_t j = 0; j < numSamples; ++j)
+    {
+      EXPECT_TRUE(equals(parallelTransforms.getTransform(i, j).matrix(),
+                         transforms.getTransform(i, j).matrix(), 0.0));
+    }
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -738,6 +738,164 @@ TEST(FRAMES, CHILDHOOD)
   EXPECT_TRUE(F1.getNumChildFrames() == 1);
 }
 
+TEST(FRAMES, WORLD_TRANSFORM_VERSION)
+{
+  SimpleFrame F1(Frame::World(), "F1");
+  SimpleFrame F2(&F1, "F2");
+  SimpleFrame F3(Frame::World(), "F3");
+
+  std::size_t version1 = F1.getWorldTransformVersion();
+  std::size_t version2 = F2.getWorldTransformVersion();
+  std::size_t version3 = F3.getWorldTransformVersion();
+
+  // Nothing has moved
+  EXPECT_EQ(version1, F1.getWorldTransformVersion());
+  EXPECT_EQ(version2, F2.getWorldTransformVersion());
+
+  // Moving the parent moves the child as well
+  Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+  tf.translation() = Eigen::Vector3d(1.0, 2.0, 3.0);
+  F1.setRelativeTransform(tf);
+  EXPECT_NE(version1, F1.getWorldTransformVersion());
+  EXPECT_NE(version2, F2.getWorldTransformVersion());
+  EXPECT_EQ(version3, F3.getWorldTransformVersion());
+
+  version1 = F1.getWorldTransformVersion();
+  version2 = F2.getWorldTransformVersion();
+
+  // Moving the child leaves the parent alone
+  F2.setRelativeTransform(tf);
+  EXPECT_EQ(version1, F1.getWorldTransformVersion());
+  EXPECT_NE(version2, F2.getWorldTransformVersion());
+}
+
+void setRandomMotion(SimpleFrame& frame)
+{
+  Eigen::Isometry3d tf;
+  randomize_transform(tf);
+  frame.setRelativeTransform(tf);
+  frame.setRelativeSpatialVelocity(random_vec<6>());
+  frame.setRelativeSpatialAcceleration(random_vec<6>());
+}
+
+TEST(FRAMES, LAZY_INVALIDATION)
+{
+  SimpleFrame F1(Frame::World(), "F1");
+  SimpleFrame F2(&F1, "F2");
+  SimpleFrame F3(&F2, "F3");
+
+  setRandomMotion(F1);
+  setRandomMotion(F2);
+  setRandomMotion(F3);
+
+  F3.getWorldTransform();
+  F3.getSpatialAcceleration();
+  EXPECT_FALSE(F3.needsTransformUpdate());
+  EXPECT_FALSE(F3.needsVelocityUpdate());
+  EXPECT_FALSE(F3.needsAccelerationUpdate());
+
+  const std::size_t velocityVersion = F3.getSpatialVelocityVersion();
+  const std::size_t accelerationVersion = F3.getSpatialAccelerationVersion();
+
+  for(std::size_t i = 0; i < 10; ++i)
+  {
+    // Moving an ancestor is noticed by the descendants when they are queried
+    setRandomMotion(F1);
+    EXPECT_TRUE(F3.needsTransformUpdate());
+    EXPECT_TRUE(F3.needsVelocityUpdate());
+    EXPECT_TRUE(F3.needsAccelerationUpdate());
+
+    // Frames built from scratch with the same relative motions
+    SimpleFrame G1(Frame::World(), "G1", F1.getRelativeTransform());
+    G1.setRelativeSpatialVelocity(F1.getRelativeSpatialVelocity());
+    G1.setRelativeSpatialAcceleration(F1.getRelativeSpatialAcceleration());
+    SimpleFrame G2(&G1, "G2", F2.getRelativeTransform());
+    G2.setRelativeSpatialVelocity(F2.getRelativeSpatialVelocity());
+    G2.setRelativeSpatialAcceleration(F2.getRelativeSpatialAcceleration());
+    SimpleFrame G3(&G2, "G3", F3.getRelativeTransform());
+    G3.setRelativeSpatialVelocity(F3.getRelativeSpatialVelocity());
+    G3.setRelativeSpatialAcceleration(F3.getRelativeSpatialAcceleration());
+
+    EXPECT_TRUE(equals(G3.getWorldTransform().matrix(),
+                       F3.getWorldTransform().matrix()));
+    EXPECT_TRUE(equals(G3.getSpatialVelocity(), F3.getSpatialVelocity()));
+    EXPECT_TRUE(equals(G3.getSpatialAcceleration(),
+                       F3.getSpatialAcceleration()));
+
+    EXPECT_FALSE(F3.needsTransformUpdate());
+    EXPECT_FALSE(F3.needsVelocityUpdate());
+    EXPECT_FALSE(F3.needsAccelerationUpdate());
+  }
+
+  EXPECT_NE(velocityVersion, F3.getSpatialVelocityVersion());
+  EXPECT_NE(accelerationVersion, F3.getSpatialAccelerationVersion());
+
+  // Changing only the acceleration of an ancestor leaves the transforms and
+  // the velocities of its descendants alone
+  const std::size_t transformVersion = F3.getWorldTransformVersion();
+  const std::size_t velocityVersion2 = F3.getSpatialVelocityVersion();
+  F1.setRelativeSpatialAcceleration(random_vec<6>());
+  EXPECT_EQ(transformVersion, F3.getWorldTransformVersion());
+  EXPECT_EQ(velocityVersion2, F3.getSpatialVelocityVersion());
+  EXPECT_TRUE(F3.needsAccelerationUpdate());
+}
+
+TEST(FRAMES, LAZY_INVALIDATION_SIGNALS_AND_TREES)
+{
+  SimpleFrame F1(Frame::World(), "F1");
+  SimpleFrame F2(&F1, "F2");
+  SimpleFrame F3(&F2, "F3");
+  SimpleFrame F4(&F3, "F4");
+  SimpleFrame H1(Frame::World(), "H1");
+
+  setRandomMotion(F1);
+  setRandomMotion(F2);
+  setRandomMotion(F3);
+  setRandomMotion(F4);
+  setRandomMotion(H1);
+
+  std::size_t transformSignals = 0u;
+  F4.onTransformUpdated.connect(
+        [&](const Entity*) { ++transformSignals; });
+
+  F4.getWorldTransform();
+  F4.getSpatialAcceleration();
+  transformSignals = 0u;
+
+  // A descendant with a connected slot is dirtied as soon as its ancestor
+  // moves, without being queried
+  setRandomMotion(F1);
+  EXPECT_EQ(1u, transformSignals);
+  EXPECT_TRUE(F4.needsTransformUpdate());
+  F4.getWorldTransform();
+  EXPECT_EQ(1u, transformSignals);
+  EXPECT_FALSE(F4.needsTransformUpdate());
+
+  // Moving a subtree into another tree makes it follow its new root
+  F3.setParentFrame(&H1);
+  EXPECT_TRUE(equals(
+      (H1.getWorldTransform()*F3.getRelativeTransform()
+       *F4.getRelativeTransform()).matrix(),
+      F4.getWorldTransform().matrix()));
+
+  transformSignals = 0u;
+  setRandomMotion(H1);
+  EXPECT_EQ(1u, transformSignals);
+  EXPECT_TRUE(F4.needsTransformUpdate());
+  EXPECT_TRUE(equals(
+      (H1.getWorldTransform()*F3.getRelativeTransform()
+       *F4.getRelativeTransform()).matrix(),
+      F4.getWorldTransform().matrix()));
+
+  // and leaves its old tree behind
+  F4.getSpatialAcceleration();
+  setRandomMotion(F1);
+  EXPECT_EQ(1u, transformSignals);
+  EXPECT_FALSE(F4.needsTransformUpdate());
+  EXPECT_FALSE(F4.needsVelocityUpdate());
+  EXPECT_FALSE(F4.needsAccelerationUpdate());
+}
+
 int main(int argc, char* argv[])
 {
   srand(271828); // Seed with an arbitrary fixed integer. Don't seed with time,
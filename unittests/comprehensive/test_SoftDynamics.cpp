@@ -38,6 +38,8 @@
 #include "dart/common/Console.hpp"
 #include "dart/math/Constants.hpp"
 #include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/dynamics/SoftBodyNode.hpp"
 #include "dart/dynamics/PointMass.hpp"
@@ -458,6 +460,93 @@ TEST_F(SoftDynamicsTest, compareEquationsOfMotion)
 //  }
 }
 
+//==============================================================================
+void compareSoftSkeletons(const dynamics::SkeletonPtr& _skel,
+                          const dynamics::SkeletonPtr& _expected)
+{
+  using namespace dynamics;
+
+  const SoftBodyNode* soft = _skel->getSoftBodyNode(0);
+  const SoftBodyNode* expectedSoft = _expected->getSoftBodyNode(0);
+  for (std::size_t i = 0; i < soft->getNumPointMasses(); ++i)
+  {
+    const PointMass* pm = soft->getPointMass(i);
+    EXPECT_TRUE(equals(expectedSoft->getPointMass(i)->getWorldPosition(),
+                       pm->getWorldPosition()));
+    EXPECT_TRUE(equals(
+        Vector3d(soft->getWorldTransform()*pm->getLocalPosition()),
+        pm->getWorldPosition()));
+  }
+
+  EXPECT_TRUE(equals(_expected->getGravityForces(), _skel->getGravityForces()));
+  EXPECT_TRUE(equals(_expected->getCoriolisForces(),
+                     _skel->getCoriolisForces()));
+  EXPECT_TRUE(equals(_expected->getExternalForces(),
+                     _skel->getExternalForces()));
+
+  _expected->computeForwardDynamics();
+  _skel->computeForwardDynamics();
+  EXPECT_TRUE(equals(_expected->getAccelerations(), _skel->getAccelerations()));
+}
+
+//==============================================================================
+/// Creates a Skeleton with a SoftBodyNode attached to a floating rigid body.
+/// A unit force along the x-axis is applied to every point mass.
+dynamics::SkeletonPtr createSoftSkeleton()
+{
+  using namespace dynamics;
+
+  SkeletonPtr skel = Skeleton::create("soft");
+  BodyNode* root = skel->createJointAndBodyNodePair<FreeJoint>().second;
+
+  SoftBodyNode::Properties properties(
+        BodyNode::Properties(),
+        SoftBodyNodeHelper::makeBoxProperties(
+          Vector3d::Constant(0.5), Isometry3d::Identity(),
+          Vector3i(3, 3, 3), 1.0));
+  RevoluteJoint::Properties joint;
+  joint.mT_ParentBodyToJoint.translation() = Vector3d(0.0, 0.0, 0.5);
+  SoftBodyNode* soft = skel->createJointAndBodyNodePair<
+      RevoluteJoint, SoftBodyNode>(root, joint, properties).second;
+
+  for (std::size_t i = 0; i < soft->getNumPointMasses(); ++i)
+    soft->getPointMass(i)->addExtForce(Vector3d::UnitX());
+
+  return skel;
+}
+
+//==============================================================================
+TEST_F(SoftDynamicsTest, movingParentOfSoftBodyNode)
+{
+  using namespace dynamics;
+
+  SkeletonPtr skel = createSoftSkeleton();
+  skel->setPositions(VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(VectorXd::Random(skel->getNumDofs()));
+
+  // Bring every cache of the point masses up to date
+  SoftBodyNode* soft = skel->getSoftBodyNode(0);
+  for (std::size_t i = 0; i < soft->getNumPointMasses(); ++i)
+    soft->getPointMass(i)->getWorldPosition();
+  skel->getExternalForces();
+  skel->computeForwardDynamics();
+
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    // Move the parent of the SoftBodyNode, and then the SoftBodyNode itself
+    if (i < 2)
+      skel->getRootJoint()->setPositions(Vector6d::Random());
+    else
+      soft->getParentJoint()->setPosition(0, 1.0);
+
+    SkeletonPtr expected = createSoftSkeleton();
+    expected->setPositions(skel->getPositions());
+    expected->setVelocities(skel->getVelocities());
+
+    compareSoftSkeletons(skel, expected);
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -30,6 +30,7 @@
  */
 
 #include <iostream>
+#include <thread>
 #include <gtest/gtest.h>
 #include "TestHelpers.hpp"
 
@@ -303,6 +304,255 @@ TEST(World, ValidatingClones)
   }
 }
 
+//==============================================================================
+TEST(World, MultiThreadedStep)
+{
+  const auto createWorld = []()
+  {
+    WorldPtr world(new World);
+    world->addSkeleton(createGround(Eigen::Vector3d(100.0, 100.0, 0.1)));
+
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+      const double x = 2.0 * static_cast<double>(i);
+      world->addSkeleton(createBox(
+          Eigen::Vector3d(0.5, 0.5, 0.5), Eigen::Vector3d(x, 0.0, 0.5)));
+
+      SkeletonPtr robot = createNLinkRobot(
+          4, Eigen::Vector3d(0.1, 0.1, 0.3), DOF_ROLL);
+      robot->getRootJoint()->setTransformFromParentBodyNode(
+          Eigen::Isometry3d(Eigen::Translation3d(x, 1.0, 2.0)));
+      world->addSkeleton(robot);
+    }
+
+    return world;
+  };
+
+  WorldPtr serialWorld = createWorld();
+  WorldPtr threadedWorld = createWorld();
+  threadedWorld->setNumThreads(4u);
+  EXPECT_EQ(serialWorld->getNumThreads(), 1u);
+  EXPECT_EQ(threadedWorld->getNumThreads(), 4u);
+
+#ifndef NDEBUG // Debug mode
+  std::size_t numIterations = 20;
+#else
+  std::size_t numIterations = 500;
+#endif
+
+  for (std::size_t i = 0; i < numIterations; ++i)
+  {
+    for (std::size_t k = 0; k < serialWorld->getNumSkeletons(); ++k)
+    {
+      SkeletonPtr skel = serialWorld->getSkeleton(k);
+
+      Eigen::VectorXd commands = skel->getCommands();
+      for (int q = 0; q < commands.size(); ++q)
+        commands[q] = random(-0.1, 0.1);
+
+      skel->setCommands(commands);
+      threadedWorld->getSkeleton(k)->setCommands(commands);
+    }
+
+    serialWorld->step();
+    threadedWorld->step();
+  }
+
+  for (std::size_t k = 0; k < serialWorld->getNumSkeletons(); ++k)
+  {
+    SkeletonPtr skel = serialWorld->getSkeleton(k);
+    SkeletonPtr clone = threadedWorld->getSkeleton(k);
+
+    EXPECT_TRUE(equals(skel->getPositions(), clone->getPositions(), 0));
+    EXPECT_TRUE(equals(skel->getVelocities(), clone->getVelocities(), 0));
+    EXPECT_TRUE(equals(skel->getAccelerations(), clone->getAccelerations(), 0));
+  }
+}
+
+//==============================================================================
+/// Stacks of boxes on a ground plane, next to swinging chains
+WorldPtr createStackedBoxesWorld()
+{
+  WorldPtr world(new World);
+  world->addSkeleton(createGround(Eigen::Vector3d(100.0, 100.0, 0.1)));
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    const double x = 2.0 * static_cast<double>(i);
+    world->addSkeleton(createBox(
+        Eigen::Vector3d(0.5, 0.5, 0.5), Eigen::Vector3d(x, 0.0, 0.3)));
+    world->addSkeleton(createBox(
+        Eigen::Vector3d(0.3, 0.3, 0.3), Eigen::Vector3d(x, 0.0, 0.8)));
+
+    SkeletonPtr robot = createNLinkRobot(
+        4, Eigen::Vector3d(0.1, 0.1, 0.3), DOF_ROLL);
+    robot->getRootJoint()->setTransformFromParentBodyNode(
+        Eigen::Isometry3d(Eigen::Translation3d(x, 1.0, 1.0)));
+    world->addSkeleton(robot);
+  }
+
+  return world;
+}
+
+//==============================================================================
+TEST(World, CollisionPipelining)
+{
+  WorldPtr serialWorld = createStackedBoxesWorld();
+  WorldPtr pipelinedWorld = createStackedBoxesWorld();
+  EXPECT_FALSE(pipelinedWorld->isCollisionPipeliningEnabled());
+  pipelinedWorld->setCollisionPipeliningEnabled(true);
+  EXPECT_TRUE(pipelinedWorld->isCollisionPipeliningEnabled());
+  EXPECT_TRUE(pipelinedWorld->clone()->isCollisionPipeliningEnabled());
+
+  WorldPtr threadedWorld = createStackedBoxesWorld();
+  threadedWorld->setCollisionPipeliningEnabled(true);
+  threadedWorld->setNumThreads(4u);
+
+#ifndef NDEBUG // Debug mode
+  std::size_t numIterations = 20;
+#else
+  std::size_t numIterations = 500;
+#endif
+
+  std::size_t numContacts = 0u;
+  for (std::size_t i = 0; i < numIterations; ++i)
+  {
+    for (std::size_t k = 0; k < serialWorld->getNumSkeletons(); ++k)
+    {
+      SkeletonPtr skel = serialWorld->getSkeleton(k);
+
+      Eigen::VectorXd commands = skel->getCommands();
+      for (int q = 0; q < commands.size(); ++q)
+        commands[q] = random(-0.1, 0.1);
+
+      skel->setCommands(commands);
+      pipelinedWorld->getSkeleton(k)->setCommands(commands);
+      threadedWorld->getSkeleton(k)->setCommands(commands);
+    }
+
+    serialWorld->step();
+    pipelinedWorld->step();
+    threadedWorld->step();
+
+    const auto& result = serialWorld->getLastCollisionResult();
+    EXPECT_EQ(pipelinedWorld->getLastCollisionResult().getNumContacts(),
+              result.getNumContacts());
+    EXPECT_EQ(threadedWorld->getLastCollisionResult().getNumContacts(),
+              result.getNumContacts());
+    numContacts += result.getNumContacts();
+  }
+  EXPECT_GT(numContacts, 0u);
+
+  for (std::size_t k = 0; k < serialWorld->getNumSkeletons(); ++k)
+  {
+    SkeletonPtr skel = serialWorld->getSkeleton(k);
+
+    for (const WorldPtr& world : {pipelinedWorld, threadedWorld})
+    {
+      SkeletonPtr clone = world->getSkeleton(k);
+      EXPECT_TRUE(equals(skel->getPositions(), clone->getPositions(), 0));
+      EXPECT_TRUE(equals(skel->getVelocities(), clone->getVelocities(), 0));
+    }
+  }
+
+  // Switching the pipelining off in between steps keeps the results identical
+  pipelinedWorld->setCollisionPipeliningEnabled(false);
+  serialWorld->step();
+  pipelinedWorld->step();
+  for (std::size_t k = 0; k < serialWorld->getNumSkeletons(); ++k)
+  {
+    EXPECT_TRUE(equals(serialWorld->getSkeleton(k)->getPositions(),
+                       pipelinedWorld->getSkeleton(k)->getPositions(), 0));
+  }
+}
+
+//==============================================================================
+TEST(World, CollisionPipeliningStress)
+{
+  // The collision detection runs in a thread of its own while the forward
+  // dynamics dirties the velocities and accelerations of the same BodyNodes.
+  // The World only does this with several hardware threads, so the overlap is
+  // also forced here with a std::thread. Build with -fsanitize=thread to check
+  // that the two sides never write state that the other one reads.
+  const std::size_t maxNumContactsPerPair = 2u;
+
+  WorldPtr serialWorld = createStackedBoxesWorld();
+  WorldPtr pipelinedWorld = createStackedBoxesWorld();
+  WorldPtr threadedWorld = createStackedBoxesWorld();
+  pipelinedWorld->setCollisionPipeliningEnabled(true);
+  for (const WorldPtr& world : {serialWorld, pipelinedWorld, threadedWorld})
+  {
+    world->getConstraintSolver()->setMaxNumContactsPerPair(
+          maxNumContactsPerPair);
+  }
+
+#ifndef NDEBUG // Debug mode
+  std::size_t numIterations = 20;
+#else
+  std::size_t numIterations = 500;
+#endif
+
+  const auto solver = threadedWorld->getConstraintSolver();
+  const auto group = solver->getCollisionGroup();
+
+  std::size_t numReducedContacts = 0u;
+  for (std::size_t i = 0; i < numIterations; ++i)
+  {
+    for (std::size_t k = 0; k < serialWorld->getNumSkeletons(); ++k)
+    {
+      Eigen::VectorXd commands = serialWorld->getSkeleton(k)->getCommands();
+      for (int q = 0; q < commands.size(); ++q)
+        commands[q] = random(-0.1, 0.1);
+
+      for (const WorldPtr& world : {serialWorld, pipelinedWorld, threadedWorld})
+        world->getSkeleton(k)->setCommands(commands);
+    }
+
+    // Same as World::step() with the collision pipelining, except that the
+    // forward dynamics is thrown away
+    for (std::size_t j = 0; j < group->getNumShapeFrames(); ++j)
+      group->getShapeFrame(j)->getWorldTransform();
+
+    std::thread worker([&]() { solver->detectCollision(); });
+    for (std::size_t k = 0; k < threadedWorld->getNumSkeletons(); ++k)
+    {
+      SkeletonPtr skel = threadedWorld->getSkeleton(k);
+      const Eigen::VectorXd velocities = skel->getVelocities();
+      for (std::size_t n = 0; n < 10; ++n)
+      {
+        skel->computeForwardDynamics();
+        skel->integrateVelocities(threadedWorld->getTimeStep());
+        skel->setVelocities(velocities);
+      }
+    }
+    worker.join();
+
+    serialWorld->step();
+    pipelinedWorld->step();
+    threadedWorld->step();
+
+    const auto& result = serialWorld->getLastCollisionResult();
+    EXPECT_EQ(pipelinedWorld->getLastCollisionResult().getNumContacts(),
+              result.getNumContacts());
+    EXPECT_EQ(threadedWorld->getLastCollisionResult().getNumContacts(),
+              result.getNumContacts());
+    numReducedContacts += solver->getLastNumReducedContacts();
+  }
+  EXPECT_GT(numReducedContacts, 0u);
+
+  for (std::size_t k = 0; k < serialWorld->getNumSkeletons(); ++k)
+  {
+    SkeletonPtr skel = serialWorld->getSkeleton(k);
+
+    for (const WorldPtr& world : {pipelinedWorld, threadedWorld})
+    {
+      SkeletonPtr clone = world->getSkeleton(k);
+      EXPECT_TRUE(equals(skel->getPositions(), clone->getPositions(), 0));
+      EXPECT_TRUE(equals(skel->getVelocities(), clone->getVelocities(), 0));
+    }
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2017, Graphics Lab, Georgia Tech Research Corporation
+ * Copyright (c) 2017, Personal Robotics Lab, Carnegie Mellon University
+ * All rights reserved.
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "dart/common/ThreadPool.hpp"
+
+using namespace dart;
+using namespace common;
+
+//==============================================================================
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce)
+{
+  for (std::size_t numThreads : {1u, 2u, 5u})
+  {
+    ThreadPool pool(numThreads);
+    EXPECT_EQ(pool.getNumThreads(), numThreads);
+
+    std::vector<int> visits(103, 0);
+    pool.parallelFor(3u, visits.size(), [&](std::size_t i) { ++visits[i]; });
+
+    for (std::size_t i = 0u; i < visits.size(); ++i)
+      EXPECT_EQ(visits[i], i < 3u ? 0 : 1);
+
+    // Empty ranges are no-ops
+    pool.parallelFor(5u, 5u, [&](std::size_t) { FAIL(); });
+  }
+}
+
+//==============================================================================
+TEST(ThreadPool, Submit)
+{
+  ThreadPool pool(3u);
+
+  std::atomic<int> counter(0);
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 20; ++i)
+    futures.push_back(pool.submit([&]() { ++counter; }));
+
+  for (auto& future : futures)
+    future.get();
+
+  EXPECT_EQ(counter.load(), 20);
+}
+
+//==============================================================================
+TEST(ThreadPool, ExceptionIsRethrown)
+{
+  ThreadPool pool(4u);
+
+  EXPECT_THROW(
+      pool.parallelFor(0u, 100u, [](std::size_t i)
+      {
+        if (i == 70u)
+          throw std::runtime_error("failure");
+      }),
+      std::runtime_error);
+
+  // The pool is still usable afterwards
+  std::atomic<int> counter(0);
+  pool.parallelFor(0u, 100u, [&](std::size_t) { ++counter; });
+  EXPECT_EQ(counter.load(), 100);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}